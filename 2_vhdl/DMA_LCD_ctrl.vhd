@@ -4,47 +4,361 @@ use IEEE.std_logic_1164.all;
 use IEEE.numeric_std.all;
 
 entity DMA_LCD_ctrl is
+	generic (
+		BURST_LENGTH      : integer := 16;  -- words each burst, max. 128
+		FIFO_DEPTH        : integer := 64;  -- words, power of 2, >= BURST_LENGTH
+		WR_LOW_CYCLES     : integer := 2;   -- ILI9341: twrl >= 15 ns
+		WR_HIGH_CYCLES    : integer := 2    -- ILI9341: twrh >= 15 ns, twc >= 66 ns
+	);
 	port (
 		clk               : in    std_logic                    ;
-		reset             : in    std_logic                    ;         
+		reset             : in    std_logic                    ;
 		-- master interface
  		master_address	  : out  std_logic_vector(31 downto 0);
 		master_read	  : out std_logic;
-		master_readdata	  : in std_logic_vector(7 downto 0) ;
+		master_burstcount : out std_logic_vector(7 downto 0);
+		master_readdata	  : in std_logic_vector(31 downto 0) ;
+		master_readdatavalid : in std_logic;
 		master_waitrequest : in std_logic;
 		-- IRQ generation
-		end_of_transaction_irq : out std_logic;		
-		-- slave interface 
+		end_of_transaction_irq : out std_logic;
+		-- slave interface
 		avalon_address    : in    std_logic_vector(2 downto 0) ;
-		avalon_cs         : in    std_logic                   ;  
-		avalon_wr         : in    std_logic                    ;  
+		avalon_cs         : in    std_logic                   ;
+		avalon_wr         : in    std_logic                    ;
 		avalon_write_data : in    std_logic_vector(31 downto 0);
-		avalon_rd         : in    std_logic                    ;  
+		avalon_rd         : in    std_logic                    ;
 		avalon_read_data  : out    std_logic_vector(31 downto 0);
+		avalon_waitrequest : out   std_logic;
 		-- LCD interface
 		LCD_data          : out std_logic_vector(7 downto 0) ;
-		LCD_CS_n	  : out    std_logic ;		
-		LCD_WR_n	  : out    std_logic ;				
-		LCD_D_C_n	  : out    std_logic 
+		LCD_CS_n	  : out    std_logic ;
+		LCD_WR_n	  : out    std_logic ;
+		LCD_D_C_n	  : out    std_logic
 	);
 end entity DMA_LCD_ctrl;
 
 architecture rtl of DMA_LCD_ctrl is
--- your signals
+	type fifo_t is array (0 to FIFO_DEPTH-1) of std_logic_vector(31 downto 0);
+	type lcd_state_t is (LCD_IDLE, LCD_LOW, LCD_HIGH);
+	type master_state_t is (MASTER_IDLE, MASTER_READ);
+
+	-- registers
+	signal pointer_reg       : unsigned(31 downto 2);
+	signal size_reg          : unsigned(23 downto 0);
+	signal irq_reg           : std_logic;
+	signal busy_reg          : std_logic;
+	signal start             : std_logic;
+
+	-- single command/data writes from the slave
+	signal write_lcd         : std_logic;
+	signal single_pending    : std_logic;
+	signal single_data       : std_logic_vector(7 downto 0);
+	signal single_d_c_n      : std_logic;
+
+	-- avalon master
+	signal master_state      : master_state_t;
+	signal read_address      : unsigned(31 downto 2);
+	signal words_to_request  : unsigned(21 downto 0);
+	signal burst_words       : integer range 0 to 128;
+	signal burst_reg         : integer range 0 to 128;
+	signal outstanding       : integer range 0 to FIFO_DEPTH;
+
+	-- fifo, the word in unpacking is held in word_reg
+	signal fifo              : fifo_t;
+	signal fifo_wr_ptr       : integer range 0 to FIFO_DEPTH-1;
+	signal fifo_rd_ptr       : integer range 0 to FIFO_DEPTH-1;
+	signal fifo_count        : integer range 0 to FIFO_DEPTH;
+	signal word_reg          : std_logic_vector(31 downto 0);
+	signal word_valid        : std_logic;
+
+	-- unpacking and LCD write cycle
+	signal lcd_state         : lcd_state_t;
+	signal lcd_count         : integer range 0 to 15;
+	signal bytes_left        : unsigned(23 downto 0);
+	signal byte_index        : unsigned(1 downto 0);
+	signal dma_byte          : std_logic_vector(7 downto 0);
+	signal dma_available     : std_logic;
+	signal can_start         : std_logic;
+	signal take_single       : std_logic;
+	signal take_dma          : std_logic;
+	signal cycle_done        : std_logic;
 
 begin
--------- register model (a proposal) -----------
--- 000 write command to LCD
--- 001 write data to LCD
--- 010 write pointer of the image to copy
--- 011 write size of the image to copy
--- 100 control register 
---	bit 0 => start transfer 
---	bit 1 => reserved 
---	bit 2 => IRQ ack 
+-------- register model -----------
+-- 000 write: command byte to LCD (bit 7..0)
+-- 001 write: data byte to LCD (bit 7..0)
+--     writes to 000 and 001 are held by the waitrequest while a byte is
+--     waiting or a transfer is in progress
+-- 010 r/w: pointer of the image to copy (word aligned)
+-- 011 r/w: size of the image to copy in bytes (2 per RGB565 pixel)
+-- 100 write: control register
+--	bit 0 => start transfer
+--	bit 1 => reserved
+--	bit 2 => IRQ ack
+--     read: status
+--	bit 0 => transfer in progress
+--	bit 1 => LCD write cycle in progress
+--	bit 2 => IRQ pending (end of transfer)
+-- The bytes of each 32-bit word are sent as 15..8, 7..0, 31..24, 23..16,
+-- that is each little endian RGB565 pixel with its high byte first, as the
+-- ILI9341 expects it in 8-bit mode. The "memory write" command (0x2C) is
+-- written to 000 before the transfer is started.
+
+-- Avalon slave
+-- ------------
+	write_lcd <= '1' when avalon_cs = '1' and avalon_wr = '1' and
+	                      avalon_address(2 downto 1) = "00" else '0';
+	avalon_waitrequest <= '1' when write_lcd = '1' and
+	                               (single_pending = '1' or busy_reg = '1') else '0';
+	start <= '1' when avalon_cs = '1' and avalon_wr = '1' and
+	                  avalon_address = "100" and avalon_write_data(0) = '1' and
+	                  busy_reg = '0' else '0';
+
+	-- Read process from registers with wait 1
+	pRegRd : process(clk)
+	begin
+		if rising_edge(clk) then
+			avalon_read_data <= (others => '0');
+			if avalon_cs = '1' and avalon_rd = '1' then
+				case avalon_address is
+					when "010" => avalon_read_data <= std_logic_vector(pointer_reg) & "00";
+					when "011" => avalon_read_data(23 downto 0) <= std_logic_vector(size_reg);
+					when "100" => avalon_read_data(2 downto 0) <= irq_reg &
+					                 not(cycle_done) & busy_reg;
+					when others => null;
+				end case;
+			end if;
+		end if;
+	end process pRegRd;
+
+	-- Write process to registers
+	pRegWr : process(clk)
+	begin
+		if rising_edge(clk) then
+			if reset = '1' then
+				pointer_reg <= (others => '0');
+				size_reg <= (others => '0');
+			elsif avalon_cs = '1' and avalon_wr = '1' then
+				case avalon_address is
+					when "010" => pointer_reg <= unsigned(avalon_write_data(31 downto 2));
+					when "011" => size_reg <= unsigned(avalon_write_data(23 downto 0));
+					when others => null;
+				end case;
+			end if;
+		end if;
+	end process pRegWr;
+
+	pSingle : process(clk)
+	begin
+		if rising_edge(clk) then
+			if reset = '1' then
+				single_pending <= '0';
+				single_data <= (others => '0');
+				single_d_c_n <= '0';
+			elsif write_lcd = '1' and single_pending = '0' and busy_reg = '0' then
+				single_pending <= '1';
+				single_data <= avalon_write_data(7 downto 0);
+				single_d_c_n <= avalon_address(0);
+			elsif take_single = '1' then
+				single_pending <= '0';
+			end if;
+		end if;
+	end process pSingle;
+
+-- IRQ and transfer status
+-- -----------------------
+	end_of_transaction_irq <= irq_reg;
+
+	pStatus : process(clk)
+	begin
+		if rising_edge(clk) then
+			if reset = '1' then
+				busy_reg <= '0';
+				irq_reg <= '0';
+			elsif start = '1' then
+				busy_reg <= '1';
+			elsif busy_reg = '1' and bytes_left = 0 and cycle_done = '1' then
+				busy_reg <= '0';
+				irq_reg <= '1';
+			elsif avalon_cs = '1' and avalon_wr = '1' and
+			      avalon_address = "100" and avalon_write_data(2) = '1' then
+				irq_reg <= '0';
+			end if;
+		end if;
+	end process pStatus;
+
+-- Avalon master, a burst is only requested if it fits in the fifo
+-- ----------------------------------------------------------------
+	burst_words <= BURST_LENGTH when words_to_request >= BURST_LENGTH else
+	               to_integer(words_to_request);
+
+	pMaster : process(clk)
+		variable v_outstanding : integer range 0 to FIFO_DEPTH;
+	begin
+		if rising_edge(clk) then
+			if reset = '1' then
+				master_state <= MASTER_IDLE;
+				master_read <= '0';
+				master_address <= (others => '0');
+				master_burstcount <= (others => '0');
+				read_address <= (others => '0');
+				words_to_request <= (others => '0');
+				burst_reg <= 0;
+				outstanding <= 0;
+			else
+				v_outstanding := outstanding;
+				if master_readdatavalid = '1' and v_outstanding /= 0 then
+					v_outstanding := v_outstanding - 1;
+				end if;
+				if start = '1' then
+					read_address <= pointer_reg;
+					words_to_request <= resize((size_reg + 3) srl 2, 22);
+				end if;
+				case master_state is
+					when MASTER_IDLE =>
+						if start = '0' and words_to_request /= 0 and
+						   fifo_count + outstanding + burst_words <= FIFO_DEPTH then
+							master_state <= MASTER_READ;
+							master_read <= '1';
+							master_address <= std_logic_vector(read_address) & "00";
+							master_burstcount <= std_logic_vector(to_unsigned(burst_words, 8));
+							burst_reg <= burst_words;
+						end if;
+					when MASTER_READ =>
+						if master_waitrequest = '0' then
+							master_state <= MASTER_IDLE;
+							master_read <= '0';
+							read_address <= read_address + burst_reg;
+							words_to_request <= words_to_request - burst_reg;
+							v_outstanding := v_outstanding + burst_reg;
+						end if;
+				end case;
+				outstanding <= v_outstanding;
+			end if;
+		end if;
+	end process pMaster;
+
+-- FIFO and unpacking into bytes
+-- -----------------------------
+	pFifoMem : process(clk)
+	begin
+		if rising_edge(clk) then
+			if master_readdatavalid = '1' then
+				fifo(fifo_wr_ptr) <= master_readdata;
+			end if;
+		end if;
+	end process pFifoMem;
+
+	pFifo : process(clk)
+		variable v_count : integer range 0 to FIFO_DEPTH;
+		variable v_valid : std_logic;
+	begin
+		if rising_edge(clk) then
+			if reset = '1' or start = '1' then
+				fifo_wr_ptr <= 0;
+				fifo_rd_ptr <= 0;
+				fifo_count <= 0;
+				word_valid <= '0';
+				byte_index <= "00";
+				if start = '1' then
+					bytes_left <= size_reg;
+				else
+					bytes_left <= (others => '0');
+				end if;
+			else
+				v_count := fifo_count;
+				v_valid := word_valid;
+				if master_readdatavalid = '1' then
+					if fifo_wr_ptr = FIFO_DEPTH-1 then
+						fifo_wr_ptr <= 0;
+					else
+						fifo_wr_ptr <= fifo_wr_ptr + 1;
+					end if;
+					v_count := v_count + 1;
+				end if;
+				if take_dma = '1' then
+					bytes_left <= bytes_left - 1;
+					if byte_index = "11" or bytes_left = 1 then
+						v_valid := '0';
+						byte_index <= "00";
+					else
+						byte_index <= byte_index + 1;
+					end if;
+				end if;
+				if v_valid = '0' and fifo_count /= 0 then
+					word_reg <= fifo(fifo_rd_ptr);
+					if fifo_rd_ptr = FIFO_DEPTH-1 then
+						fifo_rd_ptr <= 0;
+					else
+						fifo_rd_ptr <= fifo_rd_ptr + 1;
+					end if;
+					v_count := v_count - 1;
+					v_valid := '1';
+				end if;
+				fifo_count <= v_count;
+				word_valid <= v_valid;
+			end if;
+		end if;
+	end process pFifo;
 
+	with byte_index select
+		dma_byte <= word_reg(15 downto 8)  when "00",
+		            word_reg(7 downto 0)   when "01",
+		            word_reg(31 downto 24) when "10",
+		            word_reg(23 downto 16) when others;
 
--- your code
+-- LCD write cycle
+-- ---------------
+	dma_available <= '1' when busy_reg = '1' and word_valid = '1' and
+	                          bytes_left /= 0 else '0';
+	can_start <= '1' when lcd_state = LCD_IDLE or
+	                      (lcd_state = LCD_HIGH and lcd_count = 0) else '0';
+	take_single <= can_start and single_pending;
+	take_dma <= can_start and dma_available and not(single_pending);
+	cycle_done <= '1' when lcd_state = LCD_IDLE else '0';
 
+	-- data and D/C change with the falling edge of WR, the next byte
+	-- follows directly after the high time
+	pLcd : process(clk)
+	begin
+		if rising_edge(clk) then
+			if reset = '1' then
+				lcd_state <= LCD_IDLE;
+				lcd_count <= 0;
+				LCD_data <= (others => '0');
+				LCD_CS_n <= '1';
+				LCD_WR_n <= '1';
+				LCD_D_C_n <= '1';
+			elsif take_single = '1' or take_dma = '1' then
+				if take_single = '1' then
+					LCD_data <= single_data;
+					LCD_D_C_n <= single_d_c_n;
+				else
+					LCD_data <= dma_byte;
+					LCD_D_C_n <= '1';
+				end if;
+				LCD_CS_n <= '0';
+				LCD_WR_n <= '0';
+				lcd_state <= LCD_LOW;
+				lcd_count <= WR_LOW_CYCLES-1;
+			elsif lcd_state = LCD_LOW then
+				if lcd_count = 0 then
+					LCD_WR_n <= '1';
+					lcd_state <= LCD_HIGH;
+					lcd_count <= WR_HIGH_CYCLES-1;
+				else
+					lcd_count <= lcd_count - 1;
+				end if;
+			elsif lcd_state = LCD_HIGH then
+				if lcd_count = 0 then
+					LCD_CS_n <= '1';
+					lcd_state <= LCD_IDLE;
+				else
+					lcd_count <= lcd_count - 1;
+				end if;
+			end if;
+		end if;
+	end process pLcd;
 
-end architecture rtl; 
+end architecture rtl;
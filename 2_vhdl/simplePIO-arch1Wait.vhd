@@ -12,6 +12,8 @@ entity SimplePIO is
         Write_SI        : in    std_logic;
         ReadData_DO     : out   std_logic_vector (7 DOWNTO 0);
         WriteData_DI    : in    std_logic_vector (7 DOWNTO 0);
+        -- Edge capture interrupt
+        Irq_SO          : out   std_logic;
         -- Parallel Port external interface
         ParPort_DIO     : INOUT std_logic_vector (7 DOWNTO 0)
     );
@@ -23,6 +25,11 @@ architecture oneWait of simplePIO is
     signal RegDir_D     : std_logic_vector (7 DOWNTO 0);		-- Direction
     signal RegPort_D    : std_logic_vector (7 DOWNTO 0);		-- Output
     signal RegPin_D     : std_logic_vector (7 DOWNTO 0);		-- Input
+    signal RegIrqEn_D   : std_logic_vector (7 DOWNTO 0);		-- IRQ enable
+    signal RegEdge_D    : std_logic_vector (7 DOWNTO 0);		-- Edge capture
+    signal PinSync_D    : std_logic_vector (7 DOWNTO 0);		-- Synchronizer
+    signal PinNew_D     : std_logic_vector (7 DOWNTO 0);
+    signal PinOld_D     : std_logic_vector (7 DOWNTO 0);
 begin
 
 -- Avalon Stuff
@@ -39,6 +46,8 @@ begin
                 when "000" => ReadData_DO <= RegDir_D;
                 when "001" => ReadData_DO <= RegPin_D;
                 when "010" => ReadData_DO <= RegPort_D;
+                when "101" => ReadData_DO <= RegIrqEn_D;
+                when "110" => ReadData_DO <= RegEdge_D;
                 when others => null;
             end case;
         end if;
@@ -53,6 +62,7 @@ pRegWr : process(Clk_CI, Reset_RLI)
 		-- Input by default
 		RegDir_D <= (others => '0');
 		RegPort_D <= (others => '0');
+		RegIrqEn_D <= (others => '0');
 	elsif rising_edge(Clk_CI) then
 		if ChipSelect_SI = '1' and Write_SI = '1' then
 			-- Write cycle
@@ -61,6 +71,7 @@ pRegWr : process(Clk_CI, Reset_RLI)
 				when "010" => RegPort_D <= WriteData_DI;
 				when "011" => RegPort_D <= RegPort_D OR WriteData_DI;
 				when "100" => RegPort_D <= RegPort_D AND NOT WriteData_DI;
+				when "101" => RegIrqEn_D <= WriteData_DI;
 				when others => null;
 			end case;
 		end if;
@@ -68,6 +79,37 @@ pRegWr : process(Clk_CI, Reset_RLI)
 end process pRegWr;
 
 
+-- Edge capture
+-- ------------
+
+-- The input pins are synchronized, every change of an input pin sets its
+-- capture bit. Writing a one to a bit of register "110" clears it, an edge
+-- in the same cycle wins.
+pEdge : process(Clk_CI, Reset_RLI)
+begin
+    if (Reset_RLI = '0') then
+        PinSync_D <= (others => '0');
+        PinNew_D  <= (others => '0');
+        PinOld_D  <= (others => '0');
+        RegEdge_D <= (others => '0');
+    elsif rising_edge(Clk_CI) then
+        PinSync_D <= RegPin_D;
+        PinNew_D  <= PinSync_D;
+        PinOld_D  <= PinNew_D;
+        if ChipSelect_SI = '1' and Write_SI = '1' and Address_DI = "110" then
+            RegEdge_D <= (RegEdge_D AND NOT WriteData_DI) OR
+                         ((PinNew_D XOR PinOld_D) AND NOT RegDir_D);
+        else
+            RegEdge_D <= RegEdge_D OR
+                         ((PinNew_D XOR PinOld_D) AND NOT RegDir_D);
+        end if;
+    end if;
+end process pEdge;
+
+-- The interrupt stays active as long as an enabled capture bit is set
+Irq_SO <= '1' when (RegEdge_D AND RegIrqEn_D) /= "00000000" else '0';
+
+
 
 -- Interface to real world
 -- -----------------------
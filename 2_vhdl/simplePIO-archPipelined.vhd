@@ -0,0 +1,140 @@
+library ieee;
+use ieee.std_logic_1164.all;
+
+entity SimplePIOPipelined is
+    port(
+        -- Avalon interfaces signals
+        Clk_CI          : in    std_logic;
+        Reset_RLI       : in    std_logic;
+        Address_DI      : in    std_logic_vector (2 DOWNTO 0);
+        ChipSelect_SI   : in    std_logic;
+        Read_SI         : in    std_logic;
+        Write_SI        : in    std_logic;
+        ReadData_DO     : out   std_logic_vector (7 DOWNTO 0);
+        ReadDataValid_SO: out   std_logic;
+        WriteData_DI    : in    std_logic_vector (7 DOWNTO 0);
+        -- Edge capture interrupt
+        Irq_SO          : out   std_logic;
+        -- Parallel Port external interface
+        ParPort_DIO     : INOUT std_logic_vector (7 DOWNTO 0)
+    );
+end entity SimplePIOPipelined;
+
+
+
+architecture pipelined of SimplePIOPipelined is
+    signal RegDir_D     : std_logic_vector (7 DOWNTO 0);		-- Direction
+    signal RegPort_D    : std_logic_vector (7 DOWNTO 0);		-- Output
+    signal RegPin_D     : std_logic_vector (7 DOWNTO 0);		-- Input
+    signal RegIrqEn_D   : std_logic_vector (7 DOWNTO 0);		-- IRQ enable
+    signal RegEdge_D    : std_logic_vector (7 DOWNTO 0);		-- Edge capture
+    signal PinSync_D    : std_logic_vector (7 DOWNTO 0);		-- Synchronizer
+    signal PinNew_D     : std_logic_vector (7 DOWNTO 0);
+    signal PinOld_D     : std_logic_vector (7 DOWNTO 0);
+begin
+
+-- Avalon Stuff
+-- ------------
+
+-- Read Process from registers without wait state
+-- A read is accepted in every cycle, the data follows one cycle later with
+-- ReadDataValid_SO, so back-to-back reads complete at one per cycle.
+pRegRd : process(Clk_CI, Reset_RLI)
+begin
+    if (Reset_RLI = '0') then
+        ReadData_DO <= (others => '0');
+        ReadDataValid_SO <= '0';
+    elsif rising_edge(Clk_CI) then
+        ReadData_DO <= (others => '0');
+        ReadDataValid_SO <= '0';
+        if ChipSelect_SI = '1' and Read_SI = '1' then
+            -- Read cycle
+            ReadDataValid_SO <= '1';
+            case Address_DI(2 downto 0) is
+                when "000" => ReadData_DO <= RegDir_D;
+                when "001" => ReadData_DO <= RegPin_D;
+                when "010" => ReadData_DO <= RegPort_D;
+                when "101" => ReadData_DO <= RegIrqEn_D;
+                when "110" => ReadData_DO <= RegEdge_D;
+                when others => null;
+            end case;
+        end if;
+    end if;
+end process pRegRd;
+
+
+-- Write Process to registers without wait state
+pRegWr : process(Clk_CI, Reset_RLI)
+	begin
+		if (Reset_RLI = '0') then
+		-- Input by default
+		RegDir_D <= (others => '0');
+		RegPort_D <= (others => '0');
+		RegIrqEn_D <= (others => '0');
+	elsif rising_edge(Clk_CI) then
+		if ChipSelect_SI = '1' and Write_SI = '1' then
+			-- Write cycle
+			case Address_DI(2 downto 0) is
+				when "000" => RegDir_D <= WriteData_DI;
+				when "010" => RegPort_D <= WriteData_DI;
+				when "011" => RegPort_D <= RegPort_D OR WriteData_DI;
+				when "100" => RegPort_D <= RegPort_D AND NOT WriteData_DI;
+				when "101" => RegIrqEn_D <= WriteData_DI;
+				when others => null;
+			end case;
+		end if;
+	end if;
+end process pRegWr;
+
+
+-- Edge capture
+-- ------------
+
+-- The input pins are synchronized, every change of an input pin sets its
+-- capture bit. Writing a one to a bit of register "110" clears it, an edge
+-- in the same cycle wins.
+pEdge : process(Clk_CI, Reset_RLI)
+begin
+    if (Reset_RLI = '0') then
+        PinSync_D <= (others => '0');
+        PinNew_D  <= (others => '0');
+        PinOld_D  <= (others => '0');
+        RegEdge_D <= (others => '0');
+    elsif rising_edge(Clk_CI) then
+        PinSync_D <= RegPin_D;
+        PinNew_D  <= PinSync_D;
+        PinOld_D  <= PinNew_D;
+        if ChipSelect_SI = '1' and Write_SI = '1' and Address_DI = "110" then
+            RegEdge_D <= (RegEdge_D AND NOT WriteData_DI) OR
+                         ((PinNew_D XOR PinOld_D) AND NOT RegDir_D);
+        else
+            RegEdge_D <= RegEdge_D OR
+                         ((PinNew_D XOR PinOld_D) AND NOT RegDir_D);
+        end if;
+    end if;
+end process pEdge;
+
+-- The interrupt stays active as long as an enabled capture bit is set
+Irq_SO <= '1' when (RegEdge_D AND RegIrqEn_D) /= "00000000" else '0';
+
+
+
+-- Interface to real world
+-- -----------------------
+
+-- Parallel Port output value
+pPort : process(RegDir_D, RegPort_D)
+begin
+    for idx in 0 to 7 loop
+        if RegDir_D(idx) = '1' then
+            ParPort_DIO(idx) <= RegPort_D(idx);
+        else
+            ParPort_DIO(idx) <= 'Z';
+        end if;
+    end loop;
+end process pPort;
+
+-- Parallel Port Input value
+RegPin_D <= ParPort_DIO;
+
+end architecture pipelined;
@@ -20,6 +20,14 @@
  *
  *  The example shows how to use ISR and Timer. The timer is used with
  *  fixed period.
+ *  The ISRs do not set flags, they put timestamped events in a queue: one
+ *  for each timer period and one for each edge of the simplePIO inputs
+ *  (upper nibble, edge capture interrupt). The main loop only takes the
+ *  events out, it does not read any register. The timestamp is the number
+ *  of timer periods.
+ *  The events are logged with binlog() of binlog/ (add binlog.c) instead
+ *  of printf(); the log is sent when the queue is empty. Decode the
+ *  terminal output with binlog/host/binlog_decode.
  *  Caution, there is no read back of ctrl Reg before writing new values.
  *  This can result in wrong behavior.
  * @copyright GNU Lesser General Public License
@@ -36,6 +44,8 @@
 #include "sys/alt_irq.h"
 #include "priv/alt_legacy_irq.h"
 
+#include "binlog.h"
+
 // simplify working with the Timer
 #define TIMER_EN_IRQ    0x0001
 #define TIMER_DIS_IRQ   0x0000
@@ -48,34 +58,71 @@
 #define TIMER_REG_PERIOD_LOW   0x02
 #define TIMER_REG_PERIOD_HIGH  0x03
 
+// simplePIO registers
+#define PIO_REG_DIR     0x00
+#define PIO_REG_PIN     0x01
+#define PIO_REG_PORT    0x02
+#define PIO_REG_IRQ_EN  0x05
+#define PIO_REG_EDGE    0x06
+
+#define PIO_OUTPUTS     0x0F   // counter on the lower nibble
+#define PIO_INPUTS      0xF0   // edge capture interrupt on the upper nibble
+
+#define EVENT_TIMER     1
+#define EVENT_PIO       2
+#define EVENT_SLOTS     16     // must be a power of two
+
 // function prototypes
 static void timer_interrupt_handler(void *context, alt_u32 id);
 
+static void pio_interrupt_handler(void *context, alt_u32 id);
+
 static int init_timer(void* context, alt_isr_func handler);
 
-static int init_simplePIO(void);
+static int init_simplePIO(void* context, alt_isr_func handler);
 
 static int init_led(void);
 
-// counter structure
-typedef struct _IRQcounter{
-	int count;
-	bool irq;
-}IRQcounter;
+// event, filled in by the ISRs
+typedef struct _IRQevent{
+	int timestamp;
+	int source;
+	alt_u8 value;
+	alt_u8 changed;
+}IRQevent;
+
+// event queue, the ISRs only write head, main only writes tail
+typedef struct _IRQqueue{
+	volatile int count;
+	volatile unsigned int head;
+	volatile unsigned int tail;
+	IRQevent event[EVENT_SLOTS];
+}IRQqueue;
+
+static void put_event(IRQqueue *queue, int source, alt_u8 value,
+		alt_u8 changed);
+
+static bool get_event(IRQqueue *queue, IRQevent *event);
 
 
 int main(void)
 {
-	// counter
-	IRQcounter counter;
-	counter.count = 0;
-	counter.irq   = false;
+	// event queue
+	static IRQqueue queue;
+	IRQevent event;
+	queue.count = 0;
+	queue.head  = 0;
+	queue.tail  = 0;
+
+	// initialize the log
+	binlog_start_clock();
+	binlog_init();
 
 	// initialize the timer
-	init_timer(&counter, (alt_isr_func)timer_interrupt_handler);
+	init_timer(&queue, (alt_isr_func)timer_interrupt_handler);
 
 	// initialize simple PIO
-	init_simplePIO();
+	init_simplePIO(&queue, (alt_isr_func)pio_interrupt_handler);
 
 	// initialize LED interface
 	init_led();
@@ -90,14 +137,22 @@ int main(void)
 
 	while(1)
 	{
-		if(counter.irq)
+		if(!get_event(&queue, &event))
 		{
-			printf("counter value is = %d \n",counter.count);
+			binlog_drain(BINLOG_DRAIN_MAX); // idle: send the log
+			continue;
+		}
+		if(event.source == EVENT_TIMER)
+		{
+			binlog(LOG_COUNTER, event.timestamp, 0);
 			// led IF count (lab1)
-			IOWR_16DIRECT(LEDS_BASE,0, counter.count);
+			IOWR_16DIRECT(LEDS_BASE,0, event.timestamp);
 			// simplePIO IF count (lab2)
-			IOWR_8DIRECT(SIMPLEPIO_BASE,2, counter.count);
-			counter.irq = false;
+			IOWR_8DIRECT(SIMPLEPIO_BASE,PIO_REG_PORT, event.timestamp);
+		}
+		else
+		{
+			binlog(LOG_PIO_EDGE, event.value, event.changed);
 		}
 	}
 }
@@ -105,9 +160,9 @@ int main(void)
 
 static void timer_interrupt_handler(void *context, alt_u32 id)
 {
-	IRQcounter *ctr_ptr = (IRQcounter*) context;
-	ctr_ptr->count++; // increase the counter;
-	ctr_ptr->irq = true;
+	IRQqueue *queue = (IRQqueue*) context;
+	queue->count++; // increase the counter;
+	put_event(queue, EVENT_TIMER, 0, 0);
 
 	IOWR_16DIRECT(SYS_TIMER_BASE, TIMER_REG_STATUS, TIMER_CLEAR_IRQ);
 
@@ -115,6 +170,49 @@ static void timer_interrupt_handler(void *context, alt_u32 id)
 }
 
 
+static void pio_interrupt_handler(void *context, alt_u32 id)
+{
+	IRQqueue *queue = (IRQqueue*) context;
+	alt_u8 changed = IORD_8DIRECT(SIMPLEPIO_BASE, PIO_REG_EDGE);
+
+	// writing a one clears the captured edge, a new edge is kept
+	IOWR_8DIRECT(SIMPLEPIO_BASE, PIO_REG_EDGE, changed);
+	put_event(queue, EVENT_PIO,
+			IORD_8DIRECT(SIMPLEPIO_BASE, PIO_REG_PIN) & PIO_INPUTS, changed);
+
+	return;
+}
+
+
+// called by the ISRs only, a full queue drops the event
+static void put_event(IRQqueue *queue, int source, alt_u8 value,
+		alt_u8 changed)
+{
+	IRQevent *event;
+	if (queue->head - queue->tail >= EVENT_SLOTS)
+		return;
+	event = &queue->event[queue->head & (EVENT_SLOTS-1)];
+	event->timestamp = queue->count;
+	event->source    = source;
+	event->value     = value;
+	event->changed   = changed;
+	__asm__ __volatile__("" ::: "memory");
+	queue->head++;
+}
+
+
+static bool get_event(IRQqueue *queue, IRQevent *event)
+{
+	if (queue->head == queue->tail)
+		return false;
+	__asm__ __volatile__("" ::: "memory");
+	*event = queue->event[queue->tail & (EVENT_SLOTS-1)];
+	__asm__ __volatile__("" ::: "memory");
+	queue->tail++;
+	return true;
+}
+
+
 static int init_timer(void* context, alt_isr_func handler)
 {
 	puts("initialize Timer interface...");
@@ -133,11 +231,22 @@ static int init_timer(void* context, alt_isr_func handler)
 	return 0;
 }
 
-static int init_simplePIO(void)
+static int init_simplePIO(void* context, alt_isr_func handler)
 {
 	puts("initialize simplePIO interface...");
-	IOWR_8DIRECT(SIMPLEPIO_BASE, 0, 0xFF);
-	IOWR_8DIRECT(SIMPLEPIO_BASE, 2, 0x0);
+	alt_irq_context statusISR;
+
+	IOWR_8DIRECT(SIMPLEPIO_BASE, PIO_REG_DIR, PIO_OUTPUTS);
+	IOWR_8DIRECT(SIMPLEPIO_BASE, PIO_REG_PORT, 0x0);
+
+	statusISR = alt_irq_disable_all();
+
+	IOWR_8DIRECT(SIMPLEPIO_BASE, PIO_REG_EDGE, 0xFF); // clear old edges
+	alt_irq_register(SIMPLEPIO_IRQ, context, handler);
+	IOWR_8DIRECT(SIMPLEPIO_BASE, PIO_REG_IRQ_EN, PIO_INPUTS);
+
+	alt_irq_enable_all(statusISR);
+
 	return 0;
 }
 
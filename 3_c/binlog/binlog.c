@@ -0,0 +1,162 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Andreas HABEGGER                                   *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) lab3 - binary logging           *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file binlog.c
+ * @author Andreas HABEGGER
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardware System Engineering
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+
+#include "binlog.h"
+
+#ifdef BINLOG_HOST
+bool binlog_host_write(const char *line, unsigned int length);
+#else
+#ifdef ALT_STDOUT_IS_JTAG_UART
+#include "altera_avalon_jtag_uart_regs.h"
+#endif
+#ifdef PERFORMANCE_COUNTER_0_BASE
+#include "altera_avalon_performance_counter.h"
+#endif
+#endif
+
+LOGbuffer binlog_buffer;
+
+static const char hex_digit[16] = "0123456789abcdef";
+
+
+void binlog_init(void)
+{
+	binlog_buffer.head     = 0;
+	binlog_buffer.tail     = 0;
+	binlog_buffer.dropped  = 0;
+	binlog_buffer.reported = 0;
+}
+
+
+// starts the clock of BINLOG_TIMESTAMP()
+void binlog_start_clock(void)
+{
+#if defined(BINLOG_HOST)
+#elif defined(PERFORMANCE_COUNTER_0_BASE)
+	PERF_RESET(PERFORMANCE_COUNTER_0_BASE);
+	PERF_START_MEASURING(PERFORMANCE_COUNTER_0_BASE);
+#elif defined(ALT_TIMESTAMP_CLK)
+	alt_timestamp_start();
+#endif
+}
+
+
+// records that wait for the drain
+unsigned int binlog_pending(void)
+{
+	return binlog_buffer.head - binlog_buffer.tail;
+}
+
+
+static char *binlog_hex(char *line, uint32_t value, int digits)
+{
+	while (digits-- > 0)
+		*line++ = hex_digit[(value >> (4*digits)) & 0xF];
+	return line;
+}
+
+
+// "#L" timestamp id seq arg0 arg1 in hex, BINLOG_LINE characters
+void binlog_encode(const LOGrecord *record, char *line)
+{
+	*line++ = '#';
+	*line++ = 'L';
+	line = binlog_hex(line, record->timestamp, 8);
+	line = binlog_hex(line, record->id, 4);
+	line = binlog_hex(line, record->seq, 4);
+	line = binlog_hex(line, record->arg0, 8);
+	line = binlog_hex(line, record->arg1, 8);
+	*line = '\n';
+}
+
+
+// writes the whole line or nothing, returns false when it does not fit
+static bool binlog_write(const char *line, unsigned int length)
+{
+#ifdef BINLOG_HOST
+	return binlog_host_write(line, length);
+#elif defined(ALT_STDOUT_IS_JTAG_UART)
+	alt_irq_context context;
+	unsigned int space;
+	unsigned int loop;
+
+	// the HAL driver fills the FIFO from its ISR, keep it out of the line
+	context = alt_irq_disable_all();
+	space = (IORD_ALTERA_AVALON_JTAG_UART_CONTROL(ALT_STDOUT_BASE) &
+			ALTERA_AVALON_JTAG_UART_CONTROL_WSPACE_MSK) >>
+			ALTERA_AVALON_JTAG_UART_CONTROL_WSPACE_OFST;
+	if (space < length)
+	{
+		alt_irq_enable_all(context);
+		return false;
+	}
+	for (loop = 0; loop < length; loop++)
+		IOWR_ALTERA_AVALON_JTAG_UART_DATA(ALT_STDOUT_BASE, line[loop]);
+	alt_irq_enable_all(context);
+	return true;
+#else
+	return fwrite(line, 1, length, stdout) == length;
+#endif
+}
+
+
+// sends up to max records, stops when the UART has no space; returns the
+// number of records sent
+unsigned int binlog_drain(unsigned int max)
+{
+	LOGbuffer *log = &binlog_buffer;
+	LOGrecord dropped;
+	char line[BINLOG_LINE];
+	unsigned int sent = 0;
+	unsigned int count = log->dropped;
+
+	if (count != log->reported)
+	{
+		dropped.timestamp = BINLOG_TIMESTAMP();
+		dropped.id   = LOG_DROPPED;
+		dropped.seq  = (uint16_t)log->tail;
+		dropped.arg0 = count - log->reported;
+		dropped.arg1 = 0;
+		binlog_encode(&dropped, line);
+		if (!binlog_write(line, BINLOG_LINE))
+			return 0;
+		log->reported = count;
+	}
+
+	while (sent < max && log->tail != log->head)
+	{
+		binlog_encode(&log->record[log->tail & (BINLOG_SIZE-1)], line);
+		if (!binlog_write(line, BINLOG_LINE))
+			break;
+		// the slot is free for binlog() only after it was encoded
+		BINLOG_BARRIER();
+		log->tail = log->tail + 1;
+		sent++;
+	}
+	return sent;
+}
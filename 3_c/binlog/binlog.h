@@ -0,0 +1,142 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Andreas HABEGGER                                   *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) lab3 - binary logging           *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file binlog.h
+ * @author Andreas HABEGGER
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardware System Engineering
+ *
+ *  Non-blocking logging for the hot loops and the ISRs. Instead of a
+ *  printf() that waits for the JTAG UART, binlog() stores a 16 byte record
+ *  (message id, timestamp, two 32 bit arguments) in a ring buffer; the
+ *  format strings stay on the host (binlog_msg.h).
+ *
+ *  binlog_drain() is called where the CPU has nothing else to do (the idle
+ *  branch of the main loop). It sends the records as text lines
+ *  "#L<32 hex digits>" and writes to the JTAG UART FIFO only what fits, so
+ *  it never waits either. host/binlog_decode turns a capture of the
+ *  nios2-terminal back into the messages.
+ *
+ *  The main loop and the ISRs may all log: a record is claimed with the
+ *  IRQs off for a few instructions, there is no lock and no waiting. The
+ *  drain is the only reader. When the buffer is full the record is
+ *  dropped and counted; the drain reports the count as a LOG_DROPPED
+ *  record.
+ *
+ *  The timestamp is the low word of the global time of the performance
+ *  counter (CPU cycles), else the HAL timestamp timer, else 0. The clock
+ *  is started by binlog_start_clock() or by sched_start_clock().
+ *  logBench.c measures the cost of binlog() against printf().
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef BINLOG_H_
+#define BINLOG_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "system.h"
+#include "binlog_msg.h"
+
+#define BINLOG_SIZE       256      // records, a power of two
+#define BINLOG_LINE       35       // "#L" + 32 hex digits + '\n'
+#define BINLOG_DRAIN_MAX  8        // records per binlog_drain() call
+
+#ifdef BINLOG_HOST
+uint32_t binlog_host_clock(void);
+#define BINLOG_TIMESTAMP() binlog_host_clock()
+#define BINLOG_LOCK(context) ((context) = 0)
+#define BINLOG_UNLOCK(context) ((void)(context))
+#define BINLOG_BARRIER() __asm__ __volatile__ ("" ::: "memory")
+#else
+#include "io.h"
+#include "sys/alt_irq.h"
+#ifdef PERFORMANCE_COUNTER_0_BASE
+#define BINLOG_TIMESTAMP() ((uint32_t)IORD(PERFORMANCE_COUNTER_0_BASE, 0))
+#elif defined(ALT_TIMESTAMP_CLK)
+#include "sys/alt_timestamp.h"
+#define BINLOG_TIMESTAMP() ((uint32_t)alt_timestamp())
+#else
+#define BINLOG_TIMESTAMP() 0
+#endif
+#define BINLOG_LOCK(context) ((context) = alt_irq_disable_all())
+#define BINLOG_UNLOCK(context) alt_irq_enable_all(context)
+// the compiler may not move the record stores behind the head update
+#define BINLOG_BARRIER() __asm__ __volatile__ ("" ::: "memory")
+#endif
+
+// log record
+typedef struct _LOGrecord{
+	uint32_t timestamp;
+	uint16_t id;
+	uint16_t seq;               // low bits of the record number
+	uint32_t arg0;
+	uint32_t arg1;
+}LOGrecord;
+
+// ring buffer, head is written by binlog(), tail by binlog_drain() only
+typedef struct _LOGbuffer{
+	volatile unsigned int head;
+	volatile unsigned int tail;
+	volatile unsigned int dropped;
+	unsigned int reported;      // dropped count the drain has sent
+	LOGrecord record[BINLOG_SIZE];
+}LOGbuffer;
+
+extern LOGbuffer binlog_buffer;
+
+void binlog_init(void);
+
+void binlog_start_clock(void);
+
+unsigned int binlog_drain(unsigned int max);
+
+unsigned int binlog_pending(void);
+
+void binlog_encode(const LOGrecord *record, char *line);
+
+// the hot path: a few loads and stores, never waits
+static inline void binlog(uint16_t id, uint32_t arg0, uint32_t arg1)
+{
+	LOGbuffer *log = &binlog_buffer;
+	LOGrecord *record;
+	unsigned int head;
+	int context;
+
+	BINLOG_LOCK(context);
+	head = log->head;
+	if (head - log->tail >= BINLOG_SIZE)
+	{
+		log->dropped++;
+		BINLOG_UNLOCK(context);
+		return;
+	}
+	record = &log->record[head & (BINLOG_SIZE-1)];
+	record->timestamp = BINLOG_TIMESTAMP();
+	record->id   = id;
+	record->seq  = (uint16_t)head;
+	record->arg0 = arg0;
+	record->arg1 = arg1;
+	BINLOG_BARRIER();
+	log->head = head + 1;
+	BINLOG_UNLOCK(context);
+}
+
+#endif /* BINLOG_H_ */
@@ -0,0 +1,49 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Andreas HABEGGER                                   *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) lab3 - binary logging           *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file binlog_msg.h
+ * @author Andreas HABEGGER
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardware System Engineering
+ *
+ *  The messages of binlog(). The target only uses the ids, the format
+ *  strings are used by the host decoder. A format takes the two arguments
+ *  of the record as unsigned int (%u, %d, %x with flags and width), a
+ *  message may ignore them. New messages go to the end of the list, the
+ *  ids of older captures stay valid.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef BINLOG_MSG_H_
+#define BINLOG_MSG_H_
+
+#define BINLOG_MESSAGES \
+	BINLOG_MSG(LOG_DROPPED,   "%u log records dropped") \
+	BINLOG_MSG(LOG_COUNTER,   "counter value is = %u") \
+	BINLOG_MSG(LOG_PIO_EDGE,  "simplePIO inputs 0x%02x, changed 0x%02x") \
+	BINLOG_MSG(LOG_BENCH,     "benchmark record %u of %u")
+
+enum {
+#define BINLOG_MSG(id, format) id,
+	BINLOG_MESSAGES
+#undef BINLOG_MSG
+	LOG_MESSAGES
+};
+
+#endif /* BINLOG_MSG_H_ */
@@ -0,0 +1,90 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Andreas HABEGGER                                   *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) lab3 - binary logging           *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file binlog_decode.c
+ * @author Andreas HABEGGER
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardware System Engineering
+ *
+ *  Decodes a capture of the nios2-terminal (a file or stdin) to text:
+ *    binlog_decode [-f clock_hz] [capture.txt]
+ *  The clock is the one of the binlog timestamps, 50 MHz by default (the
+ *  CPU clock of the performance counter). Lines without a record are
+ *  copied as they are.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "decode.h"
+
+#define CLOCK_FREQ 50000000.0
+
+int main(int argc, char **argv)
+{
+	LOGdecoder decoder;
+	FILE *input = stdin;
+	double clock_freq = CLOCK_FREQ;
+	char line[512];
+	char out[256];
+	int arg;
+
+	for (arg = 1; arg < argc; arg++)
+	{
+		if (strcmp(argv[arg], "-f") == 0 && arg+1 < argc)
+			clock_freq = atof(argv[++arg]);
+		else if (input == stdin && argv[arg][0] != '-')
+		{
+			input = fopen(argv[arg], "r");
+			if (input == NULL)
+			{
+				perror(argv[arg]);
+				return 1;
+			}
+		}
+		else
+		{
+			fprintf(stderr, "usage: %s [-f clock_hz] [capture.txt]\n",
+					argv[0]);
+			return 1;
+		}
+	}
+	if (clock_freq <= 0)
+	{
+		fprintf(stderr, "%s: bad clock frequency\n", argv[0]);
+		return 1;
+	}
+
+	decoder_init(&decoder, clock_freq);
+	while (fgets(line, sizeof(line), input) != NULL)
+	{
+		if (decoder_line(&decoder, line, out, sizeof(out)))
+			puts(out);
+		else
+			fputs(line, stdout);
+	}
+	if (input != stdin)
+		fclose(input);
+
+	fprintf(stderr, "%u records, %u not captured\n", decoder.records,
+			decoder.lost);
+	return 0;
+}
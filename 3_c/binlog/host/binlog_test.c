@@ -0,0 +1,298 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Andreas HABEGGER                                   *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) lab3 - binary logging           *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file binlog_test.c
+ * @author Andreas HABEGGER
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardware System Engineering
+ *
+ *  Host test of binlog and the decoder. The clock of the records is set by
+ *  the test, the JTAG UART is a capture buffer with a given free space.
+ *  It checks the decoded text of drained records, a full buffer, a drain
+ *  that stops when the UART is full, the timestamp wrap, records missing in
+ *  a capture and records between printf output. At the end the host time
+ *  of binlog() and of an fprintf() are printed; the cycles on the Nios are
+ *  measured by logBench.c.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "binlog.h"
+#include "decode.h"
+
+#define CLOCK_FREQ   50000000.0
+#define CAPTURE_SIZE (4*BINLOG_SIZE*BINLOG_LINE)
+#define BENCH_CALLS  10000000
+
+static uint32_t host_time;
+static char capture[CAPTURE_SIZE+1];
+static unsigned int captured;
+static unsigned int uart_space;
+static int errors = 0;
+
+uint32_t binlog_host_clock(void)
+{
+	return host_time;
+}
+
+bool binlog_host_write(const char *line, unsigned int length)
+{
+	if (uart_space < length || captured + length > CAPTURE_SIZE)
+		return false;
+	memcpy(&capture[captured], line, length);
+	captured += length;
+	capture[captured] = '\0';
+	uart_space -= length;
+	return true;
+}
+
+static void check(int condition, const char *message, unsigned int value)
+{
+	if (!condition)
+	{
+		printf("error: %s (%u)\n", message, value);
+		errors++;
+	}
+}
+
+static void check_text(const char *text, const char *expected)
+{
+	if (strcmp(text, expected) != 0)
+	{
+		printf("error: decoded \"%s\", expected \"%s\"\n", text, expected);
+		errors++;
+	}
+}
+
+static void test_init(void)
+{
+	binlog_init();
+	host_time  = 0;
+	captured   = 0;
+	capture[0] = '\0';
+	uart_space = CAPTURE_SIZE;
+}
+
+// decodes the capture line by line, returns the number of records
+static unsigned int decode_capture(LOGdecoder *decoder, char out[][128],
+		unsigned int max)
+{
+	char *line = capture;
+	char *end;
+	unsigned int count = 0;
+
+	decoder_init(decoder, CLOCK_FREQ);
+	while (*line != '\0' && count < max)
+	{
+		end = strchr(line, '\n');
+		if (end == NULL)
+			break;
+		*end = '\0';
+		if (decoder_line(decoder, line, out[count], sizeof(out[count])))
+			count++;
+		*end = '\n';
+		line = end + 1;
+	}
+	return count;
+}
+
+static void test_messages(void)
+{
+	LOGdecoder decoder;
+	char out[4][128];
+
+	test_init();
+	host_time = 50000000;
+	binlog(LOG_COUNTER, 42, 0);
+	host_time += 25000;
+	binlog(LOG_PIO_EDGE, 0x30, 0x10);
+	host_time += 25000;
+	binlog(LOG_MESSAGES + 3, 7, 8);
+
+	check(binlog_pending() == 3, "pending", binlog_pending());
+	check(binlog_drain(BINLOG_DRAIN_MAX) == 3, "drained", 0);
+	check(binlog_pending() == 0, "pending after drain", binlog_pending());
+	check(captured == 3*BINLOG_LINE, "captured bytes", captured);
+
+	check(decode_capture(&decoder, out, 4) == 3, "decoded", decoder.records);
+	check_text(out[0], "[    1.000000] counter value is = 42");
+	check_text(out[1], "[    1.000500] simplePIO inputs 0x30, changed 0x10");
+	check_text(out[2], "[    1.001000] unknown message 7 (7, 8)");
+	check(decoder.lost == 0, "lost", decoder.lost);
+}
+
+static void test_full(void)
+{
+	LOGdecoder decoder;
+	static char out[BINLOG_SIZE+2][128];
+	unsigned int loop;
+	unsigned int count;
+
+	test_init();
+	for (loop = 0; loop < BINLOG_SIZE+10; loop++)
+	{
+		host_time += 100;
+		binlog(LOG_BENCH, loop, BINLOG_SIZE+10);
+	}
+	check(binlog_buffer.dropped == 10, "dropped", binlog_buffer.dropped);
+	check(binlog_pending() == BINLOG_SIZE, "pending", binlog_pending());
+
+	count = 0;
+	while (binlog_pending() > 0)
+		count += binlog_drain(BINLOG_DRAIN_MAX);
+	check(count == BINLOG_SIZE, "drained", count);
+
+	count = decode_capture(&decoder, out, BINLOG_SIZE+2);
+	check(count == BINLOG_SIZE+1, "decoded", count);
+	check_text(out[0] + 15, "10 log records dropped");
+	check_text(out[1] + 15, "benchmark record 0 of 266");
+	check_text(out[BINLOG_SIZE] + 15, "benchmark record 255 of 266");
+	check(decoder.lost == 0, "lost", decoder.lost);
+
+	// the next drop is reported again
+	binlog_buffer.dropped++;
+	captured = 0;
+	check(binlog_drain(BINLOG_DRAIN_MAX) == 0, "drain of an empty buffer", 0);
+	check(captured == BINLOG_LINE, "dropped record", captured);
+}
+
+// the drain writes whole lines only and goes on where it stopped
+static void test_uart_full(void)
+{
+	LOGdecoder decoder;
+	char out[8][128];
+	unsigned int loop;
+
+	test_init();
+	for (loop = 0; loop < 5; loop++)
+		binlog(LOG_COUNTER, loop, 0);
+
+	uart_space = 2*BINLOG_LINE + BINLOG_LINE/2;
+	check(binlog_drain(BINLOG_DRAIN_MAX) == 2, "drain with 2.5 lines", 0);
+	check(captured == 2*BINLOG_LINE, "partial line", captured);
+	check(binlog_pending() == 3, "pending", binlog_pending());
+
+	uart_space = 0;
+	check(binlog_drain(BINLOG_DRAIN_MAX) == 0, "drain without space", 0);
+
+	uart_space = CAPTURE_SIZE;
+	check(binlog_drain(2) == 2, "drain max", 0);
+	check(binlog_drain(BINLOG_DRAIN_MAX) == 1, "drain rest", 0);
+
+	check(decode_capture(&decoder, out, 8) == 5, "decoded", decoder.records);
+	check_text(out[4] + 15, "counter value is = 4");
+	check(decoder.lost == 0, "lost", decoder.lost);
+}
+
+static void test_decoder(void)
+{
+	LOGdecoder decoder;
+	LOGrecord record = {0, LOG_COUNTER, 0, 1, 0};
+	char line[BINLOG_LINE+1];
+	char text[128];
+	char out[128];
+
+	decoder_init(&decoder, CLOCK_FREQ);
+
+	// the timestamp wraps after 2^32 clocks (86 s at 50 MHz)
+	record.timestamp = 0xFFFFFF00;
+	binlog_encode(&record, line);
+	line[BINLOG_LINE] = '\0';
+	decoder_line(&decoder, line, out, sizeof(out));
+	record.timestamp = 0x00000100;
+	record.seq = 1;
+	binlog_encode(&record, line);
+	decoder_line(&decoder, line, out, sizeof(out));
+	check(decoder.time == 0x100000100ULL, "time after the wrap",
+			(unsigned int)(decoder.time >> 32));
+
+	// records 2 to 4 are missing
+	record.seq = 5;
+	binlog_encode(&record, line);
+	decoder_line(&decoder, line, out, sizeof(out));
+	check(decoder.lost == 3, "lost", decoder.lost);
+	check(strstr(out, "(3 records not captured)") != NULL, "gap text", 0);
+
+	// a record behind printf output, broken records
+	record.seq = 6;
+	binlog_encode(&record, line);
+	line[BINLOG_LINE-1] = '\0';
+	snprintf(text, sizeof(text), "counter val#Lxx%s", line);
+	check(decoder_line(&decoder, text, out, sizeof(out)), "record after text",
+			0);
+	check(decoder.lost == 3, "lost after text", decoder.lost);
+	check(!decoder_line(&decoder, "counter value is = 3", out, sizeof(out)),
+			"text decoded", 0);
+	line[20] = '\0';
+	check(!decoder_line(&decoder, line, out, sizeof(out)),
+			"short record decoded", 0);
+}
+
+static double bench_seconds(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec*1e-9;
+}
+
+// host time only: the Nios cycles are measured by logBench.c
+static void bench(void)
+{
+	FILE *null = fopen("/dev/null", "w");
+	double start, log_time, printf_time;
+	unsigned int loop;
+
+	if (null == NULL)
+		return;
+	test_init();
+	start = bench_seconds();
+	for (loop = 0; loop < BENCH_CALLS; loop++)
+	{
+		binlog(LOG_COUNTER, loop, 0);
+		if ((loop & (BINLOG_SIZE-1)) == BINLOG_SIZE-1)
+			binlog_buffer.tail = binlog_buffer.head;
+	}
+	log_time = bench_seconds() - start;
+
+	start = bench_seconds();
+	for (loop = 0; loop < BENCH_CALLS; loop++)
+		fprintf(null, "counter value is = %u \n", loop);
+	printf_time = bench_seconds() - start;
+	fclose(null);
+
+	check(binlog_buffer.dropped == 0, "dropped in the benchmark",
+			binlog_buffer.dropped);
+	printf("host: binlog() %.1f ns, fprintf() to /dev/null %.1f ns per call\n",
+			log_time*1e9/BENCH_CALLS, printf_time*1e9/BENCH_CALLS);
+}
+
+int main(void)
+{
+	test_messages();
+	test_full();
+	test_uart_full();
+	test_decoder();
+	bench();
+
+	printf("binlog_test: %d error(s)\n", errors);
+	return errors != 0;
+}
@@ -0,0 +1,141 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Andreas HABEGGER                                   *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) lab3 - binary logging           *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file decode.c
+ * @author Andreas HABEGGER
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardware System Engineering
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "decode.h"
+
+static const char *formats[LOG_MESSAGES] = {
+#define BINLOG_MSG(id, format) format,
+	BINLOG_MESSAGES
+#undef BINLOG_MSG
+};
+
+
+void decoder_init(LOGdecoder *decoder, double clock_freq)
+{
+	decoder->clock_freq = clock_freq;
+	decoder->time     = 0;
+	decoder->next_seq = 0;
+	decoder->started  = false;
+	decoder->records  = 0;
+	decoder->lost     = 0;
+}
+
+
+static bool decoder_hex(const char **text, int digits, uint32_t *value)
+{
+	char digit;
+
+	*value = 0;
+	while (digits-- > 0)
+	{
+		digit = *(*text)++;
+		if (digit >= '0' && digit <= '9')
+			*value = (*value << 4) | (digit - '0');
+		else if (digit >= 'a' && digit <= 'f')
+			*value = (*value << 4) | (digit - 'a' + 10);
+		else if (digit >= 'A' && digit <= 'F')
+			*value = (*value << 4) | (digit - 'A' + 10);
+		else
+			return false;
+	}
+	return true;
+}
+
+
+// finds a record in the text, printf output around it is ignored
+bool decoder_parse(const char *text, LOGrecord *record)
+{
+	const char *start = text;
+	uint32_t id, seq;
+
+	while ((start = strstr(start, "#L")) != NULL)
+	{
+		text = start + 2;
+		start++;
+		if (!decoder_hex(&text, 8, &record->timestamp) ||
+				!decoder_hex(&text, 4, &id) ||
+				!decoder_hex(&text, 4, &seq) ||
+				!decoder_hex(&text, 8, &record->arg0) ||
+				!decoder_hex(&text, 8, &record->arg1))
+			continue;
+		record->id  = (uint16_t)id;
+		record->seq = (uint16_t)seq;
+		return true;
+	}
+	return false;
+}
+
+
+// decodes a line to out; false when the line has no record
+bool decoder_line(LOGdecoder *decoder, const char *text, char *out,
+		size_t size)
+{
+	LOGrecord record;
+	char message[128];
+	char gap[48] = "";
+	uint32_t last;
+	uint16_t missing;
+
+	if (!decoder_parse(text, &record))
+		return false;
+
+	// the 32 bit timestamp wraps after 2^32 clocks
+	if (!decoder->started)
+		decoder->time = record.timestamp;
+	else
+	{
+		last = (uint32_t)decoder->time;
+		decoder->time += (uint32_t)(record.timestamp - last);
+	}
+
+	// the dropped count has the number of the next record
+	if (decoder->started && record.seq != decoder->next_seq)
+	{
+		missing = (uint16_t)(record.seq - decoder->next_seq);
+		decoder->lost += missing;
+		snprintf(gap, sizeof(gap), " (%u records not captured)",
+				(unsigned int)missing);
+	}
+	decoder->next_seq = (record.id == LOG_DROPPED) ? record.seq :
+			(uint16_t)(record.seq + 1);
+	decoder->started = true;
+	decoder->records++;
+
+	if (record.id < LOG_MESSAGES)
+		snprintf(message, sizeof(message), formats[record.id],
+				(unsigned int)record.arg0, (unsigned int)record.arg1);
+	else
+		snprintf(message, sizeof(message), "unknown message %u (%u, %u)",
+				(unsigned int)record.id, (unsigned int)record.arg0,
+				(unsigned int)record.arg1);
+
+	snprintf(out, size, "[%12.6f] %s%s", decoder->time/decoder->clock_freq,
+			message, gap);
+	return true;
+}
@@ -0,0 +1,59 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Andreas HABEGGER                                   *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) lab3 - binary logging           *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file decode.h
+ * @author Andreas HABEGGER
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardware System Engineering
+ *
+ *  Host decoder of the binlog lines. A line with "#L" and 32 hex digits
+ *  is a record: the 32 bit timestamp is extended over its wrap around and
+ *  shown in seconds, the message is printed with the format of
+ *  binlog_msg.h. A gap in the record numbers shows records that were not
+ *  captured. Other lines are not records (printf output).
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef DECODE_H_
+#define DECODE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "binlog.h"
+
+// decoder state
+typedef struct _LOGdecoder{
+	double clock_freq;
+	unsigned long long time;    // extended timestamp of the last record
+	uint16_t next_seq;
+	bool started;
+	unsigned int records;
+	unsigned int lost;          // records missing in the capture
+}LOGdecoder;
+
+void decoder_init(LOGdecoder *decoder, double clock_freq);
+
+bool decoder_parse(const char *text, LOGrecord *record);
+
+bool decoder_line(LOGdecoder *decoder, const char *text, char *out,
+		size_t size);
+
+#endif /* DECODE_H_ */
@@ -0,0 +1,8 @@
+/*
+ * Host stand-in for the system.h of the BSP: binlog is built with
+ * BINLOG_HOST, the host test gives it its own clock and output.
+ */
+#ifndef SYSTEM_H_
+#define SYSTEM_H_
+
+#endif /* SYSTEM_H_ */
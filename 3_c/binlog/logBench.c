@@ -0,0 +1,174 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Andreas HABEGGER                                   *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) lab3 - binary logging           *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file logBench.c
+ * @author Andreas HABEGGER
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardware System Engineering
+ *
+ *  Measures the cost of one log call on the Nios: binlog() against the
+ *  printf() and puts() of the same message, and the drain of one record
+ *  in the idle loop. Each call is measured alone with the binlog
+ *  timestamp (CPU cycles of the performance counter, else timestamp timer
+ *  ticks); the cost of the measurement itself is subtracted. The results
+ *  are printed at the end, with the nios2-terminal connected (printf
+ *  waits for the JTAG UART when its FIFO is full).
+ *
+ *  Add binlog.c to the application.
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "system.h"
+#include "binlog.h"
+
+#define BENCH_RUNS      200      // fits into the log buffer
+#define PRINTF_RUNS     50
+#define DRAIN_TRIES     1000000  // no terminal: the FIFO stays full
+
+// result structure
+typedef struct _BENCHresult{
+	const char *name;
+	unsigned int runs;
+	uint32_t min;
+	uint32_t max;
+	uint64_t total;
+}BENCHresult;
+
+static void bench_init(BENCHresult *result, const char *name);
+
+static void bench_add(BENCHresult *result, uint32_t start, uint32_t end,
+		uint32_t overhead);
+
+static void bench_print(const BENCHresult *result);
+
+
+int main(void)
+{
+	BENCHresult overhead, logged, drain, print, put;
+	uint32_t start, end;
+	unsigned int loop;
+	unsigned int tries;
+
+#if !defined(PERFORMANCE_COUNTER_0_BASE) && !defined(ALT_TIMESTAMP_CLK)
+	puts("no performance counter and no timestamp timer, no results");
+#endif
+	binlog_start_clock();
+	binlog_init();
+	puts("binlog benchmark ...");
+
+	// cost of two timestamps
+	bench_init(&overhead, "timestamp");
+	for (loop = 0; loop < BENCH_RUNS; loop++)
+	{
+		start = BINLOG_TIMESTAMP();
+		end   = BINLOG_TIMESTAMP();
+		bench_add(&overhead, start, end, 0);
+	}
+
+	// the hot path
+	bench_init(&logged, "binlog()");
+	for (loop = 0; loop < BENCH_RUNS; loop++)
+	{
+		start = BINLOG_TIMESTAMP();
+		binlog(LOG_BENCH, loop, BENCH_RUNS);
+		end   = BINLOG_TIMESTAMP();
+		bench_add(&logged, start, end, overhead.min);
+	}
+
+	// the idle work, a drain that finds the FIFO full is not counted
+	bench_init(&drain, "binlog_drain(1)");
+	for (tries = 0; tries < DRAIN_TRIES && binlog_pending() > 0; tries++)
+	{
+		start = BINLOG_TIMESTAMP();
+		if (binlog_drain(1) == 1)
+		{
+			end = BINLOG_TIMESTAMP();
+			bench_add(&drain, start, end, overhead.min);
+		}
+	}
+
+	// the same message as text
+	bench_init(&print, "printf()");
+	for (loop = 0; loop < PRINTF_RUNS; loop++)
+	{
+		start = BINLOG_TIMESTAMP();
+		printf("benchmark record %u of %u\n", loop, PRINTF_RUNS);
+		end   = BINLOG_TIMESTAMP();
+		bench_add(&print, start, end, overhead.min);
+	}
+
+	bench_init(&put, "puts()");
+	for (loop = 0; loop < PRINTF_RUNS; loop++)
+	{
+		start = BINLOG_TIMESTAMP();
+		puts("benchmark record");
+		end   = BINLOG_TIMESTAMP();
+		bench_add(&put, start, end, overhead.min);
+	}
+
+	printf("\ncall             runs       min       avg       max\n");
+	bench_print(&overhead);
+	bench_print(&logged);
+	bench_print(&drain);
+	bench_print(&print);
+	bench_print(&put);
+	printf("%u records not drained, %u dropped\n", binlog_pending(),
+			binlog_buffer.dropped);
+
+	while(1);
+	return 0;
+}
+
+static void bench_init(BENCHresult *result, const char *name)
+{
+	result->name  = name;
+	result->runs  = 0;
+	result->min   = UINT32_MAX;
+	result->max   = 0;
+	result->total = 0;
+}
+
+static void bench_add(BENCHresult *result, uint32_t start, uint32_t end,
+		uint32_t overhead)
+{
+	uint32_t cycles = end - start;
+
+	cycles = (cycles > overhead) ? cycles - overhead : 0;
+	result->runs++;
+	result->total += cycles;
+	if (cycles < result->min)
+		result->min = cycles;
+	if (cycles > result->max)
+		result->max = cycles;
+}
+
+static void bench_print(const BENCHresult *result)
+{
+	if (result->runs == 0)
+	{
+		printf("%-15s %6u         -         -         -\n", result->name, 0);
+		return;
+	}
+	printf("%-15s %6u %9u %9u %9u\n", result->name, result->runs,
+			(unsigned int)result->min,
+			(unsigned int)(result->total/result->runs),
+			(unsigned int)result->max);
+}
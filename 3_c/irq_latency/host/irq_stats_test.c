@@ -0,0 +1,126 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Andreas HABEGGER                                   *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) lab3 - interrupt latency        *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file irq_stats_test.c
+ * @author Andreas HABEGGER
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardware System Engineering
+ *
+ *  Host test of irq_stats.c: min, avg and max, the bins of the histogram
+ *  with the samples above the last one, an empty series and a bin width
+ *  of 0. The histogram of a latency like series is printed at the end.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+
+#include "irq_stats.h"
+
+#define CLOCK_FREQ  50000000
+
+static int errors = 0;
+
+static void check(int condition, const char *message, unsigned int value)
+{
+	if (!condition)
+	{
+		printf("error: %s (%u)\n", message, value);
+		errors++;
+	}
+}
+
+static void test_summary(void)
+{
+	IRQstats stats;
+	uint32_t sample[5] = {120, 100, 103, 140, 100};
+
+	irq_stats_compute(&stats, "summary", sample, 5, 4);
+	check(stats.count == 5, "count", stats.count);
+	check(stats.min == 100, "min", stats.min);
+	check(stats.max == 140, "max", stats.max);
+	check(irq_stats_avg(&stats) == 113, "avg", irq_stats_avg(&stats));
+
+	// the bins start at the min
+	check(stats.histogram[0] == 3, "bin 100..103", stats.histogram[0]);
+	check(stats.histogram[5] == 1, "bin 120..123", stats.histogram[5]);
+	check(stats.histogram[10] == 1, "bin 140..143", stats.histogram[10]);
+	check(stats.histogram[1] == 0, "bin 104..107", stats.histogram[1]);
+}
+
+static void test_overflow(void)
+{
+	IRQstats stats;
+	uint32_t sample[4] = {10, 10 + IRQSTAT_BINS - 2, 10 + IRQSTAT_BINS - 1,
+			100000};
+	unsigned int loop;
+	unsigned int total = 0;
+
+	irq_stats_compute(&stats, "overflow", sample, 4, 1);
+	check(stats.histogram[IRQSTAT_BINS-2] == 1, "last bin",
+			stats.histogram[IRQSTAT_BINS-2]);
+	check(stats.histogram[IRQSTAT_BINS-1] == 2, "samples above",
+			stats.histogram[IRQSTAT_BINS-1]);
+	for (loop = 0; loop < IRQSTAT_BINS; loop++)
+		total += stats.histogram[loop];
+	check(total == 4, "samples in the histogram", total);
+	check(irq_stats_avg(&stats) == 25019, "avg", irq_stats_avg(&stats));
+}
+
+static void test_corner(void)
+{
+	IRQstats stats;
+	uint32_t sample[2] = {7, 8};
+
+	irq_stats_compute(&stats, "empty", sample, 0, 4);
+	check(stats.count == 0, "empty count", stats.count);
+	check(irq_stats_avg(&stats) == 0, "empty avg", irq_stats_avg(&stats));
+	irq_stats_print(&stats, CLOCK_FREQ);
+
+	irq_stats_compute(&stats, "width 0", sample, 2, 0);
+	check(stats.bin_width == 1, "bin width", stats.bin_width);
+	check(stats.histogram[1] == 1, "bin 8", stats.histogram[1]);
+	check(irq_stats_avg(&stats) == 8, "avg rounded", irq_stats_avg(&stats));
+}
+
+// a series as irqLatency.c measures it: a peak and some late samples
+static void show(void)
+{
+	static uint32_t sample[1000];
+	IRQstats stats;
+	unsigned int loop;
+
+	for (loop = 0; loop < 1000; loop++)
+		sample[loop] = 118 + (loop*7 % 13) + ((loop % 97 == 0) ? 60 : 0) +
+				((loop == 500) ? 900 : 0);
+	irq_stats_compute(&stats, "irq entry", sample, 1000, 4);
+	irq_stats_print(&stats, CLOCK_FREQ);
+	irq_stats_histogram(&stats);
+	check(stats.max == 118 + (500*7 % 13) + 900, "max", stats.max);
+}
+
+int main(void)
+{
+	test_summary();
+	test_overflow();
+	test_corner();
+	show();
+
+	printf("irq_stats_test: %d error(s)\n", errors);
+	return errors != 0;
+}
@@ -0,0 +1,311 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Andreas HABEGGER                                   *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) lab3 - interrupt latency        *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file irqLatency.c
+ * @author Andreas HABEGGER
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardware System Engineering
+ *
+ *  Measures the HAL interrupt path with the timer IRQ of 021_pio_ISR_Timer.c.
+ *  The timer runs in continuous mode, each timeout raises the IRQ. Three
+ *  times are taken for LAT_SAMPLES interrupts:
+ *    entry   from the timeout to the first line of the handler: the HAL
+ *            exception entry (alt_irq_entry.S, alt_exception_entry.S) and
+ *            the dispatch of alt_irq_handler.c. The snapshot register of the
+ *            timer gives the clocks since the counter was reloaded.
+ *    handler the handler itself (clear the timeout, count), as in 021.
+ *    return  from the last line of the handler back to the interrupted
+ *            loop: the rest of alt_irq_handler.c, the register restore and
+ *            eret. The loop spins on the count, one turn is included.
+ *  The handler and return times are taken with the global counter of the
+ *  performance counter (CPU cycles); without one with the timer snapshot
+ *  too. The cost of reading the clock is subtracted. A polled run (the
+ *  timeout bit read in a loop, no IRQ) is the floor of the entry latency.
+ *
+ *  A build measures the configuration of its BSP, the first line of the
+ *  output names it. The BSP takes the enhanced alt_ic_isr_register() when
+ *  all its drivers support it, else the legacy alt_irq_register(); the
+ *  code has paths for both and for an external interrupt controller (VIC),
+ *  but the systems of this repository only have the internal interrupt
+ *  controller without shadow register sets. A comparison with the legacy
+ *  API or with a VIC and shadow register sets needs such a system and its
+ *  BSP, each run gives one row of the comparison.
+ *
+ *  The timer must not be the sys_clk_timer or the timestamp timer of the
+ *  BSP. The other IRQs of the internal interrupt controller are disabled
+ *  during the runs, the results are printed at the end.
+ *  Add irq_stats.c to the application.
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "io.h"
+#include "system.h"
+#include "nios2.h"
+#include "sys/alt_irq.h"
+#ifndef ALT_ENHANCED_INTERRUPT_API_PRESENT
+#include "priv/alt_legacy_irq.h"
+#endif
+#include "altera_avalon_timer_regs.h"
+#ifdef PERFORMANCE_COUNTER_0_BASE
+#include "altera_avalon_performance_counter.h"
+#endif
+
+#include "irq_stats.h"
+
+#define LAT_SAMPLES     1000
+#define LAT_BIN         4        // cycles of a histogram bin
+#define LAT_PERIOD      49999    // 1 ms at 50 MHz, if the period is not fixed
+#define LAT_CALIBRATE   100
+
+#if !SYS_TIMER_SNAPSHOT
+#error "irqLatency needs the snapshot register of the sys_timer"
+#endif
+
+#if SYS_TIMER_FIXED_PERIOD
+#define LAT_LOAD        SYS_TIMER_LOAD_VALUE
+#else
+#define LAT_LOAD        LAT_PERIOD
+#endif
+
+#ifdef PERFORMANCE_COUNTER_0_BASE
+#define LAT_CLOCK()      ((uint32_t)IORD(PERFORMANCE_COUNTER_0_BASE, 0))
+#define LAT_CLOCK_NAME   "performance counter"
+#else
+#define LAT_CLOCK()      lat_since_timeout()
+#define LAT_CLOCK_NAME   "timer snapshot"
+#endif
+
+#ifdef ALT_ENHANCED_INTERRUPT_API_PRESENT
+#define LAT_API_NAME     "alt_ic_isr_register"
+#else
+#define LAT_API_NAME     "alt_irq_register (legacy)"
+#endif
+
+#ifdef NIOS2_EIC_PRESENT
+#define LAT_IC_NAME      "external"
+#else
+#define LAT_IC_NAME      "internal"
+#endif
+
+// filled in by the ISR
+typedef struct _LATisr{
+	volatile unsigned int count;
+	uint32_t entry;             // timer clocks from the timeout
+	uint32_t enter;             // LAT_CLOCK() at the first line
+	uint32_t leave;             // LAT_CLOCK() at the last line
+}LATisr;
+
+static LATisr isr;
+
+// samples of the runs
+static uint32_t polled[LAT_SAMPLES];
+static uint32_t entry[LAT_SAMPLES];
+static uint32_t handler[LAT_SAMPLES];
+static uint32_t back[LAT_SAMPLES];
+
+static void timer_start(int irq);
+
+static void timer_stop(void);
+
+static uint32_t clock_cost(void);
+
+static void measure_polled(void);
+
+static void measure_irq(uint32_t cost);
+
+
+// timer clocks since the counter was reloaded at the last timeout
+static inline uint32_t lat_since_timeout(void)
+{
+	uint32_t snap;
+
+	IOWR_ALTERA_AVALON_TIMER_SNAPL(SYS_TIMER_BASE, 0);
+	snap = IORD_ALTERA_AVALON_TIMER_SNAPL(SYS_TIMER_BASE) & 0xFFFF;
+	snap |= (IORD_ALTERA_AVALON_TIMER_SNAPH(SYS_TIMER_BASE) & 0xFFFF) << 16;
+	return LAT_LOAD - snap;
+}
+
+
+#ifdef ALT_ENHANCED_INTERRUPT_API_PRESENT
+static void latency_isr(void *context)
+#else
+static void latency_isr(void *context, alt_u32 id)
+#endif
+{
+	LATisr *data = (LATisr*) context;
+
+	data->entry = lat_since_timeout();
+	data->enter = LAT_CLOCK();
+	IOWR_ALTERA_AVALON_TIMER_STATUS(SYS_TIMER_BASE, 0);
+	data->count++;
+	data->leave = LAT_CLOCK();
+}
+
+
+int main(void)
+{
+	IRQstats stats;
+	uint32_t cost;
+	uint32_t polled_min;
+	alt_irq_context context;
+#ifndef NIOS2_EIC_PRESENT
+	alt_u32 ienable;
+#endif
+
+	printf("irq latency: %s, %s interrupt controller, %d shadow register "
+			"sets, clock %s\n", LAT_API_NAME, LAT_IC_NAME,
+			NIOS2_NUM_OF_SHADOW_REG_SETS, LAT_CLOCK_NAME);
+
+#ifdef PERFORMANCE_COUNTER_0_BASE
+	PERF_RESET(PERFORMANCE_COUNTER_0_BASE);
+	PERF_START_MEASURING(PERFORMANCE_COUNTER_0_BASE);
+#endif
+
+	context = alt_irq_disable_all();
+	timer_stop();
+	isr.count = 0;
+#ifdef ALT_ENHANCED_INTERRUPT_API_PRESENT
+	alt_ic_isr_register(SYS_TIMER_IRQ_INTERRUPT_CONTROLLER_ID, SYS_TIMER_IRQ,
+			latency_isr, &isr, NULL);
+#else
+	alt_irq_register(SYS_TIMER_IRQ, &isr, latency_isr);
+#endif
+#ifndef NIOS2_EIC_PRESENT
+	// only the timer may interrupt the runs (the JTAG UART still sends)
+	NIOS2_READ_IENABLE(ienable);
+	NIOS2_WRITE_IENABLE(1 << SYS_TIMER_IRQ);
+#endif
+	alt_irq_enable_all(context);
+
+	cost = clock_cost();
+	measure_polled();
+	measure_irq(cost);
+
+	context = alt_irq_disable_all();
+	timer_stop();
+#ifndef NIOS2_EIC_PRESENT
+	NIOS2_WRITE_IENABLE(ienable);
+#endif
+	alt_irq_enable_all(context);
+
+	printf("%u samples, clock read %u cycles (subtracted)\n", LAT_SAMPLES,
+			(unsigned int)cost);
+	printf("\nseries                   runs       min       avg       max"
+			"       avg\n");
+	irq_stats_compute(&stats, "polled timeout", polled, LAT_SAMPLES, LAT_BIN);
+	irq_stats_print(&stats, ALT_CPU_FREQ);
+	polled_min = stats.min;
+	irq_stats_compute(&stats, "irq entry", entry, LAT_SAMPLES, LAT_BIN);
+	irq_stats_print(&stats, ALT_CPU_FREQ);
+	printf("%-22s %6s %9u\n", "  entry - polled", "",
+			(unsigned int)(stats.min - polled_min));
+	irq_stats_compute(&stats, "handler", handler, LAT_SAMPLES, LAT_BIN);
+	irq_stats_print(&stats, ALT_CPU_FREQ);
+	irq_stats_compute(&stats, "handler to return", back, LAT_SAMPLES, LAT_BIN);
+	irq_stats_print(&stats, ALT_CPU_FREQ);
+
+	putchar('\n');
+	irq_stats_compute(&stats, "irq entry", entry, LAT_SAMPLES, LAT_BIN);
+	irq_stats_histogram(&stats);
+	irq_stats_compute(&stats, "handler to return", back, LAT_SAMPLES, LAT_BIN);
+	irq_stats_histogram(&stats);
+
+	while(1);
+	return 0;
+}
+
+
+// continuous mode, the counter restarts from LAT_LOAD
+static void timer_start(int irq)
+{
+	IOWR_ALTERA_AVALON_TIMER_CONTROL(SYS_TIMER_BASE,
+			ALTERA_AVALON_TIMER_CONTROL_STOP_MSK);
+#if !SYS_TIMER_FIXED_PERIOD
+	IOWR_ALTERA_AVALON_TIMER_PERIODL(SYS_TIMER_BASE, LAT_LOAD & 0xFFFF);
+	IOWR_ALTERA_AVALON_TIMER_PERIODH(SYS_TIMER_BASE, LAT_LOAD >> 16);
+#endif
+	IOWR_ALTERA_AVALON_TIMER_STATUS(SYS_TIMER_BASE, 0);
+	IOWR_ALTERA_AVALON_TIMER_CONTROL(SYS_TIMER_BASE,
+			ALTERA_AVALON_TIMER_CONTROL_CONT_MSK |
+			ALTERA_AVALON_TIMER_CONTROL_START_MSK |
+			(irq ? ALTERA_AVALON_TIMER_CONTROL_ITO_MSK : 0));
+}
+
+static void timer_stop(void)
+{
+	IOWR_ALTERA_AVALON_TIMER_CONTROL(SYS_TIMER_BASE,
+			ALTERA_AVALON_TIMER_CONTROL_STOP_MSK);
+	IOWR_ALTERA_AVALON_TIMER_STATUS(SYS_TIMER_BASE, 0);
+}
+
+// the min of two clock reads, with the timer running for the snapshot
+static uint32_t clock_cost(void)
+{
+	uint32_t start, end;
+	uint32_t min = UINT32_MAX;
+	int loop;
+
+	timer_start(0);
+	for (loop = 0; loop < LAT_CALIBRATE; loop++)
+	{
+		start = LAT_CLOCK();
+		end   = LAT_CLOCK();
+		if (end - start < min)
+			min = end - start;
+	}
+	timer_stop();
+	return min;
+}
+
+// no IRQ: the loop sees the timeout bit, the floor of the entry latency
+static void measure_polled(void)
+{
+	int loop;
+
+	timer_start(0);
+	for (loop = 0; loop < LAT_SAMPLES; loop++)
+	{
+		while ((IORD_ALTERA_AVALON_TIMER_STATUS(SYS_TIMER_BASE) &
+				ALTERA_AVALON_TIMER_STATUS_TO_MSK) == 0);
+		polled[loop] = lat_since_timeout();
+		IOWR_ALTERA_AVALON_TIMER_STATUS(SYS_TIMER_BASE, 0);
+	}
+	timer_stop();
+}
+
+static void measure_irq(uint32_t cost)
+{
+	unsigned int seen = isr.count;
+	uint32_t now;
+	int loop;
+
+	timer_start(1);
+	for (loop = 0; loop < LAT_SAMPLES; loop++)
+	{
+		while (isr.count == seen);
+		now = LAT_CLOCK();
+		seen = isr.count;
+		entry[loop]   = isr.entry;
+		handler[loop] = isr.leave - isr.enter - cost;
+		back[loop]    = now - isr.leave - cost;
+	}
+	timer_stop();
+}
@@ -0,0 +1,125 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Andreas HABEGGER                                   *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) lab3 - interrupt latency        *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file irq_stats.c
+ * @author Andreas HABEGGER
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardware System Engineering
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+
+#include "irq_stats.h"
+
+
+void irq_stats_compute(IRQstats *stats, const char *name,
+		const uint32_t *sample, unsigned int count, uint32_t bin_width)
+{
+	unsigned int loop;
+	uint32_t bin;
+
+	stats->name      = name;
+	stats->count     = count;
+	stats->min       = UINT32_MAX;
+	stats->max       = 0;
+	stats->total     = 0;
+	stats->bin_width = (bin_width == 0) ? 1 : bin_width;
+	for (loop = 0; loop < IRQSTAT_BINS; loop++)
+		stats->histogram[loop] = 0;
+
+	for (loop = 0; loop < count; loop++)
+	{
+		stats->total += sample[loop];
+		if (sample[loop] < stats->min)
+			stats->min = sample[loop];
+		if (sample[loop] > stats->max)
+			stats->max = sample[loop];
+	}
+
+	// the min is known now, the bins start there
+	for (loop = 0; loop < count; loop++)
+	{
+		bin = (sample[loop] - stats->min) / stats->bin_width;
+		if (bin >= IRQSTAT_BINS)
+			bin = IRQSTAT_BINS-1;
+		stats->histogram[bin]++;
+	}
+}
+
+
+uint32_t irq_stats_avg(const IRQstats *stats)
+{
+	if (stats->count == 0)
+		return 0;
+	return (uint32_t)((stats->total + stats->count/2) / stats->count);
+}
+
+
+// one line: runs, min avg max in cycles, and the avg in ns
+void irq_stats_print(const IRQstats *stats, uint32_t clock_freq)
+{
+	if (stats->count == 0)
+	{
+		printf("%-22s %6u         -         -         -\n", stats->name, 0);
+		return;
+	}
+	printf("%-22s %6u %9u %9u %9u %9u ns\n", stats->name, stats->count,
+			(unsigned int)stats->min, (unsigned int)irq_stats_avg(stats),
+			(unsigned int)stats->max,
+			(unsigned int)((uint64_t)irq_stats_avg(stats)*1000000000ULL/
+					clock_freq));
+}
+
+
+// the bins up to the last one used, scaled to the largest
+void irq_stats_histogram(const IRQstats *stats)
+{
+	unsigned int largest = 0;
+	unsigned int last = 0;
+	unsigned int loop;
+	unsigned int bar;
+	uint32_t from;
+
+	for (loop = 0; loop < IRQSTAT_BINS; loop++)
+	{
+		if (stats->histogram[loop] > largest)
+			largest = stats->histogram[loop];
+		if (stats->histogram[loop] != 0)
+			last = loop;
+	}
+	printf("%s, cycles:\n", stats->name);
+	if (largest == 0)
+		return;
+	for (loop = 0; loop <= last; loop++)
+	{
+		from = stats->min + loop*stats->bin_width;
+		if (loop == IRQSTAT_BINS-1)
+			printf("  >=%-12u %6u ", (unsigned int)from,
+					stats->histogram[loop]);
+		else
+			printf("  %6u..%-6u %6u ", (unsigned int)from,
+					(unsigned int)(from + stats->bin_width - 1),
+					stats->histogram[loop]);
+		bar = (stats->histogram[loop]*IRQSTAT_BAR + largest - 1) / largest;
+		while (bar-- > 0)
+			putchar('#');
+		putchar('\n');
+	}
+}
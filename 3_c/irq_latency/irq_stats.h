@@ -0,0 +1,60 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Andreas HABEGGER                                   *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) lab3 - interrupt latency        *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file irq_stats.h
+ * @author Andreas HABEGGER
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardware System Engineering
+ *
+ *  Statistics of the samples of irqLatency.c: min, avg and max and a
+ *  histogram. The histogram starts at the min, each bin is bin_width
+ *  cycles wide, the last bin takes all the samples above. There is no HAL
+ *  in here, the host test builds it as it is.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef IRQ_STATS_H_
+#define IRQ_STATS_H_
+
+#include <stdint.h>
+
+#define IRQSTAT_BINS    24       // the last one counts the samples above
+#define IRQSTAT_BAR     48       // characters of the largest bin
+
+// statistics of one series
+typedef struct _IRQstats{
+	const char *name;
+	unsigned int count;
+	uint32_t min;
+	uint32_t max;
+	uint64_t total;
+	uint32_t bin_width;
+	unsigned int histogram[IRQSTAT_BINS];
+}IRQstats;
+
+void irq_stats_compute(IRQstats *stats, const char *name,
+		const uint32_t *sample, unsigned int count, uint32_t bin_width);
+
+uint32_t irq_stats_avg(const IRQstats *stats);
+
+void irq_stats_print(const IRQstats *stats, uint32_t clock_freq);
+
+void irq_stats_histogram(const IRQstats *stats);
+
+#endif /* IRQ_STATS_H_ */
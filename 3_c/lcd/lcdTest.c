@@ -21,6 +21,15 @@
  *
  *  The example shows how to use ISR and Timer. The timer is used with
  *  fixed period.
+ *  The tasks run on the cooperative scheduler of ../scheduler (add
+ *  scheduler.c and scheduler.h to the application): the timer ISR only
+ *  ticks it, the counter task has the shortest period and therefore the
+ *  highest priority, so it waits for at most one LCD transfer instead of
+ *  a whole round. The report task prints the deadline misses and the
+ *  execution times every REPORT_PERIOD ticks.
+ *  The counter task logs with binlog() of ../binlog (add binlog.c), the
+ *  records are sent when no task is ready; decode the terminal output with
+ *  binlog/host/binlog_decode.
  *  Caution, there is no read back of ctrl Reg before writing new values.
  *  This can result in wrong behavior.
  * @copyright GNU Lesser General Public License
@@ -37,7 +46,9 @@
 #include "sys/alt_irq.h"
 #include "priv/alt_legacy_irq.h"
 
+#include "binlog.h"
 #include "lcd_simple.h"
+#include "scheduler.h"
 #include "tuxAnimation_1.h"
 #include "tuxAnimation_2.h"
 #include "tuxAnimation_3.h"
@@ -54,12 +65,18 @@
 #define TIMER_REG_PERIOD_LOW   2
 #define TIMER_REG_PERIOD_HIGH  3
 
+// task periods in SYS_TIMER ticks (10 ms)
+#define COUNTER_PERIOD  10
+#define LCD_PERIOD      30
+#define REPORT_PERIOD   1000
+
 // counter structure
 typedef struct _IRQcounter{
 	int count;
-	bool irq;
 }IRQcounter;
 
+static SCHEDscheduler sched;
+
 // function prototypes
 
 static int TIMER_init(void* context, alt_isr_func handler);
@@ -70,13 +87,15 @@ static int PIO_init(void);
 
 static int LED_init(void);
 
-static void task1(IRQcounter *counter);
+static void task1(void *context);
 
-static void task2(void);
+static void task2(void *context);
 
-static void task3(void);
+static void task3(void *context);
 
-static void task4(void);
+static void task4(void *context);
+
+static void task_report(void *context);
 
 
 int main(void)
@@ -84,7 +103,21 @@ int main(void)
 	// counter
 	IRQcounter counter;
 	counter.count = 0;
-	counter.irq   = false;
+
+	// initialize the scheduler, the rate monotonic order puts task1 first
+	sched_init(&sched, SCHED_DEFAULT_CLOCK);
+	sched_start_clock();
+	binlog_init();
+	sched_add(&sched, "task1", task1, &counter, COUNTER_PERIOD, 0,
+			SCHED_RATE_MONOTONIC);
+	sched_add(&sched, "task2", task2, NULL, LCD_PERIOD, 1,
+			SCHED_RATE_MONOTONIC);
+	sched_add(&sched, "task3", task3, NULL, LCD_PERIOD, 1+LCD_PERIOD/3,
+			SCHED_RATE_MONOTONIC);
+	sched_add(&sched, "task4", task4, NULL, LCD_PERIOD, 1+2*LCD_PERIOD/3,
+			SCHED_RATE_MONOTONIC);
+	sched_add(&sched, "report", task_report, NULL, REPORT_PERIOD,
+			REPORT_PERIOD, SCHED_RATE_MONOTONIC);
 
 	// initialize the timer
 	TIMER_init(&counter, (alt_isr_func)timer_interrupt_handler);
@@ -107,57 +140,46 @@ int main(void)
 
 	while(1)
 	{
-
-		task1(&counter);
-
-		task2();
-
-		task3();
-
-		task4();
+		if (!sched_run(&sched))
+			binlog_drain(BINLOG_DRAIN_MAX); // idle: send the log
 	}
 }
 
-static void task1(IRQcounter *counter)
+static void task1(void *context)
 {
-	puts("Enter Task 1");
-	if(counter->irq)
-	{
-		printf("counter value is = %d \n",counter->count);
-		// led IF count (lab1)
-		IOWR_16DIRECT(LEDS_BASE,0, counter->count);
-
-		counter->irq = false;
-	}
+	IRQcounter *counter = (IRQcounter*) context;
+	binlog(LOG_COUNTER, counter->count, 0);
+	// led IF count (lab1)
+	IOWR_16DIRECT(LEDS_BASE,0, counter->count);
 }
 
-static void task2(void)
+static void task2(void *context)
 {
-	puts("Enter Task 2");
 	LCD_transfer(&picture_array_tuxAnimation_1, picture_height_tuxAnimation_1, picture_width_tuxAnimation_1);
-	puts("Img Tux 1 transfered");
 }
 
 
-static void task3(void)
+static void task3(void *context)
 {
-	puts("Enter Task 3");
 	LCD_transfer(&picture_array_tuxAnimation_2, picture_height_tuxAnimation_2, picture_width_tuxAnimation_2);
-	puts("Img Tux 2 transfered");
 }
 
-static void task4(void)
+static void task4(void *context)
 {
-	puts("Enter Task 4");
 	LCD_transfer(&picture_array_tuxAnimation_3, picture_height_tuxAnimation_3, picture_width_tuxAnimation_3);
-	puts("Img Tux 3 transfered");
+}
+
+static void task_report(void *context)
+{
+	sched_report(&sched);
+	sched_reset_stats(&sched);
 }
 
 static void timer_interrupt_handler(void *context, alt_u32 id)
 {
 	IRQcounter *ctr_ptr = (IRQcounter*) context;
 	ctr_ptr->count++; // increase the counter;
-	ctr_ptr->irq = true;
+	sched_tick(&sched);
 
 	// simplePIO IF count (lab2)
 	IOWR_8DIRECT(SIMPLEPIO_BASE,2, ctr_ptr->count);
@@ -0,0 +1,243 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Andreas HABEGGER                                   *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) lab3 - LCD DMA animation        *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file anim_sim.c
+ * @author Andreas HABEGGER
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardware System Engineering
+ *
+ *  Host test of the LCD animation. A simulated clock counts CPU cycles at
+ *  50 MHz, calls lcd_anim_tick() every 10 ms as the SYS_TIMER ISR does and
+ *  lcd_anim_dma_done() when a simulated DMA transfer ends, as the end of
+ *  DMA ISR does. Each frame has its own transfer time.
+ *
+ *  It checks the order of the frames, the frame rate and the jitter with
+ *  transfers shorter than the period, longer than it, and one frame that
+ *  is longer than the others; then stop, the stats reset and the tick
+ *  counter wrap around.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <limits.h>
+
+#include "lcd_animation.h"
+
+#define CPU_FREQ      50000000ULL
+#define TICK_CYCLES   (CPU_FREQ/100)     // SYS_TIMER period 10 ms
+#define ANIM_PERIOD   10                 // ticks, 10 fps
+#define FRAMES        3
+#define SEQUENCE_MAX  512
+
+static LCDanimation anim;
+static LCDframe frames[FRAMES];
+static lcd_anim_time_t cost[FRAMES];     // transfer time of each frame
+static lcd_anim_time_t sim_time;
+static lcd_anim_time_t tick_time;        // time of the next timer IRQ
+static lcd_anim_time_t dma_end;
+static bool dma_busy;
+static unsigned int sequence[SEQUENCE_MAX];
+static unsigned int shown;
+static int errors = 0;
+
+static lcd_anim_time_t sim_clock(void)
+{
+	return sim_time;
+}
+
+// the start function of the animation: the DMA runs for the frame cost
+static void sim_start(const LCDframe *frame)
+{
+	unsigned int index = frame - frames;
+
+	if (dma_busy)
+	{
+		printf("error: frame started while the DMA is busy\n");
+		errors++;
+	}
+	if (shown < SEQUENCE_MAX)
+		sequence[shown] = index;
+	shown++;
+	dma_busy = true;
+	dma_end  = sim_time + cost[index];
+}
+
+static void check(int condition, const char *message, unsigned int value)
+{
+	if (!condition)
+	{
+		printf("error: %s (%u)\n", message, value);
+		errors++;
+	}
+}
+
+// runs the timer and the DMA, the ISRs are the only code that runs
+static void sim_run(unsigned int ticks)
+{
+	while (ticks > 0)
+	{
+		if (dma_busy && dma_end <= tick_time)
+		{
+			sim_time = dma_end;
+			dma_busy = false;
+			lcd_anim_dma_done(&anim);
+		}
+		else
+		{
+			sim_time   = tick_time;
+			tick_time += TICK_CYCLES;
+			lcd_anim_tick(&anim);
+			ticks--;
+		}
+	}
+}
+
+// transfer times in ticks/10
+static void sim_init(unsigned int cost0, unsigned int cost1,
+		unsigned int cost2, unsigned int start_ticks)
+{
+	unsigned int loop;
+
+	cost[0] = cost0*TICK_CYCLES/10;
+	cost[1] = cost1*TICK_CYCLES/10;
+	cost[2] = cost2*TICK_CYCLES/10;
+	for (loop = 0; loop < FRAMES; loop++)
+	{
+		frames[loop].picture = NULL;
+		frames[loop].width   = 240;
+		frames[loop].height  = 320;
+	}
+	sim_time  = 0;
+	tick_time = TICK_CYCLES;
+	dma_busy  = false;
+	shown    = 0;
+	lcd_anim_init(&anim, frames, FRAMES, ANIM_PERIOD, sim_start, sim_clock,
+			CPU_FREQ);
+	anim.ticks = start_ticks;
+	lcd_anim_start(&anim);
+}
+
+static void check_sequence(void)
+{
+	unsigned int loop;
+	for (loop = 0; loop < shown && loop < SEQUENCE_MAX; loop++)
+		if (sequence[loop] != loop%FRAMES)
+		{
+			check(0, "frame out of order at", loop);
+			return;
+		}
+}
+
+// all transfers end before the next release: a frame every period on the
+// tick, whatever the transfer time is
+static void fast_set(unsigned int start_ticks)
+{
+	sim_init(30, 95, 60, start_ticks);
+	sim_run(1000);
+	lcd_anim_report(&anim);
+
+	check_sequence();
+	check(anim.frames == 100, "frames", anim.frames);
+	check(lcd_anim_fps_x100(&anim) == 1000, "fps x100",
+			lcd_anim_fps_x100(&anim));
+	check(lcd_anim_jitter_us(&anim) == 0, "jitter us",
+			lcd_anim_jitter_us(&anim));
+	check(anim.late == 0, "late", anim.late);
+	check(anim.skipped == 0, "skipped", anim.skipped);
+}
+
+// all transfers are longer than the period: the end of DMA ISR chains the
+// frames back to back, at the rate of the DMA
+static void slow_set(void)
+{
+	sim_init(150, 150, 150, 0);
+	sim_run(1000);
+	lcd_anim_report(&anim);
+
+	check_sequence();
+	check(anim.frames == 67, "frames", anim.frames);
+	check(lcd_anim_fps_x100(&anim) == 666, "fps x100",
+			lcd_anim_fps_x100(&anim));
+	check(lcd_anim_jitter_us(&anim) == 0, "jitter us",
+			lcd_anim_jitter_us(&anim));
+	check(anim.late == anim.frames-1, "late", anim.late);
+	check(anim.skipped > 0, "no period skipped", anim.skipped);
+}
+
+// the second frame is longer than the period: the third one is late, the
+// first one is on time again, the mean rate stays at 10 fps
+static void mixed_set(void)
+{
+	sim_init(40, 140, 40, 0);
+	sim_run(3000);
+	lcd_anim_report(&anim);
+
+	check_sequence();
+	check(anim.frames == 300, "frames", anim.frames);
+	check(lcd_anim_fps_x100(&anim) >= 995 && lcd_anim_fps_x100(&anim) <= 1000,
+			"fps x100", lcd_anim_fps_x100(&anim));
+	check(lcd_anim_jitter_us(&anim) == 80000, "jitter us",
+			lcd_anim_jitter_us(&anim));
+	check(anim.late == 100, "late", anim.late);
+	check(anim.skipped == 0, "skipped", anim.skipped);
+}
+
+// stop lets the running transfer end; the stats reset keeps the last start
+static void stop_reset_set(void)
+{
+	unsigned int count;
+
+	sim_init(30, 30, 30, 0);
+	sim_run(105);
+	lcd_anim_reset_stats(&anim);
+	sim_run(100);
+	check(anim.frames == 10, "frames after reset", anim.frames);
+	check(anim.intervals == 10, "intervals after reset", anim.intervals);
+
+	// stop in the transfer of the frame released at tick 211
+	count = shown;
+	sim_run(6);
+	check(anim.busy, "no transfer at the stop", 0);
+	lcd_anim_stop(&anim);
+	sim_run(100);
+	check(shown == count+1, "frames after stop", shown-count);
+	check(!dma_busy && !anim.busy, "transfer not ended after stop", 0);
+
+	lcd_anim_start(&anim);
+	sim_run(100);
+	check(shown == count+11, "frames after restart", shown-count);
+	check_sequence();
+}
+
+int main(void)
+{
+	printf("transfers shorter than the period:\n");
+	fast_set(0);
+	printf("\ntick counter wraps around:\n");
+	fast_set(UINT_MAX - 500);
+	printf("\ntransfers longer than the period:\n");
+	slow_set();
+	printf("\none transfer longer than the period:\n");
+	mixed_set();
+	stop_reset_set();
+
+	printf("\nanim_sim: %d error(s)\n", errors);
+	return errors != 0;
+}
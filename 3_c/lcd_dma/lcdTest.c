@@ -25,6 +25,16 @@
  *  This can result in wrong behavior.
  * @copyright GNU Lesser General Public License
  * @see http://www.msengineering.ch/
+ *  The tasks run on the cooperative scheduler of ../scheduler (add
+ *  scheduler.c and scheduler.h to the application): the timer ISR only
+ *  ticks it, the counter task has the highest priority. The tux animation
+ *  is played by lcd_animation.c in the timer and the end of DMA ISRs, a
+ *  frame every ANIM_PERIOD ticks, without a task. The report task prints
+ *  the deadline misses, the execution times and the frame rate and jitter
+ *  of the animation every REPORT_PERIOD ticks.
+ *  The counter task logs with binlog() of ../binlog (add binlog.c), the
+ *  records are sent when no task is ready; decode the terminal output with
+ *  binlog/host/binlog_decode.
  * @bug currently no bugs
  * @todo Read control Reg back and mask before write back.
  */
@@ -38,7 +48,10 @@
 #include "sys/alt_irq.h"
 #include "priv/alt_legacy_irq.h"
 
+#include "binlog.h"
+#include "lcd_animation.h"
 #include "lcd_simple.h"
+#include "scheduler.h"
 #include "tuxAnimation_1.h"
 #include "tuxAnimation_2.h"
 #include "tuxAnimation_3.h"
@@ -55,17 +68,32 @@
 #define TIMER_REG_PERIOD_LOW   2
 #define TIMER_REG_PERIOD_HIGH  3
 
+// task and frame periods in SYS_TIMER ticks (10 ms)
+#define TICKS_PER_SEC   100
+#define COUNTER_PERIOD  10
+#define ANIM_PERIOD     10
+#define REPORT_PERIOD   1000
+
+// the animation measures with the clock of the scheduler
+#ifdef PERFORMANCE_COUNTER_0_BASE
+#define ANIM_CLOCK_FREQ ALT_CPU_FREQ
+#elif defined(ALT_TIMESTAMP_CLK)
+#include "sys/alt_timestamp.h"
+#define ANIM_CLOCK_FREQ alt_timestamp_freq()
+#else
+#define ANIM_CLOCK_FREQ TICKS_PER_SEC
+#endif
+
 // counter structure
 typedef struct _IRQcounter{
 	uint32_t count;
-	bool newCount;
 }IRQcounter;
 
-// lcd structure
-typedef struct _IRQlcd{
-	void* picture;
-	bool newPicture;
-}IRQlcd;
+static SCHEDscheduler sched;
+
+static LCDanimation anim;
+
+static LCDframe tux_frames[3];
 
 // function prototypes
 static void timer_interrupt_handler(void *context, alt_u32 id);
@@ -80,28 +108,40 @@ static int init_simplePIO(void);
 
 static int init_led(void);
 
-static void task1(IRQcounter *counter);
-
-static void task2(IRQlcd *lcd);
+static void task1(void *context);
 
-static void task3(void);
+static void start_frame(const LCDframe *frame);
 
-static void task4(void);
+static void task_report(void *context);
 
 
 int main(void)
 {
-	// img reference ring
-	void* pictureRef[] = {&picture_array_tuxAnimation_1, &picture_array_tuxAnimation_2, &picture_array_tuxAnimation_3};
-
 	// counter
 	IRQcounter counter;
 	counter.count = 0;
-	counter.newCount   = false;
 
-	IRQlcd lcd;
-	lcd.picture    = NULL;
-	lcd.newPicture = false;
+	// initialize the scheduler, the rate monotonic order puts task1 first
+	sched_init(&sched, SCHED_DEFAULT_CLOCK);
+	sched_start_clock();
+	binlog_init();
+	sched_add(&sched, "task1", task1, &counter, COUNTER_PERIOD, 0,
+			SCHED_RATE_MONOTONIC);
+	sched_add(&sched, "report", task_report, NULL, REPORT_PERIOD,
+			REPORT_PERIOD, SCHED_RATE_MONOTONIC);
+
+	// frame list of the tux animation
+	tux_frames[0].picture = picture_array_tuxAnimation_1;
+	tux_frames[0].width   = picture_width_tuxAnimation_1;
+	tux_frames[0].height  = picture_height_tuxAnimation_1;
+	tux_frames[1].picture = picture_array_tuxAnimation_2;
+	tux_frames[1].width   = picture_width_tuxAnimation_2;
+	tux_frames[1].height  = picture_height_tuxAnimation_2;
+	tux_frames[2].picture = picture_array_tuxAnimation_3;
+	tux_frames[2].width   = picture_width_tuxAnimation_3;
+	tux_frames[2].height  = picture_height_tuxAnimation_3;
+	lcd_anim_init(&anim, tux_frames, 3, ANIM_PERIOD, start_frame,
+			SCHED_DEFAULT_CLOCK, ANIM_CLOCK_FREQ);
 
 	alt_irq_context statusISR;
 
@@ -121,7 +161,7 @@ int main(void)
 	init_timer(&counter, (alt_isr_func)timer_interrupt_handler);
 
 	// add lcd dma ctrl irq
-//	init_lcd_irq(&lcd, (alt_isr_func)lcd_interrupt_handler);
+	init_lcd_irq(&anim, (alt_isr_func)lcd_interrupt_handler);
 
 	// Start the timer
 	puts("Enable Timer IRQ and start Timer ...");
@@ -129,85 +169,55 @@ int main(void)
 	IOWR_16DIRECT(SYS_TIMER_BASE, TIMER_REG_CTRL,
 			TIMER_EN_IRQ | TIMER_START); // Enable IRQ + Start timer
 
-//	puts("Enable LCD CTRL IRQ ...");
-//	IOWR_16DIRECT(LCD_CTRL_DMA_BASE, LCD_CONTROL_REG, LCD_IRQ_Enabled);
-
-	lcd.newPicture = true;
-
+	// from here on the ISRs play the animation
+	puts("Start animation ...");
+	statusISR = alt_irq_disable_all();
+	lcd_anim_start(&anim);
+	alt_irq_enable_all(statusISR);
 
 	while(1)
 	{
-
-		if(counter.newCount)
-			task1(&counter);
-
-		if(lcd.newPicture){
-			lcd.newPicture = false;
-			LCD_transfer_dma(&picture_array_tuxAnimation_2, picture_width_tuxAnimation_2, picture_height_tuxAnimation_2, true);
-//			lcd.picture = pictureRef[0];
-//			task2(&lcd);
-//			pictureRef[0] = pictureRef[1];
-//			pictureRef[1] = pictureRef[2];
-//			pictureRef[2] = lcd.picture;
-
-		}
-
-//		if(counter.newCount)
-//			task1(&counter);
-
-//		task3();
-//		if(counter.newCount)
-//			task1(&counter);
-
-//		task4();
-
+		if (!sched_run(&sched))
+			binlog_drain(BINLOG_DRAIN_MAX); // idle: send the log
 	}
 }
 
-static void task1(IRQcounter *counter)
+static void task1(void *context)
 {
-	puts("Enter Task 1");
-	if(counter->newCount)
-	{
-		printf("counter value is = %u \n",(unsigned int)counter->count);
-		// led IF count (lab1)
-		IOWR_16DIRECT(LEDS_BASE,0, counter->count);
-
-		counter->newCount = false;
-	}
+	IRQcounter *counter = (IRQcounter*) context;
+	binlog(LOG_COUNTER, counter->count, 0);
+	// led IF count (lab1)
+	IOWR_16DIRECT(LEDS_BASE,0, counter->count);
 }
 
-static void task2(IRQlcd *lcd)
+// called by the animation in the ISRs
+static void start_frame(const LCDframe *frame)
 {
-	puts("Enter Task 2");
-	if(lcd->newPicture)
-	{
-		LCD_transfer(&lcd->picture, 320, 240);
-		lcd->newPicture = false;
-	}
-	puts("Img Tux 1 transfered");
+	LCD_transfer_dma_irq(frame->picture, frame->width, frame->height);
 }
 
-
-static void task3(void)
+static void task_report(void *context)
 {
-	puts("Enter Task 3");
-	LCD_transfer_dma(&picture_array_tuxAnimation_2, picture_height_tuxAnimation_2, picture_width_tuxAnimation_2, true);
-	puts("Img Tux 2 transfered");
-}
+	LCDanimation stats;
+	alt_irq_context statusISR;
 
-static void task4(void)
-{
-	puts("Enter Task 4");
-	LCD_transfer_dma(&picture_array_tuxAnimation_3, picture_height_tuxAnimation_3, picture_width_tuxAnimation_3, true);
-	puts("Img Tux 3 transfered");
+	// the ISRs update the animation stats, report a copy
+	statusISR = alt_irq_disable_all();
+	stats = anim;
+	lcd_anim_reset_stats(&anim);
+	alt_irq_enable_all(statusISR);
+
+	sched_report(&sched);
+	sched_reset_stats(&sched);
+	lcd_anim_report(&stats);
 }
 
 static void timer_interrupt_handler(void *context, alt_u32 id)
 {
 	IRQcounter *ctr_ptr = (IRQcounter*) context;
 	ctr_ptr->count++; // increase the counter;
-	ctr_ptr->newCount = true;
+	sched_tick(&sched);
+	lcd_anim_tick(&anim);
 
 	// simplePIO IF count (lab2)
 	IOWR_8DIRECT(SIMPLEPIO_BASE,2, ctr_ptr->count);
@@ -219,11 +229,10 @@ static void timer_interrupt_handler(void *context, alt_u32 id)
 
 static void lcd_interrupt_handler(void *context, alt_u32 id)
 {
-	IRQlcd *lcd_ptr = (IRQlcd*) context;
-	lcd_ptr->picture = NULL; // increase the counter;
-	lcd_ptr->newPicture = true;
+	LCDanimation *anim_ptr = (LCDanimation*) context;
 
-	IOWR_16DIRECT(LCD_DMA_BASE, LCD_CONTROL_REG, LCD_Clear_IRQ);
+	LCD_ack_irq();
+	lcd_anim_dma_done(anim_ptr); // chains the next frame when it is due
 
 	return;
 }
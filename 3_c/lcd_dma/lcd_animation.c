@@ -0,0 +1,178 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Andreas HABEGGER                                   *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) lab3 - LCD DMA animation        *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file lcd_animation.c
+ * @author Andreas HABEGGER
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardware System Engineering
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+#include <stddef.h>
+
+#include "lcd_animation.h"
+
+// tick a is at or after tick b, also when the tick counter wraps
+#define ANIM_REACHED(a, b) ((int)((a) - (b)) >= 0)
+
+
+void lcd_anim_init(LCDanimation *anim, const LCDframe *frame,
+		unsigned int count, unsigned int period, lcd_anim_start_func start,
+		lcd_anim_clock_func clock, lcd_anim_time_t clock_freq)
+{
+	anim->frame      = frame;
+	anim->count      = count;
+	anim->next       = 0;
+	anim->period     = (period > 0) ? period : 1;
+	anim->start      = start;
+	anim->clock      = clock;
+	anim->clock_freq = clock_freq;
+	anim->ticks      = 0;
+	anim->release    = 0;
+	anim->running    = false;
+	anim->busy       = false;
+	anim->due        = false;
+	anim->started    = false;
+	anim->last_start = 0;
+	lcd_anim_reset_stats(anim);
+}
+
+
+// the first frame is shown with the next tick; call it with the IRQs off
+void lcd_anim_start(LCDanimation *anim)
+{
+	if (anim->count == 0)
+		return;
+	anim->release = anim->ticks + 1;
+	anim->due     = false;
+	anim->started = false;
+	anim->running = true;
+}
+
+
+// a running transfer is finished, no frame is started after it
+void lcd_anim_stop(LCDanimation *anim)
+{
+	anim->running = false;
+	anim->due     = false;
+}
+
+
+// starts the next frame, called in interrupt context only
+static void lcd_anim_next(LCDanimation *anim)
+{
+	lcd_anim_time_t now = (anim->clock != NULL) ? anim->clock() :
+			(lcd_anim_time_t)anim->ticks;
+	lcd_anim_time_t interval;
+
+	if (anim->started)
+	{
+		interval = now - anim->last_start;
+		anim->intervals++;
+		anim->interval_total += interval;
+		if (anim->intervals == 1 || interval < anim->interval_min)
+			anim->interval_min = interval;
+		if (interval > anim->interval_max)
+			anim->interval_max = interval;
+	}
+	anim->last_start = now;
+	anim->started    = true;
+
+	anim->due  = false;
+	anim->busy = true;
+	anim->frames++;
+	anim->start(&anim->frame[anim->next]);
+	if (++anim->next >= anim->count)
+		anim->next = 0;
+}
+
+
+// called by the timer ISR
+void lcd_anim_tick(LCDanimation *anim)
+{
+	anim->ticks++;
+	if (!anim->running || !ANIM_REACHED(anim->ticks, anim->release))
+		return;
+
+	anim->release += anim->period;
+	// the last frame is still waiting for the DMA, this period is lost
+	if (anim->due)
+		anim->skipped++;
+	anim->due = true;
+	if (!anim->busy)
+		lcd_anim_next(anim);
+}
+
+
+// called by the end of DMA ISR, after the IRQ is cleared
+void lcd_anim_dma_done(LCDanimation *anim)
+{
+	anim->busy = false;
+	if (anim->running && anim->due)
+	{
+		anim->late++;
+		lcd_anim_next(anim);
+	}
+}
+
+
+// the time of the last frame start is kept for the next interval
+void lcd_anim_reset_stats(LCDanimation *anim)
+{
+	anim->frames         = 0;
+	anim->late           = 0;
+	anim->skipped        = 0;
+	anim->intervals      = 0;
+	anim->interval_total = 0;
+	anim->interval_min   = 0;
+	anim->interval_max   = 0;
+}
+
+
+// achieved frames per second times 100
+unsigned int lcd_anim_fps_x100(const LCDanimation *anim)
+{
+	if (anim->interval_total == 0)
+		return 0;
+	return (unsigned int)((anim->intervals*anim->clock_freq*100ULL)/
+			anim->interval_total);
+}
+
+
+// max - min of the time between two frame starts in microseconds
+unsigned int lcd_anim_jitter_us(const LCDanimation *anim)
+{
+	if (anim->clock_freq == 0)
+		return 0;
+	return (unsigned int)(((anim->interval_max - anim->interval_min)*
+			1000000ULL)/anim->clock_freq);
+}
+
+
+// prints a copy taken with the IRQs off, the ISRs change the stats
+void lcd_anim_report(const LCDanimation *anim)
+{
+	unsigned int fps = lcd_anim_fps_x100(anim);
+
+	printf("animation: %u frames, %u.%02u fps (period %u ticks), "
+			"jitter %u us, %u late, %u skipped\n",
+			anim->frames, fps/100, fps%100, anim->period,
+			lcd_anim_jitter_us(anim), anim->late, anim->skipped);
+}
@@ -0,0 +1,111 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Andreas HABEGGER                                   *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) lab3 - LCD DMA animation        *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file lcd_animation.h
+ * @author Andreas HABEGGER
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardware System Engineering
+ *
+ *  Animation player that runs in the interrupt handlers only. A frame list
+ *  is shown in a loop, a new frame every period timer ticks:
+ *   - the timer ISR calls lcd_anim_tick(); when a frame is due and the
+ *     DMA of the LCD controller is idle, the frame is started at once
+ *   - the end of DMA ISR calls lcd_anim_dma_done(); when a frame got due
+ *     while the last one was still transferred, it is chained from here
+ *  So in steady state the main loop does nothing for the animation.
+ *
+ *  A frame that is started by the end of DMA ISR is late. When the next
+ *  release comes before a late frame could start, the period is skipped
+ *  (the frames are still shown in order, none is left out).
+ *
+ *  The start time of each frame is taken with the clock given to
+ *  lcd_anim_init() (clock units, clock_freq per second). Without a clock
+ *  the timer ticks are used, clock_freq is the tick rate then. The stats
+ *  give the achieved frame rate and the jitter (max - min) of the time
+ *  between two frame starts. The host test (host/anim_sim.c) simulates
+ *  the timer and the DMA.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef LCD_ANIMATION_H_
+#define LCD_ANIMATION_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef unsigned long long lcd_anim_time_t;
+
+typedef lcd_anim_time_t (*lcd_anim_clock_func)(void);
+
+// frame structure
+typedef struct _LCDframe{
+	const void *picture;
+	uint16_t width;
+	uint16_t height;
+}LCDframe;
+
+typedef void (*lcd_anim_start_func)(const LCDframe *frame);
+
+// animation structure, written by the ISRs
+typedef struct _LCDanimation{
+	const LCDframe *frame;
+	unsigned int count;
+	unsigned int next;          // index of the next frame
+	unsigned int period;        // ticks per frame
+	lcd_anim_start_func start;
+	lcd_anim_clock_func clock;
+	lcd_anim_time_t clock_freq;
+	volatile unsigned int ticks;
+	unsigned int release;       // tick the next frame is due
+	volatile bool running;
+	volatile bool busy;         // a DMA transfer is running
+	volatile bool due;          // a frame waits for the end of the DMA
+	lcd_anim_time_t last_start;
+	bool started;
+	// statistics
+	unsigned int frames;
+	unsigned int late;
+	unsigned int skipped;
+	unsigned int intervals;
+	lcd_anim_time_t interval_total;
+	lcd_anim_time_t interval_min;
+	lcd_anim_time_t interval_max;
+}LCDanimation;
+
+void lcd_anim_init(LCDanimation *anim, const LCDframe *frame,
+		unsigned int count, unsigned int period, lcd_anim_start_func start,
+		lcd_anim_clock_func clock, lcd_anim_time_t clock_freq);
+
+void lcd_anim_start(LCDanimation *anim);
+
+void lcd_anim_stop(LCDanimation *anim);
+
+void lcd_anim_tick(LCDanimation *anim);
+
+void lcd_anim_dma_done(LCDanimation *anim);
+
+void lcd_anim_reset_stats(LCDanimation *anim);
+
+unsigned int lcd_anim_fps_x100(const LCDanimation *anim);
+
+unsigned int lcd_anim_jitter_us(const LCDanimation *anim);
+
+void lcd_anim_report(const LCDanimation *anim);
+
+#endif /* LCD_ANIMATION_H_ */
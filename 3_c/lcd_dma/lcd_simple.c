@@ -164,3 +164,24 @@ void LCD_transfer_dma(void *array, uint16_t width, uint16_t height, bool noGrayC
 				         LCD_RGB565_Mode|LCD_GrayScale_Image);
 }
 
+// color transfer that raises the end of DMA IRQ; every write of the control
+// register sets all mode bits, so the IRQ enable is part of each write
+void LCD_transfer_dma_irq(const void *array, uint16_t width, uint16_t height)
+{
+	uint16_t real_height = (height > IMAGE_MAX_HIGHT) ? IMAGE_MAX_HIGHT : height;
+	uint16_t real_width = (width > IMAGE_MAX_WIDTH) ? IMAGE_MAX_WIDTH : width;
+	IOWR_32DIRECT(LCD_DMA_BASE,LCD_Pict_width_reg,width);
+	IOWR_32DIRECT(LCD_DMA_BASE,LCD_IMAGE_POINTER_REG,(uint32_t)array);
+	IOWR_32DIRECT(LCD_DMA_BASE,LCD_IMAGE_SIZE_REG,real_width*real_height);
+	IOWR_16DIRECT(LCD_DMA_BASE,LCD_CONTROL_REG,
+			         LCD_Sixteen_Bit|LCD_Start_DMA|LCD_IRQ_Enabled|
+			         LCD_RGB565_Mode|LCD_Color_Image);
+}
+
+// clears the end of DMA IRQ and keeps it enabled
+void LCD_ack_irq(void)
+{
+	IOWR_16DIRECT(LCD_DMA_BASE,LCD_CONTROL_REG,
+			         LCD_Sixteen_Bit|LCD_Clear_IRQ|LCD_IRQ_Enabled|
+			         LCD_RGB565_Mode|LCD_Color_Image);
+}
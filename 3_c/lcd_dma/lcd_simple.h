@@ -74,4 +74,8 @@ void LCD_transfer(void* array, uint16_t width, uint16_t height);
 
 void LCD_transfer_dma(void *array, uint16_t width, uint16_t height, bool noGrayConversion);
 
+void LCD_transfer_dma_irq(const void *array, uint16_t width, uint16_t height);
+
+void LCD_ack_irq(void);
+
 #endif /* LCD_SIMPLE_H_ */
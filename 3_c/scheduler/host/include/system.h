@@ -0,0 +1,8 @@
+/*
+ * Host stand-in for the system.h of the BSP: no performance counter and no
+ * timestamp timer, the host test gives the scheduler its own clock.
+ */
+#ifndef SYSTEM_H_
+#define SYSTEM_H_
+
+#endif /* SYSTEM_H_ */
@@ -0,0 +1,246 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Andreas HABEGGER                                   *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) lab3 - cooperative scheduler     *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file sched_sim.c
+ * @author Andreas HABEGGER
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardware System Engineering
+ *
+ *  Host test of the scheduler. A simulated clock counts CPU cycles at
+ *  50 MHz and calls sched_tick() every 10 ms, as the SYS_TIMER of the lab
+ *  system does. A task "runs" by advancing the clock by its cost, so the
+ *  ticks arrive while it runs as the timer IRQ would.
+ *
+ *  The lcdTest task set (a short counter task and three LCD transfers) is
+ *  run in the old round-robin loop and with the scheduler; the counter
+ *  latency and the lost counter periods of both are printed. Then it checks the deadline miss counters,
+ *  the execution time stats, fixed priorities and the tick wrap around.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+#include <limits.h>
+
+#include "scheduler.h"
+
+#define CPU_FREQ      50000000ULL
+#define TICK_CYCLES   (CPU_FREQ/100)     // SYS_TIMER period 10 ms
+#define SIM_TICKS     3000               // 30 s
+
+#define COUNTER_COST  2000               // cycles
+#define LCD_COST      (9*TICK_CYCLES+TICK_CYCLES/2)
+#define COUNTER_PERIOD 10                // ticks
+#define LCD_PERIOD     30
+#define LCD_PHASE      5                 // the counter is released mid transfer
+
+// simulated task
+typedef struct _SIMtask{
+	sched_time_t cost;
+	unsigned int runs;
+	int order;
+}SIMtask;
+
+static SCHEDscheduler sched;
+static sched_time_t sim_time;
+static int errors = 0;
+static int run_order = 0;
+
+static sched_time_t sim_clock(void)
+{
+	return sim_time;
+}
+
+// advances the clock, the timer IRQ ticks on the way
+static void sim_advance(sched_time_t cycles)
+{
+	sched_time_t end = sim_time + cycles;
+	sched_time_t next = (sim_time/TICK_CYCLES+1)*TICK_CYCLES;
+
+	while (next <= end)
+	{
+		sched_tick(&sched);
+		next += TICK_CYCLES;
+	}
+	sim_time = end;
+}
+
+// the main loop waits for the next tick when no task is ready
+static void sim_idle(void)
+{
+	sim_advance((sim_time/TICK_CYCLES+1)*TICK_CYCLES - sim_time);
+}
+
+static void sim_task(void *context)
+{
+	SIMtask *task = (SIMtask*) context;
+	task->runs++;
+	task->order = run_order++;
+	sim_advance(task->cost);
+}
+
+static void check(int condition, const char *message, unsigned int value)
+{
+	if (!condition)
+	{
+		printf("error: %s (%u)\n", message, value);
+		errors++;
+	}
+}
+
+static void sim_run(unsigned int ticks)
+{
+	unsigned int end = sched.ticks + ticks;
+	while ((int)(sched.ticks - end) < 0)
+	{
+		if (!sched_run(&sched))
+			sim_idle();
+	}
+}
+
+// the old lcdTest loop: task1() to task4() one after the other; the ISR
+// only sets a flag, so the counter periods passed in one round are lost
+static unsigned int round_robin_latency(unsigned int *lost)
+{
+	unsigned int served = 0;
+	unsigned int elapsed;
+	unsigned int max_latency = 0;
+	int loop;
+
+	*lost = 0;
+	sim_time = 0;
+	sched_init(&sched, sim_clock);
+	while (sched.ticks < SIM_TICKS)
+	{
+		elapsed = sched.ticks/COUNTER_PERIOD;
+		if (elapsed != served)
+		{
+			if (sched.ticks - (served+1)*COUNTER_PERIOD > max_latency)
+				max_latency = sched.ticks - (served+1)*COUNTER_PERIOD;
+			*lost += elapsed - served - 1;
+			served = elapsed;
+			sim_advance(COUNTER_COST);
+		}
+		for (loop = 0; loop < 3; loop++)
+			sim_advance(LCD_COST);
+	}
+	return max_latency;
+}
+
+static void lcd_test_set(unsigned int start)
+{
+	SIMtask counter = {COUNTER_COST, 0, 0};
+	SIMtask lcd[3] = {{LCD_COST, 0, 0}, {LCD_COST, 0, 0}, {LCD_COST, 0, 0}};
+	const char *lcd_name[3] = {"lcd_fill", "lcd_text", "lcd_blit"};
+	int loop;
+
+	sim_time = 0;
+	sched_init(&sched, sim_clock);
+	sched.ticks = start;
+	// the LCD tasks are added first, rate monotonic sorts the counter first
+	for (loop = 0; loop < 3; loop++)
+		sched_add(&sched, lcd_name[loop], sim_task, &lcd[loop], LCD_PERIOD,
+				LCD_PHASE+loop*LCD_PERIOD/3, SCHED_RATE_MONOTONIC);
+	sched_add(&sched, "counter", sim_task, &counter, COUNTER_PERIOD, 0,
+			SCHED_RATE_MONOTONIC);
+	sim_run(SIM_TICKS);
+	sched_report(&sched);
+
+	check(sched.task[0].context == &counter, "counter not first", 0);
+	check(sched.task[0].misses == 0, "counter misses", sched.task[0].misses);
+	check(sched.task[0].max_latency > 0, "counter never waited for an LCD task",
+			0);
+	check(sched.task[0].max_latency <= LCD_COST/TICK_CYCLES+1,
+			"counter latency above one LCD transfer", sched.task[0].max_latency);
+	check(counter.runs == SIM_TICKS/COUNTER_PERIOD, "counter runs", counter.runs);
+	for (loop = 1; loop < 4; loop++)
+	{
+		check(sched.task[loop].misses == 0, "lcd misses",
+				sched.task[loop].misses);
+		check(sched.task[loop].exec_max == LCD_COST, "lcd exec max",
+				(unsigned int)sched.task[loop].exec_max);
+		check(sched.task[loop].exec_total == LCD_COST*sched.task[loop].runs,
+				"lcd exec total", sched.task[loop].runs);
+	}
+	check(sched.task[0].exec_max == COUNTER_COST, "counter exec max",
+			(unsigned int)sched.task[0].exec_max);
+}
+
+// a task longer than its period misses, the task below it starves
+static void overload_set(void)
+{
+	SIMtask fast = {TICK_CYCLES/2, 0, 0};
+	SIMtask hog  = {5*TICK_CYCLES, 0, 0};
+	SIMtask slow = {TICK_CYCLES/10, 0, 0};
+
+	sim_time = 0;
+	sched_init(&sched, sim_clock);
+	sched_add(&sched, "fast", sim_task, &fast, 2, 0, SCHED_RATE_MONOTONIC);
+	sched_add(&sched, "hog", sim_task, &hog, 4, 0, SCHED_RATE_MONOTONIC);
+	sched_add(&sched, "slow", sim_task, &slow, 50, 0, SCHED_RATE_MONOTONIC);
+	sim_run(1000);
+	sched_report(&sched);
+
+	check(sched.task[0].misses > 0, "fast task delayed by hog never missed", 0);
+	check(sched.task[1].misses > 0, "hog never missed", 0);
+	check(sched.task[2].runs == 0, "slow task ran in overload",
+			sched.task[2].runs);
+}
+
+// a fixed priority beats the rate monotonic order, even when it is above
+// the period of the rate monotonic task
+static void priority_set(void)
+{
+	SIMtask first  = {100, 0, 0};
+	SIMtask second = {100, 0, 0};
+	SIMtask third  = {100, 0, 0};
+
+	sim_time = 0;
+	sched_init(&sched, sim_clock);
+	sched_add(&sched, "third", sim_task, &third, 2, 0, SCHED_RATE_MONOTONIC);
+	sched_add(&sched, "second", sim_task, &second, 20, 0, 10);
+	sched_add(&sched, "first", sim_task, &first, 20, 0, 0);
+	check(sched_add(&sched, "out", sim_task, NULL, 20, 0,
+			SCHED_FIXED_PRIORITIES) == -1, "fixed priority out of band", 0);
+	run_order = 0;
+	sched_run(&sched);
+	sched_run(&sched);
+	sched_run(&sched);
+	check(first.order == 0 && second.order == 1 && third.order == 2,
+			"fixed priority order", third.order);
+}
+
+int main(void)
+{
+	unsigned int latency, lost;
+
+	latency = round_robin_latency(&lost);
+	printf("round robin: counter latency up to %u ticks, period %u, "
+			"%u periods lost\n\n", latency, COUNTER_PERIOD, lost);
+
+	printf("scheduler, %u ticks of 10 ms:\n", SIM_TICKS);
+	lcd_test_set(0);
+	printf("\nscheduler, tick counter wraps around:\n");
+	lcd_test_set(UINT_MAX - SIM_TICKS/2);
+	printf("\noverload:\n");
+	overload_set();
+	priority_set();
+
+	printf("\nsched_sim: %d error(s)\n", errors);
+	return errors != 0;
+}
@@ -0,0 +1,220 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Andreas HABEGGER                                   *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) lab3 - cooperative scheduler     *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file scheduler.c
+ * @author Andreas HABEGGER
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardware System Engineering
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <limits.h>
+#include <stdio.h>
+
+#include "scheduler.h"
+
+#ifdef PERFORMANCE_COUNTER_0_BASE
+#include "altera_avalon_performance_counter.h"
+#elif defined(ALT_TIMESTAMP_CLK)
+#include "sys/alt_timestamp.h"
+#endif
+
+// tick a is at or after tick b, also when the tick counter wraps
+#define SCHED_REACHED(a, b) ((int)((a) - (b)) >= 0)
+
+
+void sched_init(SCHEDscheduler *sched, sched_clock_func clock)
+{
+	sched->ticks = 0;
+	sched->count = 0;
+	sched->clock = clock;
+}
+
+
+// returns the index of the task, or -1 when the table is full or the fixed
+// priority is out of its band
+int sched_add(SCHEDscheduler *sched, const char *name, sched_task_func run,
+		void *context, unsigned int period, unsigned int phase, int priority)
+{
+	SCHEDtask *task;
+	unsigned int prio = (priority < 0) ? SCHED_FIXED_PRIORITIES + period :
+			(unsigned int)priority;
+	int index;
+
+	if (sched->count >= SCHED_MAX_TASKS || period == 0 ||
+			period > UINT_MAX - SCHED_FIXED_PRIORITIES ||
+			priority >= SCHED_FIXED_PRIORITIES)
+		return -1;
+
+	// the table is kept sorted by priority, equal priorities in add order
+	index = sched->count;
+	while (index > 0 && sched->task[index-1].priority > prio)
+	{
+		sched->task[index] = sched->task[index-1];
+		index--;
+	}
+	sched->count++;
+
+	task = &sched->task[index];
+	task->name     = name;
+	task->run      = run;
+	task->context  = context;
+	task->period   = period;
+	task->priority = prio;
+	task->release  = sched->ticks + phase;
+	task->deadline = task->release;
+	task->pending  = false;
+	task->runs        = 0;
+	task->misses      = 0;
+	task->max_latency = 0;
+	task->exec_total  = 0;
+	task->exec_max    = 0;
+	return index;
+}
+
+
+// called by the timer ISR, nothing else is done in interrupt context
+void sched_tick(SCHEDscheduler *sched)
+{
+	sched->ticks++;
+}
+
+
+// releases the tasks that are due and runs the ready task with the highest
+// priority; returns false when no task was ready
+bool sched_run(SCHEDscheduler *sched)
+{
+	unsigned int now = sched->ticks;
+	unsigned int latency;
+	unsigned int loop;
+	SCHEDtask *task;
+	sched_time_t start, exec;
+
+	for (loop = 0; loop < sched->count; loop++)
+	{
+		task = &sched->task[loop];
+		while (SCHED_REACHED(now, task->release))
+		{
+			// the last release did not run before its deadline, drop it
+			if (task->pending)
+				task->misses++;
+			task->pending  = true;
+			task->deadline = task->release + task->period;
+			task->release += task->period;
+		}
+	}
+
+	for (loop = 0; loop < sched->count; loop++)
+	{
+		task = &sched->task[loop];
+		if (!task->pending)
+			continue;
+		task->pending = false;
+		latency = sched->ticks - (task->deadline - task->period);
+		if (latency > task->max_latency)
+			task->max_latency = latency;
+
+		start = (sched->clock != NULL) ? sched->clock() : 0;
+		task->run(task->context);
+		exec = (sched->clock != NULL) ? sched->clock() - start : 0;
+
+		task->runs++;
+		task->exec_total += exec;
+		if (exec > task->exec_max)
+			task->exec_max = exec;
+		if (SCHED_REACHED(sched->ticks, task->deadline))
+			task->misses++;
+		return true;
+	}
+	return false;
+}
+
+
+void sched_reset_stats(SCHEDscheduler *sched)
+{
+	unsigned int loop;
+	for (loop = 0; loop < sched->count; loop++)
+	{
+		sched->task[loop].runs        = 0;
+		sched->task[loop].misses      = 0;
+		sched->task[loop].max_latency = 0;
+		sched->task[loop].exec_total  = 0;
+		sched->task[loop].exec_max    = 0;
+	}
+}
+
+
+void sched_report(SCHEDscheduler *sched)
+{
+	unsigned int loop;
+	SCHEDtask *task;
+
+	printf("task         period prio   runs misses latency  exec avg  exec max\n");
+	for (loop = 0; loop < sched->count; loop++)
+	{
+		task = &sched->task[loop];
+		printf("%-12s %6u %4u %6u %6u %7u %9u %9u\n", task->name,
+				task->period, task->priority, task->runs, task->misses,
+				task->max_latency,
+				(unsigned int)(task->runs ? task->exec_total/task->runs : 0),
+				(unsigned int)task->exec_max);
+	}
+}
+
+
+// starts the clock of SCHED_DEFAULT_CLOCK
+void sched_start_clock(void)
+{
+#ifdef PERFORMANCE_COUNTER_0_BASE
+	PERF_RESET(PERFORMANCE_COUNTER_0_BASE);
+	PERF_START_MEASURING(PERFORMANCE_COUNTER_0_BASE);
+#elif defined(ALT_TIMESTAMP_CLK)
+	alt_timestamp_start();
+#endif
+}
+
+
+#ifdef PERFORMANCE_COUNTER_0_BASE
+// CPU cycles of the global counter of the performance counter, read while
+// it runs (perf_get_total_time() stops it)
+sched_time_t sched_perf_clock(void)
+{
+	alt_u32 high, low;
+
+	do
+	{
+		high = IORD(PERFORMANCE_COUNTER_0_BASE, 1);
+		low  = IORD(PERFORMANCE_COUNTER_0_BASE, 0);
+	} while (high != IORD(PERFORMANCE_COUNTER_0_BASE, 1));
+	return ((sched_time_t)high << 32) | low;
+}
+#elif defined(ALT_TIMESTAMP_CLK)
+// ticks of alt_timestamp_freq(), the 32 bit timestamp is extended here
+sched_time_t sched_timestamp_clock(void)
+{
+	static alt_u32 last = 0;
+	static sched_time_t high = 0;
+	alt_u32 now = (alt_u32)alt_timestamp();
+
+	if (now < last)
+		high += 1ULL << 32;
+	last = now;
+	return high | now;
+}
+#endif
@@ -0,0 +1,118 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Andreas HABEGGER                                   *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) lab3 - cooperative scheduler     *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file scheduler.h
+ * @author Andreas HABEGGER
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardware System Engineering
+ *
+ *  Small cooperative scheduler for periodic tasks, driven by the ticks of
+ *  a timer interrupt (SYS_TIMER). The timer ISR only calls sched_tick();
+ *  sched_run() in the main loop releases the tasks whose period is over
+ *  and runs the ready task with the highest priority to its end.
+ *
+ *  Priorities are rate monotonic by default (the shorter the period, the
+ *  higher the priority), a task can also get a fixed priority from 0 (the
+ *  highest) to SCHED_FIXED_PRIORITIES-1. The fixed priorities form a band
+ *  above all rate monotonic tasks, whose priority is SCHED_FIXED_PRIORITIES
+ *  plus the period, so a fixed priority never ties with a period. As the
+ *  tasks are not preempted, a task can be delayed by at most one run of a
+ *  lower priority task instead of a whole round.
+ *
+ *  A deadline (the next release) is missed when a task finishes after it,
+ *  or when it is released again before it could run; in the second case
+ *  the older release is dropped. The execution time of each run is
+ *  measured with the clock given to sched_init(): sched_perf_clock() reads
+ *  the global time of the performance counter, sched_timestamp_clock() the
+ *  HAL timestamp timer; SCHED_DEFAULT_CLOCK is the first one the system has
+ *  (NULL: no execution time) and sched_start_clock() starts it. The host
+ *  test (host/sched_sim.c) uses a simulated clock and tick source.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "system.h"
+
+#define SCHED_MAX_TASKS     8
+#define SCHED_RATE_MONOTONIC (-1)   // priority given by the period
+#define SCHED_FIXED_PRIORITIES 16   // 0..15, above every rate monotonic task
+
+typedef unsigned long long sched_time_t;
+
+typedef void (*sched_task_func)(void *context);
+
+typedef sched_time_t (*sched_clock_func)(void);
+
+// task structure
+typedef struct _SCHEDtask{
+	const char *name;
+	sched_task_func run;
+	void *context;
+	unsigned int period;        // ticks
+	unsigned int priority;      // 0 is the highest
+	unsigned int release;       // tick of the next release
+	unsigned int deadline;      // tick the pending run has to finish
+	bool pending;
+	// statistics
+	unsigned int runs;
+	unsigned int misses;
+	unsigned int max_latency;   // ticks from release to start
+	sched_time_t exec_total;    // clock units
+	sched_time_t exec_max;
+}SCHEDtask;
+
+// scheduler structure
+typedef struct _SCHEDscheduler{
+	volatile unsigned int ticks;  // written by the timer ISR only
+	unsigned int count;
+	sched_clock_func clock;
+	SCHEDtask task[SCHED_MAX_TASKS];
+}SCHEDscheduler;
+
+void sched_init(SCHEDscheduler *sched, sched_clock_func clock);
+
+int sched_add(SCHEDscheduler *sched, const char *name, sched_task_func run,
+		void *context, unsigned int period, unsigned int phase, int priority);
+
+void sched_tick(SCHEDscheduler *sched);
+
+bool sched_run(SCHEDscheduler *sched);
+
+void sched_reset_stats(SCHEDscheduler *sched);
+
+void sched_report(SCHEDscheduler *sched);
+
+void sched_start_clock(void);
+
+#ifdef PERFORMANCE_COUNTER_0_BASE
+sched_time_t sched_perf_clock(void);
+#define SCHED_DEFAULT_CLOCK sched_perf_clock
+#elif defined(ALT_TIMESTAMP_CLK)
+sched_time_t sched_timestamp_clock(void);
+#define SCHED_DEFAULT_CLOCK sched_timestamp_clock
+#else
+#define SCHED_DEFAULT_CLOCK NULL
+#endif
+
+#endif /* SCHEDULER_H_ */
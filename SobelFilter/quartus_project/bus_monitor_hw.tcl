@@ -0,0 +1,442 @@
+# TCL File Generated by Component Editor 15.0
+# Mon Oct 19 10:12:45 CEST 2026
+# DO NOT MODIFY
+
+
+# 
+# bus_monitor "bus_monitor" v1.0
+#  2026.10.19.10:12:45
+# 
+# 
+
+# 
+# request TCL package from ACDS 15.0
+# 
+package require -exact qsys 14.0
+
+
+# 
+# module bus_monitor
+# 
+set_module_property DESCRIPTION ""
+set_module_property NAME bus_monitor
+set_module_property VERSION 1.0
+set_module_property INTERNAL false
+set_module_property OPAQUE_ADDRESS_MAP false
+set_module_property AUTHOR ""
+set_module_property DISPLAY_NAME bus_monitor
+set_module_property INSTANTIATE_IN_SYSTEM_MODULE true
+set_module_property EDITABLE true
+set_module_property REPORT_TO_TALKBACK false
+set_module_property ALLOW_GREYBOX_GENERATION false
+set_module_property REPORT_HIERARCHY false
+
+
+# 
+# file sets
+# 
+add_fileset QUARTUS_SYNTH QUARTUS_SYNTH "" ""
+set_fileset_property QUARTUS_SYNTH TOP_LEVEL bus_monitor
+set_fileset_property QUARTUS_SYNTH ENABLE_RELATIVE_INCLUDE_PATHS false
+set_fileset_property QUARTUS_SYNTH ENABLE_FILE_OVERWRITE_MODE false
+add_fileset_file bus_monitor_entity.vhdl VHDL PATH ../vhdl_modules/bus_monitor/bus_monitor_entity.vhdl TOP_LEVEL_FILE
+add_fileset_file bus_monitor_behavior.vhdl VHDL PATH ../vhdl_modules/bus_monitor/bus_monitor_behavior.vhdl
+add_fileset_file bus_monitor_channel_entity.vhdl VHDL PATH ../vhdl_modules/bus_monitor/bus_monitor_channel_entity.vhdl
+add_fileset_file bus_monitor_channel_behavior.vhdl VHDL PATH ../vhdl_modules/bus_monitor/bus_monitor_channel_behavior.vhdl
+
+
+# 
+# parameters
+# 
+
+
+# 
+# display items
+# 
+
+
+# 
+# connection point reset
+# 
+add_interface reset reset end
+set_interface_property reset associatedClock clock
+set_interface_property reset synchronousEdges DEASSERT
+set_interface_property reset ENABLED true
+set_interface_property reset EXPORT_OF ""
+set_interface_property reset PORT_NAME_MAP ""
+set_interface_property reset CMSIS_SVD_VARIABLES ""
+set_interface_property reset SVD_ADDRESS_GROUP ""
+
+add_interface_port reset Reset reset Input 1
+
+
+# 
+# connection point clock
+# 
+add_interface clock clock end
+set_interface_property clock clockRate 0
+set_interface_property clock ENABLED true
+set_interface_property clock EXPORT_OF ""
+set_interface_property clock PORT_NAME_MAP ""
+set_interface_property clock CMSIS_SVD_VARIABLES ""
+set_interface_property clock SVD_ADDRESS_GROUP ""
+
+add_interface_port clock Clock clk Input 1
+
+
+# 
+# connection point slave
+# 
+add_interface slave avalon end
+set_interface_property slave addressUnits WORDS
+set_interface_property slave associatedClock clock
+set_interface_property slave associatedReset reset
+set_interface_property slave bitsPerSymbol 8
+set_interface_property slave burstOnBurstBoundariesOnly false
+set_interface_property slave burstcountUnits WORDS
+set_interface_property slave explicitAddressSpan 0
+set_interface_property slave holdTime 0
+set_interface_property slave linewrapBursts false
+set_interface_property slave maximumPendingReadTransactions 0
+set_interface_property slave maximumPendingWriteTransactions 0
+set_interface_property slave readLatency 0
+set_interface_property slave readWaitTime 1
+set_interface_property slave setupTime 0
+set_interface_property slave timingUnits Cycles
+set_interface_property slave writeWaitTime 0
+set_interface_property slave ENABLED true
+set_interface_property slave EXPORT_OF ""
+set_interface_property slave PORT_NAME_MAP ""
+set_interface_property slave CMSIS_SVD_VARIABLES ""
+set_interface_property slave SVD_ADDRESS_GROUP ""
+
+add_interface_port slave slave_address address Input 5
+add_interface_port slave slave_cs chipselect Input 1
+add_interface_port slave slave_we write Input 1
+add_interface_port slave slave_rd read Input 1
+add_interface_port slave slave_write_data writedata Input 32
+add_interface_port slave slave_read_data readdata Output 32
+set_interface_assignment slave embeddedsw.configuration.isFlash 0
+set_interface_assignment slave embeddedsw.configuration.isMemoryDevice 0
+set_interface_assignment slave embeddedsw.configuration.isNonVolatileStorage 0
+set_interface_assignment slave embeddedsw.configuration.isPrintableDevice 0
+
+
+# 
+# connection point s0 (cam_dma), passed through to m0
+# 
+add_interface s0 avalon end
+set_interface_property s0 addressUnits SYMBOLS
+set_interface_property s0 associatedClock clock
+set_interface_property s0 associatedReset reset
+set_interface_property s0 bitsPerSymbol 8
+set_interface_property s0 bridgesToMaster m0
+set_interface_property s0 burstOnBurstBoundariesOnly false
+set_interface_property s0 burstcountUnits WORDS
+set_interface_property s0 explicitAddressSpan 0
+set_interface_property s0 holdTime 0
+set_interface_property s0 linewrapBursts false
+set_interface_property s0 maximumPendingReadTransactions 16
+set_interface_property s0 maximumPendingWriteTransactions 0
+set_interface_property s0 readLatency 0
+set_interface_property s0 readWaitTime 1
+set_interface_property s0 setupTime 0
+set_interface_property s0 timingUnits Cycles
+set_interface_property s0 writeWaitTime 0
+set_interface_property s0 ENABLED true
+set_interface_property s0 EXPORT_OF ""
+set_interface_property s0 PORT_NAME_MAP ""
+set_interface_property s0 CMSIS_SVD_VARIABLES ""
+set_interface_property s0 SVD_ADDRESS_GROUP ""
+
+add_interface_port s0 s0_address address Input 24
+add_interface_port s0 s0_read read Input 1
+add_interface_port s0 s0_write write Input 1
+add_interface_port s0 s0_write_data writedata Input 32
+add_interface_port s0 s0_byte_enable byteenable Input 4
+add_interface_port s0 s0_burst_count burstcount Input 10
+add_interface_port s0 s0_read_data readdata Output 32
+add_interface_port s0 s0_read_data_valid readdatavalid Output 1
+add_interface_port s0 s0_wait_request waitrequest Output 1
+set_interface_assignment s0 embeddedsw.configuration.isFlash 0
+set_interface_assignment s0 embeddedsw.configuration.isMemoryDevice 0
+set_interface_assignment s0 embeddedsw.configuration.isNonVolatileStorage 0
+set_interface_assignment s0 embeddedsw.configuration.isPrintableDevice 0
+
+
+# 
+# connection point m0
+# 
+add_interface m0 avalon start
+set_interface_property m0 addressUnits SYMBOLS
+set_interface_property m0 associatedClock clock
+set_interface_property m0 associatedReset reset
+set_interface_property m0 bitsPerSymbol 8
+set_interface_property m0 burstOnBurstBoundariesOnly false
+set_interface_property m0 burstcountUnits WORDS
+set_interface_property m0 doStreamReads false
+set_interface_property m0 doStreamWrites false
+set_interface_property m0 holdTime 0
+set_interface_property m0 linewrapBursts false
+set_interface_property m0 maximumPendingReadTransactions 0
+set_interface_property m0 maximumPendingWriteTransactions 0
+set_interface_property m0 readLatency 0
+set_interface_property m0 readWaitTime 1
+set_interface_property m0 setupTime 0
+set_interface_property m0 timingUnits Cycles
+set_interface_property m0 writeWaitTime 0
+set_interface_property m0 ENABLED true
+set_interface_property m0 EXPORT_OF ""
+set_interface_property m0 PORT_NAME_MAP ""
+set_interface_property m0 CMSIS_SVD_VARIABLES ""
+set_interface_property m0 SVD_ADDRESS_GROUP ""
+
+add_interface_port m0 m0_address address Output 24
+add_interface_port m0 m0_read read Output 1
+add_interface_port m0 m0_write write Output 1
+add_interface_port m0 m0_write_data writedata Output 32
+add_interface_port m0 m0_byte_enable byteenable Output 4
+add_interface_port m0 m0_burst_count burstcount Output 10
+add_interface_port m0 m0_read_data readdata Input 32
+add_interface_port m0 m0_read_data_valid readdatavalid Input 1
+add_interface_port m0 m0_wait_request waitrequest Input 1
+
+
+# 
+# connection point s1 (lcd_dma), passed through to m1
+# 
+add_interface s1 avalon end
+set_interface_property s1 addressUnits SYMBOLS
+set_interface_property s1 associatedClock clock
+set_interface_property s1 associatedReset reset
+set_interface_property s1 bitsPerSymbol 8
+set_interface_property s1 bridgesToMaster m1
+set_interface_property s1 burstOnBurstBoundariesOnly false
+set_interface_property s1 burstcountUnits WORDS
+set_interface_property s1 explicitAddressSpan 0
+set_interface_property s1 holdTime 0
+set_interface_property s1 linewrapBursts false
+set_interface_property s1 maximumPendingReadTransactions 16
+set_interface_property s1 maximumPendingWriteTransactions 0
+set_interface_property s1 readLatency 0
+set_interface_property s1 readWaitTime 1
+set_interface_property s1 setupTime 0
+set_interface_property s1 timingUnits Cycles
+set_interface_property s1 writeWaitTime 0
+set_interface_property s1 ENABLED true
+set_interface_property s1 EXPORT_OF ""
+set_interface_property s1 PORT_NAME_MAP ""
+set_interface_property s1 CMSIS_SVD_VARIABLES ""
+set_interface_property s1 SVD_ADDRESS_GROUP ""
+
+add_interface_port s1 s1_address address Input 24
+add_interface_port s1 s1_read read Input 1
+add_interface_port s1 s1_write write Input 1
+add_interface_port s1 s1_write_data writedata Input 32
+add_interface_port s1 s1_byte_enable byteenable Input 4
+add_interface_port s1 s1_burst_count burstcount Input 10
+add_interface_port s1 s1_read_data readdata Output 32
+add_interface_port s1 s1_read_data_valid readdatavalid Output 1
+add_interface_port s1 s1_wait_request waitrequest Output 1
+set_interface_assignment s1 embeddedsw.configuration.isFlash 0
+set_interface_assignment s1 embeddedsw.configuration.isMemoryDevice 0
+set_interface_assignment s1 embeddedsw.configuration.isNonVolatileStorage 0
+set_interface_assignment s1 embeddedsw.configuration.isPrintableDevice 0
+
+
+# 
+# connection point m1
+# 
+add_interface m1 avalon start
+set_interface_property m1 addressUnits SYMBOLS
+set_interface_property m1 associatedClock clock
+set_interface_property m1 associatedReset reset
+set_interface_property m1 bitsPerSymbol 8
+set_interface_property m1 burstOnBurstBoundariesOnly false
+set_interface_property m1 burstcountUnits WORDS
+set_interface_property m1 doStreamReads false
+set_interface_property m1 doStreamWrites false
+set_interface_property m1 holdTime 0
+set_interface_property m1 linewrapBursts false
+set_interface_property m1 maximumPendingReadTransactions 0
+set_interface_property m1 maximumPendingWriteTransactions 0
+set_interface_property m1 readLatency 0
+set_interface_property m1 readWaitTime 1
+set_interface_property m1 setupTime 0
+set_interface_property m1 timingUnits Cycles
+set_interface_property m1 writeWaitTime 0
+set_interface_property m1 ENABLED true
+set_interface_property m1 EXPORT_OF ""
+set_interface_property m1 PORT_NAME_MAP ""
+set_interface_property m1 CMSIS_SVD_VARIABLES ""
+set_interface_property m1 SVD_ADDRESS_GROUP ""
+
+add_interface_port m1 m1_address address Output 24
+add_interface_port m1 m1_read read Output 1
+add_interface_port m1 m1_write write Output 1
+add_interface_port m1 m1_write_data writedata Output 32
+add_interface_port m1 m1_byte_enable byteenable Output 4
+add_interface_port m1 m1_burst_count burstcount Output 10
+add_interface_port m1 m1_read_data readdata Input 32
+add_interface_port m1 m1_read_data_valid readdatavalid Input 1
+add_interface_port m1 m1_wait_request waitrequest Input 1
+
+
+# 
+# connection point s2 (vga_dma), passed through to m2
+# 
+add_interface s2 avalon end
+set_interface_property s2 addressUnits SYMBOLS
+set_interface_property s2 associatedClock clock
+set_interface_property s2 associatedReset reset
+set_interface_property s2 bitsPerSymbol 8
+set_interface_property s2 bridgesToMaster m2
+set_interface_property s2 burstOnBurstBoundariesOnly false
+set_interface_property s2 burstcountUnits WORDS
+set_interface_property s2 explicitAddressSpan 0
+set_interface_property s2 holdTime 0
+set_interface_property s2 linewrapBursts false
+set_interface_property s2 maximumPendingReadTransactions 16
+set_interface_property s2 maximumPendingWriteTransactions 0
+set_interface_property s2 readLatency 0
+set_interface_property s2 readWaitTime 1
+set_interface_property s2 setupTime 0
+set_interface_property s2 timingUnits Cycles
+set_interface_property s2 writeWaitTime 0
+set_interface_property s2 ENABLED true
+set_interface_property s2 EXPORT_OF ""
+set_interface_property s2 PORT_NAME_MAP ""
+set_interface_property s2 CMSIS_SVD_VARIABLES ""
+set_interface_property s2 SVD_ADDRESS_GROUP ""
+
+add_interface_port s2 s2_address address Input 24
+add_interface_port s2 s2_read read Input 1
+add_interface_port s2 s2_write write Input 1
+add_interface_port s2 s2_write_data writedata Input 32
+add_interface_port s2 s2_byte_enable byteenable Input 4
+add_interface_port s2 s2_burst_count burstcount Input 10
+add_interface_port s2 s2_read_data readdata Output 32
+add_interface_port s2 s2_read_data_valid readdatavalid Output 1
+add_interface_port s2 s2_wait_request waitrequest Output 1
+set_interface_assignment s2 embeddedsw.configuration.isFlash 0
+set_interface_assignment s2 embeddedsw.configuration.isMemoryDevice 0
+set_interface_assignment s2 embeddedsw.configuration.isNonVolatileStorage 0
+set_interface_assignment s2 embeddedsw.configuration.isPrintableDevice 0
+
+
+# 
+# connection point m2
+# 
+add_interface m2 avalon start
+set_interface_property m2 addressUnits SYMBOLS
+set_interface_property m2 associatedClock clock
+set_interface_property m2 associatedReset reset
+set_interface_property m2 bitsPerSymbol 8
+set_interface_property m2 burstOnBurstBoundariesOnly false
+set_interface_property m2 burstcountUnits WORDS
+set_interface_property m2 doStreamReads false
+set_interface_property m2 doStreamWrites false
+set_interface_property m2 holdTime 0
+set_interface_property m2 linewrapBursts false
+set_interface_property m2 maximumPendingReadTransactions 0
+set_interface_property m2 maximumPendingWriteTransactions 0
+set_interface_property m2 readLatency 0
+set_interface_property m2 readWaitTime 1
+set_interface_property m2 setupTime 0
+set_interface_property m2 timingUnits Cycles
+set_interface_property m2 writeWaitTime 0
+set_interface_property m2 ENABLED true
+set_interface_property m2 EXPORT_OF ""
+set_interface_property m2 PORT_NAME_MAP ""
+set_interface_property m2 CMSIS_SVD_VARIABLES ""
+set_interface_property m2 SVD_ADDRESS_GROUP ""
+
+add_interface_port m2 m2_address address Output 24
+add_interface_port m2 m2_read read Output 1
+add_interface_port m2 m2_write write Output 1
+add_interface_port m2 m2_write_data writedata Output 32
+add_interface_port m2 m2_byte_enable byteenable Output 4
+add_interface_port m2 m2_burst_count burstcount Output 10
+add_interface_port m2 m2_read_data readdata Input 32
+add_interface_port m2 m2_read_data_valid readdatavalid Input 1
+add_interface_port m2 m2_wait_request waitrequest Input 1
+
+
+# 
+# connection point s3 (cpu), passed through to m3
+# 
+add_interface s3 avalon end
+set_interface_property s3 addressUnits SYMBOLS
+set_interface_property s3 associatedClock clock
+set_interface_property s3 associatedReset reset
+set_interface_property s3 bitsPerSymbol 8
+set_interface_property s3 bridgesToMaster m3
+set_interface_property s3 burstOnBurstBoundariesOnly false
+set_interface_property s3 burstcountUnits WORDS
+set_interface_property s3 explicitAddressSpan 0
+set_interface_property s3 holdTime 0
+set_interface_property s3 linewrapBursts false
+set_interface_property s3 maximumPendingReadTransactions 16
+set_interface_property s3 maximumPendingWriteTransactions 0
+set_interface_property s3 readLatency 0
+set_interface_property s3 readWaitTime 1
+set_interface_property s3 setupTime 0
+set_interface_property s3 timingUnits Cycles
+set_interface_property s3 writeWaitTime 0
+set_interface_property s3 ENABLED true
+set_interface_property s3 EXPORT_OF ""
+set_interface_property s3 PORT_NAME_MAP ""
+set_interface_property s3 CMSIS_SVD_VARIABLES ""
+set_interface_property s3 SVD_ADDRESS_GROUP ""
+
+add_interface_port s3 s3_address address Input 24
+add_interface_port s3 s3_read read Input 1
+add_interface_port s3 s3_write write Input 1
+add_interface_port s3 s3_write_data writedata Input 32
+add_interface_port s3 s3_byte_enable byteenable Input 4
+add_interface_port s3 s3_burst_count burstcount Input 10
+add_interface_port s3 s3_read_data readdata Output 32
+add_interface_port s3 s3_read_data_valid readdatavalid Output 1
+add_interface_port s3 s3_wait_request waitrequest Output 1
+set_interface_assignment s3 embeddedsw.configuration.isFlash 0
+set_interface_assignment s3 embeddedsw.configuration.isMemoryDevice 0
+set_interface_assignment s3 embeddedsw.configuration.isNonVolatileStorage 0
+set_interface_assignment s3 embeddedsw.configuration.isPrintableDevice 0
+
+
+# 
+# connection point m3
+# 
+add_interface m3 avalon start
+set_interface_property m3 addressUnits SYMBOLS
+set_interface_property m3 associatedClock clock
+set_interface_property m3 associatedReset reset
+set_interface_property m3 bitsPerSymbol 8
+set_interface_property m3 burstOnBurstBoundariesOnly false
+set_interface_property m3 burstcountUnits WORDS
+set_interface_property m3 doStreamReads false
+set_interface_property m3 doStreamWrites false
+set_interface_property m3 holdTime 0
+set_interface_property m3 linewrapBursts false
+set_interface_property m3 maximumPendingReadTransactions 0
+set_interface_property m3 maximumPendingWriteTransactions 0
+set_interface_property m3 readLatency 0
+set_interface_property m3 readWaitTime 1
+set_interface_property m3 setupTime 0
+set_interface_property m3 timingUnits Cycles
+set_interface_property m3 writeWaitTime 0
+set_interface_property m3 ENABLED true
+set_interface_property m3 EXPORT_OF ""
+set_interface_property m3 PORT_NAME_MAP ""
+set_interface_property m3 CMSIS_SVD_VARIABLES ""
+set_interface_property m3 SVD_ADDRESS_GROUP ""
+
+add_interface_port m3 m3_address address Output 24
+add_interface_port m3 m3_read read Output 1
+add_interface_port m3 m3_write write Output 1
+add_interface_port m3 m3_write_data writedata Output 32
+add_interface_port m3 m3_byte_enable byteenable Output 4
+add_interface_port m3 m3_burst_count burstcount Output 10
+add_interface_port m3 m3_read_data readdata Input 32
+add_interface_port m3 m3_read_data_valid readdatavalid Input 1
+add_interface_port m3 m3_wait_request waitrequest Input 1
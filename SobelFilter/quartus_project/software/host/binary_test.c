@@ -0,0 +1,156 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file binary_test.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Unit tests of the packing kernels: binary_pack/binary_unpack round trips
+ * with the padding bits of the last word of each line, and
+ * sobel_ctx_threshold_packed against the byte picture of
+ * sobel_ctx_threshold. The widths around a word boundary are covered;
+ * the pictures are random, so each width is run with several seeds.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "binary.h"
+#include "sobel.h"
+
+#define TEST_HEIGHT 7
+#define TEST_SEEDS 20
+
+unsigned int errors = 0;
+
+const int test_widths[] = {1,31,32,33,40,320};
+
+void test_check(int condition,
+		        const char *test,
+		        int width,
+		        const char *what) {
+	if (!condition) {
+		printf("error: %s, width %d: %s\n",test,width,what);
+		errors++;
+	}
+}
+
+/* Random pixels, about one of density set */
+void random_picture(unsigned char *picture,
+		            int pixels,
+		            int density,
+		            unsigned int *seed) {
+	int index;
+	for (index = 0 ; index < pixels ; index++) {
+		*seed = *seed*1103515245+12345;
+		picture[index] = (((*seed>>16)%density) == 0) ? 0xFF : 0;
+	}
+}
+
+void test_pack(int width,
+		       unsigned int seed) {
+	int words = BINARY_WORDS_EACH_LINE(width);
+	int pixels = width*TEST_HEIGHT;
+	unsigned char *source = (unsigned char *)malloc(pixels);
+	unsigned char *unpacked = (unsigned char *)malloc(pixels);
+	unsigned int *packed = (unsigned int *)malloc(words*TEST_HEIGHT*4);
+	unsigned int padding = ((width&31) == 0) ? 0 : ~0u<<(width&31);
+	int x,y,ok;
+	random_picture(source,pixels,2,&seed);
+	/* any non zero byte is a set pixel */
+	source[0] = 0x01;
+	memset(packed,0xA5,words*TEST_HEIGHT*4);
+	binary_pack(source,packed,width,TEST_HEIGHT);
+	ok = 1;
+	for (y = 0 ; y < TEST_HEIGHT ; y++)
+		for (x = 0 ; x < width ; x++)
+			if (BINARY_PIXEL(packed,words,x,y) != (source[y*width+x] != 0))
+				ok = 0;
+	test_check(ok,"pack",width,"pixel");
+	ok = 1;
+	for (y = 0 ; y < TEST_HEIGHT ; y++)
+		if ((packed[y*words+words-1]&padding) != 0)
+			ok = 0;
+	test_check(ok,"pack",width,"padding bits not cleared");
+	memset(unpacked,0x5A,pixels);
+	binary_unpack(packed,unpacked,width,TEST_HEIGHT);
+	source[0] = 0xFF;
+	test_check(memcmp(source,unpacked,pixels) == 0,"unpack",width,
+			   "round trip");
+	free(source);
+	free(unpacked);
+	free(packed);
+}
+
+void test_threshold(int width,
+		            int height,
+		            unsigned int seed) {
+	int words = BINARY_WORDS_EACH_LINE(width);
+	int pixels = width*height;
+	unsigned char *gray = (unsigned char *)malloc(pixels);
+	unsigned char *result = (unsigned char *)calloc(pixels,1);
+	unsigned char *unpacked = (unsigned char *)malloc(pixels);
+	unsigned int *packed = (unsigned int *)malloc(words*height*4);
+	sobel_ctx_t ctx;
+	int index;
+	sobel_ctx_init(&ctx,width,height,
+			       (short *)calloc(pixels,sizeof(short)),
+			       (short *)calloc(pixels,sizeof(short)),
+			       NULL,NULL,result);
+	for (index = 0 ; index < pixels ; index++) {
+		seed = seed*1103515245+12345;
+		gray[index] = seed>>16;
+	}
+	sobel_ctx_x(&ctx,gray);
+	sobel_ctx_y(&ctx,gray);
+	/* the byte picture leaves the border, the packed one clears it */
+	sobel_ctx_threshold(&ctx,128);
+	memset(packed,0xA5,words*height*4);
+	sobel_ctx_threshold_packed(&ctx,128,packed);
+	binary_unpack(packed,unpacked,width,height);
+	test_check(memcmp(result,unpacked,pixels) == 0,"threshold_packed",width,
+			   "differs from sobel_ctx_threshold");
+	free(ctx.x_result);
+	free(ctx.y_result);
+	free(gray);
+	free(result);
+	free(unpacked);
+	free(packed);
+}
+
+int main(void) {
+	unsigned int index,seed;
+	int width;
+	for (index = 0 ; index < sizeof(test_widths)/sizeof(test_widths[0]) ;
+		 index++) {
+		width = test_widths[index];
+		for (seed = 1 ; seed <= TEST_SEEDS ; seed++) {
+			test_pack(width,seed);
+			test_threshold(width,TEST_HEIGHT,seed);
+			test_threshold(width,1,seed);
+			test_threshold(width,240,seed);
+		}
+	}
+	printf("binary_test: %u error(s)\n",errors);
+	return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,147 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file frame_queue_model.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Host model of the frame hand over of the dual core system (dual_core.h),
+ * built with the frame_queue.c of the sobel application. Two threads take
+ * the role of the cores: core 0 queues jobs with a numbered source frame,
+ * core 1 "filters" (inverts) the frame into the destination and queues the
+ * job back, core 0 checks the order and the pixels. As on the target, at
+ * most DUAL_JOBS jobs are in flight and a job is reused as soon as it is
+ * back. Both threads spin on the queues, sched_yield() at random points
+ * shuffles the interleaving.
+ *
+ *   frame_queue_model [frames]
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include "frame_queue.h"
+
+#define DUAL_JOBS 2
+#define FRAME_PIXELS 1024
+
+typedef struct model_job {
+	unsigned int frame;
+	unsigned int *source;
+	unsigned int *destination;
+} model_job_t;
+
+frame_queue_t to_compute;
+frame_queue_t to_display;
+model_job_t job[DUAL_JOBS];
+unsigned int buffer[2*DUAL_JOBS][FRAME_PIXELS];
+unsigned int frames = 1000000;
+
+/* a yield about every 64 calls, different for each thread */
+void model_shuffle(unsigned int *seed) {
+	if ((rand_r(seed)&63) == 0)
+		sched_yield();
+}
+
+void *model_core1(void *argument) {
+	unsigned int seed = 2;
+	unsigned int done = 0;
+	model_job_t *current;
+	int loop;
+	while (done < frames) {
+		current = (model_job_t *)frame_queue_get(&to_compute);
+		if (current == NULL) {
+			model_shuffle(&seed);
+			continue;
+		}
+		for (loop = 0 ; loop < FRAME_PIXELS ; loop++)
+			current->destination[loop] = ~current->source[loop];
+		model_shuffle(&seed);
+		if (frame_queue_put(&to_display,current) == 0) {
+			printf("core 1: to_display full\n");
+			exit(1);
+		}
+		done++;
+	}
+	return NULL;
+}
+
+int main(int argc, char **argv) {
+	pthread_t core1;
+	model_job_t *current;
+	unsigned int seed = 1;
+	unsigned int next_job = 0;
+	unsigned int in_flight = 0;
+	unsigned int queued = 0;
+	unsigned int expected = 0;
+	unsigned int errors = 0;
+	struct timespec start, stop;
+	double seconds;
+	int loop;
+	if (argc > 1)
+		frames = strtoul(argv[1],NULL,0);
+	frame_queue_init(&to_compute);
+	frame_queue_init(&to_display);
+	for (loop = 0 ; loop < DUAL_JOBS ; loop++) {
+		job[loop].source = buffer[2*loop];
+		job[loop].destination = buffer[2*loop+1];
+	}
+	clock_gettime(CLOCK_MONOTONIC,&start);
+	pthread_create(&core1,NULL,model_core1,NULL);
+	while (expected < frames) {
+		while ((current = (model_job_t *)frame_queue_get(&to_display)) != NULL) {
+			if (current->frame != expected)
+				errors++;
+			for (loop = 0 ; loop < FRAME_PIXELS ; loop++)
+				if (current->destination[loop] != ~(current->frame+loop))
+					errors++;
+			expected++;
+			in_flight--;
+		}
+		if (in_flight == DUAL_JOBS || queued == frames) {
+			model_shuffle(&seed);
+			continue;
+		}
+		current = &job[next_job++%DUAL_JOBS];
+		current->frame = queued;
+		for (loop = 0 ; loop < FRAME_PIXELS ; loop++)
+			current->source[loop] = queued+loop;
+		memset(current->destination,0,FRAME_PIXELS*sizeof(unsigned int));
+		if (frame_queue_put(&to_compute,current) == 0) {
+			printf("core 0: to_compute full\n");
+			return 1;
+		}
+		queued++;
+		in_flight++;
+		model_shuffle(&seed);
+	}
+	pthread_join(core1,NULL);
+	clock_gettime(CLOCK_MONOTONIC,&stop);
+	seconds = (stop.tv_sec-start.tv_sec)+(stop.tv_nsec-start.tv_nsec)*1e-9;
+	printf("frame_queue_model: %u frames, %.0f frames/s, %u error(s)\n",
+		   frames,frames/seconds,errors);
+	return (errors == 0) ? 0 : 1;
+}
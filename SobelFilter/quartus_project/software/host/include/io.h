@@ -0,0 +1,47 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file io.h
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Host stand-in of the HAL io.h. The sobel sources only use the DIRECT
+ * accesses on memory buffers, which are plain loads and stores on the host.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef HOST_IO_H_
+#define HOST_IO_H_
+
+#include <stdint.h>
+
+#define IORD_8DIRECT(base,offset) (*(uint8_t *)((uintptr_t)(base)+(offset)))
+#define IORD_16DIRECT(base,offset) (*(uint16_t *)((uintptr_t)(base)+(offset)))
+#define IORD_32DIRECT(base,offset) (*(uint32_t *)((uintptr_t)(base)+(offset)))
+#define IOWR_8DIRECT(base,offset,data) \
+	(*(uint8_t *)((uintptr_t)(base)+(offset)) = (data))
+#define IOWR_16DIRECT(base,offset,data) \
+	(*(uint16_t *)((uintptr_t)(base)+(offset)) = (data))
+#define IOWR_32DIRECT(base,offset,data) \
+	(*(uint32_t *)((uintptr_t)(base)+(offset)) = (data))
+
+#endif /* HOST_IO_H_ */
@@ -0,0 +1,35 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file system.h
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Host stand-in of the system.h of the BSP: no peripherals and no tightly
+ * coupled memories (see tcm.h).
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef HOST_SYSTEM_H_
+#define HOST_SYSTEM_H_
+
+#endif /* HOST_SYSTEM_H_ */
@@ -0,0 +1,216 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file integral_bench.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Checks integral_box_blur and integral_adaptive_threshold against a naive
+ * box filter that adds up the (2*radius+1)^2 pixels of each box, and
+ * measures both on the host for the radii 1 to 15:
+ *
+ *   integral_bench [-w width] [-h height] [-r runs]
+ *
+ * The naive mean is taken with the same 16 bit reciprocal as the blur,
+ * so the results must be bit exact; the reciprocal itself may be off by
+ * one from the rounded division. The integral time includes the table.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "integral.h"
+
+#define MAX_RADIUS 15
+#define THRESHOLD_PERCENT 15
+
+unsigned int errors = 0;
+
+/* the box sum of each pixel with a complete box, -1 on the border */
+void naive_box_sums(unsigned char *source,
+		            int *sums,
+		            int width,
+		            int height,
+		            int radius) {
+	int x,y,dx,dy,sum;
+	for (y = 0 ; y < height ; y++) {
+		for (x = 0 ; x < width ; x++) {
+			if (x < radius || x >= width-radius ||
+				y < radius || y >= height-radius) {
+				sums[y*width+x] = -1;
+				continue;
+			}
+			sum = 0;
+			for (dy = -radius ; dy <= radius ; dy++)
+				for (dx = -radius ; dx <= radius ; dx++)
+					sum += source[(y+dy)*width+x+dx];
+			sums[y*width+x] = sum;
+		}
+	}
+}
+
+void naive_box_blur(unsigned char *source,
+		            unsigned char *destination,
+		            int *sums,
+		            int width,
+		            int height,
+		            int radius) {
+	int size = 2*radius+1;
+	unsigned int reciprocal = (65536+(size*size)/2)/(size*size);
+	int index;
+	naive_box_sums(source,sums,width,height,radius);
+	for (index = 0 ; index < width*height ; index++)
+		destination[index] = (sums[index] < 0) ? source[index] :
+				             (sums[index]*reciprocal+32768)>>16;
+}
+
+void naive_adaptive_threshold(unsigned char *source,
+		                      unsigned char *destination,
+		                      int *sums,
+		                      int width,
+		                      int height,
+		                      int radius,
+		                      int percent) {
+	int size = 2*radius+1;
+	int index;
+	naive_box_sums(source,sums,width,height,radius);
+	for (index = 0 ; index < width*height ; index++)
+		destination[index] = (sums[index] >= 0 &&
+				              source[index]*size*size*100 >
+		                      sums[index]*(100-percent)) ? 0xFF : 0;
+}
+
+/* A gradient with noise, like an unevenly lit camera picture */
+void test_picture(unsigned char *picture,
+		          int width,
+		          int height) {
+	unsigned int seed = 1;
+	int x,y,level;
+	for (y = 0 ; y < height ; y++) {
+		for (x = 0 ; x < width ; x++) {
+			seed = seed*1103515245+12345;
+			level = (x+y)*128/(width+height)+((seed>>16)&0x7F);
+			picture[y*width+x] = level;
+		}
+	}
+}
+
+void test_check(unsigned char *result,
+		        unsigned char *expected,
+		        int pixels,
+		        const char *what,
+		        int radius) {
+	if (memcmp(result,expected,pixels) != 0) {
+		printf("error: %s radius %d differs from the naive filter\n",what,
+			   radius);
+		errors++;
+	}
+}
+
+/* the reciprocal mean against the rounded division */
+void test_rounding(unsigned char *blur,
+		           int *sums,
+		           int pixels,
+		           int radius) {
+	int size = 2*radius+1;
+	int index,exact;
+	for (index = 0 ; index < pixels ; index++) {
+		if (sums[index] < 0)
+			continue;
+		exact = (sums[index]+(size*size)/2)/(size*size);
+		if (blur[index] < exact-1 || blur[index] > exact+1) {
+			printf("error: mean of radius %d is %d, expected %d\n",radius,
+				   blur[index],exact);
+			errors++;
+			return;
+		}
+	}
+}
+
+double bench_seconds(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC,&now);
+	return now.tv_sec+now.tv_nsec*1e-9;
+}
+
+int main(int argc, char **argv) {
+	int width = 320, height = 240, runs = 5;
+	int pixels,radius,run,arg;
+	unsigned char *picture,*result,*expected;
+	int *sums;
+	double start,integral_time,naive_time;
+	for (arg = 1 ; arg < argc ; arg++) {
+		if (strcmp(argv[arg],"-w") == 0 && arg+1 < argc)
+			width = atoi(argv[++arg]);
+		else if (strcmp(argv[arg],"-h") == 0 && arg+1 < argc)
+			height = atoi(argv[++arg]);
+		else if (strcmp(argv[arg],"-r") == 0 && arg+1 < argc)
+			runs = atoi(argv[++arg]);
+		else {
+			fprintf(stderr,"usage: %s [-w width] [-h height] [-r runs]\n",
+					argv[0]);
+			return 1;
+		}
+	}
+	if (width < 1 || height < 1 || runs < 1) {
+		fprintf(stderr,"%s: bad size or runs\n",argv[0]);
+		return 1;
+	}
+	pixels = width*height;
+	picture = (unsigned char *)malloc(pixels);
+	result = (unsigned char *)malloc(pixels);
+	expected = (unsigned char *)malloc(pixels);
+	sums = (int *)malloc(pixels*sizeof(int));
+	test_picture(picture,width,height);
+	init_integral_image(width,height);
+
+	printf("box blur of %dx%d, %d runs (ms each)\n",width,height,runs);
+	printf("radius  integral     naive\n");
+	for (radius = 1 ; radius <= MAX_RADIUS ; radius++) {
+		start = bench_seconds();
+		for (run = 0 ; run < runs ; run++) {
+			integral_image(picture);
+			integral_box_blur(radius,picture,result);
+		}
+		integral_time = (bench_seconds()-start)/runs;
+		start = bench_seconds();
+		for (run = 0 ; run < runs ; run++)
+			naive_box_blur(picture,expected,sums,width,height,radius);
+		naive_time = (bench_seconds()-start)/runs;
+		printf("%6d %9.3f %9.3f\n",radius,integral_time*1e3,naive_time*1e3);
+		test_check(result,expected,pixels,"box blur",radius);
+		test_rounding(result,sums,pixels,radius);
+
+		integral_adaptive_threshold(radius,THRESHOLD_PERCENT,picture,result);
+		naive_adaptive_threshold(picture,expected,sums,width,height,radius,
+				                 THRESHOLD_PERCENT);
+		test_check(result,expected,pixels,"adaptive threshold",radius);
+	}
+	free(picture);
+	free(result);
+	free(expected);
+	free(sums);
+	printf("integral_bench: %u error(s)\n",errors);
+	return (errors == 0) ? 0 : 1;
+}
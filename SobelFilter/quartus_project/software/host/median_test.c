@@ -0,0 +1,165 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file median_test.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Unit tests of median.c against a reference that sorts the 9 pixels of
+ * each window with qsort. The pictures are random, salt and pepper (a
+ * gray picture with 10% black and white pixels) and constant, at odd and
+ * even widths and heights, including the sizes below 3x3 that are kept
+ * unchanged. At the end the host time of a 320x240 frame is printed; the
+ * Nios cycles are reported by the sobel application (SW7).
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "median.h"
+
+#define BENCH_FRAMES 200
+
+enum {
+	TEST_RANDOM,
+	TEST_SALT_AND_PEPPER,
+	TEST_CONSTANT,
+	TEST_PICTURES
+};
+
+const char *test_names[TEST_PICTURES] = {"random","salt and pepper",
+                                         "constant"};
+
+const int test_sizes[][2] = {
+		{1,1},{2,5},{5,2},{3,3},{3,5},{5,3},{7,7},{9,4},{31,9},{33,13},
+		{63,3},{65,21},{319,11},{320,240},{321,241},{639,7},{640,5}};
+
+unsigned int errors = 0;
+
+unsigned int test_seed = 1;
+
+unsigned int test_random(void) {
+	test_seed = test_seed*1103515245+12345;
+	return test_seed>>16;
+}
+
+int compare_pixels(const void *a,
+		           const void *b) {
+	return *(const unsigned char *)a-*(const unsigned char *)b;
+}
+
+/* the median of each interior window, the border is kept */
+void reference(const unsigned char *source,
+		       unsigned char *result,
+		       int width,
+		       int height) {
+	unsigned char window[9];
+	int x,y,dx,dy;
+	memcpy(result,source,width*height);
+	if (width < 3)
+		return;
+	for (y = 1 ; y < (height-1) ; y++) {
+		for (x = 1 ; x < (width-1) ; x++) {
+			for (dy = -1 ; dy <= 1 ; dy++)
+				for (dx = -1 ; dx <= 1 ; dx++)
+					window[(dy+1)*3+dx+1] = source[(y+dy)*width+x+dx];
+			qsort(window,9,1,compare_pixels);
+			result[y*width+x] = window[4];
+		}
+	}
+}
+
+void test_picture_fill(unsigned char *picture,
+		               int pixels,
+		               int kind) {
+	int index;
+	unsigned int value = test_random()&0xFF;
+	for (index = 0 ; index < pixels ; index++) {
+		switch (kind) {
+		case TEST_RANDOM          : picture[index] = test_random();
+		                            break;
+		case TEST_SALT_AND_PEPPER : value = test_random()%20;
+		                            picture[index] = (value == 0) ? 0 :
+		                            		         (value == 1) ? 0xFF : 0x80;
+		                            break;
+		default                   : picture[index] = value;
+		                            break;
+		}
+	}
+}
+
+void test_picture(int width,
+		          int height,
+		          int kind) {
+	int pixels = width*height;
+	unsigned char *picture = (unsigned char *)malloc(pixels);
+	unsigned char *source = (unsigned char *)malloc(pixels);
+	unsigned char *expected = (unsigned char *)malloc(pixels);
+	test_picture_fill(source,pixels,kind);
+	reference(source,expected,width,height);
+	memcpy(picture,source,pixels);
+	init_median(width,height);
+	median_filter(picture);
+	if (memcmp(picture,expected,pixels) != 0) {
+		printf("error: %s picture of %dx%d differs\n",test_names[kind],
+			   width,height);
+		errors++;
+	}
+	free(picture);
+	free(source);
+	free(expected);
+}
+
+double bench_seconds(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC,&now);
+	return now.tv_sec+now.tv_nsec*1e-9;
+}
+
+/* host time only: the Nios cycles are in the SW7 report */
+void bench(void) {
+	unsigned char *picture = (unsigned char *)malloc(320*240);
+	double start;
+	int frame;
+	test_picture_fill(picture,320*240,TEST_RANDOM);
+	init_median(320,240);
+	start = bench_seconds();
+	for (frame = 0 ; frame < BENCH_FRAMES ; frame++)
+		median_filter(picture);
+	printf("host: median_filter() of 320x240 %.3f ms\n",
+		   (bench_seconds()-start)*1e3/BENCH_FRAMES);
+	free(picture);
+}
+
+int main(void) {
+	unsigned int index;
+	int kind;
+	for (index = 0 ; index < sizeof(test_sizes)/sizeof(test_sizes[0]) ;
+		 index++)
+		for (kind = 0 ; kind < TEST_PICTURES ; kind++)
+			test_picture(test_sizes[index][0],test_sizes[index][1],kind);
+	bench();
+	printf("median_test: %u error(s)\n",errors);
+	return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file morphology_test.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Unit tests of morphology.c against a naive reference on a byte each
+ * pixel: erode, dilate, open and close at radius 1 and 2, where the pixels
+ * outside the picture are left out of the minimum and the maximum. The
+ * pictures are 1 line and 1 word, odd widths, widths around the word
+ * boundaries and random sizes up to MORPHOLOGY_MAX_WIDTH, each with sparse
+ * and dense random pixels. The padding bits of the last word must stay
+ * cleared.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "morphology.h"
+
+#define RANDOM_CASES 500
+#define RANDOM_MAX_HEIGHT 12
+
+enum {
+	TEST_ERODE,
+	TEST_DILATE,
+	TEST_OPEN,
+	TEST_CLOSE,
+	TEST_OPERATIONS
+};
+
+const char *test_names[TEST_OPERATIONS] = {"erode","dilate","open","close"};
+
+const int test_sizes[][2] = {
+		{1,1},{5,1},{32,1},{1,5},{32,32},{3,3},{31,4},{33,7},{63,5},{65,9},
+		{97,3},{319,11},{320,240},{321,6},{639,5},{640,8}};
+
+unsigned int errors = 0;
+
+unsigned int cases = 0;
+
+unsigned int test_seed = 1;
+
+unsigned int test_random(void) {
+	test_seed = test_seed*1103515245+12345;
+	return test_seed>>16;
+}
+
+/* the minimum (erode) or maximum of the square, in place */
+void reference(unsigned char *picture,
+		       int width,
+		       int height,
+		       int radius,
+		       int erode) {
+	unsigned char *source = (unsigned char *)malloc(width*height);
+	int x,y,dx,dy,value;
+	memcpy(source,picture,width*height);
+	for (y = 0 ; y < height ; y++) {
+		for (x = 0 ; x < width ; x++) {
+			value = (erode != 0) ? 1 : 0;
+			for (dy = -radius ; dy <= radius ; dy++) {
+				for (dx = -radius ; dx <= radius ; dx++) {
+					if ((x+dx) < 0 || (x+dx) >= width ||
+						(y+dy) < 0 || (y+dy) >= height)
+						continue;
+					if (erode != 0)
+						value &= source[(y+dy)*width+x+dx];
+					else
+						value |= source[(y+dy)*width+x+dx];
+				}
+			}
+			picture[y*width+x] = value;
+		}
+	}
+	free(source);
+}
+
+void reference_operation(unsigned char *picture,
+		                 int width,
+		                 int height,
+		                 int radius,
+		                 int operation) {
+	switch (operation) {
+	case TEST_ERODE  : reference(picture,width,height,radius,1);
+	                   break;
+	case TEST_DILATE : reference(picture,width,height,radius,0);
+	                   break;
+	case TEST_OPEN   : reference(picture,width,height,radius,1);
+	                   reference(picture,width,height,radius,0);
+	                   break;
+	default          : reference(picture,width,height,radius,0);
+	                   reference(picture,width,height,radius,1);
+	                   break;
+	}
+}
+
+void morphology_operation(unsigned int *picture,
+		                  int radius,
+		                  int operation) {
+	switch (operation) {
+	case TEST_ERODE  : morphology_erode(picture,radius);
+	                   break;
+	case TEST_DILATE : morphology_dilate(picture,radius);
+	                   break;
+	case TEST_OPEN   : morphology_open(picture,radius);
+	                   break;
+	default          : morphology_close(picture,radius);
+	                   break;
+	}
+}
+
+/* all operations and radii on one random picture, one of density set */
+void test_picture(int width,
+		          int height,
+		          int density) {
+	int words = BINARY_WORDS_EACH_LINE(width);
+	int pixels = width*height;
+	unsigned char *source = (unsigned char *)malloc(pixels);
+	unsigned char *expected = (unsigned char *)malloc(pixels);
+	unsigned int *packed = (unsigned int *)malloc(words*height*4);
+	unsigned int padding = ((width&31) == 0) ? 0 : ~0u<<(width&31);
+	int index,x,y,radius,operation,ok;
+	for (index = 0 ; index < pixels ; index++)
+		source[index] = ((test_random()%density) != 0);
+	init_morphology(width,height);
+	for (radius = 1 ; radius <= MORPHOLOGY_MAX_RADIUS ; radius++) {
+		for (operation = 0 ; operation < TEST_OPERATIONS ; operation++) {
+			memcpy(expected,source,pixels);
+			reference_operation(expected,width,height,radius,operation);
+			binary_pack(source,packed,width,height);
+			morphology_operation(packed,radius,operation);
+			ok = 1;
+			for (y = 0 ; y < height ; y++) {
+				for (x = 0 ; x < width ; x++)
+					if (BINARY_PIXEL(packed,words,x,y) != expected[y*width+x])
+						ok = 0;
+				if ((packed[y*words+words-1]&padding) != 0)
+					ok = 0;
+			}
+			if (!ok) {
+				printf("error: %s radius %d of %dx%d differs\n",
+					   test_names[operation],radius,width,height);
+				errors++;
+			}
+			cases++;
+		}
+	}
+	free(source);
+	free(expected);
+	free(packed);
+}
+
+int main(void) {
+	unsigned int index;
+	int width,height;
+	for (index = 0 ; index < sizeof(test_sizes)/sizeof(test_sizes[0]) ;
+		 index++) {
+		test_picture(test_sizes[index][0],test_sizes[index][1],3);
+		test_picture(test_sizes[index][0],test_sizes[index][1],20);
+	}
+	for (index = 0 ; index < RANDOM_CASES ; index++) {
+		width = 1+test_random()%MORPHOLOGY_MAX_WIDTH;
+		height = 1+test_random()%RANDOM_MAX_HEIGHT;
+		test_picture(width,height,2+test_random()%20);
+	}
+	printf("morphology_test: %u cases, %u error(s)\n",cases,errors);
+	return (errors == 0) ? 0 : 1;
+}
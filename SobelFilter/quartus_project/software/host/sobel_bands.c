@@ -0,0 +1,232 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file sobel_bands.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Offline edge detection of recorded camera sequences on all cores of the
+ * host: conv_grayscale, sobel_x, sobel_y and sobel_threshold of the sobel
+ * application, each frame split into bands of lines that run on the work-
+ * stealing pool (thread_pool.h). A band converts its lines plus a one-line
+ * halo above and below into its own grayscale buffer, so the bands of a
+ * frame do not wait for each other; only the _lines kernels are used, which
+ * keep no global state. The first frame is checked against the global
+ * single-threaded functions.
+ *
+ * The frames are measured with 1 to max_threads workers (default: the online
+ * cores). The speedup is only a scaling figure up to the number of cores, the
+ * rows above it share the cores and are marked as such:
+ *
+ *   sobel_bands [-w width] [-h height] [-t threshold] [-b band_lines]
+ *               [-f frames] [-n max_threads] [sequence.raw]
+ *
+ * sequence.raw holds RGB565 frames of width x height (little endian, as
+ * written by the cam_dma); without a file a synthetic sequence is used.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include "grayscale.h"
+#include "sobel.h"
+#include "thread_pool.h"
+
+#define SYNTHETIC_FRAMES 8
+
+typedef struct band_frame {
+	unsigned short *rgb;
+	short *x_result;
+	short *y_result;
+	unsigned char *result;
+	int width;
+	int height;
+	short threshold;
+} band_frame_t;
+
+typedef struct band {
+	band_frame_t *frame;
+	int first;             // first line of the band
+	int last;              // one after the last line
+	unsigned char *gray;   // the lines of the band and the halo
+} band_t;
+
+void band_filter(void *argument) {
+	band_t *band = (band_t *)argument;
+	band_frame_t *frame = band->frame;
+	int width = frame->width;
+	int top = (band->first > 0) ? band->first-1 : 0;
+	int bottom = (band->last < frame->height) ? band->last+1 : frame->height;
+	int lines = bottom-top;
+	conv_grayscale_to(&frame->rgb[top*width],width,lines,band->gray);
+	sobel_x_lines(band->gray,&frame->x_result[top*width],width,lines);
+	sobel_y_lines(band->gray,&frame->y_result[top*width],width,lines);
+	sobel_threshold_lines(&frame->x_result[top*width],
+			              &frame->y_result[top*width],
+			              &frame->result[top*width],
+			              width,lines,frame->threshold);
+}
+
+/* Moving circles with noise, to have edges of all directions */
+void synthetic_frame(unsigned short *rgb,
+		             int width,
+		             int height,
+		             int index) {
+	unsigned int seed = index*7919+1;
+	int x,y,dx,dy,level;
+	for (y = 0 ; y < height ; y++) {
+		for (x = 0 ; x < width ; x++) {
+			dx = x-width/2-index*4;
+			dy = y-height/2+index*3;
+			level = ((dx*dx+dy*dy)>>8)&0x3F;
+			seed = seed*1103515245+12345;
+			level = (level+((seed>>16)&7)) > 63 ? 63 : level+((seed>>16)&7);
+			rgb[y*width+x] = ((level>>1)<<11)|(level<<5)|(level>>1);
+		}
+	}
+}
+
+int load_sequence(const char *name,
+		          unsigned short *rgb,
+		          int pixels,
+		          int max_frames) {
+	FILE *file = fopen(name,"rb");
+	int frames = 0;
+	if (file == NULL)
+		return 0;
+	while (frames < max_frames &&
+		   fread(&rgb[frames*pixels],2,pixels,file) == (size_t)pixels)
+		frames++;
+	fclose(file);
+	return frames;
+}
+
+double seconds_now(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC,&now);
+	return now.tv_sec+now.tv_nsec*1e-9;
+}
+
+int main(int argc, char **argv) {
+	int width = 640, height = 480, band_lines = 16, frames = 200;
+	int cores = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	int max_threads = cores;
+	short threshold = 128;
+	int option,loop,threads,bands,sequence,pixels;
+	unsigned short *rgb;
+	band_frame_t frame;
+	band_t *band;
+	pool_task_t *task;
+	thread_pool_t *pool;
+	double start,seconds,single = 0.0;
+	while ((option = getopt(argc,argv,"w:h:t:b:f:n:")) != -1) {
+		switch (option) {
+		case 'w' : width = atoi(optarg); break;
+		case 'h' : height = atoi(optarg); break;
+		case 't' : threshold = (short)atoi(optarg); break;
+		case 'b' : band_lines = atoi(optarg); break;
+		case 'f' : frames = atoi(optarg); break;
+		case 'n' : max_threads = atoi(optarg); break;
+		default  : fprintf(stderr,"usage: %s [-w width] [-h height] [-t threshold] "
+				           "[-b band_lines] [-f frames] [-n max_threads] "
+				           "[sequence.raw]\n",argv[0]);
+		           return 1;
+		}
+	}
+	if (width < 3 || height < 3 || band_lines < 1 || frames < 1 || max_threads < 1)
+		return 1;
+	pixels = width*height;
+	if (optind < argc) {
+		rgb = (unsigned short *)malloc((size_t)frames*pixels*2);
+		sequence = load_sequence(argv[optind],rgb,pixels,frames);
+		if (sequence == 0) {
+			fprintf(stderr,"%s: no %dx%d frame\n",argv[optind],width,height);
+			return 1;
+		}
+	} else {
+		sequence = SYNTHETIC_FRAMES;
+		rgb = (unsigned short *)malloc((size_t)sequence*pixels*2);
+		for (loop = 0 ; loop < sequence ; loop++)
+			synthetic_frame(&rgb[loop*pixels],width,height,loop);
+	}
+	frame.width = width;
+	frame.height = height;
+	frame.threshold = threshold;
+	frame.x_result = (short *)calloc(pixels,sizeof(short));
+	frame.y_result = (short *)calloc(pixels,sizeof(short));
+	frame.result = (unsigned char *)calloc(pixels,1);
+	bands = (height+band_lines-1)/band_lines;
+	band = (band_t *)calloc(bands,sizeof(band_t));
+	task = (pool_task_t *)calloc(bands,sizeof(pool_task_t));
+	for (loop = 0 ; loop < bands ; loop++) {
+		band[loop].frame = &frame;
+		band[loop].first = loop*band_lines;
+		band[loop].last = (loop+1)*band_lines < height ? (loop+1)*band_lines : height;
+		band[loop].gray = (unsigned char *)malloc((band_lines+2)*width);
+		task[loop].function = band_filter;
+		task[loop].argument = &band[loop];
+	}
+
+	/* the bands must give the result of the single-threaded functions */
+	pool = pool_create(max_threads,bands);
+	frame.rgb = rgb;
+	if (pool == NULL || pool_run(pool,task,bands) != 0) {
+		printf("sobel_bands: the pool does not run %d bands\n",bands);
+		return 1;
+	}
+	pool_destroy(pool);
+	conv_grayscale(rgb,width,height);
+	init_sobel_arrays(width,height);
+	sobel_x(get_grayscale_picture());
+	sobel_y(get_grayscale_picture());
+	sobel_threshold(threshold);
+	if (memcmp(frame.result,GetSobelResult(),pixels) != 0) {
+		printf("sobel_bands: the bands differ from sobel_threshold\n");
+		return 1;
+	}
+
+	printf("sobel_bands: %dx%d, %d frames (%d different), %d bands of %d lines, %d core(s)\n",
+		   width,height,frames,sequence,bands,band_lines,cores);
+	printf("threads  frames/s  speedup  steals\n");
+	for (threads = 1 ; threads <= max_threads ; threads++) {
+		pool = pool_create(threads,bands);
+		start = seconds_now();
+		for (loop = 0 ; loop < frames ; loop++) {
+			frame.rgb = &rgb[(loop%sequence)*pixels];
+			if (pool_run(pool,task,bands) != 0) {
+				printf("sobel_bands: the pool does not run %d bands\n",bands);
+				return 1;
+			}
+		}
+		seconds = seconds_now()-start;
+		if (threads == 1)
+			single = seconds;
+		printf("%7d  %8.1f  %7.2f  %6lu%s\n",threads,frames/seconds,
+			   single/seconds,pool->steals,
+			   threads > cores ? "  (more threads than cores)" : "");
+		pool_destroy(pool);
+	}
+	return 0;
+}
@@ -0,0 +1,184 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file thread_pool.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdlib.h>
+#include "thread_pool.h"
+
+typedef struct pool_worker {
+	thread_pool_t *pool;
+	int index;
+} pool_worker_t;
+
+/* Own tasks are taken from the bottom, in the order they were given */
+int pool_take(pool_deque_t *deque,
+		      pool_task_t *task) {
+	int found = 0;
+	pthread_mutex_lock(&deque->lock);
+	if (deque->top < deque->bottom) {
+		*task = deque->task[--deque->bottom];
+		found = 1;
+	}
+	pthread_mutex_unlock(&deque->lock);
+	return found;
+}
+
+int pool_steal(pool_deque_t *deque,
+		       pool_task_t *task) {
+	int found = 0;
+	pthread_mutex_lock(&deque->lock);
+	if (deque->top < deque->bottom) {
+		*task = deque->task[deque->top++];
+		found = 1;
+	}
+	pthread_mutex_unlock(&deque->lock);
+	return found;
+}
+
+void *pool_worker(void *argument) {
+	pool_worker_t *worker = (pool_worker_t *)argument;
+	thread_pool_t *pool = worker->pool;
+	unsigned int seen = 0;
+	pool_task_t task;
+	int victim,found,stop;
+	do {
+		pthread_mutex_lock(&pool->lock);
+		while (pool->generation == seen && pool->stop == 0)
+			pthread_cond_wait(&pool->start,&pool->lock);
+		seen = pool->generation;
+		stop = pool->stop;
+		pthread_mutex_unlock(&pool->lock);
+		if (stop != 0)
+			break;
+		do {
+			found = pool_take(&pool->deque[worker->index],&task);
+			for (victim = 1 ; found == 0 && victim < pool->workers ; victim++) {
+				found = pool_steal(&pool->deque[(worker->index+victim)%pool->workers],
+						           &task);
+				if (found != 0)
+					__atomic_fetch_add(&pool->steals,1,__ATOMIC_RELAXED);
+			}
+			if (found == 0)
+				break;
+			task.function(task.argument);
+			if (__atomic_sub_fetch(&pool->pending,1,__ATOMIC_ACQ_REL) == 0) {
+				pthread_mutex_lock(&pool->lock);
+				pthread_cond_signal(&pool->done);
+				pthread_mutex_unlock(&pool->lock);
+			}
+		} while (1);
+	} while (1);
+	free(worker);
+	return NULL;
+}
+
+thread_pool_t *pool_create(int workers,
+		                   int max_tasks) {
+	thread_pool_t *pool;
+	pool_worker_t *worker;
+	int loop;
+	if (workers < 1 || max_tasks < 1)
+		return NULL;
+	pool = (thread_pool_t *)calloc(1,sizeof(thread_pool_t));
+	if (pool == NULL)
+		return NULL;
+	pool->workers = workers;
+	pool->max_tasks = max_tasks;
+	pool->thread = (pthread_t *)calloc(workers,sizeof(pthread_t));
+	pool->deque = (pool_deque_t *)calloc(workers,sizeof(pool_deque_t));
+	pthread_mutex_init(&pool->lock,NULL);
+	pthread_cond_init(&pool->start,NULL);
+	pthread_cond_init(&pool->done,NULL);
+	for (loop = 0 ; loop < workers ; loop++) {
+		pthread_mutex_init(&pool->deque[loop].lock,NULL);
+		pool->deque[loop].task = (pool_task_t *)calloc(max_tasks,sizeof(pool_task_t));
+		worker = (pool_worker_t *)malloc(sizeof(pool_worker_t));
+		worker->pool = pool;
+		worker->index = loop;
+		pthread_create(&pool->thread[loop],NULL,pool_worker,worker);
+	}
+	return pool;
+}
+
+/*
+ * Worker n gets the tasks n*count/workers up to (n+1)*count/workers-1. A
+ * worker still looking for tasks of the previous run may already take one,
+ * hence pending is set before the deques are filled. Returns 0 when all
+ * tasks are done, -1 without running any when there are more than
+ * max_tasks.
+ */
+int pool_run(thread_pool_t *pool,
+		     pool_task_t *tasks,
+		     int count) {
+	int loop,first,last,index;
+	if (count > pool->max_tasks)
+		return -1;
+	if (count <= 0)
+		return 0;
+	__atomic_store_n(&pool->pending,count,__ATOMIC_RELEASE);
+	for (loop = 0 ; loop < pool->workers ; loop++) {
+		first = loop*count/pool->workers;
+		last = (loop+1)*count/pool->workers;
+		pthread_mutex_lock(&pool->deque[loop].lock);
+		/* the own tasks are taken from the bottom, hence stored reversed */
+		for (index = first ; index < last ; index++)
+			pool->deque[loop].task[last-1-index] = tasks[index];
+		pool->deque[loop].top = 0;
+		pool->deque[loop].bottom = last-first;
+		pthread_mutex_unlock(&pool->deque[loop].lock);
+	}
+	pthread_mutex_lock(&pool->lock);
+	pool->generation++;
+	pthread_cond_broadcast(&pool->start);
+	while (__atomic_load_n(&pool->pending,__ATOMIC_ACQUIRE) != 0)
+		pthread_cond_wait(&pool->done,&pool->lock);
+	pthread_mutex_unlock(&pool->lock);
+	return 0;
+}
+
+void pool_destroy(thread_pool_t *pool) {
+	int loop;
+	if (pool == NULL)
+		return;
+	pthread_mutex_lock(&pool->lock);
+	pool->stop = 1;
+	pthread_cond_broadcast(&pool->start);
+	pthread_mutex_unlock(&pool->lock);
+	/* a worker may still look into the other deques */
+	for (loop = 0 ; loop < pool->workers ; loop++)
+		pthread_join(pool->thread[loop],NULL);
+	for (loop = 0 ; loop < pool->workers ; loop++) {
+		free(pool->deque[loop].task);
+		pthread_mutex_destroy(&pool->deque[loop].lock);
+	}
+	free(pool->deque);
+	free(pool->thread);
+	pthread_cond_destroy(&pool->start);
+	pthread_cond_destroy(&pool->done);
+	pthread_mutex_destroy(&pool->lock);
+	free(pool);
+}
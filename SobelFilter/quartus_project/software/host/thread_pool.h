@@ -0,0 +1,83 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file thread_pool.h
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Work-stealing thread pool of the host programs. pool_run() hands a set of
+ * tasks to the workers in contiguous blocks, one block to each worker's
+ * deque, and returns when all of them are done. A worker takes its own
+ * tasks from the bottom of its deque (in order, neighbouring bands stay in
+ * its cache); a worker without tasks steals from the top of another deque.
+ * The deques are short and only touched once per task, so each has a mutex
+ * instead of the lock-free Chase-Lev protocol.
+ *
+ * A run holds at most the max_tasks given to pool_create(); pool_run()
+ * refuses a larger set and runs none of its tasks, so a frame is never
+ * returned partly processed.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+#include <pthread.h>
+
+typedef void (*pool_function_t)(void *argument);
+
+typedef struct pool_task {
+	pool_function_t function;
+	void *argument;
+} pool_task_t;
+
+typedef struct pool_deque {
+	pthread_mutex_t lock;
+	pool_task_t *task;
+	int top;     // next task to steal
+	int bottom;  // one after the next own task
+} pool_deque_t;
+
+typedef struct thread_pool {
+	int workers;
+	int max_tasks;
+	pthread_t *thread;
+	pool_deque_t *deque;
+	pthread_mutex_t lock;
+	pthread_cond_t start;
+	pthread_cond_t done;
+	unsigned int generation;
+	int pending;
+	int stop;
+	unsigned long steals;
+} thread_pool_t;
+
+thread_pool_t *pool_create(int workers,
+		                   int max_tasks);
+
+int pool_run(thread_pool_t *pool,
+		     pool_task_t *tasks,
+		     int count);
+
+void pool_destroy(thread_pool_t *pool);
+
+#endif /* THREAD_POOL_H_ */
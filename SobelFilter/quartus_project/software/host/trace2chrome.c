@@ -0,0 +1,93 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file trace2chrome.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Converts a capture of the nios2-terminal with trace dumps (sobel/src/
+ * trace.h) to a Chrome trace-event JSON file:
+ *
+ *   trace2chrome [-f clock_hz] [-o trace.json] [capture.txt]
+ *
+ * The clock is taken from the dump unless -f is given; without -o the JSON
+ * goes to stdout. Open the file in chrome://tracing or ui.perfetto.dev.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "trace_convert.h"
+
+int main(int argc, char **argv) {
+	trace_converter_t converter;
+	FILE *input = stdin;
+	FILE *output = stdout;
+	double clock_freq = 0;
+	char line[256];
+	int arg;
+	for (arg = 1 ; arg < argc ; arg++) {
+		if (strcmp(argv[arg],"-f") == 0 && arg+1 < argc) {
+			clock_freq = atof(argv[++arg]);
+			if (clock_freq <= 0) {
+				fprintf(stderr,"%s: bad clock frequency\n",argv[0]);
+				return 1;
+			}
+		} else if (strcmp(argv[arg],"-o") == 0 && arg+1 < argc &&
+				   output == stdout) {
+			output = fopen(argv[++arg],"w");
+			if (output == NULL) {
+				perror(argv[arg]);
+				return 1;
+			}
+		} else if (input == stdin && argv[arg][0] != '-') {
+			input = fopen(argv[arg],"r");
+			if (input == NULL) {
+				perror(argv[arg]);
+				return 1;
+			}
+		} else {
+			fprintf(stderr,"usage: %s [-f clock_hz] [-o trace.json] [capture.txt]\n",
+					argv[0]);
+			return 1;
+		}
+	}
+	trace_convert_init(&converter,output,clock_freq);
+	while (fgets(line,sizeof(line),input) != NULL)
+		trace_convert_line(&converter,line);
+	trace_convert_finish(&converter);
+	if (input != stdin)
+		fclose(input);
+	if (output != stdout)
+		fclose(output);
+	fprintf(stderr,"%u dumps, %u events: %u spans, %u instants; "
+			"%u unmatched ends, %u unmatched begins, %u lost, %u bad lines\n",
+			converter.dumps,converter.events,converter.spans,
+			converter.instants,converter.unmatched_ends,
+			converter.unmatched_begins,converter.lost,converter.bad_lines);
+	if (converter.dumps == 0) {
+		fprintf(stderr,"%s: no trace dump found\n",argv[0]);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,198 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file trace_convert.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "trace_convert.h"
+
+static const char *track_name[TRACE_NR_OF_TRACKS] = {
+#define TRACE_TRACK(id,name) name,
+	TRACE_TRACKS
+#undef TRACE_TRACK
+};
+
+static const char *point_name[TRACE_NR_OF_POINTS] = {
+#define TRACE_POINT(id,name,track) name,
+	TRACE_POINTS
+#undef TRACE_POINT
+};
+
+static const unsigned char point_track[TRACE_NR_OF_POINTS] = {
+#define TRACE_POINT(id,name,track) track,
+	TRACE_POINTS
+#undef TRACE_POINT
+};
+
+static void trace_convert_separator(trace_converter_t *converter) {
+	fputs((converter->written++ == 0) ? "\n" : ",\n",converter->out);
+}
+
+static double trace_convert_us(trace_converter_t *converter,
+		                       unsigned long long cycles) {
+	return (double)cycles*1e6/converter->clock_freq;
+}
+
+void trace_convert_init(trace_converter_t *converter,
+		                FILE *out,
+		                double clock_freq) {
+	int track;
+	memset(converter,0,sizeof(trace_converter_t));
+	converter->out = out;
+	converter->clock_freq = clock_freq;
+	fputs("{\"traceEvents\":[",out);
+	trace_convert_separator(converter);
+	fputs("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+		  "\"args\":{\"name\":\"sobel\"}}",out);
+	for (track = 0 ; track < TRACE_NR_OF_TRACKS ; track++) {
+		trace_convert_separator(converter);
+		fprintf(out,"{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+				"\"tid\":%d,\"args\":{\"name\":\"%s\"}}",track+1,
+				track_name[track]);
+		trace_convert_separator(converter);
+		fprintf(out,"{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,"
+				"\"tid\":%d,\"args\":{\"sort_index\":%d}}",track+1,track);
+	}
+}
+
+static void trace_convert_event(trace_converter_t *converter,
+		                        unsigned int timestamp,
+		                        char phase,
+		                        unsigned int point,
+		                        unsigned int arg) {
+	int track = point_track[point];
+	int *depth = &converter->depth[track];
+	trace_span_t *span;
+	int level,step;
+	unsigned long long now;
+	/*
+	 * The counter runs forward and wraps. An event older than the newest
+	 * one was written late with the time of its interrupt (trace_event_at)
+	 * and is put back in time; it does not move the newest time.
+	 */
+	if (converter->started == 0) {
+		converter->time = timestamp;
+		converter->first = timestamp;
+		converter->started = 1;
+	}
+	step = (int)(timestamp-(unsigned int)converter->time);
+	now = converter->time+step;
+	if (step > 0)
+		converter->time = now;
+	if (now < converter->first)
+		now = converter->first;
+	converter->events++;
+	switch (phase) {
+	case TRACE_BEGIN :
+		if (*depth == TRACE_CONVERT_DEPTH) {
+			converter->unmatched_begins++;
+			break;
+		}
+		span = &converter->span[track][(*depth)++];
+		span->begin = now;
+		span->point = point;
+		span->arg = arg;
+		break;
+	case TRACE_END :
+		/* begins inside of the span without an end are dropped */
+		for (level = *depth-1 ; level >= 0 ; level--)
+			if (converter->span[track][level].point == point)
+				break;
+		if (level < 0) {
+			converter->unmatched_ends++;
+			break;
+		}
+		converter->unmatched_begins += *depth-1-level;
+		*depth = level;
+		span = &converter->span[track][level];
+		trace_convert_separator(converter);
+		fprintf(converter->out,"{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\","
+				"\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,"
+				"\"args\":{\"arg\":%u}}",point_name[point],track_name[track],
+				track+1,trace_convert_us(converter,span->begin-converter->first),
+				trace_convert_us(converter,
+						(now > span->begin) ? now-span->begin : 0),
+				span->arg);
+		converter->spans++;
+		break;
+	default :
+		trace_convert_separator(converter);
+		fprintf(converter->out,"{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"i\","
+				"\"s\":\"t\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,"
+				"\"args\":{\"arg\":%u}}",point_name[point],track_name[track],
+				track+1,trace_convert_us(converter,now-converter->first),arg);
+		converter->instants++;
+		break;
+	}
+}
+
+/* Returns 1 for an event line */
+int trace_convert_line(trace_converter_t *converter,
+		               const char *line) {
+	unsigned int timestamp, point, arg, count, lost;
+	double clock_freq;
+	char phase;
+	int track;
+	if (sscanf(line,"TRACE BEGIN %lf %u %u",&clock_freq,&count,&lost) == 3) {
+		if (converter->clock_freq <= 0)
+			converter->clock_freq = clock_freq;
+		/* with events lost the ends of the open spans may be lost too */
+		if (lost != 0)
+			for (track = 0 ; track < TRACE_NR_OF_TRACKS ; track++) {
+				converter->unmatched_begins += converter->depth[track];
+				converter->depth[track] = 0;
+			}
+		converter->lost += lost;
+		converter->in_dump = 1;
+		converter->dumps++;
+		return 0;
+	}
+	if (converter->in_dump == 0)
+		return 0;
+	if (strncmp(line,"TRACE END",9) == 0) {
+		converter->in_dump = 0;
+		return 0;
+	}
+	if (sscanf(line,"%x %c %u %u",&timestamp,&phase,&point,&arg) != 4 ||
+		(phase != TRACE_BEGIN && phase != TRACE_END && phase != TRACE_INSTANT) ||
+		point >= TRACE_NR_OF_POINTS || converter->clock_freq <= 0) {
+		converter->bad_lines++;
+		return 0;
+	}
+	trace_convert_event(converter,timestamp,phase,point,arg);
+	return 1;
+}
+
+/* Closes the JSON; spans still open are counted as unmatched begins */
+void trace_convert_finish(trace_converter_t *converter) {
+	int track;
+	for (track = 0 ; track < TRACE_NR_OF_TRACKS ; track++) {
+		converter->unmatched_begins += converter->depth[track];
+		converter->depth[track] = 0;
+	}
+	fputs("\n],\"displayTimeUnit\":\"ms\"}\n",converter->out);
+}
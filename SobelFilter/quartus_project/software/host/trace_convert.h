@@ -0,0 +1,89 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file trace_convert.h
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Converts the dumps of trace_dump() (sobel/src/trace.h) to the Chrome
+ * trace-event JSON format, shown by chrome://tracing and ui.perfetto.dev.
+ * The lines are given one by one, lines outside of a dump (the report of
+ * the performance counter) are skipped. Each track of trace_points.h is
+ * one thread of the timeline; a begin and its end become one complete
+ * ("X") event, spans of a track may nest. The 32 bit timestamps are
+ * extended over their wrap, the time is in microseconds from the first
+ * event. An event may be older than the one before it (written late with
+ * the time of its interrupt), hence the events must follow each other
+ * within 2^31 clocks, 43 s at 50 MHz.
+ *
+ * The dump is a flight recorder, its first events may be the ends of spans
+ * that began before; such ends, and begins without an end, are counted
+ * and left out. Dumps follow each other without a gap unless the header
+ * reports lost events; then the spans still open are dropped.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef TRACE_CONVERT_H_
+#define TRACE_CONVERT_H_
+
+#include <stdio.h>
+#include "trace_points.h"
+
+#define TRACE_CONVERT_DEPTH 16
+
+typedef struct trace_span {
+	unsigned long long begin;
+	unsigned char point;
+	unsigned short arg;
+} trace_span_t;
+
+typedef struct trace_converter {
+	FILE *out;
+	double clock_freq;
+	char in_dump;
+	char started;
+	unsigned int written;
+	unsigned long long first;
+	unsigned long long time;
+	int depth[TRACE_NR_OF_TRACKS];
+	trace_span_t span[TRACE_NR_OF_TRACKS][TRACE_CONVERT_DEPTH];
+	unsigned int dumps;
+	unsigned int lost;
+	unsigned int events;
+	unsigned int spans;
+	unsigned int instants;
+	unsigned int unmatched_ends;
+	unsigned int unmatched_begins;
+	unsigned int bad_lines;
+} trace_converter_t;
+
+/* clock_freq 0 takes the frequency of the dump header */
+void trace_convert_init(trace_converter_t *converter,
+		                FILE *out,
+		                double clock_freq);
+
+int trace_convert_line(trace_converter_t *converter,
+		               const char *line);
+
+void trace_convert_finish(trace_converter_t *converter);
+
+#endif /* TRACE_CONVERT_H_ */
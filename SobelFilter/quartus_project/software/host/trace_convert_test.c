@@ -0,0 +1,266 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file trace_convert_test.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Unit tests of trace_convert.c: spans and instants of the tracks, nested
+ * spans, the timestamp wrap, events written late, unmatched begins and
+ * ends, dumps with lost events and lines that are no events. The JSON is written to a memory
+ * stream and compared as text.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "trace_convert.h"
+
+#define CLOCK "TRACE BEGIN 50000000 0 0\n"
+
+unsigned int errors = 0;
+
+/* converts the lines, the JSON is returned in *json (free it) */
+void test_convert(trace_converter_t *converter,
+		          const char *lines,
+		          char **json) {
+	size_t size;
+	char line[256];
+	const char *end;
+	FILE *out = open_memstream(json,&size);
+	trace_convert_init(converter,out,0);
+	while (*lines != '\0') {
+		end = strchr(lines,'\n');
+		end = (end == NULL) ? lines+strlen(lines) : end+1;
+		memcpy(line,lines,end-lines);
+		line[end-lines] = '\0';
+		trace_convert_line(converter,line);
+		lines = end;
+	}
+	trace_convert_finish(converter);
+	fclose(out);
+}
+
+void test_check(int condition,
+		        const char *test,
+		        const char *what) {
+	if (condition)
+		return;
+	printf("%s: %s failed\n",test,what);
+	errors++;
+}
+
+void test_contains(const char *json,
+		           const char *test,
+		           const char *expected) {
+	if (strstr(json,expected) != NULL)
+		return;
+	printf("%s: missing %s in\n%s\n",test,expected,json);
+	errors++;
+}
+
+/* the JSON closes, no empty entries */
+void test_json(const char *json,
+		       const char *test) {
+	test_check(strncmp(json,"{\"traceEvents\":[\n",17) == 0,test,"json start");
+	test_check(strstr(json,",\n]") == NULL && strstr(json,",,") == NULL,
+			   test,"json separators");
+	const char *end = "\n],\"displayTimeUnit\":\"ms\"}\n";
+	test_check(strlen(json) > strlen(end) &&
+			   strcmp(json+strlen(json)-strlen(end),end) == 0,test,"json end");
+}
+
+void test_spans(void) {
+	trace_converter_t converter;
+	char *json;
+	test_convert(&converter,
+			"Mode 3, 64 frames:\n"
+			CLOCK
+			"00000100 B 0 7\n"       /* frame 7, the time origin */
+			"00000132 B 2 0\n"       /* grayscale at 1 us */
+			"00000196 E 2 0\r\n"     /* for 2 us */
+			"000001fa I 5 0\n"       /* camera frame ready at 5 us */
+			"0000025e B 6 1\n"       /* lcd transfer at 7 us */
+			"000002c2 E 0 7\n"
+			"00000326 E 6 1\n"
+			"TRACE END\n"
+			"00000400 B 0 8\n",      /* after the dump */
+			&json);
+	test_json(json,"spans");
+	test_check(converter.dumps == 1,"spans","dumps");
+	test_check(converter.events == 7,"spans","events");
+	test_check(converter.spans == 3 && converter.instants == 1,"spans","counts");
+	test_check(converter.unmatched_begins == 0 && converter.unmatched_ends == 0 &&
+			   converter.bad_lines == 0,"spans","no errors");
+	test_contains(json,"spans","\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+			      "\"tid\":3,\"args\":{\"name\":\"lcd dma\"}");
+	test_contains(json,"spans","{\"name\":\"grayscale\",\"cat\":\"cpu\",\"ph\":\"X\","
+			      "\"pid\":1,\"tid\":1,\"ts\":1.000,\"dur\":2.000,\"args\":{\"arg\":0}}");
+	test_contains(json,"spans","{\"name\":\"frame ready\",\"cat\":\"camera dma\","
+			      "\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":2,\"ts\":5.000,");
+	test_contains(json,"spans","{\"name\":\"frame\",\"cat\":\"cpu\",\"ph\":\"X\","
+			      "\"pid\":1,\"tid\":1,\"ts\":0.000,\"dur\":9.000,\"args\":{\"arg\":7}}");
+	test_contains(json,"spans","{\"name\":\"lcd transfer\",\"cat\":\"lcd dma\","
+			      "\"ph\":\"X\",\"pid\":1,\"tid\":3,\"ts\":7.000,\"dur\":4.000,");
+	free(json);
+}
+
+void test_wrap(void) {
+	trace_converter_t converter;
+	char *json;
+	test_convert(&converter,
+			CLOCK
+			"ffffff00 B 1 0\n"
+			"00000100 E 1 0\n"
+			"TRACE END\n"
+			"TRACE BEGIN 50000000 0 0\n"
+			"00000200 I 5 0\n"
+			"TRACE END\n",
+			&json);
+	test_json(json,"wrap");
+	test_contains(json,"wrap","\"ts\":0.000,\"dur\":10.240,");
+	test_contains(json,"wrap","\"ts\":15.360,");
+	test_check(converter.dumps == 2,"wrap","dumps");
+	free(json);
+}
+
+/* the end of the lcd transfer is written late with the time of its irq */
+void test_late(void) {
+	trace_converter_t converter;
+	char *json;
+	test_convert(&converter,
+			CLOCK
+			"00001000 B 6 1\n"
+			"00004000 B 0 0\n"
+			"00003000 E 6 1\n"
+			"00005000 E 0 0\n"
+			"TRACE END\n",
+			&json);
+	test_json(json,"late");
+	test_contains(json,"late","\"ts\":0.000,\"dur\":163.840,");
+	test_contains(json,"late","\"ts\":245.760,\"dur\":81.920,");
+	test_check(converter.spans == 2,"late","spans");
+	free(json);
+}
+
+/* the camera transfer is written when the next frame ready is seen */
+void test_camera(void) {
+	trace_converter_t converter;
+	char *json;
+	test_convert(&converter,
+			CLOCK
+			"00000100 I 5 0\n"
+			"00000200 B 0 0\n"
+			"00000800 E 0 0\n"
+			"00000100 B 8 1\n"
+			"00000600 E 8 1\n"
+			"00000600 I 5 1\n"
+			"TRACE END\n",
+			&json);
+	test_json(json,"camera");
+	test_contains(json,"camera","{\"name\":\"camera transfer\",\"cat\":\"camera dma\","
+			      "\"ph\":\"X\",\"pid\":1,\"tid\":2,\"ts\":0.000,\"dur\":25.600,");
+	test_check(converter.spans == 2 && converter.instants == 2,"camera","counts");
+	test_check(converter.unmatched_begins == 0 && converter.unmatched_ends == 0,
+			   "camera","no errors");
+	free(json);
+}
+
+void test_unmatched(void) {
+	trace_converter_t converter;
+	char *json;
+	test_convert(&converter,
+			CLOCK
+			"00000100 E 2 0\n"       /* began before the dump */
+			"00000110 E 0 0\n"
+			"00000120 B 0 1\n"
+			"00000130 B 1 0\n"
+			"00000140 B 2 0\n"       /* its end is missing */
+			"00000150 E 1 0\n"
+			"00000160 E 0 1\n"
+			"00000170 B 6 0\n"       /* still open at the end */
+			"TRACE END\n",
+			&json);
+	test_json(json,"unmatched");
+	test_check(converter.unmatched_ends == 2,"unmatched","ends");
+	test_check(converter.unmatched_begins == 2,"unmatched","begins");
+	test_check(converter.spans == 2,"unmatched","spans");
+	test_contains(json,"unmatched","\"name\":\"filter chain\",\"cat\":\"cpu\","
+			      "\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":0.960,\"dur\":0.640,");
+	free(json);
+}
+
+/* after lost events a span of the previous dump is not closed */
+void test_lost(void) {
+	trace_converter_t converter;
+	char *json;
+	test_convert(&converter,
+			CLOCK
+			"00000100 B 6 0\n"
+			"TRACE END\n"
+			"TRACE BEGIN 50000000 2 120\n"
+			"00100000 E 6 1\n"
+			"00100010 B 6 2\n"
+			"TRACE END\n"
+			"TRACE BEGIN 50000000 1 0\n"
+			"00100020 E 6 2\n"
+			"TRACE END\n",
+			&json);
+	test_json(json,"lost");
+	test_check(converter.lost == 120,"lost","lost");
+	test_check(converter.unmatched_begins == 1 && converter.unmatched_ends == 1,
+			   "lost","unmatched");
+	test_check(converter.spans == 1,"lost","spans");
+	test_contains(json,"lost","\"dur\":0.320,\"args\":{\"arg\":2}}");
+	free(json);
+}
+
+void test_bad_lines(void) {
+	trace_converter_t converter;
+	char *json;
+	test_convert(&converter,
+			"00000100 B 0 0\n"        /* outside of a dump */
+			CLOCK
+			"00000100 X 0 0\n"
+			"00000100 B 99 0\n"
+			"garbage\n"
+			"00000100 I\n"
+			"TRACE END\n",
+			&json);
+	test_json(json,"bad lines");
+	test_check(converter.events == 0,"bad lines","events");
+	test_check(converter.bad_lines == 4,"bad lines","bad lines");
+	free(json);
+}
+
+int main(void) {
+	test_spans();
+	test_wrap();
+	test_late();
+	test_camera();
+	test_unmatched();
+	test_lost();
+	test_bad_lines();
+	printf("trace_convert_test: %u error(s)\n",errors);
+	return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,69 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file binary.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include "binary.h"
+
+/* Every non zero byte becomes a set pixel; the unused bits of the last
+ * word of each line are cleared. */
+void binary_pack( unsigned char *source,
+		          unsigned int *destination,
+		          int width,
+		          int height ) {
+	int x,y,bit,bits;
+	unsigned int word;
+	for (y = 0 ; y < height ; y++) {
+		for (x = 0 ; x < width ; x += 32) {
+			bits = ((width-x) > 32) ? 32 : width-x;
+			word = 0;
+			for (bit = 0 ; bit < bits ; bit++)
+				word |= (unsigned int)(source[x+bit] != 0)<<bit;
+			*destination++ = word;
+		}
+		source += width;
+	}
+}
+
+/* Set pixels become 0xFF, cleared pixels 0x00. */
+void binary_unpack( unsigned int *source,
+		            unsigned char *destination,
+		            int width,
+		            int height ) {
+	int x,y,bit,bits;
+	unsigned int word;
+	for (y = 0 ; y < height ; y++) {
+		for (x = 0 ; x < width ; x += 32) {
+			bits = ((width-x) > 32) ? 32 : width-x;
+			word = *source++;
+			for (bit = 0 ; bit < bits ; bit++) {
+				destination[x+bit] = -(word&1);
+				word >>= 1;
+			}
+		}
+		destination += width;
+	}
+}
@@ -0,0 +1,54 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file binary.h
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Packed binary pictures, one bit each pixel. A word holds 32 pixels, the
+ * leftmost in bit 0, and each line starts with a new word, hence a line
+ * takes BINARY_WORDS_EACH_LINE(width) words. The lcd_dma shows this format
+ * directly (LCD_DMA_Binary), at 1/16 of the bus bandwidth of RGB565.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef BINARY_H_
+#define BINARY_H_
+
+#include <stdlib.h>
+
+#define BINARY_WORDS_EACH_LINE(width) (((width)+31)>>5)
+
+#define BINARY_PIXEL(picture,words,x,y) \
+	(((picture)[(y)*(words)+((x)>>5)]>>((x)&31))&1)
+
+void binary_pack( unsigned char *source,
+		          unsigned int *destination,
+		          int width,
+		          int height );
+
+void binary_unpack( unsigned int *source,
+		            unsigned char *destination,
+		            int width,
+		            int height );
+
+#endif /* BINARY_H_ */
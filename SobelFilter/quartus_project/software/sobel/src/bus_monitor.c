@@ -0,0 +1,95 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file bus_monitor.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include "bus_monitor.h"
+#include <stdio.h>
+
+const char *bus_monitor_names[BUS_MONITOR_NR_OF_MASTERS] = {"cam_dma","lcd_dma",
+                                                            "vga_dma","cpu"};
+
+/* A window of 0 cycles counts until bus_monitor_stop() */
+void bus_monitor_start(unsigned int window_cycles) {
+	IOWR_32DIRECT(BUS_MONITOR_0_BASE,4,window_cycles);
+	IOWR_32DIRECT(BUS_MONITOR_0_BASE,0,BUS_MONITOR_START);
+}
+
+void bus_monitor_stop() {
+	IOWR_32DIRECT(BUS_MONITOR_0_BASE,0,BUS_MONITOR_STOP);
+}
+
+char bus_monitor_running() {
+	return (IORD_32DIRECT(BUS_MONITOR_0_BASE,0)&BUS_MONITOR_RUNNING) ? 1 : 0;
+}
+
+unsigned int bus_monitor_elapsed() {
+	return IORD_32DIRECT(BUS_MONITOR_0_BASE,8);
+}
+
+void bus_monitor_read(int master,
+		              bus_monitor_counters_t *counters) {
+	int offset = 16+master*16;
+	counters->transfers = IORD_32DIRECT(BUS_MONITOR_0_BASE,offset);
+	counters->bytes = IORD_32DIRECT(BUS_MONITOR_0_BASE,offset+4);
+	counters->wait_cycles = IORD_32DIRECT(BUS_MONITOR_0_BASE,offset+8);
+	counters->max_burst = IORD_32DIRECT(BUS_MONITOR_0_BASE,offset+12);
+}
+
+/*
+ * The utilization is the share of the window cycles a data beat of the
+ * master was on its port, the bus is 4 bytes wide. Only integer arithmetic
+ * is used, the report is printed from the main loop.
+ */
+void bus_monitor_report() {
+	int master;
+	unsigned int elapsed = bus_monitor_elapsed();
+	unsigned int beats,busy = 0;
+	bus_monitor_counters_t counters;
+
+	if (elapsed == 0)
+		return;
+	printf("Bus monitor, %u cycles (%u us):\n",elapsed,
+	       (unsigned int)((unsigned long long)elapsed*1000000/ALT_CPU_FREQ));
+	printf("master   transfers    KB/s  avg.burst max.burst wait%%  util%%\n");
+	for (master = 0 ; master < BUS_MONITOR_NR_OF_MASTERS ; master++) {
+		bus_monitor_read(master,&counters);
+		beats = counters.bytes>>2;
+		busy += beats;
+		printf("%-8s %9u %7u %6u.%02u %9u %5u %6u\n",
+		       bus_monitor_names[master],
+		       counters.transfers,
+		       (unsigned int)((unsigned long long)counters.bytes*ALT_CPU_FREQ/
+		                      elapsed/1024),
+		       (counters.transfers == 0) ? 0 : beats/counters.transfers,
+		       (counters.transfers == 0) ? 0 :
+		    		   ((beats%counters.transfers)*100)/counters.transfers,
+		       counters.max_burst,
+		       (unsigned int)((unsigned long long)counters.wait_cycles*100/elapsed),
+		       (unsigned int)((unsigned long long)beats*100/elapsed));
+	}
+	printf("total util%% %u\n",(unsigned int)((unsigned long long)busy*100/elapsed));
+}
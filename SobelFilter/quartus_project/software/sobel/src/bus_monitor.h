@@ -0,0 +1,66 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file bus_monitor.h
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Driver of the bus_monitor in front of the sdram controller. For each
+ * master (cam_dma, lcd_dma, vga_dma and the CPU) it counts the accepted
+ * commands, the bytes transferred, the cycles stalled by waitrequest and the
+ * longest burst over a window of clock cycles.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef BUS_MONITOR_H_
+#define BUS_MONITOR_H_
+
+#include <system.h>
+#include <io.h>
+
+#define BUS_MONITOR_START 1
+#define BUS_MONITOR_STOP 2
+#define BUS_MONITOR_RUNNING 1
+
+#define BUS_MONITOR_NR_OF_MASTERS 4
+
+typedef struct {
+	unsigned int transfers;
+	unsigned int bytes;
+	unsigned int wait_cycles;
+	unsigned int max_burst;
+} bus_monitor_counters_t;
+
+void bus_monitor_start(unsigned int window_cycles);
+
+void bus_monitor_stop();
+
+char bus_monitor_running();
+
+unsigned int bus_monitor_elapsed();
+
+void bus_monitor_read(int master,
+		              bus_monitor_counters_t *counters);
+
+void bus_monitor_report();
+
+#endif /* BUS_MONITOR_H_ */
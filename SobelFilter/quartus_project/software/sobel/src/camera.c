@@ -26,6 +26,9 @@
 #include "camera.h"
 #include "mt9d112.h"
 
+/* counted by the fast interrupt once cam_enable_frame_irq() was called */
+fast_irq_source_t cam_frame_irq;
+
 void init_camera() {
 	int i;
 	IOWR_8DIRECT(I2C_CTRL_BASE,I2C_PRESCALE_REG,2); // Set prescaler
@@ -164,9 +167,26 @@ void enable_continues_mode() {
 
 char new_image_available() {
 	unsigned short value;
+	if (cam_frame_irq.mask != 0)
+		return (fast_irq_take(&cam_frame_irq) != 0) ? 1 : 0;
 	value = IORD_16DIRECT(CAM_CTRL_BASE,CAM_CONTROL_REG);
 	if ((value&CAM_IRQ_Generated)!=0) {
 		IOWR_16DIRECT(CAM_CTRL_BASE,CAM_CONTROL_REG,CAM_Clear_IRQ);
 		return 1;
 	} else return 0;
 }
+
+/*
+ * The frame ready interrupt acknowledges the frame and counts it, instead of
+ * new_image_available() polling the control register; returns 0 when the
+ * polling stays.
+ */
+char cam_enable_frame_irq() {
+	if (fast_irq_register(&cam_frame_irq,CAM_CTRL_IRQ_INTERRUPT_CONTROLLER_ID,
+			              CAM_CTRL_IRQ,CAM_CTRL_BASE+CAM_CONTROL_REG,
+			              0,CAM_Clear_IRQ) == 0)
+		return 0;
+	IOWR_16DIRECT(CAM_CTRL_BASE,CAM_CONTROL_REG,CAM_Clear_IRQ);
+	IOWR_16DIRECT(CAM_CTRL_BASE,CAM_CONTROL_REG,CAM_Enable_IRQ);
+	return 1;
+}
@@ -30,6 +30,7 @@
 #include <io.h>
 #include <stdio.h>
 #include "i2c.h"
+#include "fast_irq.h"
 
 
 #define CAM_BYTES_EACH_LINE_REG 0
@@ -64,6 +65,8 @@
 #define REG_MT9D112_PLL_CLK_IN_CONTROL 0x341E
 #define REG_MT9D112_PLL_DIVIDERS_1 0x341C
 
+/* the time field holds the performance counter of the last frame ready */
+extern fast_irq_source_t cam_frame_irq;
 
 void init_camera();
 
@@ -81,6 +84,8 @@ void enable_continues_mode();
 
 char new_image_available();
 
+char cam_enable_frame_irq();
+
 unsigned short cam_get_xsize();
 
 unsigned short cam_get_ysize();
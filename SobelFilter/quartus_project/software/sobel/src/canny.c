@@ -0,0 +1,231 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file canny.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include "canny.h"
+#include "sobel.h"
+#include "tcm.h"
+
+unsigned char canny_blur_buffer[3][CANNY_MAX_WIDTH] TCM_DATA;
+
+unsigned short canny_gradient_buffer[3][CANNY_MAX_WIDTH] TCM_DATA;
+
+unsigned char *canny_blur_lines[3];
+
+unsigned short *canny_gradient_lines[3];
+
+int canny_worklist[CANNY_WORKLIST_SIZE] TCM_DATA;
+
+int canny_width;
+
+int canny_height;
+
+/* The line buffers are static to be placed in the data TCM, see tcm.h */
+void init_canny(int width , int height) {
+	int loop,x;
+	if (width > CANNY_MAX_WIDTH)
+		width = 0;
+	canny_width = width;
+	canny_height = height;
+	for (loop = 0 ; loop < 3 ; loop++) {
+		canny_blur_lines[loop] = canny_blur_buffer[loop];
+		canny_gradient_lines[loop] = canny_gradient_buffer[loop];
+		for (x = 0 ; x < width ; x++)
+			canny_gradient_lines[loop][x] = 0;
+	}
+}
+
+/* The oldest line of the window is reused for the new one */
+void canny_rotate_blur_lines() {
+	unsigned char *oldest = canny_blur_lines[0];
+	canny_blur_lines[0] = canny_blur_lines[1];
+	canny_blur_lines[1] = canny_blur_lines[2];
+	canny_blur_lines[2] = oldest;
+}
+
+void canny_rotate_gradient_lines() {
+	unsigned short *oldest = canny_gradient_lines[0];
+	canny_gradient_lines[0] = canny_gradient_lines[1];
+	canny_gradient_lines[1] = canny_gradient_lines[2];
+	canny_gradient_lines[2] = oldest;
+}
+
+/* 3x3 gaussian (1 2 1)x(1 2 1)/16 of line y, the border is copied */
+TCM_CODE void canny_blur_line(unsigned char *source,
+		                      int y,
+		                      unsigned char *result) {
+	int x;
+	unsigned char *above,*line,*below;
+	line = &source[y*canny_width];
+	if (y == 0 || y == canny_height-1) {
+		for (x = 0 ; x < canny_width ; x++)
+			result[x] = line[x];
+		return;
+	}
+	above = line-canny_width;
+	below = line+canny_width;
+	result[0] = line[0];
+	for (x = 1 ; x < canny_width-1 ; x++) {
+		result[x] = (above[x-1]+(above[x]<<1)+above[x+1]+
+		             ((line[x-1]+(line[x]<<1)+line[x+1])<<1)+
+		             below[x-1]+(below[x]<<1)+below[x+1]+8)>>4;
+	}
+	result[canny_width-1] = line[canny_width-1];
+}
+
+/*
+ * Non maximum suppression and double threshold of the middle gradient line.
+ * A pixel is kept when its magnitude is a maximum across the edge, that is
+ * along its gradient direction (bit 10..8, steps of 45 degrees, y up).
+ */
+void canny_suppress_line(unsigned char *result,
+		                 unsigned char low_threshold,
+		                 unsigned char high_threshold) {
+	int x;
+	unsigned short *above = canny_gradient_lines[0];
+	unsigned short *line = canny_gradient_lines[1];
+	unsigned short *below = canny_gradient_lines[2];
+	unsigned char magnitude,neighbor1,neighbor2;
+
+	result[0] = CANNY_NO_EDGE;
+	for (x = 1 ; x < canny_width-1 ; x++) {
+		magnitude = SOBEL_GRADIENT_MAGNITUDE(line[x]);
+		if (magnitude < low_threshold) {
+			result[x] = CANNY_NO_EDGE;
+			continue;
+		}
+		switch (SOBEL_GRADIENT_DIRECTION(line[x])&3) {
+		case 0 : neighbor1 = SOBEL_GRADIENT_MAGNITUDE(line[x-1]);
+		         neighbor2 = SOBEL_GRADIENT_MAGNITUDE(line[x+1]);
+		         break;
+		case 1 : neighbor1 = SOBEL_GRADIENT_MAGNITUDE(above[x+1]);
+		         neighbor2 = SOBEL_GRADIENT_MAGNITUDE(below[x-1]);
+		         break;
+		case 2 : neighbor1 = SOBEL_GRADIENT_MAGNITUDE(above[x]);
+		         neighbor2 = SOBEL_GRADIENT_MAGNITUDE(below[x]);
+		         break;
+		default: neighbor1 = SOBEL_GRADIENT_MAGNITUDE(above[x-1]);
+		         neighbor2 = SOBEL_GRADIENT_MAGNITUDE(below[x+1]);
+		         break;
+		}
+		if (magnitude <= neighbor1 || magnitude < neighbor2)
+			result[x] = CANNY_NO_EDGE;
+		else
+			result[x] = (magnitude >= high_threshold) ? CANNY_STRONG_EDGE : CANNY_WEAK_EDGE;
+	}
+	result[canny_width-1] = CANNY_NO_EDGE;
+}
+
+/*
+ * Grows the strong edges into the connected weak edges. Instead of a
+ * recursion a worklist of fixed size is used. If it overflows the pushes are
+ * dropped and the frame is scanned again; the weak pixels that were missed
+ * are still weak next to a strong one and are found in this next scan.
+ */
+void canny_hysteresis(unsigned char *edges) {
+	int x,y,index,neighbor,count;
+	int offsets[8];
+	char overflow;
+
+	offsets[0] = -canny_width-1;
+	offsets[1] = -canny_width;
+	offsets[2] = -canny_width+1;
+	offsets[3] = -1;
+	offsets[4] = 1;
+	offsets[5] = canny_width-1;
+	offsets[6] = canny_width;
+	offsets[7] = canny_width+1;
+	do {
+		overflow = 0;
+		for (y = 1 ; y < canny_height-1 ; y++) {
+			for (x = 1 ; x < canny_width-1 ; x++) {
+				if (edges[y*canny_width+x] != CANNY_STRONG_EDGE)
+					continue;
+				count = 0;
+				canny_worklist[count++] = y*canny_width+x;
+				while (count > 0) {
+					index = canny_worklist[--count];
+					for (neighbor = 0 ; neighbor < 8 ; neighbor++) {
+						if (edges[index+offsets[neighbor]] != CANNY_WEAK_EDGE)
+							continue;
+						edges[index+offsets[neighbor]] = CANNY_STRONG_EDGE;
+						if (count < CANNY_WORKLIST_SIZE)
+							canny_worklist[count++] = index+offsets[neighbor];
+						else
+							overflow = 1;
+					}
+				}
+			}
+		}
+	} while (overflow != 0);
+	for (index = 0 ; index < canny_width*canny_height ; index++)
+		if (edges[index] != CANNY_STRONG_EDGE)
+			edges[index] = CANNY_NO_EDGE;
+}
+
+/*
+ * The stages run with a delay of one line each: when line y is blurred, the
+ * gradient of line y-1 and the suppression of line y-2 can be done.
+ */
+void canny(unsigned char *source,
+		   unsigned char *destination,
+		   unsigned char low_threshold,
+		   unsigned char high_threshold) {
+	int y,x;
+
+	if (canny_width == 0)
+		return;
+	for (y = 0 ; y < canny_height+2 ; y++) {
+		if (y < canny_height) {
+			canny_rotate_blur_lines();
+			canny_blur_line(source,y,canny_blur_lines[2]);
+		}
+		if (y >= 1 && y <= canny_height) {
+			canny_rotate_gradient_lines();
+			if (y-1 == 0 || y-1 == canny_height-1) {
+				for (x = 0 ; x < canny_width ; x++)
+					canny_gradient_lines[2][x] = 0;
+			} else {
+				sobel_gradient_line(canny_blur_lines[0],
+				                    canny_blur_lines[1],
+				                    canny_blur_lines[2],
+				                    canny_gradient_lines[2],
+				                    canny_width);
+			}
+		}
+		if (y >= 2) {
+			if (y-2 == 0 || y-2 == canny_height-1) {
+				for (x = 0 ; x < canny_width ; x++)
+					destination[(y-2)*canny_width+x] = CANNY_NO_EDGE;
+			} else {
+				canny_suppress_line(&destination[(y-2)*canny_width],
+				                    low_threshold,high_threshold);
+			}
+		}
+	}
+	canny_hysteresis(destination);
+}
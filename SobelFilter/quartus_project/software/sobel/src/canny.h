@@ -0,0 +1,55 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file canny.h
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Canny edge detector: 3x3 gaussian blur, sobel gradient, non maximum
+ * suppression and double threshold are done line by line on rolling
+ * windows of 3 lines each. Only the edge map has the size of the frame;
+ * frames wider than CANNY_MAX_WIDTH are not processed.
+ * The hysteresis then grows the strong edges into the weak ones with a
+ * fixed size worklist.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef CANNY_H_
+#define CANNY_H_
+
+#include <stdlib.h>
+
+#define CANNY_WORKLIST_SIZE 1024
+#define CANNY_MAX_WIDTH 640
+
+#define CANNY_NO_EDGE 0
+#define CANNY_WEAK_EDGE 0x80
+#define CANNY_STRONG_EDGE 0xFF
+
+void init_canny(int width , int height);
+
+void canny(unsigned char *source,
+		   unsigned char *destination,
+		   unsigned char low_threshold,
+		   unsigned char high_threshold);
+
+#endif /* CANNY_H_ */
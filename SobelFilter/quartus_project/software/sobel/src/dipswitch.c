@@ -29,9 +29,54 @@
  */
 
 #include "dipswitch.h"
+#include "input_event.h"
+#include <stdlib.h>
+#include <sys/alt_irq.h>
+#include <altera_avalon_pio_regs.h>
+
+unsigned int DIPSW_dropped = 0;
 
 unsigned char DIPSW_get_value() {
 	return IORD_8DIRECT(DIPSW_BASE,0)^0xFF;
 }
 
+#if DIPSW_IRQ >= 0
+/* The edge capture register only clears the bits written with a one */
+void DIPSW_edge_irq(void *context) {
+	unsigned char changed = IORD_ALTERA_AVALON_PIO_EDGE_CAP(DIPSW_BASE);
+	IOWR_ALTERA_AVALON_PIO_EDGE_CAP(DIPSW_BASE,changed);
+	input_event_put(&input_events,INPUT_EVENT_DIPSW,DIPSW_get_value(),changed);
+}
+#endif
+
+/* Returns the switches at start, the changes arrive as events */
+unsigned char DIPSW_init_events() {
+	input_event_init(&input_events);
+#if DIPSW_IRQ >= 0
+	IOWR_ALTERA_AVALON_PIO_EDGE_CAP(DIPSW_BASE,0xFF);
+	alt_ic_isr_register(DIPSW_IRQ_INTERRUPT_CONTROLLER_ID,DIPSW_IRQ,
+			            DIPSW_edge_irq,NULL,NULL);
+	IOWR_ALTERA_AVALON_PIO_IRQ_MASK(DIPSW_BASE,0xFF);
+#endif
+	return DIPSW_get_value();
+}
+
+unsigned char DIPSW_update(unsigned char value) {
+#if DIPSW_IRQ >= 0
+	input_event_t event;
+	while (input_event_get(&input_events,&event) != 0) {
+		if (event.source == INPUT_EVENT_DIPSW)
+			value = event.value;
+	}
+	if (input_events.dropped != DIPSW_dropped) {
+		/* a bouncing switch filled the queue, the last change may be lost */
+		DIPSW_dropped = input_events.dropped;
+		value = DIPSW_get_value();
+	}
+	return value;
+#else
+	return DIPSW_get_value();
+#endif
+}
+
 
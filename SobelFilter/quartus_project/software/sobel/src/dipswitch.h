@@ -45,5 +45,15 @@
 
 unsigned char DIPSW_get_value();
 
+/*
+ * With the edge capture interrupt of the dipsw PIO each change of a switch is
+ * put in input_events; DIPSW_update applies them to the last value, so the
+ * main loop does not read the PIO. Without the interrupt (DIPSW_IRQ < 0)
+ * DIPSW_update reads the switches as before.
+ */
+unsigned char DIPSW_init_events();
+
+unsigned char DIPSW_update(unsigned char value);
+
 
 #endif /* DIPSWITCH_H_ */
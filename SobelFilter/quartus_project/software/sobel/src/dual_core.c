@@ -0,0 +1,122 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file dual_core.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+#include "dual_core.h"
+
+#ifdef DUAL_CORE
+#include "camera.h"
+#include "framebuffer.h"
+#include "lcd_simple.h"
+#include "vga.h"
+#include "altera_avalon_mutex.h"
+
+/* Shows the jobs finished by core 1 and returns their number */
+unsigned int dual_core_display(dual_shared_t *shared) {
+	dual_job_t *job;
+	frame_buffer_t *output;
+	unsigned int done = 0;
+	while ((job = (dual_job_t *)frame_queue_get(&shared->to_display)) != NULL) {
+		output = (frame_buffer_t *)job->output;
+		/* core 1 has flushed the output, core 0 never wrote it */
+		output->cpu_written = 0;
+		fb_show_lcd(output,job->result.lcd_start,shared->width,
+				    shared->height,job->result.lcd_format);
+		if (job->result.vga_swap != 0)
+			fb_show_vga(output,job->result.vga_swap);
+		fb_release(output,FB_USER_CPU);
+		fb_release((frame_buffer_t *)job->camera,FB_USER_CPU);
+		done++;
+	}
+	return done;
+}
+
+/*
+ * Main loop of core 0, does not return. The jobs are finished in the order
+ * they are queued, hence job[next_job%DUAL_JOBS] is free as long as less than
+ * DUAL_JOBS jobs are in flight.
+ */
+void dual_core_capture(int width,
+		               int height,
+		               unsigned int frame_bytes) {
+	dual_shared_t *shared = DUAL_SHARED;
+	alt_mutex_dev *mutex;
+	frame_buffer_t *camera, *output;
+	dual_job_t *job;
+	unsigned char current_mode;
+	unsigned int next_job = 0;
+	unsigned int in_flight = 0;
+	shared->width = width;
+	shared->height = height;
+	shared->frame_bytes = frame_bytes;
+	frame_queue_init(&shared->to_compute);
+	frame_queue_init(&shared->to_display);
+	current_mode = DIPSW_get_value();
+	mutex = altera_avalon_mutex_open(MUTEX_NAME);
+	if (mutex == NULL) {
+		printf("No mutex, core 1 is not started\n");
+		return;
+	}
+	altera_avalon_mutex_unlock(mutex);
+	printf("Filter chain runs on core 1\n");
+	do {
+		in_flight -= dual_core_display(shared);
+		if (in_flight == DUAL_JOBS || new_image_available() == 0 ||
+			current_image_valid() == 0)
+			continue;
+		camera = fb_camera_take_frame();
+		if (camera == NULL)
+			continue;
+		current_mode = DIPSW_update(current_mode);
+		if ((current_mode&FILTER_MODE_MASK) == 0) {
+			/* nothing to compute, the camera picture is shown */
+			fb_show_lcd(camera,
+					    &((unsigned short *)camera->pixels)[FILTER_LCD_OFFSET],
+					    width,height,LCD_DMA_Color);
+			if ((current_mode&DIPSW_SW8_MASK)!=0)
+				fb_show_vga(camera,VGA_QuarterScreen);
+			fb_release(camera,FB_USER_CPU);
+			continue;
+		}
+		output = fb_alloc(FB_USER_CPU);
+		if (output == NULL) {
+			fb_release(camera,FB_USER_CPU);
+			continue;
+		}
+		job = &shared->job[next_job++%DUAL_JOBS];
+		job->camera = camera;
+		job->output = output;
+		job->source = (unsigned short *)camera->pixels;
+		job->destination = output->pixels;
+		job->current_mode = current_mode;
+		/* cannot be full, the queue has more slots than there are jobs */
+		frame_queue_put(&shared->to_compute,job);
+		in_flight++;
+	} while (1);
+}
+#endif
@@ -0,0 +1,85 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file dual_core.h
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Frame pipeline of the base_system_dual variant. CPU (core 0) runs the
+ * sobel application: it owns the camera, the frame buffer pool, the LCD and
+ * the VGA. CPU_1 (core 1) runs the sobel_compute application, which only
+ * runs the filter chain. A frame is handed over by the pointer of a job in
+ * two frame queues, to_compute (core 0 to core 1) and to_display (back).
+ *
+ * The jobs and the queues are in the top 4 KB of the sdram, which neither
+ * BSP links into, and are accessed through the cache bypass. The pixels stay
+ * cached: core 1 flushes the source lines before and the destination lines
+ * after the filter chain, so core 0 and the DMA masters see the sdram.
+ *
+ * The hardware mutex is owned by core 0 after reset; core 0 releases it when
+ * the shared memory is set up, core 1 waits for it before its first access.
+ * With the BSP of a single core system (no mutex) DUAL_CORE is not defined
+ * and the sobel application runs the whole chain on its own.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef DUAL_CORE_H_
+#define DUAL_CORE_H_
+
+#include <system.h>
+#include "frame_queue.h"
+#include "filter_chain.h"
+
+#ifdef MUTEX_BASE
+#define DUAL_CORE
+#endif
+
+/* one frame in the filter chain and one waiting, at most FRAME_QUEUE_SLOTS */
+#define DUAL_JOBS 2
+#define DUAL_SHARED_SIZE 0x1000
+#define DUAL_SHARED_ADDRESS (SDRAM_CTRL_BASE+SDRAM_CTRL_SPAN-DUAL_SHARED_SIZE)
+#define DUAL_SHARED \
+	((dual_shared_t *)(DUAL_SHARED_ADDRESS|NIOS2_DCACHE_BYPASS_MASK))
+
+typedef struct dual_job {
+	void *camera;              // frame_buffer_t of core 0
+	void *output;              // frame_buffer_t of core 0
+	unsigned short *source;
+	void *destination;
+	unsigned char current_mode;
+	filter_output_t result;    // filled in by core 1
+} dual_job_t;
+
+typedef struct dual_shared {
+	int width;
+	int height;
+	unsigned int frame_bytes;
+	frame_queue_t to_compute;
+	frame_queue_t to_display;
+	dual_job_t job[DUAL_JOBS];
+} dual_shared_t;
+
+void dual_core_capture(int width,
+		               int height,
+		               unsigned int frame_bytes);
+
+#endif /* DUAL_CORE_H_ */
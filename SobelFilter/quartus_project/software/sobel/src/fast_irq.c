@@ -0,0 +1,141 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file fast_irq.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stddef.h>
+#include <system.h>
+#include <io.h>
+#include <sys/alt_irq.h>
+#include "fast_irq.h"
+
+/* fails to compile when the layout does not match fast_irq.S */
+typedef char fast_irq_layout_check[
+	(offsetof(fast_irq_source_t,mask) == FAST_SRC_MASK &&
+	 offsetof(fast_irq_source_t,ack) == FAST_SRC_ACK &&
+	 offsetof(fast_irq_source_t,keep) == FAST_SRC_KEEP &&
+	 offsetof(fast_irq_source_t,set) == FAST_SRC_SET &&
+	 offsetof(fast_irq_source_t,count) == FAST_SRC_COUNT &&
+	 offsetof(fast_irq_source_t,time) == FAST_SRC_TIME &&
+	 offsetof(fast_irq_table_t,mask) == FAST_TABLE_MASK &&
+	 offsetof(fast_irq_table_t,source) == FAST_TABLE_SOURCE) ? 1 : -1];
+
+fast_irq_table_t fast_irq_table;
+
+/*
+ * The same work as the fast entry, for the sources on the HAL path. The
+ * read back ends the write before alt_irq_handler() reads ipending again.
+ */
+void fast_irq_hal(void *context) {
+	fast_irq_source_t *source = (fast_irq_source_t *)context;
+	IOWR_16DIRECT(source->ack,0,
+			      (IORD_16DIRECT(source->ack,0)&source->keep)|source->set);
+	IORD_16DIRECT(source->ack,0);
+#ifdef PERFORMANCE_COUNTER_0_BASE
+	source->time = IORD(PERFORMANCE_COUNTER_0_BASE,0);
+#endif
+	source->count++;
+}
+
+/*
+ * Returns 0 when all slots are used; the source is then not registered and
+ * the caller keeps its own HAL handler.
+ */
+char fast_irq_register(fast_irq_source_t *source,
+		               unsigned int ic_id,
+		               unsigned int irq,
+		               unsigned int ack,
+		               unsigned short keep,
+		               unsigned short set) {
+	alt_irq_context context;
+	int slot;
+	context = alt_irq_disable_all();
+	for (slot = 0 ; slot < FAST_IRQ_SLOTS ; slot++)
+		if (fast_irq_table.source[slot] == NULL ||
+			fast_irq_table.source[slot] == source)
+			break;
+	if (slot == FAST_IRQ_SLOTS) {
+		alt_irq_enable_all(context);
+		return 0;
+	}
+	source->mask = 1<<irq;
+	source->ack = ack;
+	source->keep = keep;
+	source->set = set;
+	source->count = 0;
+	source->time = 0;
+	source->taken = 0;
+	fast_irq_table.source[slot] = source;
+	alt_ic_isr_register(ic_id,irq,fast_irq_hal,source,NULL);
+	alt_irq_enable_all(context);
+	fast_irq_route(source,1);
+	return 1;
+}
+
+/* fast 0 takes the source through the HAL */
+void fast_irq_route(fast_irq_source_t *source,
+		            char fast) {
+#ifndef NIOS2_EIC_PRESENT
+	alt_irq_context context;
+	context = alt_irq_disable_all();
+	if (fast != 0)
+		fast_irq_table.mask |= source->mask;
+	else
+		fast_irq_table.mask &= ~source->mask;
+	alt_irq_enable_all(context);
+#endif
+}
+
+/*
+ * Takes the source off both paths and frees its slot. The fast entry walks
+ * source[] until it has found all pending sources, so the slots after it
+ * move down and no hole is left.
+ */
+void fast_irq_release(fast_irq_source_t *source,
+		              unsigned int ic_id,
+		              unsigned int irq) {
+	alt_irq_context context;
+	int slot;
+	fast_irq_route(source,0);
+	alt_ic_isr_register(ic_id,irq,NULL,NULL,NULL);
+	context = alt_irq_disable_all();
+	for (slot = 0 ; slot < FAST_IRQ_SLOTS ; slot++)
+		if (fast_irq_table.source[slot] == source)
+			break;
+	for ( ; slot < FAST_IRQ_SLOTS ; slot++)
+		fast_irq_table.source[slot] = (slot+1 < FAST_IRQ_SLOTS) ?
+				                      fast_irq_table.source[slot+1] : NULL;
+	source->mask = 0;
+	alt_irq_enable_all(context);
+}
+
+/* The interrupts counted since the last call; main loop only */
+unsigned int fast_irq_take(fast_irq_source_t *source) {
+	unsigned int count = source->count;
+	unsigned int events = count-source->taken;
+	source->taken = count;
+	return events;
+}
@@ -0,0 +1,119 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file fast_irq.h
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Fast path for the interrupts that only acknowledge the device and count:
+ * the camera frame ready and the LCD end of DMA. The HAL saves the caller
+ * saved registers and goes through alt_irq_handler() for each interrupt,
+ * which costs more than the work itself. A fast source is a descriptor:
+ * its ipending bit, the 16 bit register that acknowledges it (rewritten as
+ * (value&keep)|set), a count and the low word of the performance counter
+ * at the last interrupt. fast_irq.S is linked into the exception entry in
+ * front of the HAL (section .exceptions.entry.user); it serves all pending
+ * fast sources first, with 4 registers saved. Each acknowledge is read
+ * back, so the line is down when ipending is read again; the fast sources
+ * pending again are served again. Then the entry returns with eret, or
+ * goes on to the HAL when other interrupts are pending, with no fast
+ * source left in ipending. The main loop takes the counts with
+ * fast_irq_take() and does the rest of the work (framebuffer.c).
+ *
+ * fast_irq_register() also registers the source with the HAL, with a C
+ * handler that does the same work. This is the fallback: with an external
+ * interrupt controller (EIC) the fast entry is not built and every source
+ * goes through the HAL; fast_irq_route() moves a source between the two
+ * paths at run time for fast_irq_bench(), fast_irq_release() frees its
+ * slot again.
+ *
+ * Budget of the fast entry, Nios II/f with the exception code in the
+ * instruction cache: 14 instructions to find a fast source, 23 for each
+ * source served (two 16 bit reads and one write of its register, one read
+ * of the performance counter), 5 for each registered source skipped and
+ * 13 to return; 50 instructions for one source. The interrupts of the HAL
+ * pay 18 instructions more for the test. These are counted in fast_irq.S;
+ * FAST_IRQ_CYCLE_BUDGET, the cycles an interrupt of one source takes from
+ * the main loop with the exception and the eret, is only an estimate from
+ * them, as the wait states of the I/O accesses are not known. It is not a
+ * measured value: fast_irq_bench() measures both paths on the board and
+ * counts the interrupts over the budget.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef FAST_IRQ_H_
+#define FAST_IRQ_H_
+
+#define FAST_IRQ_SLOTS 4
+#define FAST_IRQ_CYCLE_BUDGET 140 // estimate, see above
+
+/* the layout of the descriptors as used by fast_irq.S */
+#define FAST_SRC_MASK 0
+#define FAST_SRC_ACK 4
+#define FAST_SRC_KEEP 8
+#define FAST_SRC_SET 10
+#define FAST_SRC_COUNT 12
+#define FAST_SRC_TIME 16
+#define FAST_TABLE_MASK 0
+#define FAST_TABLE_SOURCE 4
+
+#ifndef __ASSEMBLER__
+
+typedef struct fast_irq_source {
+	unsigned int mask;
+	unsigned int ack;
+	unsigned short keep;
+	unsigned short set;
+	volatile unsigned int count;
+	volatile unsigned int time;  // performance counter, last interrupt
+	unsigned int taken;
+} fast_irq_source_t;
+
+/* the fast entry serves the sources of mask, source[] is filled in order */
+typedef struct fast_irq_table {
+	volatile unsigned int mask;
+	fast_irq_source_t *source[FAST_IRQ_SLOTS];
+} fast_irq_table_t;
+
+extern fast_irq_table_t fast_irq_table;
+
+char fast_irq_register(fast_irq_source_t *source,
+		               unsigned int ic_id,
+		               unsigned int irq,
+		               unsigned int ack,
+		               unsigned short keep,
+		               unsigned short set);
+
+void fast_irq_route(fast_irq_source_t *source,
+		            char fast);
+
+void fast_irq_release(fast_irq_source_t *source,
+		              unsigned int ic_id,
+		              unsigned int irq);
+
+unsigned int fast_irq_take(fast_irq_source_t *source);
+
+void fast_irq_bench(void);
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* FAST_IRQ_H_ */
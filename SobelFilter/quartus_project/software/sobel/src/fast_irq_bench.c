@@ -0,0 +1,170 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file fast_irq_bench.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Before/after numbers of fast_irq.h. The ProfileTimer interrupts every
+ * 100 us and is registered as a fast source (the acknowledge is a write of
+ * its status register). The main loop reads the global counter of the
+ * performance counter in a tight loop; for each interrupt it takes the
+ * cycles it lost, from the exception to the eret plus one turn of the
+ * loop. BENCH_SAMPLES interrupts are measured on the HAL path and on the
+ * fast path, with only the timer interrupt enabled. The HAL numbers
+ * include the test of the fast entry.
+ *
+ * Built with FAST_IRQ_BENCH defined main() runs it before the camera is
+ * started; the ProfileTimer is the timestamp timer of the BSP and is
+ * started again by DIPSW_init_events(). The timer gives its fast slot back
+ * at the end.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+#include <system.h>
+#include <io.h>
+#include <nios2.h>
+#include <sys/alt_irq.h>
+#include "fast_irq.h"
+#include "altera_avalon_timer_regs.h"
+#include "altera_avalon_performance_counter.h"
+
+#define BENCH_SAMPLES 1000
+#define BENCH_PERIOD 4999
+#define BENCH_CALIBRATE 100
+
+#define BENCH_CLOCK() ((unsigned int)IORD(PERFORMANCE_COUNTER_0_BASE,0))
+
+typedef struct bench_result {
+	const char *name;
+	unsigned int min;
+	unsigned int max;
+	unsigned int over;
+	unsigned long long total;
+} bench_result_t;
+
+fast_irq_source_t bench_timer;
+
+/* the min of two clock reads */
+unsigned int bench_clock_cost(void) {
+	unsigned int start, end, min = 0xFFFFFFFF;
+	int loop;
+	for (loop = 0 ; loop < BENCH_CALIBRATE ; loop++) {
+		start = BENCH_CLOCK();
+		end = BENCH_CLOCK();
+		if (end-start < min)
+			min = end-start;
+	}
+	return min;
+}
+
+/*
+ * The interrupt falls between two clock reads of the loop or between the
+ * last one and the read after the loop, the longer gap is taken.
+ */
+void bench_run(bench_result_t *result,
+		       unsigned int cost) {
+	unsigned int seen, before, now, after, lost;
+	int sample;
+	result->min = 0xFFFFFFFF;
+	result->max = 0;
+	result->over = 0;
+	result->total = 0;
+	seen = bench_timer.count;
+	now = BENCH_CLOCK();
+	for (sample = 0 ; sample < BENCH_SAMPLES ; sample++) {
+		do {
+			before = now;
+			now = BENCH_CLOCK();
+		} while (bench_timer.count == seen);
+		after = BENCH_CLOCK();
+		seen = bench_timer.count;
+		lost = (now-before > after-now) ? now-before : after-now;
+		lost = (lost > cost) ? lost-cost : 0;
+		result->total += lost;
+		if (lost < result->min)
+			result->min = lost;
+		if (lost > result->max)
+			result->max = lost;
+		if (lost > FAST_IRQ_CYCLE_BUDGET)
+			result->over++;
+		now = BENCH_CLOCK();
+	}
+}
+
+void bench_print(bench_result_t *result) {
+	printf("%-5s %6u %6u %6u %6u\n",result->name,result->min,
+		   (unsigned int)(result->total/BENCH_SAMPLES),result->max,
+		   result->over);
+}
+
+void fast_irq_bench(void) {
+	bench_result_t hal = {"HAL"}, fast = {"fast"};
+	alt_irq_context context;
+	alt_u32 ienable;
+	unsigned int cost;
+	PERF_RESET(PERFORMANCE_COUNTER_0_BASE);
+	PERF_START_MEASURING(PERFORMANCE_COUNTER_0_BASE);
+	IOWR_ALTERA_AVALON_TIMER_CONTROL(PROFILETIMER_BASE,
+			ALTERA_AVALON_TIMER_CONTROL_STOP_MSK);
+	IOWR_ALTERA_AVALON_TIMER_PERIODL(PROFILETIMER_BASE,BENCH_PERIOD&0xFFFF);
+	IOWR_ALTERA_AVALON_TIMER_PERIODH(PROFILETIMER_BASE,BENCH_PERIOD>>16);
+	IOWR_ALTERA_AVALON_TIMER_STATUS(PROFILETIMER_BASE,0);
+	NIOS2_READ_IENABLE(ienable);
+	if (fast_irq_register(&bench_timer,PROFILETIMER_IRQ_INTERRUPT_CONTROLLER_ID,
+			              PROFILETIMER_IRQ,PROFILETIMER_BASE,0,0) == 0) {
+		printf("fast_irq_bench: no free slot\n");
+		return;
+	}
+	/* only the timer interrupts the runs */
+	context = alt_irq_disable_all();
+	NIOS2_WRITE_IENABLE(1<<PROFILETIMER_IRQ);
+	alt_irq_enable_all(context);
+	cost = bench_clock_cost();
+	IOWR_ALTERA_AVALON_TIMER_CONTROL(PROFILETIMER_BASE,
+			ALTERA_AVALON_TIMER_CONTROL_ITO_MSK|
+			ALTERA_AVALON_TIMER_CONTROL_CONT_MSK|
+			ALTERA_AVALON_TIMER_CONTROL_START_MSK);
+	fast_irq_route(&bench_timer,0);
+	bench_run(&hal,cost);
+	fast_irq_route(&bench_timer,1);
+	bench_run(&fast,cost);
+	IOWR_ALTERA_AVALON_TIMER_CONTROL(PROFILETIMER_BASE,
+			ALTERA_AVALON_TIMER_CONTROL_STOP_MSK);
+	IOWR_ALTERA_AVALON_TIMER_STATUS(PROFILETIMER_BASE,0);
+	context = alt_irq_disable_all();
+	NIOS2_WRITE_IENABLE(ienable);
+	alt_irq_enable_all(context);
+	/* the slot and the mask bit are for the sources of the application */
+	fast_irq_release(&bench_timer,PROFILETIMER_IRQ_INTERRUPT_CONTROLLER_ID,
+			         PROFILETIMER_IRQ);
+	PERF_STOP_MEASURING(PERFORMANCE_COUNTER_0_BASE);
+#ifdef NIOS2_EIC_PRESENT
+	printf("EIC present, both runs took the HAL path\n");
+#endif
+	printf("%d timer interrupts each, cycles lost by the main loop "
+		   "(clock read %u subtracted):\n",BENCH_SAMPLES,cost);
+	printf("path     min    avg    max  >%d\n",FAST_IRQ_CYCLE_BUDGET);
+	bench_print(&hal);
+	bench_print(&fast);
+}
@@ -0,0 +1,225 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file filter_chain.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+#include <system.h>
+#include "filter_chain.h"
+#include "lcd_simple.h"
+#include "vga.h"
+#include "grayscale.h"
+#include "sobel.h"
+#include "integral.h"
+#include "canny.h"
+#include "morphology.h"
+#include "median.h"
+#include "trace.h"
+#include "altera_avalon_performance_counter.h"
+
+int filter_width;
+
+int filter_height;
+
+/* The chain has its own contexts, the outputs are set for each frame */
+gray_ctx_t filter_gray;
+
+sobel_ctx_t filter_sobel;
+
+void init_filter_chain(int width , int height) {
+	int pixels = width*height;
+	filter_width = width;
+	filter_height = height;
+	free(filter_gray.picture);
+	gray_ctx_init(&filter_gray,width,height,(unsigned char *)malloc(pixels));
+	free(filter_sobel.x_result);
+	free(filter_sobel.y_result);
+	free(filter_sobel.gradient);
+	sobel_ctx_init(&filter_sobel,width,height,
+			       (short *)calloc(pixels,sizeof(short)),
+			       (short *)calloc(pixels,sizeof(short)),
+			       (unsigned short *)calloc(pixels,sizeof(unsigned short)),
+			       NULL,NULL);
+	init_integral_image(width,height);
+	init_canny(width,height);
+	init_morphology(width,height);
+	init_median(width,height);
+}
+
+/* The grayscale of the modes 2 to 7, into the picture of the chain context */
+unsigned char *filter_to_gray(unsigned short *image) {
+	trace_begin(TRACE_GRAY,0);
+	gray_ctx_convert(&filter_gray,(void *)image);
+	trace_end(TRACE_GRAY,0);
+	return filter_gray.picture;
+}
+
+/*
+ * SW4 selects the median filter against the camera noise in the modes 1 to 6;
+ * in mode 7 SW4 to SW6 are the morphology switches of the edge map.
+ */
+void denoise(unsigned char *grayscale,
+		     unsigned char current_mode) {
+	if ((current_mode&DIPSW_SW4_MASK)==0 ||
+		(current_mode&FILTER_MODE_MASK)==FILTER_MODE_MASK)
+		return;
+	PERF_BEGIN(PERFORMANCE_COUNTER_0_BASE,PERF_MEDIAN_SECTION);
+	trace_begin(TRACE_MEDIAN,0);
+	median_filter(grayscale);
+	trace_end(TRACE_MEDIAN,0);
+	PERF_END(PERFORMANCE_COUNTER_0_BASE,PERF_MEDIAN_SECTION);
+}
+
+/*
+ * image is the RGB565 camera picture; destination is the output buffer of the
+ * modes 1 to 7, in mode 0 the camera picture itself is shown.
+ */
+void filter_chain(unsigned char current_mode,
+		          unsigned short *image,
+		          void *destination,
+		          filter_output_t *output) {
+	unsigned char *grayscale;
+	unsigned int *packed;
+	int words;
+	int radius;
+	char vga = ((current_mode&DIPSW_SW8_MASK)!=0) ? VGA_QuarterScreen : 0;
+	output->lcd_format = LCD_DMA_Color;
+	output->vga_swap = vga;
+	switch (current_mode&FILTER_MODE_MASK) {
+	case 0 : output->lcd_start = &image[FILTER_LCD_OFFSET];
+	         break;
+	case 1 : grayscale = (unsigned char *)destination;
+	         trace_begin(TRACE_GRAY,0);
+	         conv_grayscale_to((void *)image,
+	        		           filter_width,
+	        		           filter_height,
+	        		           grayscale);
+	         trace_end(TRACE_GRAY,0);
+	         denoise(grayscale,current_mode);
+	         output->lcd_start = &grayscale[FILTER_LCD_OFFSET];
+	         output->lcd_format = LCD_DMA_Grayscale;
+	         output->vga_swap = vga ? vga|VGA_Grayscale : 0;
+	         break;
+	case 2 : grayscale = filter_to_gray(image);
+	         denoise(grayscale,current_mode);
+	         sobel_ctx_set_rgb_output(&filter_sobel,(unsigned short *)destination);
+	         sobel_ctx_x_with_rgb(&filter_sobel,grayscale);
+	         image = filter_sobel.rgb565;
+	         output->lcd_start = &image[FILTER_LCD_OFFSET];
+	         break;
+	case 3 : grayscale = filter_to_gray(image);
+	         denoise(grayscale,current_mode);
+	         sobel_ctx_set_rgb_output(&filter_sobel,(unsigned short *)destination);
+	         sobel_ctx_x(&filter_sobel,grayscale);
+	         sobel_ctx_y_with_rgb(&filter_sobel,grayscale);
+	         image = filter_sobel.rgb565;
+	         output->lcd_start = &image[FILTER_LCD_OFFSET];
+	         break;
+	case 4 : grayscale = filter_to_gray(image);
+	         denoise(grayscale,current_mode);
+	         integral_image(grayscale);
+	         integral_adaptive_threshold(7,15,grayscale,
+	        		                     (unsigned char *)destination);
+	         grayscale = (unsigned char *)destination;
+	         output->lcd_start = &grayscale[FILTER_LCD_OFFSET];
+	         output->lcd_format = LCD_DMA_Grayscale;
+	         output->vga_swap = vga ? vga|VGA_Grayscale : 0;
+	         break;
+	case 5 : grayscale = filter_to_gray(image);
+	         denoise(grayscale,current_mode);
+	         PERF_BEGIN(PERFORMANCE_COUNTER_0_BASE,PERF_STAGE_SECTION);
+	         trace_begin(TRACE_STAGE,current_mode&FILTER_MODE_MASK);
+	         sobel_ctx_gradient(&filter_sobel,grayscale);
+	         trace_end(TRACE_STAGE,current_mode&FILTER_MODE_MASK);
+	         PERF_END(PERFORMANCE_COUNTER_0_BASE,PERF_STAGE_SECTION);
+	         sobel_ctx_set_rgb_output(&filter_sobel,(unsigned short *)destination);
+	         sobel_ctx_gradient_rgb(&filter_sobel,32);
+	         image = filter_sobel.rgb565;
+	         output->lcd_start = &image[FILTER_LCD_OFFSET];
+	         break;
+	case 6 : grayscale = filter_to_gray(image);
+	         denoise(grayscale,current_mode);
+	         PERF_BEGIN(PERFORMANCE_COUNTER_0_BASE,PERF_STAGE_SECTION);
+	         trace_begin(TRACE_STAGE,current_mode&FILTER_MODE_MASK);
+	         canny(grayscale,(unsigned char *)destination,10,24);
+	         trace_end(TRACE_STAGE,current_mode&FILTER_MODE_MASK);
+	         PERF_END(PERFORMANCE_COUNTER_0_BASE,PERF_STAGE_SECTION);
+	         grayscale = (unsigned char *)destination;
+	         output->lcd_start = &grayscale[FILTER_LCD_OFFSET];
+	         output->lcd_format = LCD_DMA_Grayscale;
+	         output->vga_swap = vga ? vga|VGA_Grayscale : 0;
+	         break;
+	default: grayscale = filter_to_gray(image);
+	         denoise(grayscale,current_mode);
+	         sobel_ctx_x(&filter_sobel,grayscale);
+	         sobel_ctx_y(&filter_sobel,grayscale);
+	         if (vga != 0) {
+	        	 /* the VGA needs one byte each pixel */
+	        	 sobel_ctx_set_result_output(&filter_sobel,(unsigned char *)destination);
+	        	 sobel_ctx_threshold(&filter_sobel,128);
+	        	 grayscale = filter_sobel.result;
+	        	 output->lcd_start = &grayscale[FILTER_LCD_OFFSET];
+	        	 output->lcd_format = LCD_DMA_Grayscale;
+	        	 output->vga_swap = vga|VGA_Grayscale;
+	        	 break;
+	         }
+	         /* packed edge map, the LCD starts at a word boundary */
+	         packed = (unsigned int *)destination;
+	         sobel_ctx_threshold_packed(&filter_sobel,128,packed);
+	         /* SW4 opens (removes specks), SW5 closes, SW6 5x5 */
+	         radius = ((current_mode&DIPSW_SW6_MASK)!=0) ? 2 : 1;
+	         PERF_BEGIN(PERFORMANCE_COUNTER_0_BASE,PERF_STAGE_SECTION);
+	         trace_begin(TRACE_STAGE,current_mode&FILTER_MODE_MASK);
+	         if ((current_mode&DIPSW_SW4_MASK)!=0)
+	        	 morphology_open(packed,radius);
+	         if ((current_mode&DIPSW_SW5_MASK)!=0)
+	        	 morphology_close(packed,radius);
+	         trace_end(TRACE_STAGE,current_mode&FILTER_MODE_MASK);
+	         PERF_END(PERFORMANCE_COUNTER_0_BASE,PERF_STAGE_SECTION);
+	         words = BINARY_WORDS_EACH_LINE(filter_width);
+	         output->lcd_start = &packed[(FILTER_LCD_OFFSET/filter_width)*words+
+	                                     ((FILTER_LCD_OFFSET%filter_width)>>5)];
+	         output->lcd_format = LCD_DMA_Binary;
+	         break;
+	}
+}
+
+/* Prints the performance counter sections; the caller stops the counter */
+void filter_chain_report(unsigned char mode,
+		                 unsigned int frames) {
+	unsigned int median_runs;
+	printf("Mode %d, %d frames:\n",mode,frames);
+	perf_print_formatted_report((void *)PERFORMANCE_COUNTER_0_BASE,
+			ALT_CPU_FREQ,3,"frame","stage","median");
+	median_runs = perf_get_num_starts(
+			(void *)PERFORMANCE_COUNTER_0_BASE,PERF_MEDIAN_SECTION);
+	if (median_runs != 0)
+		printf("median: %u cycles per pixel\n",
+			   (unsigned int)(perf_get_section_time(
+					   (void *)PERFORMANCE_COUNTER_0_BASE,
+					   PERF_MEDIAN_SECTION)/median_runs/
+					   (filter_width*filter_height)));
+}
@@ -0,0 +1,64 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file filter_chain.h
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * The filter chain of each DIP switch mode, taken out of main.c so that it
+ * runs unchanged on the single core system and on the compute core of the
+ * dual core system (see dual_core.h). It only touches the sdram and the
+ * performance counter; showing the result is left to the caller, which gets
+ * the first pixel and the format for the LCD and the swap bits for the VGA.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef FILTER_CHAIN_H_
+#define FILTER_CHAIN_H_
+
+#include "dipswitch.h"
+
+#define PERF_FRAME_SECTION 1
+#define PERF_STAGE_SECTION 2
+#define PERF_MEDIAN_SECTION 3
+
+#define FILTER_MODE_MASK (DIPSW_SW1_MASK|DIPSW_SW2_MASK|DIPSW_SW3_MASK)
+/* first pixel of the part of the picture shown on the LCD */
+#define FILTER_LCD_OFFSET 16520
+
+typedef struct filter_output {
+	void *lcd_start;
+	char lcd_format;
+	char vga_swap; // 0 when the picture is not for the VGA (SW8 off)
+} filter_output_t;
+
+void init_filter_chain(int width , int height);
+
+void filter_chain(unsigned char current_mode,
+		          unsigned short *image,
+		          void *destination,
+		          filter_output_t *output);
+
+void filter_chain_report(unsigned char mode,
+		                 unsigned int frames);
+
+#endif /* FILTER_CHAIN_H_ */
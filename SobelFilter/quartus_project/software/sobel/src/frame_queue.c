@@ -0,0 +1,76 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file frame_queue.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include "frame_queue.h"
+
+#ifdef __nios2__
+/* The Nios II keeps its uncached data accesses in program order, only the
+ * compiler may not move the slot access across the counter access */
+#define FRAME_QUEUE_LOAD(counter) \
+	({ unsigned int v = (counter); __asm__ __volatile__("" ::: "memory"); v; })
+#define FRAME_QUEUE_STORE(counter,value) \
+	{ __asm__ __volatile__("" ::: "memory"); (counter) = (value); }
+#else
+#define FRAME_QUEUE_LOAD(counter) __atomic_load_n(&(counter),__ATOMIC_ACQUIRE)
+#define FRAME_QUEUE_STORE(counter,value) \
+	__atomic_store_n(&(counter),(value),__ATOMIC_RELEASE)
+#endif
+
+void frame_queue_init(frame_queue_t *queue) {
+	int loop;
+	queue->head = 0;
+	queue->tail = 0;
+	for (loop = 0 ; loop < FRAME_QUEUE_SLOTS ; loop++)
+		queue->slot[loop] = NULL;
+}
+
+/* Producer side; returns 0 when the queue is full */
+char frame_queue_put(frame_queue_t *queue,
+		             void *frame) {
+	unsigned int head = queue->head;
+	if (head-FRAME_QUEUE_LOAD(queue->tail) >= FRAME_QUEUE_SLOTS)
+		return 0;
+	queue->slot[head&(FRAME_QUEUE_SLOTS-1)] = frame;
+	FRAME_QUEUE_STORE(queue->head,head+1);
+	return 1;
+}
+
+/* Consumer side; returns NULL when the queue is empty */
+void *frame_queue_get(frame_queue_t *queue) {
+	unsigned int tail = queue->tail;
+	void *frame;
+	if (FRAME_QUEUE_LOAD(queue->head) == tail)
+		return NULL;
+	frame = queue->slot[tail&(FRAME_QUEUE_SLOTS-1)];
+	FRAME_QUEUE_STORE(queue->tail,tail+1);
+	return frame;
+}
+
+unsigned int frame_queue_count(frame_queue_t *queue) {
+	return FRAME_QUEUE_LOAD(queue->head)-FRAME_QUEUE_LOAD(queue->tail);
+}
@@ -0,0 +1,63 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file frame_queue.h
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Lock-free single producer, single consumer queue of frame pointers. The
+ * producer only writes head and the consumer only writes tail; both are free
+ * running counters, so head-tail is the number of queued frames. No lock is
+ * needed as long as the slot is written before head (put) and read before
+ * tail (get) is advanced.
+ *
+ * On the dual core base_system the queues live in the shared sdram and are
+ * accessed through the cache bypass (bit 31 of the address), see dual_core.h.
+ * The same sources build on the host, where the counters are accessed with
+ * acquire/release atomics (software/host/frame_queue_model.c).
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef FRAME_QUEUE_H_
+#define FRAME_QUEUE_H_
+
+#include <stdlib.h>
+
+/* must be a power of two */
+#define FRAME_QUEUE_SLOTS 4
+
+typedef struct frame_queue {
+	volatile unsigned int head;
+	volatile unsigned int tail;
+	void * volatile slot[FRAME_QUEUE_SLOTS];
+} frame_queue_t;
+
+void frame_queue_init(frame_queue_t *queue);
+
+char frame_queue_put(frame_queue_t *queue,
+		             void *frame);
+
+void *frame_queue_get(frame_queue_t *queue);
+
+unsigned int frame_queue_count(frame_queue_t *queue);
+
+#endif /* FRAME_QUEUE_H_ */
@@ -0,0 +1,228 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file framebuffer.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include "framebuffer.h"
+#include "camera.h"
+#include "lcd_simple.h"
+#include "vga.h"
+#include "trace.h"
+#include <sys/alt_irq.h>
+#include <sys/alt_cache.h>
+
+frame_buffer_t fb_pool[FB_NR_OF_BUFFERS];
+unsigned int fb_size = 0;
+
+frame_buffer_t * volatile fb_lcd_current = NULL;
+frame_buffer_t *fb_vga_current = NULL;
+frame_buffer_t * volatile fb_vga_retiring = NULL;
+/* the LCD end of DMA, taken by the main loop in fb_lcd_poll() */
+fast_irq_source_t fb_lcd_end;
+
+void fb_lcd_irq(void *context) {
+	trace_end(TRACE_LCD_DMA,fb_lcd_current-fb_pool);
+	fb_lcd_done();
+	LCD_clear_irq();
+}
+
+void fb_vga_flip(void *context) {
+	fb_vga_frame_end();
+}
+
+void fb_init(unsigned int bytes_each_buffer) {
+	int loop;
+	fb_size = bytes_each_buffer;
+	for (loop = 0 ; loop < FB_NR_OF_BUFFERS ; loop++) {
+		if (fb_pool[loop].pixels != NULL)
+			free(fb_pool[loop].pixels);
+		fb_pool[loop].pixels = malloc(bytes_each_buffer);
+		fb_pool[loop].users = 0;
+		fb_pool[loop].camera_slot = -1;
+		fb_pool[loop].cpu_written = 0;
+	}
+	fb_lcd_current = NULL;
+	fb_vga_current = NULL;
+	fb_vga_retiring = NULL;
+	if (LCD_register_fast_irq(&fb_lcd_end) != 0)
+		trace_latch(&fb_lcd_end.time);
+	else
+		LCD_register_irq(fb_lcd_irq,NULL);
+	vga_register_flip_callback(fb_vga_flip,NULL);
+}
+
+frame_buffer_t *fb_alloc(unsigned char user) {
+	int loop;
+	alt_irq_context context;
+	frame_buffer_t *result = NULL;
+	fb_lcd_poll();
+	context = alt_irq_disable_all();
+	for (loop = 0 ; loop < FB_NR_OF_BUFFERS && result == NULL ; loop++) {
+		if (fb_pool[loop].users == 0 && fb_pool[loop].pixels != NULL) {
+			result = &fb_pool[loop];
+			result->users = user;
+			result->camera_slot = -1;
+			result->cpu_written = (user == FB_USER_CPU) ? 1 : 0;
+		}
+	}
+	alt_irq_enable_all(context);
+	return result;
+}
+
+void fb_acquire(frame_buffer_t *buffer,
+		        unsigned char user) {
+	alt_irq_context context;
+	if (buffer == NULL)
+		return;
+	context = alt_irq_disable_all();
+	buffer->users |= user;
+	alt_irq_enable_all(context);
+}
+
+void fb_release(frame_buffer_t *buffer,
+		        unsigned char user) {
+	alt_irq_context context;
+	if (buffer == NULL)
+		return;
+	context = alt_irq_disable_all();
+	buffer->users &= ~user;
+	alt_irq_enable_all(context);
+}
+
+/*
+ * The camera keeps 4 buffers in its pointer slots. When a frame is taken, the
+ * completed slot is refilled with a free buffer. The cam_dma only selects the
+ * next slot at the start of a frame, so the refilled slot is used again after
+ * three more frames.
+ */
+void fb_camera_start(void) {
+	char slot;
+	frame_buffer_t *buffer;
+	for (slot = 0 ; slot < FB_NR_OF_CAMERA_SLOTS ; slot++) {
+		buffer = fb_alloc(FB_USER_CAMERA);
+		if (buffer == NULL)
+			return;
+		alt_dcache_flush(buffer->pixels,fb_size);
+		buffer->camera_slot = slot;
+		cam_set_image_pointer(slot,buffer->pixels);
+	}
+}
+
+frame_buffer_t *fb_camera_take_frame(void) {
+	int loop;
+	void *image = current_image_pointer();
+	frame_buffer_t *buffer = NULL, *refill;
+	for (loop = 0 ; loop < FB_NR_OF_BUFFERS ; loop++)
+		if (fb_pool[loop].pixels == image && fb_pool[loop].camera_slot >= 0)
+			buffer = &fb_pool[loop];
+	if (buffer == NULL)
+		return NULL;
+	refill = fb_alloc(FB_USER_CAMERA);
+	if (refill == NULL)
+		return NULL; // pool exhausted, the camera keeps this buffer (frame drop)
+	alt_dcache_flush(refill->pixels,fb_size);
+	refill->camera_slot = buffer->camera_slot;
+	cam_set_image_pointer(refill->camera_slot,refill->pixels);
+	buffer->camera_slot = -1;
+	buffer->cpu_written = 0;
+	fb_acquire(buffer,FB_USER_CPU);
+	fb_release(buffer,FB_USER_CAMERA);
+	return buffer;
+}
+
+/*
+ * Returns 0 when the LCD is still busy with the previous buffer; in this case
+ * the new buffer is not shown (the frame is dropped for the LCD only).
+ */
+char fb_show_lcd(frame_buffer_t *buffer,
+		         void *start,
+		         int width,
+		         int height,
+		         char grayscale) {
+	fb_lcd_poll();
+	if (buffer == NULL || fb_lcd_current != NULL)
+		return 0;
+	if (buffer->cpu_written != 0) {
+		alt_dcache_flush(buffer->pixels,fb_size);
+		buffer->cpu_written = 0;
+	}
+	fb_acquire(buffer,FB_USER_LCD);
+	fb_lcd_current = buffer;
+	trace_begin(TRACE_LCD_DMA,buffer-fb_pool);
+	transfer_LCD_with_dma(start,width,height,grayscale);
+	return 1;
+}
+
+/*
+ * Returns 0 when the previous pointer is not yet latched; the vga_dma latches
+ * its pointer only at the start of a frame, hence at most one new buffer each
+ * frame can be accepted. The old buffer is released by the flip interrupt.
+ */
+char fb_show_vga(frame_buffer_t *buffer,
+		         char swap) {
+	if (buffer == NULL || fb_vga_retiring != NULL)
+		return 0;
+	if (buffer == fb_vga_current)
+		return 1;
+	if (buffer->cpu_written != 0) {
+		alt_dcache_flush(buffer->pixels,fb_size);
+		buffer->cpu_written = 0;
+	}
+	fb_acquire(buffer,FB_USER_VGA);
+	vga_set_swap(swap);
+	fb_vga_retiring = (fb_vga_current == NULL) ? buffer : fb_vga_current;
+	fb_vga_current = buffer;
+	trace_begin(TRACE_VGA_FLIP,buffer-fb_pool);
+	vga_set_pointer(buffer->pixels);
+	return 1;
+}
+
+/* Called from the LCD end-of-DMA interrupt, or by fb_lcd_poll() */
+void fb_lcd_done(void) {
+	fb_release(fb_lcd_current,FB_USER_LCD);
+	fb_lcd_current = NULL;
+}
+
+/*
+ * Releases the LCD buffer of a counted end of DMA; main loop only. The
+ * trace gets the time the fast interrupt latched, not the time of the poll.
+ */
+void fb_lcd_poll(void) {
+	if (fb_lcd_end.mask != 0 && fast_irq_take(&fb_lcd_end) != 0) {
+		trace_end_at(TRACE_LCD_DMA,fb_lcd_current-fb_pool,fb_lcd_end.time);
+		fb_lcd_done();
+	}
+}
+
+/* Called from the VGA flip done interrupt */
+void fb_vga_frame_end(void) {
+	if (fb_vga_retiring == NULL)
+		return;
+	trace_end(TRACE_VGA_FLIP,fb_vga_current-fb_pool);
+	if (fb_vga_retiring != fb_vga_current)
+		fb_release(fb_vga_retiring,FB_USER_VGA);
+	fb_vga_retiring = NULL;
+}
@@ -0,0 +1,91 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file framebuffer.h
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Frame buffer pool shared by the camera, the CPU, the LCD and the VGA.
+ * Every buffer carries one bit for each of its current users. A buffer is
+ * only handed out again when all users have released it:
+ *   - the camera releases a buffer when its frame is taken by the CPU,
+ *   - the LCD releases a buffer after the end-of-DMA interrupt; the fast
+ *     interrupt (fast_irq.h) only counts it, the next fb_alloc() or
+ *     fb_show_lcd() releases the buffer,
+ *   - the VGA releases a buffer when the vga_dma latched the next pointer.
+ * Like this the LCD and the VGA can scan out the producer buffers directly
+ * without a copy and without the buffer being overwritten while in use.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef FRAMEBUFFER_H_
+#define FRAMEBUFFER_H_
+
+#include <stdlib.h>
+#include <system.h>
+#include <io.h>
+
+#define FB_NR_OF_BUFFERS 10
+#define FB_NR_OF_CAMERA_SLOTS 4
+
+#define FB_USER_CAMERA 1
+#define FB_USER_CPU 2
+#define FB_USER_LCD 4
+#define FB_USER_VGA 8
+
+typedef struct frame_buffer {
+	void *pixels;
+	volatile unsigned char users;
+	signed char camera_slot;
+	char cpu_written;
+} frame_buffer_t;
+
+void fb_init(unsigned int bytes_each_buffer);
+
+frame_buffer_t *fb_alloc(unsigned char user);
+
+void fb_acquire(frame_buffer_t *buffer,
+		        unsigned char user);
+
+void fb_release(frame_buffer_t *buffer,
+		        unsigned char user);
+
+void fb_camera_start(void);
+
+frame_buffer_t *fb_camera_take_frame(void);
+
+char fb_show_lcd(frame_buffer_t *buffer,
+		         void *start,
+		         int width,
+		         int height,
+		         char grayscale);
+
+char fb_show_vga(frame_buffer_t *buffer,
+		         char swap);
+
+void fb_lcd_done(void);
+
+void fb_lcd_poll(void);
+
+void fb_vga_frame_end(void);
+
+#endif /* FRAMEBUFFER_H_ */
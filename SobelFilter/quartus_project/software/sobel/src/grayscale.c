@@ -28,22 +28,44 @@
  */
 
 #include "grayscale.h"
+#include "tcm.h"
 
 
-unsigned char *grayscale_array;
-int grayscale_width = 0;
-int grayscape_height = 0;
+/* Context of conv_grayscale, its picture is reallocated on a new size */
+gray_ctx_t gray_default;
+
+void gray_ctx_init(gray_ctx_t *ctx,
+		           int width,
+		           int height,
+		           unsigned char *picture) {
+	ctx->width = width;
+	ctx->height = height;
+	ctx->picture = picture;
+}
+
+void gray_ctx_convert(gray_ctx_t *ctx,
+		              void *picture) {
+	conv_grayscale_to(picture,ctx->width,ctx->height,ctx->picture);
+}
 
 void conv_grayscale(void *picture,
 		            int width,
 		            int height) {
+	if (gray_default.picture == NULL || gray_default.width != width ||
+		gray_default.height != height) {
+		free(gray_default.picture);
+		gray_ctx_init(&gray_default,width,height,
+				      (unsigned char *) malloc(width*height));
+	}
+	gray_ctx_convert(&gray_default,picture);
+}
+
+TCM_CODE void conv_grayscale_to(void *picture,
+		                        int width,
+		                        int height,
+		                        unsigned char *destination) {
 	int x,y,gray;
 	unsigned short *pixels = (unsigned short *)picture , rgb;
-	grayscale_width = width;
-	grayscape_height = height;
-	if (grayscale_array != NULL)
-		free(grayscale_array);
-	grayscale_array = (unsigned char *) malloc(width*height);
 	for (y = 0 ; y < height ; y++) {
 		for (x = 0 ; x < width ; x++) {
 			rgb = pixels[y*width+x];
@@ -51,22 +73,22 @@ void conv_grayscale(void *picture,
 			gray += (((rgb>>5)&0x3F)<<2)*72; // green part
 			gray += (((rgb>>0)&0x1F)<<3)*7; // blue part
 			gray /= 100;
-			IOWR_8DIRECT(grayscale_array,y*width+x,gray);
+			IOWR_8DIRECT(destination,y*width+x,gray);
 		}
 	}
 }
 
 
 int get_grayscale_width() {
-	return grayscale_width;
+	return gray_default.width;
 }
 
 int get_grayscale_height() {
-	return grayscape_height;
+	return gray_default.height;
 }
 
 unsigned char *get_grayscale_picture() {
-	return grayscale_array;
+	return gray_default.picture;
 }
 
 
@@ -34,10 +34,30 @@
 #include <io.h>
 #include <system.h>
 
+/* Size and caller's picture of one grayscale stream */
+typedef struct gray_ctx {
+	int width;
+	int height;
+	unsigned char *picture;
+} gray_ctx_t;
+
+void gray_ctx_init(gray_ctx_t *ctx,
+		           int width,
+		           int height,
+		           unsigned char *picture);
+
+void gray_ctx_convert(gray_ctx_t *ctx,
+		              void *picture);
+
 void conv_grayscale(void *picture,
 		            int width,
 		            int height);
 
+void conv_grayscale_to(void *picture,
+		               int width,
+		               int height,
+		               unsigned char *destination);
+
 int get_grayscale_width();
 
 int get_grayscale_height();
@@ -0,0 +1,76 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file input_event.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include "input_event.h"
+#include <sys/alt_timestamp.h>
+
+/* The slot may not be moved across the head or tail access */
+#define INPUT_EVENT_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+input_event_queue_t input_events;
+
+void input_event_init(input_event_queue_t *queue) {
+	queue->head = 0;
+	queue->tail = 0;
+	queue->dropped = 0;
+	alt_timestamp_start();
+}
+
+/* Interrupt side; a full queue drops the event and returns 0 */
+char input_event_put(input_event_queue_t *queue,
+		             unsigned char source,
+		             unsigned char value,
+		             unsigned char changed) {
+	unsigned int head = queue->head;
+	input_event_t *event;
+	if (head-queue->tail >= INPUT_EVENT_SLOTS) {
+		queue->dropped++;
+		return 0;
+	}
+	event = &queue->slot[head&(INPUT_EVENT_SLOTS-1)];
+	event->timestamp = alt_timestamp();
+	event->source = source;
+	event->value = value;
+	event->changed = changed;
+	INPUT_EVENT_BARRIER();
+	queue->head = head+1;
+	return 1;
+}
+
+/* Main loop side; returns 0 when the queue is empty */
+char input_event_get(input_event_queue_t *queue,
+		             input_event_t *event) {
+	unsigned int tail = queue->tail;
+	if (queue->head == tail)
+		return 0;
+	INPUT_EVENT_BARRIER();
+	*event = queue->slot[tail&(INPUT_EVENT_SLOTS-1)];
+	INPUT_EVENT_BARRIER();
+	queue->tail = tail+1;
+	return 1;
+}
@@ -0,0 +1,74 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file input_event.h
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Timestamped queue of input changes. The edge capture interrupt of a PIO
+ * puts one event for each change, the main loop takes them out without any
+ * I/O access. The queue has one producer (the interrupt) and one consumer
+ * (the main loop) on the same core, so head and tail need no lock.
+ *
+ * The timestamp is taken with alt_timestamp() (the ProfileTimer, ticks of
+ * alt_timestamp_freq()) when the interrupt runs.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef INPUT_EVENT_H_
+#define INPUT_EVENT_H_
+
+#include <alt_types.h>
+
+/* must be a power of two */
+#define INPUT_EVENT_SLOTS 16
+
+#define INPUT_EVENT_DIPSW 1
+#define INPUT_EVENT_SIMPLEPIO 2
+
+typedef struct input_event {
+	alt_u32 timestamp;
+	unsigned char source;
+	unsigned char value;   /* the pins after the change */
+	unsigned char changed; /* the captured edges */
+} input_event_t;
+
+typedef struct input_event_queue {
+	volatile unsigned int head;
+	volatile unsigned int tail;
+	volatile unsigned int dropped;
+	input_event_t slot[INPUT_EVENT_SLOTS];
+} input_event_queue_t;
+
+extern input_event_queue_t input_events;
+
+void input_event_init(input_event_queue_t *queue);
+
+char input_event_put(input_event_queue_t *queue,
+		             unsigned char source,
+		             unsigned char value,
+		             unsigned char changed);
+
+char input_event_get(input_event_queue_t *queue,
+		             input_event_t *event);
+
+#endif /* INPUT_EVENT_H_ */
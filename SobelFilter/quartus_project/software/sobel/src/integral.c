@@ -0,0 +1,154 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file integral.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include "integral.h"
+
+unsigned int *integral_table;
+
+int integral_width;
+
+int integral_height;
+
+void init_integral_image(int width , int height) {
+	int loop;
+	integral_width = width;
+	integral_height = height;
+	if (integral_table != NULL)
+		free(integral_table);
+	integral_table = (unsigned int *)malloc((width+1)*(height+1)*sizeof(unsigned int));
+	for (loop = 0 ; loop < (width+1)*(height+1) ; loop++)
+		integral_table[loop] = 0;
+}
+
+/*
+ * One pass over the picture: each entry is the running sum of its line plus
+ * the entry above it. 8-bit pixels of a 16M pixel picture still fit in 32 bit.
+ */
+void integral_image( unsigned char *source ) {
+	int x,y,stride = integral_width+1;
+	unsigned int line_sum;
+	unsigned int *above,*current;
+
+	for (y = 0 ; y < integral_height ; y++) {
+		above = &integral_table[y*stride+1];
+		current = above+stride;
+		line_sum = 0;
+		for (x = 0 ; x < integral_width ; x++) {
+			line_sum += source[y*integral_width+x];
+			current[x] = above[x]+line_sum;
+		}
+	}
+}
+
+/* Sum of the pixels x0..x1 and y0..y1 (inclusive) */
+unsigned int integral_box_sum(int x0,
+		                      int y0,
+		                      int x1,
+		                      int y1) {
+	int stride = integral_width+1;
+	return integral_table[(y1+1)*stride+x1+1]-
+	       integral_table[(y1+1)*stride+x0]-
+	       integral_table[y0*stride+x1+1]+
+	       integral_table[y0*stride+x0];
+}
+
+/*
+ * Writes the mean of the (2*radius+1)^2 box around each pixel. As sobel, only
+ * the pixels with a complete box are filtered, the border is copied. The
+ * Nios II has no hardware divider, the mean is taken by a 16 bit reciprocal.
+ */
+void integral_box_blur(int radius,
+		               unsigned char *source,
+		               unsigned char *destination) {
+	int x,y,stride = integral_width+1;
+	int size = 2*radius+1;
+	unsigned int reciprocal = (65536+(size*size)/2)/(size*size);
+	unsigned int *top,*bottom;
+
+	for (y = 0 ; y < integral_height ; y++) {
+		if (y < radius || y >= integral_height-radius) {
+			for (x = 0 ; x < integral_width ; x++)
+				destination[y*integral_width+x] = source[y*integral_width+x];
+			continue;
+		}
+		top = &integral_table[(y-radius)*stride];
+		bottom = &integral_table[(y+radius+1)*stride];
+		for (x = 0 ; x < radius ; x++)
+			destination[y*integral_width+x] = source[y*integral_width+x];
+		for (x = radius ; x < integral_width-radius ; x++) {
+			destination[y*integral_width+x] =
+				((bottom[x+radius+1]-bottom[x-radius]-
+				  top[x+radius+1]+top[x-radius])*reciprocal+32768)>>16;
+		}
+		for (x = integral_width-radius ; x < integral_width ; x++)
+			destination[y*integral_width+x] = source[y*integral_width+x];
+	}
+}
+
+/*
+ * Local mean threshold: a pixel is set to 0xFF when it is brighter than
+ * (100-percent)% of the mean of its (2*radius+1)^2 box, else to 0. The
+ * comparison is done as pixel*area*100 > sum*(100-percent) to avoid the
+ * division. The border without a complete box is set to 0.
+ */
+void integral_adaptive_threshold(int radius,
+		                         int percent,
+		                         unsigned char *source,
+		                         unsigned char *destination) {
+	int x,y,stride = integral_width+1;
+	int size = 2*radius+1;
+	unsigned int area100 = size*size*100;
+	unsigned int factor = 100-percent;
+	unsigned int sum;
+	unsigned int *top,*bottom;
+
+	for (y = 0 ; y < integral_height ; y++) {
+		if (y < radius || y >= integral_height-radius) {
+			for (x = 0 ; x < integral_width ; x++)
+				destination[y*integral_width+x] = 0;
+			continue;
+		}
+		top = &integral_table[(y-radius)*stride];
+		bottom = &integral_table[(y+radius+1)*stride];
+		for (x = 0 ; x < radius ; x++)
+			destination[y*integral_width+x] = 0;
+		for (x = radius ; x < integral_width-radius ; x++) {
+			sum = bottom[x+radius+1]-bottom[x-radius]-
+			      top[x+radius+1]+top[x-radius];
+			destination[y*integral_width+x] =
+				(source[y*integral_width+x]*area100 > sum*factor) ? 0xFF : 0;
+		}
+		for (x = integral_width-radius ; x < integral_width ; x++)
+			destination[y*integral_width+x] = 0;
+	}
+}
+
+unsigned int *GetIntegralImage(void)
+{
+  return integral_table;
+}
@@ -0,0 +1,59 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file integral.h
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Integral image (summed area table) of a grayscale picture. The table has
+ * one extra zero row and column, entry (x,y) holds the sum of all pixels
+ * left of x and above y. Any box sum then costs four table reads,
+ * independent of the box size.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef INTEGRAL_H_
+#define INTEGRAL_H_
+
+#include <stdlib.h>
+
+void init_integral_image(int width , int height);
+
+void integral_image( unsigned char *source );
+
+unsigned int integral_box_sum(int x0,
+		                      int y0,
+		                      int x1,
+		                      int y1);
+
+void integral_box_blur(int radius,
+		               unsigned char *source,
+		               unsigned char *destination);
+
+void integral_adaptive_threshold(int radius,
+		                         int percent,
+		                         unsigned char *source,
+		                         unsigned char *destination);
+
+unsigned int *GetIntegralImage(void);
+
+#endif /* INTEGRAL_H_ */
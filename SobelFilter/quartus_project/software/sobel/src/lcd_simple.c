@@ -29,9 +29,14 @@
  */
 
 #include "lcd_simple.h"
+#include <sys/alt_irq.h>
 
 unsigned short LCD_width;
 unsigned short LCD_height;
+unsigned short LCD_irq_mode = LCD_IRQ_Disabled;
+unsigned short LCD_orientation = LCD_Normal;
+unsigned short LCD_binary_one = 0xFFFF;
+unsigned short LCD_binary_zero = 0x0000;
 
 void LCD_Write_Command(int command) {
 	IOWR_16DIRECT(LCD_CTRL_BASE,LCD_COMMAND_REG,command);
@@ -148,17 +153,98 @@ void transfer_LCD_with_dma(void *array,
 		                   int width,
 		                   int height,
 		                   char grayscale) {
-	unsigned short real_height = (height > LCD_height) ? LCD_height : height;
-	unsigned short real_width = (width > LCD_width) ? LCD_width : width;
+	unsigned short real_height;
+	unsigned short real_width;
+	unsigned int first_x = 0;
+	unsigned int first_y = 0;
+	unsigned int bytes = (grayscale==0) ? 2 : 1;
+	if (grayscale==LCD_DMA_Binary) {
+		/* packed binary, see binary.h; the orientation is not supported
+		 * and array must point to the first word of a line */
+		real_height = (height > LCD_height) ? LCD_height : height;
+		real_width = (width > LCD_width) ? LCD_width : width;
+		IOWR_32DIRECT(LCD_CTRL_BASE,LCD_Pict_width_reg,
+				         width|((unsigned int)LCD_binary_one<<16));
+		IOWR_32DIRECT(LCD_CTRL_BASE,LCD_NR_PIX_LINE_REG,
+				         LCD_width|((unsigned int)LCD_binary_zero<<16));
+		IOWR_32DIRECT(LCD_CTRL_BASE,LCD_IMAGE_POINTER_REG,(int)array);
+		IOWR_32DIRECT(LCD_CTRL_BASE,LCD_IMAGE_SIZE_REG,real_width*real_height);
+		IOWR_16DIRECT(LCD_CTRL_BASE,LCD_CONTROL_REG,
+				         LCD_Sixteen_Bit|LCD_Start_DMA|LCD_irq_mode|
+				         LCD_Binary_Image);
+		return;
+	}
+	if (LCD_orientation&LCD_Transpose) {
+		/* each LCD line is an image column */
+		real_height = (height > LCD_width) ? LCD_width : height;
+		real_width = (width > LCD_height) ? LCD_height : width;
+		if (LCD_orientation&LCD_Reverse_Pixels)
+			first_y = real_height-1;
+		if (LCD_orientation&LCD_Reverse_Lines)
+			first_x = real_width-1;
+	} else {
+		real_height = (height > LCD_height) ? LCD_height : height;
+		real_width = (width > LCD_width) ? LCD_width : width;
+		if (LCD_orientation&LCD_Reverse_Pixels)
+			first_x = real_width-1;
+		if (LCD_orientation&LCD_Reverse_Lines)
+			first_y = real_height-1;
+	}
+	/* the core starts at the first pixel sent, a corner of the image */
 	IOWR_32DIRECT(LCD_CTRL_BASE,LCD_Pict_width_reg,width);
-	IOWR_32DIRECT(LCD_CTRL_BASE,LCD_IMAGE_POINTER_REG,(int)array);
+	IOWR_32DIRECT(LCD_CTRL_BASE,LCD_IMAGE_POINTER_REG,
+			         (int)array+(first_y*width+first_x)*bytes);
 	IOWR_32DIRECT(LCD_CTRL_BASE,LCD_IMAGE_SIZE_REG,real_width*real_height);
 	if (grayscale==0)
 		IOWR_16DIRECT(LCD_CTRL_BASE,LCD_CONTROL_REG,
-				         LCD_Sixteen_Bit|LCD_Start_DMA|
-				         LCD_RGB565_Mode|LCD_Color_Image);
+				         LCD_Sixteen_Bit|LCD_Start_DMA|LCD_irq_mode|
+				         LCD_RGB565_Mode|LCD_Color_Image|LCD_orientation);
 	else
 		IOWR_16DIRECT(LCD_CTRL_BASE,LCD_CONTROL_REG,
-				         LCD_Sixteen_Bit|LCD_Start_DMA|
-				         LCD_RGB565_Mode|LCD_GrayScale_Image);
+				         LCD_Sixteen_Bit|LCD_Start_DMA|LCD_irq_mode|
+				         LCD_RGB565_Mode|LCD_GrayScale_Image|LCD_orientation);
+}
+
+void LCD_register_irq(void (*handler)(void *),
+		              void *context) {
+	alt_ic_isr_register(LCD_CTRL_IRQ_INTERRUPT_CONTROLLER_ID,LCD_CTRL_IRQ,
+			            handler,context,NULL);
+	LCD_irq_mode = LCD_IRQ_Enabled;
+}
+
+void LCD_clear_irq() {
+	/* the control register is rewritten completely, keep the mode bits */
+	unsigned short control = IORD_16DIRECT(LCD_CTRL_BASE,LCD_CONTROL_REG);
+	IOWR_16DIRECT(LCD_CTRL_BASE,LCD_CONTROL_REG,
+			         (control&LCD_Mode_Mask)|LCD_irq_mode|LCD_Clear_IRQ);
+}
+
+/* The end of DMA is acknowledged as by LCD_clear_irq() and counted */
+char LCD_register_fast_irq(fast_irq_source_t *source) {
+	if (fast_irq_register(source,LCD_CTRL_IRQ_INTERRUPT_CONTROLLER_ID,
+			              LCD_CTRL_IRQ,LCD_CTRL_BASE+LCD_CONTROL_REG,
+			              LCD_Mode_Mask,LCD_IRQ_Enabled|LCD_Clear_IRQ) == 0)
+		return 0;
+	LCD_irq_mode = LCD_IRQ_Enabled;
+	return 1;
+}
+
+void LCD_set_write_timing(int setup,
+		                  int low,
+		                  int hold) {
+	/* at 50 MHz setup=1, low=1, hold=0 is the ILI9341 limit (twc >= 66 ns) */
+	IOWR_32DIRECT(LCD_CTRL_BASE,LCD_WRITE_TIMING_REG,
+			         LCD_Write_Timing(setup,low,hold));
+}
+
+void LCD_set_orientation(int orientation) {
+	/* the rotated modes read single pixels, at most 255 pixels each LCD line */
+	LCD_orientation = orientation&LCD_Orientation_Mask;
+}
+
+void LCD_set_binary_colors(unsigned short one,
+		                   unsigned short zero) {
+	/* RGB565 colors of the set and the cleared pixels of a binary picture */
+	LCD_binary_one = one;
+	LCD_binary_zero = zero;
 }
@@ -36,6 +36,7 @@
 #include "io.h"
 #include "time.h"
 #include "unistd.h"
+#include "fast_irq.h"
 
 #define LCD_COMMAND_REG 0
 #define LCD_DATA_REG 4
@@ -44,6 +45,7 @@
 #define LCD_IMAGE_SIZE_REG 16
 #define LCD_NR_PIX_LINE_REG 20
 #define LCD_Pict_width_reg 24
+#define LCD_WRITE_TIMING_REG 28
 
 #define LCD_Sixteen_Bit 0
 #define LCD_Eight_Bit 1
@@ -56,6 +58,31 @@
 #define LCD_IRQ_Enabled (1<<5)
 #define LCD_Start_DMA (1<<8)
 #define LCD_Clear_IRQ (1<<9)
+#define LCD_Transpose (1<<10)
+#define LCD_Reverse_Pixels (1<<11)
+#define LCD_Reverse_Lines (1<<12)
+#define LCD_Orientation_Mask (7<<10)
+#define LCD_Binary_Image (1<<13)
+/* the bits an interrupt acknowledge keeps */
+#define LCD_Mode_Mask (LCD_Eight_Bit|LCD_RGB888_Mode|LCD_GrayScale_Image|\
+		               LCD_Orientation_Mask|LCD_Binary_Image)
+
+/* picture formats of transfer_LCD_with_dma */
+#define LCD_DMA_Color 0
+#define LCD_DMA_Grayscale 1
+#define LCD_DMA_Binary 2
+
+/* orientations of the image on the LCD, see LCD_set_orientation */
+#define LCD_Normal 0
+#define LCD_Rotate_90 (LCD_Transpose|LCD_Reverse_Pixels)
+#define LCD_Rotate_180 (LCD_Reverse_Pixels|LCD_Reverse_Lines)
+#define LCD_Rotate_270 (LCD_Transpose|LCD_Reverse_Lines)
+#define LCD_Mirror_X LCD_Reverse_Pixels
+#define LCD_Mirror_Y LCD_Reverse_Lines
+
+/* write cycle phases in clock cycles, 0 selects the default of the core */
+#define LCD_Write_Timing(setup,low,hold) \
+	(((setup)&0xF)|(((low)&0xF)<<4)|(((hold)&0xF)<<8))
 
 void init_LCD();
 
@@ -72,6 +99,22 @@ void transfer_LCD_with_dma(void *array,
 		                   int height,
 		                   char grayscale);
 
+void LCD_register_irq(void (*handler)(void *),
+		              void *context);
+
+void LCD_clear_irq();
+
+char LCD_register_fast_irq(fast_irq_source_t *source);
+
+void LCD_set_write_timing(int setup,
+		                  int low,
+		                  int hold);
+
+void LCD_set_orientation(int orientation);
+
+void LCD_set_binary_colors(unsigned short one,
+		                   unsigned short zero);
+
 
 
 #endif /* LCD_SIMPLE_H_ */
@@ -33,107 +33,128 @@
 #include <stdlib.h>
 #include <io.h>
 #include "lcd_simple.h"
-#include "grayscale.h"
 #include "i2c.h"
 #include "camera.h"
 #include "vga.h"
 #include "dipswitch.h"
-#include "sobel.h"
+#include "framebuffer.h"
+#include "filter_chain.h"
+#include "dual_core.h"
+#include "bus_monitor.h"
+#include "trace.h"
+#include "fast_irq.h"
+#include "altera_avalon_performance_counter.h"
+
+#define PERF_REPORT_FRAMES 64
+#define BUS_MONITOR_WINDOW ALT_CPU_FREQ
+
+/* time of the previous frame ready, the begin of the current camera transfer */
+static volatile unsigned int camera_dma_begin;
+
+/*
+ * With the fast interrupt the frame ready is traced at the time it latched,
+ * and the camera transfer from the previous frame ready to this one (the
+ * cam_dma starts the next frame in the slot after it).
+ */
+static void trace_camera_frame(void) {
+	static unsigned short camera_frames = 0;
+	static char camera_started = 0;
+	unsigned int time;
+	if (cam_frame_irq.mask == 0) {
+		trace_instant(TRACE_CAMERA_FRAME,0);
+		return;
+	}
+	time = cam_frame_irq.time;
+	if (camera_started != 0) {
+		trace_begin_at(TRACE_CAMERA_DMA,camera_frames,camera_dma_begin);
+		trace_end_at(TRACE_CAMERA_DMA,camera_frames,time);
+	}
+	trace_instant_at(TRACE_CAMERA_FRAME,camera_frames,time);
+	camera_dma_begin = time;
+	camera_started = 1;
+	camera_frames++;
+}
 
 int main(void)
 {
-  void *buffer1,*buffer2,*buffer3,*buffer4;
-  unsigned short *image;
-  unsigned char *grayscale;
+  frame_buffer_t *camera, *output;
+  filter_output_t result;
   unsigned char current_mode;
   unsigned char mode;
+  unsigned char last_mode = 0xFF;
+  unsigned int frames = 0;
   init_LCD();
   init_camera();
   vga_set_swap(VGA_QuarterScreen|VGA_Grayscale);
   printf("Hello from Nios II!\n");
+#ifdef FAST_IRQ_BENCH
+  fast_irq_bench();
+#endif
   cam_get_profiling();
-  buffer1 = (void *) malloc(cam_get_xsize()*cam_get_ysize());
-  buffer2 = (void *) malloc(cam_get_xsize()*cam_get_ysize());
-  buffer3 = (void *) malloc(cam_get_xsize()*cam_get_ysize());
-  buffer4 = (void *) malloc(cam_get_xsize()*cam_get_ysize());
-  cam_set_image_pointer(0,buffer1);
-  cam_set_image_pointer(1,buffer2);
-  cam_set_image_pointer(2,buffer3);
-  cam_set_image_pointer(3,buffer4);
+  fb_init(cam_get_xsize()*cam_get_ysize());
+  fb_camera_start();
   enable_continues_mode();
-  init_sobel_arrays(cam_get_xsize()>>1,cam_get_ysize());
+  if (cam_enable_frame_irq() != 0) {
+	  trace_latch(&cam_frame_irq.time);
+	  trace_latch(&camera_dma_begin);
+  }
+  current_mode = DIPSW_init_events();
+#ifdef DUAL_CORE
+  dual_core_capture(cam_get_xsize()>>1,cam_get_ysize(),
+		            cam_get_xsize()*cam_get_ysize());
+#endif
+  init_filter_chain(cam_get_xsize()>>1,cam_get_ysize());
+  trace_init();
+  trace_perf_restart();
+  bus_monitor_start(BUS_MONITOR_WINDOW);
   do {
 	  if (new_image_available() != 0) {
+		  trace_camera_frame();
 		  if (current_image_valid()!=0) {
-			  current_mode = DIPSW_get_value();
-			  mode = current_mode&(DIPSW_SW1_MASK|DIPSW_SW3_MASK|DIPSW_SW2_MASK);
-			  image = (unsigned short*)current_image_pointer();
-		      switch (mode) {
-		      case 0 : transfer_LCD_with_dma(&image[16520],
-		                	cam_get_xsize()>>1,
-		                	cam_get_ysize(),0);
-		      	  	   if ((current_mode&DIPSW_SW8_MASK)!=0) {
-		      	  		  vga_set_swap(VGA_QuarterScreen);
-		      	  		  vga_set_pointer(image);
-		      	  	   }
-		      	  	   break;
-		      case 1 : conv_grayscale((void *)image,
-		    		                  cam_get_xsize()>>1,
-		    		                  cam_get_ysize());
-		               grayscale = get_grayscale_picture();
-		               transfer_LCD_with_dma(&grayscale[16520],
-		      		                	cam_get_xsize()>>1,
-		      		                	cam_get_ysize(),1);
-		      	  	   if ((current_mode&DIPSW_SW8_MASK)!=0) {
-		      	  		  vga_set_swap(VGA_QuarterScreen|VGA_Grayscale);
-		      	  		  vga_set_pointer(grayscale);
-		      	  	   }
-		      	  	   break;
-		      case 2 : conv_grayscale((void *)image,
-		    		                  cam_get_xsize()>>1,
-		    		                  cam_get_ysize());
-		               grayscale = get_grayscale_picture();
-		               sobel_x_with_rgb(grayscale);
-		               image = GetSobel_rgb();
-		               transfer_LCD_with_dma(&image[16520],
-		      		                	cam_get_xsize()>>1,
-		      		                	cam_get_ysize(),0);
-		      	  	   if ((current_mode&DIPSW_SW8_MASK)!=0) {
-		      	  		  vga_set_swap(VGA_QuarterScreen);
-		      	  		  vga_set_pointer(image);
-		      	  	   }
-		      	  	   break;
-		      case 3 : conv_grayscale((void *)image,
-		    		                  cam_get_xsize()>>1,
-		    		                  cam_get_ysize());
-		               grayscale = get_grayscale_picture();
-		               sobel_x(grayscale);
-		               sobel_y_with_rgb(grayscale);
-		               image = GetSobel_rgb();
-		               transfer_LCD_with_dma(&image[16520],
-		      		                	cam_get_xsize()>>1,
-		      		                	cam_get_ysize(),0);
-		      	  	   if ((current_mode&DIPSW_SW8_MASK)!=0) {
-		      	  		  vga_set_swap(VGA_QuarterScreen);
-		      	  		  vga_set_pointer(image);
-		      	  	   }
-		      	  	   break;
-		      default: conv_grayscale((void *)image,
-	                                  cam_get_xsize()>>1,
-	                                  cam_get_ysize());
-                       grayscale = get_grayscale_picture();
-                       sobel_x(grayscale);
-                       sobel_y(grayscale);
-                       sobel_threshold(128);
-                       grayscale=GetSobelResult();
-		               transfer_LCD_with_dma(&grayscale[16520],
-		      		                	cam_get_xsize()>>1,
-		      		                	cam_get_ysize(),1);
-		      	  	   if ((current_mode&DIPSW_SW8_MASK)!=0) {
-		      	  		  vga_set_swap(VGA_QuarterScreen|VGA_Grayscale);
-		      	  		  vga_set_pointer(grayscale);
-		      	  	   }
-		      	  	   break;
+			  camera = fb_camera_take_frame();
+			  if (camera == NULL)
+				  continue;
+			  current_mode = DIPSW_update(current_mode);
+			  mode = current_mode&FILTER_MODE_MASK;
+			  if (mode != last_mode) {
+				  /* the profile is reported for one mode at a time */
+				  trace_perf_restart();
+				  last_mode = mode;
+				  frames = 0;
+			  }
+			  PERF_BEGIN(PERFORMANCE_COUNTER_0_BASE,PERF_FRAME_SECTION);
+			  trace_begin(TRACE_FRAME,frames);
+			  output = (mode == 0) ? camera : fb_alloc(FB_USER_CPU);
+			  if (output == NULL) {
+				  fb_release(camera,FB_USER_CPU);
+				  trace_end(TRACE_FRAME,frames);
+				  PERF_END(PERFORMANCE_COUNTER_0_BASE,PERF_FRAME_SECTION);
+				  continue;
+			  }
+			  trace_begin(TRACE_FILTER,mode);
+			  filter_chain(current_mode,(unsigned short *)camera->pixels,
+					       output->pixels,&result);
+			  trace_end(TRACE_FILTER,mode);
+			  fb_show_lcd(output,result.lcd_start,
+					      cam_get_xsize()>>1,
+					      cam_get_ysize(),result.lcd_format);
+			  if (result.vga_swap != 0) {
+				  fb_show_vga(output,result.vga_swap);
+			  }
+		      fb_release(output,FB_USER_CPU);
+		      fb_release(camera,FB_USER_CPU);
+		      trace_end(TRACE_FRAME,frames);
+		      PERF_END(PERFORMANCE_COUNTER_0_BASE,PERF_FRAME_SECTION);
+		      if (++frames == PERF_REPORT_FRAMES) {
+		    	  if ((current_mode&DIPSW_SW7_MASK)!=0) {
+		    		  PERF_STOP_MEASURING(PERFORMANCE_COUNTER_0_BASE);
+		    		  filter_chain_report(mode,frames);
+		    		  bus_monitor_report();
+		    		  trace_dump();
+		    		  bus_monitor_start(BUS_MONITOR_WINDOW);
+		    	  }
+		    	  trace_perf_restart();
+		    	  frames = 0;
 		      }
 		  }
 	  }
@@ -0,0 +1,102 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file median.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include "median.h"
+#include "tcm.h"
+
+/* a becomes the minimum and b the maximum, without a branch: the mask is
+ * all ones when a < b */
+#define MEDIAN_SORT(a,b) { int d = (a)-(b); int m = d&(d>>31); \
+                           (a) = (b)+m; (b) = (b)+d-m; }
+
+unsigned char median_buffer[2][MEDIAN_MAX_WIDTH] TCM_DATA;
+
+int median_width;
+
+int median_height;
+
+/* The line buffers are static to be placed in the data TCM, see tcm.h */
+void init_median(int width , int height) {
+	if (width > MEDIAN_MAX_WIDTH)
+		width = 0;
+	median_width = width;
+	median_height = height;
+}
+
+/*
+ * One line: column x+1 of the window is loaded and sorted (comparators
+ * 1..9 of the network for this column), the columns x-1 and x are taken
+ * over from the previous pixel. The remaining 10 comparators give the
+ * median in p4.
+ */
+TCM_CODE void median_line(unsigned char *above,
+		                  unsigned char *line,
+		                  unsigned char *below,
+		                  unsigned char *result) {
+	int x;
+	int p0,p1,p2,p3,p4,p5,p6,p7,p8;
+	int l0,l1,l2,c0,c1,c2,r0,r1,r2;
+	l0 = above[0]; l1 = line[0]; l2 = below[0];
+	MEDIAN_SORT(l1,l2); MEDIAN_SORT(l0,l1); MEDIAN_SORT(l1,l2);
+	c0 = above[1]; c1 = line[1]; c2 = below[1];
+	MEDIAN_SORT(c1,c2); MEDIAN_SORT(c0,c1); MEDIAN_SORT(c1,c2);
+	for (x = 1 ; x < (median_width-1) ; x++) {
+		r0 = above[x+1]; r1 = line[x+1]; r2 = below[x+1];
+		MEDIAN_SORT(r1,r2); MEDIAN_SORT(r0,r1); MEDIAN_SORT(r1,r2);
+		p0 = l0; p1 = l1; p2 = l2;
+		p3 = c0; p4 = c1; p5 = c2;
+		p6 = r0; p7 = r1; p8 = r2;
+		MEDIAN_SORT(p0,p3); MEDIAN_SORT(p5,p8); MEDIAN_SORT(p4,p7);
+		MEDIAN_SORT(p3,p6); MEDIAN_SORT(p1,p4); MEDIAN_SORT(p2,p5);
+		MEDIAN_SORT(p4,p7); MEDIAN_SORT(p4,p2); MEDIAN_SORT(p6,p4);
+		MEDIAN_SORT(p4,p2);
+		result[x] = p4;
+		l0 = c0; l1 = c1; l2 = c2;
+		c0 = r0; c1 = r1; c2 = r2;
+	}
+}
+
+TCM_CODE void median_filter( unsigned char *picture ) {
+	int x,y;
+	unsigned char *above = median_buffer[0];
+	unsigned char *line = median_buffer[1];
+	unsigned char *swap;
+	if (median_width < 3)
+		return;
+	for (x = 0 ; x < median_width ; x++)
+		above[x] = picture[x];
+	for (y = 1 ; y < (median_height-1) ; y++) {
+		for (x = 0 ; x < median_width ; x++)
+			line[x] = picture[y*median_width+x];
+		median_line(above,line,&picture[(y+1)*median_width],
+				    &picture[y*median_width]);
+		swap = above;
+		above = line;
+		line = swap;
+	}
+}
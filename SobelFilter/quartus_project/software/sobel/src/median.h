@@ -0,0 +1,48 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file median.h
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * 3x3 median filter of a grayscale picture, in place. The median of the
+ * 9 pixels is found by the 19 comparator network of Paeth/Devillard with
+ * branch free compare and swap. Its first 9 comparators sort the three
+ * columns of the window; a sorted column is shared by three neighbouring
+ * pixels, so 13 comparators remain for each pixel. Two line copies (in the
+ * data TCM) hold the original lines above and at the current one, hence
+ * the result can be written back at once. The border pixels are kept.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef MEDIAN_H_
+#define MEDIAN_H_
+
+#include <stdlib.h>
+
+#define MEDIAN_MAX_WIDTH 640
+
+void init_median(int width , int height);
+
+void median_filter( unsigned char *picture );
+
+#endif /* MEDIAN_H_ */
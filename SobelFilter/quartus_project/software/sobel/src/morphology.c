@@ -0,0 +1,158 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file morphology.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include "morphology.h"
+#include "tcm.h"
+
+#define MORPHOLOGY_LINES (2*MORPHOLOGY_MAX_RADIUS+1)
+#define MORPHOLOGY_MAX_WORDS BINARY_WORDS_EACH_LINE(MORPHOLOGY_MAX_WIDTH)
+
+unsigned int morphology_buffer[MORPHOLOGY_LINES][MORPHOLOGY_MAX_WORDS] TCM_DATA;
+
+int morphology_width;
+
+int morphology_height;
+
+int morphology_words;
+
+/* the valid bits of the last word of each line */
+unsigned int morphology_last_mask;
+
+/* The line buffers are static to be placed in the data TCM, see tcm.h */
+void init_morphology(int width , int height) {
+	if (width > MORPHOLOGY_MAX_WIDTH)
+		width = 0;
+	morphology_width = width;
+	morphology_height = height;
+	morphology_words = BINARY_WORDS_EACH_LINE(width);
+	morphology_last_mask = ((width&31) == 0) ? 0xFFFFFFFF :
+			               (1U<<(width&31))-1;
+}
+
+/*
+ * Horizontal erode (AND) or dilate (OR) of one line. Pixel x+s lies s bits
+ * up, in the next word for the bits shifted out; the words left of and
+ * right of the line as well as the unused bits of the last word are
+ * outside, hence all ones for erode and all zeros for dilate.
+ */
+TCM_CODE void morphology_line(unsigned int *source,
+		                      unsigned int *result,
+		                      int radius,
+		                      int erode) {
+	int index,shift;
+	int last = morphology_words-1;
+	unsigned int outside = (erode != 0) ? 0xFFFFFFFF : 0;
+	unsigned int pad = outside&~morphology_last_mask;
+	unsigned int previous,current,next,left,right,word;
+	previous = outside;
+	current = source[0];
+	if (last == 0)
+		current |= pad;
+	for (index = 0 ; index <= last ; index++) {
+		if (index < last)
+			next = source[index+1]|((index+1 == last) ? pad : 0);
+		else
+			next = outside;
+		word = current;
+		for (shift = 1 ; shift <= radius ; shift++) {
+			right = (current>>shift)|(next<<(32-shift));
+			left = (current<<shift)|(previous>>(32-shift));
+			if (erode != 0)
+				word &= right&left;
+			else
+				word |= right|left;
+		}
+		result[index] = word;
+		previous = current;
+		current = next;
+	}
+	result[last] &= morphology_last_mask;
+}
+
+/*
+ * Line y is written when the lines up to y+radius are filtered, the
+ * lines above y are only read from the window from then on.
+ */
+TCM_CODE void morphology(unsigned int *picture,
+		                 int radius,
+		                 int erode) {
+	int y,line,index,first,count;
+	int lines = 2*radius+1;
+	int words = morphology_words;
+	unsigned int word;
+	unsigned int *window[MORPHOLOGY_LINES];
+	if (morphology_width == 0 || radius < 1 || radius > MORPHOLOGY_MAX_RADIUS)
+		return;
+	for (y = 0 ; y < radius && y < morphology_height ; y++)
+		morphology_line(&picture[y*words],morphology_buffer[y%lines],
+				        radius,erode);
+	for (y = 0 ; y < morphology_height ; y++) {
+		if ((y+radius) < morphology_height)
+			morphology_line(&picture[(y+radius)*words],
+					        morphology_buffer[(y+radius)%lines],radius,erode);
+		first = (y < radius) ? 0 : y-radius;
+		count = (((y+radius) < morphology_height) ? y+radius :
+				                                    morphology_height-1)-first+1;
+		for (line = 0 ; line < count ; line++)
+			window[line] = morphology_buffer[(first+line)%lines];
+		for (index = 0 ; index < words ; index++) {
+			word = window[0][index];
+			for (line = 1 ; line < count ; line++) {
+				if (erode != 0)
+					word &= window[line][index];
+				else
+					word |= window[line][index];
+			}
+			picture[y*words+index] = word;
+		}
+	}
+}
+
+void morphology_erode( unsigned int *picture,
+		               int radius ) {
+	morphology(picture,radius,1);
+}
+
+void morphology_dilate( unsigned int *picture,
+		                int radius ) {
+	morphology(picture,radius,0);
+}
+
+/* removes the specks smaller than the structuring element */
+void morphology_open( unsigned int *picture,
+		              int radius ) {
+	morphology(picture,radius,1);
+	morphology(picture,radius,0);
+}
+
+/* fills the gaps smaller than the structuring element */
+void morphology_close( unsigned int *picture,
+		               int radius ) {
+	morphology(picture,radius,0);
+	morphology(picture,radius,1);
+}
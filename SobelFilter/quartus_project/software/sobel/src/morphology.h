@@ -0,0 +1,60 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file morphology.h
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Binary morphology with a square structuring element of 3x3 (radius 1) or
+ * 5x5 (radius 2) pixels on packed binary pictures (see binary.h). A word
+ * of 32 pixels is handled by shifts, AND and OR. The square is separable,
+ * so each line is first filtered horizontally into a rolling window of
+ * 2*radius+1 lines, and the result of a line is written back in place as
+ * soon as the window has passed it. Pixels outside the picture are
+ * ignored: cleared for dilate and set for erode.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef MORPHOLOGY_H_
+#define MORPHOLOGY_H_
+
+#include <stdlib.h>
+#include "binary.h"
+
+#define MORPHOLOGY_MAX_RADIUS 2
+#define MORPHOLOGY_MAX_WIDTH 640
+
+void init_morphology(int width , int height);
+
+void morphology_erode( unsigned int *picture,
+		               int radius );
+
+void morphology_dilate( unsigned int *picture,
+		                int radius );
+
+void morphology_open( unsigned int *picture,
+		              int radius );
+
+void morphology_close( unsigned int *picture,
+		               int radius );
+
+#endif /* MORPHOLOGY_H_ */
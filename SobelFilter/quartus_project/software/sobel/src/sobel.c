@@ -28,7 +28,9 @@
  * @todo no open tasks
  */
 
+#include <string.h>
 #include "sobel.h"
+#include "tcm.h"
 
 const char gx_array[3][3] = {{-1,0,1},
                              {-2,0,2},
@@ -37,47 +39,85 @@ const char gy_array[3][3] = { {1, 2, 1},
                               {0, 0, 0},
                              {-1,-2,-1}};
 
-short *sobel_x_result;
-
-short *sobel_y_result;
-
-unsigned short *sobel_rgb565;
+/*
+ * Direction of the gradient in steps of 45 degrees (0 = +x, 2 = +y (up),
+ * 4 = -x, 6 = -y), indexed by sign(gx)<<3 | sign(gy)<<2 | sector, where the
+ * sector is 0 near the x axis, 1 near a diagonal and 2 near the y axis.
+ */
+const unsigned char gradient_direction_lut[16] = {0,1,2,0,  /* gx>=0 gy>=0 */
+                                                  0,7,6,0,  /* gx>=0 gy<0  */
+                                                  4,3,2,0,  /* gx<0  gy>=0 */
+                                                  4,5,6,0}; /* gx<0  gy<0  */
 
-unsigned char *sobel_result;
+const unsigned short gradient_direction_rgb565[8] = {0xF800,0xFFE0,0x07E0,0x07FF,
+                                                     0x001F,0xF81F,0xFFFF,0xFC00};
 
-int sobel_width;
+/* negative values green, positive values red */
+#define SOBEL_RGB(result) (((result) < 0) ? ((-(result))>>2)<<5 : \
+                                            (((result)>>3)&0x1F)<<11)
 
-int sobel_height;
+/* Context of the single-threaded functions, buffers of init_sobel_arrays */
+sobel_ctx_t sobel_default;
 
-void init_sobel_arrays(int width , int height) {
+void sobel_clear_border( void *picture,
+                         int element_size,
+                         int width,
+                         int height ) {
 	int loop;
-	sobel_width = width;
-	sobel_height = height;
-	if (sobel_x_result != NULL)
-		free(sobel_x_result);
-	sobel_x_result = (short *)malloc(width*height*sizeof(short));
-	if (sobel_y_result != NULL)
-		free(sobel_y_result);
-	sobel_y_result = (short *)malloc(width*height*sizeof(short));
-	if (sobel_result != NULL)
-		free(sobel_result);
-	sobel_result = (unsigned char *)malloc(width*height*sizeof(unsigned char));
-	if (sobel_rgb565 != NULL)
-		free(sobel_rgb565);
-	sobel_rgb565 = (unsigned short *)malloc(width*height*sizeof(unsigned short));
-	for (loop = 0 ; loop < width*height ; loop++) {
-		sobel_x_result[loop] = 0;
-		sobel_y_result[loop] = 0;
-		sobel_result[loop] = 0;
-		sobel_rgb565[loop] = 0;
+	unsigned char *bytes = (unsigned char *)picture;
+	if (picture == NULL)
+		return;
+	for (loop = 0 ; loop < width*element_size ; loop++) {
+		bytes[loop] = 0;
+		bytes[(height-1)*width*element_size+loop] = 0;
+	}
+	for (loop = 0 ; loop < height ; loop++) {
+		memset(&bytes[loop*width*element_size],0,element_size);
+		memset(&bytes[(loop*width+width-1)*element_size],0,element_size);
 	}
 }
 
-short sobel_mac( unsigned char *pixels,
-                 int x,
-                 int y,
-                 const char (*filter)[3],
-                 unsigned int width ) {
+/*
+ * The buffers are given by the caller and may be NULL when the functions
+ * that need them are not used: x_result and y_result (sobel_ctx_x/y,
+ * threshold), gradient (sobel_ctx_gradient), rgb565 and result (outputs).
+ * The kernels only write the interior pixels, hence the border of the
+ * outputs is cleared here.
+ */
+void sobel_ctx_init( sobel_ctx_t *ctx,
+                     int width,
+                     int height,
+                     short *x_result,
+                     short *y_result,
+                     unsigned short *gradient,
+                     unsigned short *rgb565,
+                     unsigned char *result ) {
+	ctx->width = width;
+	ctx->height = height;
+	ctx->x_result = x_result;
+	ctx->y_result = y_result;
+	ctx->gradient = gradient;
+	sobel_ctx_set_rgb_output(ctx,rgb565);
+	sobel_ctx_set_result_output(ctx,result);
+}
+
+void sobel_ctx_set_rgb_output( sobel_ctx_t *ctx,
+                               unsigned short *destination ) {
+	ctx->rgb565 = destination;
+	sobel_clear_border(destination,sizeof(unsigned short),ctx->width,ctx->height);
+}
+
+void sobel_ctx_set_result_output( sobel_ctx_t *ctx,
+                                  unsigned char *destination ) {
+	ctx->result = destination;
+	sobel_clear_border(destination,sizeof(unsigned char),ctx->width,ctx->height);
+}
+
+TCM_CODE short sobel_mac( unsigned char *pixels,
+                          int x,
+                          int y,
+                          const char (*filter)[3],
+                          unsigned int width ) {
    short dy,dx;
    short result = 0;
    for (dy = -1 ; dy < 2 ; dy++) {
@@ -89,81 +129,296 @@ short sobel_mac( unsigned char *pixels,
    return result;
 }
 
-void sobel_x( unsigned char *source ) {
+/*
+ * The _lines kernels only use their arguments, hence they are reentrant and
+ * can run on bands of a picture in parallel. source and result point to the
+ * first of lines lines; the interior pixels of the lines 1 to lines-2 are
+ * written, the first and the last line are the halo.
+ */
+void sobel_x_lines( unsigned char *source,
+                    short *result,
+                    int width,
+                    int lines ) {
    int x,y;
 
-   for (y = 1 ; y < (sobel_height-1) ; y++) {
-      for (x = 1 ; x < (sobel_width-1) ; x++) {
-         sobel_x_result[y*sobel_width+x] = sobel_mac(source,x,y,gx_array,sobel_width);
+   for (y = 1 ; y < (lines-1) ; y++) {
+      for (x = 1 ; x < (width-1) ; x++) {
+         result[y*width+x] = sobel_mac(source,x,y,gx_array,width);
       }
    }
 }
 
-void sobel_x_with_rgb( unsigned char *source ) {
-   int x,y;
+void sobel_ctx_x( sobel_ctx_t *ctx,
+                  unsigned char *source ) {
+   sobel_x_lines(source,ctx->x_result,ctx->width,ctx->height);
+}
+
+void sobel_ctx_x_with_rgb( sobel_ctx_t *ctx,
+                           unsigned char *source ) {
+   int x,y,width = ctx->width;
    short result;
 
-   for (y = 1 ; y < (sobel_height-1) ; y++) {
-      for (x = 1 ; x < (sobel_width-1) ; x++) {
-    	  result = sobel_mac(source,x,y,gx_array,sobel_width);
-          sobel_x_result[y*sobel_width+x] = result;
-          if (result < 0) {
-        	  sobel_rgb565[y*sobel_width+x] = ((-result)>>2)<<5;
-          } else {
-        	  sobel_rgb565[y*sobel_width+x] = ((result>>3)&0x1F)<<11;
-          }
+   for (y = 1 ; y < (ctx->height-1) ; y++) {
+      for (x = 1 ; x < (width-1) ; x++) {
+         result = sobel_mac(source,x,y,gx_array,width);
+         ctx->x_result[y*width+x] = result;
+         ctx->rgb565[y*width+x] = SOBEL_RGB(result);
       }
    }
 }
 
-void sobel_y( unsigned char *source ) {
+void sobel_y_lines( unsigned char *source,
+                    short *result,
+                    int width,
+                    int lines ) {
    int x,y;
 
-   for (y = 1 ; y < (sobel_height-1) ; y++) {
-      for (x = 1 ; x < (sobel_width-1) ; x++) {
-         sobel_y_result[y*sobel_width+x] = sobel_mac(source,x,y,gy_array,sobel_width);
+   for (y = 1 ; y < (lines-1) ; y++) {
+      for (x = 1 ; x < (width-1) ; x++) {
+         result[y*width+x] = sobel_mac(source,x,y,gy_array,width);
       }
    }
 }
 
-void sobel_y_with_rgb( unsigned char *source ) {
-   int x,y;
+void sobel_ctx_y( sobel_ctx_t *ctx,
+                  unsigned char *source ) {
+   sobel_y_lines(source,ctx->y_result,ctx->width,ctx->height);
+}
+
+void sobel_ctx_y_with_rgb( sobel_ctx_t *ctx,
+                           unsigned char *source ) {
+   int x,y,width = ctx->width;
    short result;
 
-   for (y = 1 ; y < (sobel_height-1) ; y++) {
-      for (x = 1 ; x < (sobel_width-1) ; x++) {
-    	  result = sobel_mac(source,x,y,gy_array,sobel_width);
-         sobel_y_result[y*sobel_width+x] = result;
-         if (result < 0) {
-       	  sobel_rgb565[y*sobel_width+x] = ((-result)>>2)<<5;
-         } else {
-       	  sobel_rgb565[y*sobel_width+x] = ((result>>3)&0x1F)<<11;
-         }
+   for (y = 1 ; y < (ctx->height-1) ; y++) {
+      for (x = 1 ; x < (width-1) ; x++) {
+         result = sobel_mac(source,x,y,gy_array,width);
+         ctx->y_result[y*width+x] = result;
+         ctx->rgb565[y*width+x] = SOBEL_RGB(result);
       }
    }
 }
 
-void sobel_threshold(short threshold) {
+void sobel_threshold_lines( short *x_result,
+                            short *y_result,
+                            unsigned char *result,
+                            int width,
+                            int lines,
+                            short threshold ) {
 	int x,y,arrayindex;
 	short sum,value;
-	for (y = 1 ; y < (sobel_height-1) ; y++) {
-		for (x = 1 ; x < (sobel_width-1) ; x++) {
-			arrayindex = (y*sobel_width)+x;
-			value = sobel_x_result[arrayindex];
+	for (y = 1 ; y < (lines-1) ; y++) {
+		for (x = 1 ; x < (width-1) ; x++) {
+			arrayindex = (y*width)+x;
+			value = x_result[arrayindex];
 			sum = (value < 0) ? -value : value;
-			value = sobel_y_result[arrayindex];
+			value = y_result[arrayindex];
 			sum += (value < 0) ? -value : value;
-			sobel_result[arrayindex] = (sum > threshold) ? 0xFF : 0;
+			result[arrayindex] = (sum > threshold) ? 0xFF : 0;
+		}
+	}
+}
+
+void sobel_ctx_threshold( sobel_ctx_t *ctx,
+                          short threshold ) {
+	sobel_threshold_lines(ctx->x_result,ctx->y_result,ctx->result,
+			              ctx->width,ctx->height,threshold);
+}
+
+/*
+ * Same as sobel_ctx_threshold, but writes a packed binary picture (see
+ * binary.h) of 32 pixels each word, the border pixels cleared. The words
+ * are built in a register, hence the edge map costs 1/8 of the memory writes.
+ */
+void sobel_ctx_threshold_packed( sobel_ctx_t *ctx,
+                                 short threshold,
+                                 unsigned int *destination ) {
+	int x,y,word_index,first,last,arrayindex;
+	int width = ctx->width, height = ctx->height;
+	int words = BINARY_WORDS_EACH_LINE(width);
+	short sum,value;
+	unsigned int word;
+	for (word_index = 0 ; word_index < words ; word_index++) {
+		destination[word_index] = 0;
+		destination[(height-1)*words+word_index] = 0;
+	}
+	for (y = 1 ; y < (height-1) ; y++) {
+		for (word_index = 0 ; word_index < words ; word_index++) {
+			first = (word_index == 0) ? 1 : word_index<<5;
+			last = (word_index<<5)+32;
+			if (last > (width-1))
+				last = width-1;
+			word = 0;
+			for (x = first ; x < last ; x++) {
+				arrayindex = (y*width)+x;
+				value = ctx->x_result[arrayindex];
+				sum = (value < 0) ? -value : value;
+				value = ctx->y_result[arrayindex];
+				sum += (value < 0) ? -value : value;
+				word |= (unsigned int)(sum > threshold)<<(x&31);
+			}
+			destination[y*words+word_index] = word;
 		}
 	}
 }
 
+/*
+ * Combined x and y filter writing the packed gradient: magnitude in bits 7..0
+ * and direction in bits 10..8 (see SOBEL_GRADIENT_MAGNITUDE/DIRECTION).
+ * The magnitude approximates sqrt(gx^2+gy^2) by max+3/8*min (error < 7%),
+ * scaled by 1/4 and saturated to 8 bit. The direction is found by comparing
+ * |gy| and |gx| against tan(22.5) ~ 106/256, so no atan2 is needed.
+ * One call handles the interior pixels of one line; above, line and below
+ * point to the three source lines around it.
+ */
+TCM_CODE void sobel_gradient_line( unsigned char *above,
+                                   unsigned char *line,
+                                   unsigned char *below,
+                                   unsigned short *result,
+                                   int width ) {
+   int x;
+   short gx,gy,ax,ay,max,min,magnitude;
+   unsigned char sector,index;
+
+   for (x = 1 ; x < (width-1) ; x++) {
+      gx = (above[x+1]-above[x-1])+((line[x+1]-line[x-1])<<1)+
+           (below[x+1]-below[x-1]);
+      gy = (above[x-1]+(above[x]<<1)+above[x+1])-
+           (below[x-1]+(below[x]<<1)+below[x+1]);
+      ax = (gx < 0) ? -gx : gx;
+      ay = (gy < 0) ? -gy : gy;
+      if (ax > ay) {
+         max = ax;
+         min = ay;
+      } else {
+         max = ay;
+         min = ax;
+      }
+      magnitude = (max+(min>>2)+(min>>3))>>2;
+      if (magnitude > 255)
+         magnitude = 255;
+      if ((ay<<8) < ax*106)
+         sector = 0;
+      else if ((ax<<8) < ay*106)
+         sector = 2;
+      else
+         sector = 1;
+      index = ((gx < 0) ? 8 : 0)|((gy < 0) ? 4 : 0)|sector;
+      result[x] = (gradient_direction_lut[index]<<8)|magnitude;
+   }
+}
+
+void sobel_ctx_gradient( sobel_ctx_t *ctx,
+                         unsigned char *source ) {
+   int y,width = ctx->width;
+
+   for (y = 1 ; y < (ctx->height-1) ; y++) {
+      sobel_gradient_line(&source[(y-1)*width],
+                          &source[y*width],
+                          &source[(y+1)*width],
+                          &ctx->gradient[y*width],
+                          width);
+   }
+}
+
+/* Shows the direction of each gradient above the threshold as a color */
+void sobel_ctx_gradient_rgb( sobel_ctx_t *ctx,
+                             short threshold ) {
+	int x,y,arrayindex,width = ctx->width;
+	unsigned short gradient;
+	for (y = 1 ; y < (ctx->height-1) ; y++) {
+		for (x = 1 ; x < (width-1) ; x++) {
+			arrayindex = (y*width)+x;
+			gradient = ctx->gradient[arrayindex];
+			ctx->rgb565[arrayindex] = (SOBEL_GRADIENT_MAGNITUDE(gradient) > threshold) ?
+					gradient_direction_rgb565[SOBEL_GRADIENT_DIRECTION(gradient)] : 0;
+		}
+	}
+}
+
+/*
+ * The single-threaded functions of the first exercises, on sobel_default.
+ * init_sobel_arrays allocates its buffers (cleared); the outputs can be
+ * redirected to a frame buffer, NULL selects the internal array again.
+ */
+unsigned short *sobel_rgb565_array;
+
+unsigned char *sobel_result_array;
+
+void init_sobel_arrays(int width , int height) {
+	int pixels = width*height;
+	free(sobel_default.x_result);
+	free(sobel_default.y_result);
+	free(sobel_default.gradient);
+	free(sobel_rgb565_array);
+	free(sobel_result_array);
+	sobel_rgb565_array = (unsigned short *)calloc(pixels,sizeof(unsigned short));
+	sobel_result_array = (unsigned char *)calloc(pixels,sizeof(unsigned char));
+	sobel_ctx_init(&sobel_default,width,height,
+			       (short *)calloc(pixels,sizeof(short)),
+			       (short *)calloc(pixels,sizeof(short)),
+			       (unsigned short *)calloc(pixels,sizeof(unsigned short)),
+			       sobel_rgb565_array,sobel_result_array);
+}
+
+void sobel_set_rgb_output( unsigned short *destination ) {
+	if (destination == NULL)
+		sobel_default.rgb565 = sobel_rgb565_array;
+	else
+		sobel_ctx_set_rgb_output(&sobel_default,destination);
+}
+
+void sobel_set_result_output( unsigned char *destination ) {
+	if (destination == NULL)
+		sobel_default.result = sobel_result_array;
+	else
+		sobel_ctx_set_result_output(&sobel_default,destination);
+}
+
+void sobel_x( unsigned char *source ) {
+   sobel_ctx_x(&sobel_default,source);
+}
+
+void sobel_x_with_rgb( unsigned char *source ) {
+   sobel_ctx_x_with_rgb(&sobel_default,source);
+}
+
+void sobel_y( unsigned char *source ) {
+   sobel_ctx_y(&sobel_default,source);
+}
+
+void sobel_y_with_rgb( unsigned char *source ) {
+   sobel_ctx_y_with_rgb(&sobel_default,source);
+}
+
+void sobel_threshold(short threshold) {
+	sobel_ctx_threshold(&sobel_default,threshold);
+}
+
+void sobel_threshold_packed( short threshold,
+                             unsigned int *destination ) {
+	sobel_ctx_threshold_packed(&sobel_default,threshold,destination);
+}
+
+void sobel_gradient( unsigned char *source ) {
+   sobel_ctx_gradient(&sobel_default,source);
+}
+
+void sobel_gradient_rgb(short threshold) {
+	sobel_ctx_gradient_rgb(&sobel_default,threshold);
+}
+
+unsigned short *GetSobelGradient(void)
+{
+  return sobel_default.gradient;
+}
+
 unsigned short *GetSobel_rgb(void)
 {
-  return sobel_rgb565;
+  return sobel_default.rgb565;
 }
 
 unsigned char *GetSobelResult(void)
 {
-  return sobel_result;
+  return sobel_default.result;
 }
@@ -34,20 +34,114 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "io.h"
+#include "binary.h"
 
+#define SOBEL_GRADIENT_MAGNITUDE(g) ((g)&0xFF)
+#define SOBEL_GRADIENT_DIRECTION(g) (((g)>>8)&0x7)
+
+/*
+ * A context holds the size and the caller's buffers of one picture stream,
+ * so several streams or sizes can be processed at the same time. The
+ * functions without a context work on an internal one (init_sobel_arrays).
+ */
+typedef struct sobel_ctx {
+	int width;
+	int height;
+	short *x_result;
+	short *y_result;
+	unsigned short *gradient;
+	unsigned short *rgb565;
+	unsigned char *result;
+} sobel_ctx_t;
+
+void sobel_ctx_init( sobel_ctx_t *ctx,
+                     int width,
+                     int height,
+                     short *x_result,
+                     short *y_result,
+                     unsigned short *gradient,
+                     unsigned short *rgb565,
+                     unsigned char *result );
+
+void sobel_ctx_set_rgb_output( sobel_ctx_t *ctx,
+                               unsigned short *destination );
+
+void sobel_ctx_set_result_output( sobel_ctx_t *ctx,
+                                  unsigned char *destination );
+
+void sobel_ctx_x( sobel_ctx_t *ctx,
+                  unsigned char *source );
+
+void sobel_ctx_x_with_rgb( sobel_ctx_t *ctx,
+                           unsigned char *source );
+
+void sobel_ctx_y( sobel_ctx_t *ctx,
+                  unsigned char *source );
+
+void sobel_ctx_y_with_rgb( sobel_ctx_t *ctx,
+                           unsigned char *source );
+
+void sobel_ctx_threshold( sobel_ctx_t *ctx,
+                          short threshold );
+
+void sobel_ctx_threshold_packed( sobel_ctx_t *ctx,
+                                 short threshold,
+                                 unsigned int *destination );
+
+void sobel_ctx_gradient( sobel_ctx_t *ctx,
+                         unsigned char *source );
+
+void sobel_ctx_gradient_rgb( sobel_ctx_t *ctx,
+                             short threshold );
 
 void init_sobel_arrays(int width , int height);
 
+void sobel_set_rgb_output( unsigned short *destination );
+
+void sobel_set_result_output( unsigned char *destination );
+
+void sobel_x_lines( unsigned char *source,
+                    short *result,
+                    int width,
+                    int lines );
+
 void sobel_x( unsigned char *source );
 
 void sobel_x_with_rgb( unsigned char *source );
 
+void sobel_y_lines( unsigned char *source,
+                    short *result,
+                    int width,
+                    int lines );
+
 void sobel_y( unsigned char *source );
 
 void sobel_y_with_rgb( unsigned char *source );
 
+void sobel_threshold_lines( short *x_result,
+                            short *y_result,
+                            unsigned char *result,
+                            int width,
+                            int lines,
+                            short threshold );
+
 void sobel_threshold(short threshold);
 
+void sobel_threshold_packed( short threshold,
+                             unsigned int *destination );
+
+void sobel_gradient_line( unsigned char *above,
+                          unsigned char *line,
+                          unsigned char *below,
+                          unsigned short *result,
+                          int width );
+
+void sobel_gradient( unsigned char *source );
+
+void sobel_gradient_rgb(short threshold);
+
+unsigned short *GetSobelGradient(void);
+
 unsigned short *GetSobel_rgb(void);
 
 unsigned char *GetSobelResult(void);
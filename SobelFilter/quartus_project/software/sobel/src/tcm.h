@@ -0,0 +1,55 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file tcm.h
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Placement of hot code and data in the tightly coupled memories of the
+ * base_system_tcm variant. The instruction TCM (tcm) and the data TCM
+ * (tcm_data) are single cycle and are not shared with the DMA masters on the
+ * sdram. With the BSP of base_system (no TCM) the macros are empty and
+ * everything stays in the sdram, so the same sources build for both systems.
+ * What the placement gains has not been measured on the board yet.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo compare the SW7 performance counter report of sobel_bsp and
+ *       sobel_tcm_bsp on the board
+ */
+
+#ifndef TCM_H_
+#define TCM_H_
+
+#include <system.h>
+
+#ifdef TCM_BASE
+#define TCM_CODE __attribute__((section(".tcm")))
+#else
+#define TCM_CODE
+#endif
+
+/* The HAL does not clear this section at reset, set it up in the init functions */
+#ifdef TCM_DATA_BASE
+#define TCM_DATA __attribute__((section(".tcm_data")))
+#else
+#define TCM_DATA
+#endif
+
+#endif /* TCM_H_ */
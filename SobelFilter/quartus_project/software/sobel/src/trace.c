@@ -0,0 +1,125 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file trace.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+#include <system.h>
+#include <io.h>
+#include <sys/alt_irq.h>
+#include "trace.h"
+#include "altera_avalon_performance_counter.h"
+
+/* the low word of the global time, read while the counter runs */
+#define TRACE_COUNTER() IORD(PERFORMANCE_COUNTER_0_BASE,0)
+
+trace_buffer_t trace;
+
+void trace_init(void) {
+	trace.head = 0;
+	trace.time_base = 0;
+	trace.enabled = 1;
+}
+
+/*
+ * Records an event at the time of a TRACE_COUNTER() value; a value latched
+ * by an interrupt must be kept in a latch of trace_latch().
+ */
+void trace_event_at(unsigned char phase,
+		            unsigned char point,
+		            unsigned short arg,
+		            alt_u32 counter) {
+	alt_irq_context context;
+	trace_event_t *event;
+	context = alt_irq_disable_all();
+	if (trace.enabled != 0) {
+		event = &trace.event[trace.head&(TRACE_EVENTS-1)];
+		event->timestamp = trace.time_base+counter;
+		event->phase = phase;
+		event->point = point;
+		event->arg = arg;
+		trace.head++;
+	}
+	alt_irq_enable_all(context);
+}
+
+/* Called by the main loop and the interrupts */
+void trace_event(unsigned char phase,
+		         unsigned char point,
+		         unsigned short arg) {
+	trace_event_at(phase,point,arg,TRACE_COUNTER());
+}
+
+/*
+ * A counter value latched by an interrupt is moved along with each reset of
+ * the counter, so it can still be given to trace_event_at() after a
+ * trace_perf_restart(). Returns 0 when all latches are used.
+ */
+char trace_latch(volatile unsigned int *counter) {
+	int loop;
+	for (loop = 0 ; loop < TRACE_LATCHES ; loop++) {
+		if (trace.latch[loop] == NULL || trace.latch[loop] == counter) {
+			trace.latch[loop] = counter;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/* PERF_RESET and PERF_START_MEASURING without a jump of the trace time */
+void trace_perf_restart(void) {
+	alt_irq_context context;
+	alt_u32 counter;
+	int loop;
+	context = alt_irq_disable_all();
+	counter = TRACE_COUNTER();
+	trace.time_base += counter;
+	/* an old value becomes negative, time_base+value stays the same */
+	for (loop = 0 ; loop < TRACE_LATCHES && trace.latch[loop] != NULL ; loop++)
+		*trace.latch[loop] -= counter;
+	PERF_RESET(PERFORMANCE_COUNTER_0_BASE);
+	PERF_START_MEASURING(PERFORMANCE_COUNTER_0_BASE);
+	alt_irq_enable_all(context);
+}
+
+/* Prints the recorded events, oldest first, and starts a new recording */
+void trace_dump(void) {
+	unsigned int first, loop;
+	trace_event_t *event;
+	trace.enabled = 0;
+	first = (trace.head > TRACE_EVENTS) ? trace.head-TRACE_EVENTS : 0;
+	/* the header has the clock, the events and the events overwritten */
+	printf("TRACE BEGIN %u %u %u\n",(unsigned int)ALT_CPU_FREQ,trace.head-first,
+		   first);
+	for (loop = first ; loop != trace.head ; loop++) {
+		event = &trace.event[loop&(TRACE_EVENTS-1)];
+		printf("%08x %c %u %u\n",(unsigned int)event->timestamp,event->phase,
+			   event->point,event->arg);
+	}
+	printf("TRACE END\n");
+	trace.head = 0;
+	trace.enabled = 1;
+}
@@ -0,0 +1,107 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file trace.h
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Timeline trace of the frame pipeline. The software stages and the DMA
+ * interrupts put begin, end and instant events of the points in
+ * trace_points.h into an in-memory buffer, with the time of the global
+ * counter of the performance counter. The buffer is a flight recorder:
+ * it always holds the last TRACE_EVENTS events, trace_dump() prints them
+ * (format in trace_points.h) and starts again. host/trace2chrome converts
+ * such a dump to Chrome trace-event JSON (chrome://tracing,
+ * ui.perfetto.dev), where the overlap of the stages and the DMAs can be
+ * seen.
+ *
+ * An event takes a slot with the interrupts off, so the main loop and the
+ * interrupts can both trace. The camera frame ready and the LCD end of DMA
+ * are only counted by the fast interrupt (fast_irq.h), which latches the
+ * counter; the main loop records them later with trace_event_at() and
+ * that time, so the events of a dump are not always in time order. The
+ * camera transfer of a frame is traced from one frame ready to the next,
+ * both written when the second one is seen. Without the fast interrupt
+ * the frame ready is traced when the main loop polls it. The performance counter is reset
+ * for each report: trace_perf_restart() does it and keeps the trace time
+ * running, also of the counters registered with trace_latch(); while the
+ * counter is stopped (report printing) the time stands still. Nothing is
+ * recorded before trace_init(), the compute core of dual_core.h does not
+ * trace.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <alt_types.h>
+#include "trace_points.h"
+
+/* must be a power of two */
+#define TRACE_EVENTS 1024
+#define TRACE_LATCHES 4
+
+typedef struct trace_event {
+	alt_u32 timestamp;
+	unsigned char phase;
+	unsigned char point;
+	unsigned short arg;
+} trace_event_t;
+
+typedef struct trace_buffer {
+	volatile unsigned int head;
+	volatile char enabled;
+	alt_u32 time_base;  /* counts before the last reset of the counter */
+	volatile unsigned int *latch[TRACE_LATCHES];
+	trace_event_t event[TRACE_EVENTS];
+} trace_buffer_t;
+
+extern trace_buffer_t trace;
+
+void trace_init(void);
+
+void trace_event(unsigned char phase,
+		         unsigned char point,
+		         unsigned short arg);
+
+void trace_event_at(unsigned char phase,
+		            unsigned char point,
+		            unsigned short arg,
+		            alt_u32 counter);
+
+char trace_latch(volatile unsigned int *counter);
+
+void trace_perf_restart(void);
+
+void trace_dump(void);
+
+#define trace_begin(point,arg) trace_event(TRACE_BEGIN,(point),(arg))
+#define trace_end(point,arg) trace_event(TRACE_END,(point),(arg))
+#define trace_instant(point,arg) trace_event(TRACE_INSTANT,(point),(arg))
+#define trace_begin_at(point,arg,counter) \
+	trace_event_at(TRACE_BEGIN,(point),(arg),(counter))
+#define trace_end_at(point,arg,counter) \
+	trace_event_at(TRACE_END,(point),(arg),(counter))
+#define trace_instant_at(point,arg,counter) \
+	trace_event_at(TRACE_INSTANT,(point),(arg),(counter))
+
+#endif /* TRACE_H_ */
@@ -0,0 +1,78 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file trace_points.h
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * The trace points of trace.h with their name and track; the target uses
+ * the ids, the host converter (host/trace2chrome) the names. A track is one
+ * row of the timeline: the software stages run on the cpu track, each DMA
+ * master has its own. New points go to the end of the list.
+ *
+ * A dump of trace_dump() starts with "TRACE BEGIN <clock> <events> <lost>",
+ * lost are the events overwritten since the previous dump. An event line is
+ * "<timestamp> <phase> <point> <arg>", the timestamp in hex, the point by
+ * its number. "TRACE END" closes the dump.
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#ifndef TRACE_POINTS_H_
+#define TRACE_POINTS_H_
+
+#define TRACE_BEGIN 'B'
+#define TRACE_END 'E'
+#define TRACE_INSTANT 'I'
+
+#define TRACE_TRACKS \
+	TRACE_TRACK(TRACE_TRACK_CPU,"cpu") \
+	TRACE_TRACK(TRACE_TRACK_CAMERA,"camera dma") \
+	TRACE_TRACK(TRACE_TRACK_LCD,"lcd dma") \
+	TRACE_TRACK(TRACE_TRACK_VGA,"vga dma")
+
+/* begin/end points are spans, the others are instants */
+#define TRACE_POINTS \
+	TRACE_POINT(TRACE_FRAME,"frame",TRACE_TRACK_CPU) \
+	TRACE_POINT(TRACE_FILTER,"filter chain",TRACE_TRACK_CPU) \
+	TRACE_POINT(TRACE_GRAY,"grayscale",TRACE_TRACK_CPU) \
+	TRACE_POINT(TRACE_MEDIAN,"median",TRACE_TRACK_CPU) \
+	TRACE_POINT(TRACE_STAGE,"filter stage",TRACE_TRACK_CPU) \
+	TRACE_POINT(TRACE_CAMERA_FRAME,"frame ready",TRACE_TRACK_CAMERA) \
+	TRACE_POINT(TRACE_LCD_DMA,"lcd transfer",TRACE_TRACK_LCD) \
+	TRACE_POINT(TRACE_VGA_FLIP,"vga flip",TRACE_TRACK_VGA) \
+	TRACE_POINT(TRACE_CAMERA_DMA,"camera transfer",TRACE_TRACK_CAMERA)
+
+enum trace_track {
+#define TRACE_TRACK(id,name) id,
+	TRACE_TRACKS
+#undef TRACE_TRACK
+	TRACE_NR_OF_TRACKS
+};
+
+enum trace_point {
+#define TRACE_POINT(id,name,track) id,
+	TRACE_POINTS
+#undef TRACE_POINT
+	TRACE_NR_OF_POINTS
+};
+
+#endif /* TRACE_POINTS_H_ */
@@ -29,11 +29,46 @@
  */
 
 #include "vga.h"
+#include <sys/alt_irq.h>
+
+char vga_swap = 0;
+char vga_irq_mode = 0;
+void (*vga_flip_callback)(void *) = NULL;
+void *vga_flip_context = NULL;
+
+void vga_flip_irq(void *context) {
+	IOWR_8DIRECT(VGA_DMA_BASE,4,vga_swap|vga_irq_mode|VGA_Clear_Flip_IRQ);
+	if (vga_flip_callback != NULL)
+		vga_flip_callback(vga_flip_context);
+}
+
+void vga_enable_flip_irq() {
+	if (vga_irq_mode != 0)
+		return;
+	alt_ic_isr_register(VGA_DMA_IRQ_INTERRUPT_CONTROLLER_ID,VGA_DMA_IRQ,
+			            vga_flip_irq,NULL,NULL);
+	vga_irq_mode = VGA_Flip_IRQ_Enabled;
+	IOWR_8DIRECT(VGA_DMA_BASE,4,vga_swap|vga_irq_mode|VGA_Clear_Flip_IRQ);
+}
 
 void vga_set_pointer( void* image ) {
 	IOWR_32DIRECT(VGA_DMA_BASE,0,(int)image);
 }
 
 void vga_set_swap(char swap) {
-	IOWR_8DIRECT(VGA_DMA_BASE,4,swap);
+	vga_swap = swap&(VGA_RED_BLUE_SWAP|VGA_TEST_SCREEN|VGA_FLIP_X|
+			         VGA_QuarterScreen|VGA_Grayscale);
+	IOWR_8DIRECT(VGA_DMA_BASE,4,vga_swap|vga_irq_mode);
+}
+
+/*
+ * The callback is called in interrupt context after each flip. There is one
+ * flip owner, the frame buffer pool (fb_show_vga()), which also keeps track
+ * of the buffer on screen.
+ */
+void vga_register_flip_callback(void (*callback)(void *),
+		                        void *context) {
+	vga_flip_context = context;
+	vga_flip_callback = callback;
+	vga_enable_flip_irq();
 }
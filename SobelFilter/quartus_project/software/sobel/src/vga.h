@@ -31,6 +31,7 @@
 #ifndef VGA_H_
 #define VGA_H_
 
+#include <stdlib.h>
 #include <system.h>
 #include <io.h>
 
@@ -39,9 +40,16 @@
 #define VGA_FLIP_X 4
 #define VGA_QuarterScreen 8
 #define VGA_Grayscale 16
+#define VGA_Flip_IRQ_Enabled 32
+#define VGA_Clear_Flip_IRQ 64
+#define VGA_Flip_IRQ_Generated 64
+#define VGA_Flip_Pending 128
 
 void vga_set_pointer( void* image );
 
 void vga_set_swap(char swap);
 
+void vga_register_flip_callback(void (*callback)(void *),
+		                        void *context);
+
 #endif /* VGA_H_ */
@@ -149,6 +149,7 @@
 #define __ALTERA_AVALON_TIMER
 #define __ALTERA_NIOS2_GEN2
 #define __ALTPLL
+#define __BUS_MONITOR
 #define __CAM_DMA
 #define __I2C_MASTER
 #define __LCD_DMA
@@ -257,6 +258,20 @@
 #define SYSTIMER_TYPE "altera_avalon_timer"
 
 
+/*
+ * bus_monitor_0 configuration
+ *
+ */
+
+#define ALT_MODULE_CLASS_bus_monitor_0 bus_monitor
+#define BUS_MONITOR_0_BASE 0x1001180
+#define BUS_MONITOR_0_IRQ -1
+#define BUS_MONITOR_0_IRQ_INTERRUPT_CONTROLLER_ID -1
+#define BUS_MONITOR_0_NAME "/dev/bus_monitor_0"
+#define BUS_MONITOR_0_SPAN 128
+#define BUS_MONITOR_0_TYPE "bus_monitor"
+
+
 /*
  * cam_ctrl configuration
  *
@@ -278,20 +293,20 @@
 
 #define ALT_MODULE_CLASS_dipsw altera_avalon_pio
 #define DIPSW_BASE 0x1001120
-#define DIPSW_BIT_CLEARING_EDGE_REGISTER 0
+#define DIPSW_BIT_CLEARING_EDGE_REGISTER 1
 #define DIPSW_BIT_MODIFYING_OUTPUT_REGISTER 0
-#define DIPSW_CAPTURE 0
+#define DIPSW_CAPTURE 1
 #define DIPSW_DATA_WIDTH 8
 #define DIPSW_DO_TEST_BENCH_WIRING 0
 #define DIPSW_DRIVEN_SIM_VALUE 0
-#define DIPSW_EDGE_TYPE "NONE"
+#define DIPSW_EDGE_TYPE "ANY"
 #define DIPSW_FREQ 50000000
 #define DIPSW_HAS_IN 1
 #define DIPSW_HAS_OUT 0
 #define DIPSW_HAS_TRI 0
-#define DIPSW_IRQ -1
-#define DIPSW_IRQ_INTERRUPT_CONTROLLER_ID -1
-#define DIPSW_IRQ_TYPE "NONE"
+#define DIPSW_IRQ 7
+#define DIPSW_IRQ_INTERRUPT_CONTROLLER_ID 0
+#define DIPSW_IRQ_TYPE "EDGE"
 #define DIPSW_NAME "/dev/dipsw"
 #define DIPSW_RESET_VALUE 0
 #define DIPSW_SPAN 16
@@ -432,8 +447,8 @@
 
 #define ALT_MODULE_CLASS_vga_dma vga_dma
 #define VGA_DMA_BASE 0x1001150
-#define VGA_DMA_IRQ -1
-#define VGA_DMA_IRQ_INTERRUPT_CONTROLLER_ID -1
+#define VGA_DMA_IRQ 6
+#define VGA_DMA_IRQ_INTERRUPT_CONTROLLER_ID 0
 #define VGA_DMA_NAME "/dev/vga_dma"
 #define VGA_DMA_SPAN 8
 #define VGA_DMA_TYPE "vga_dma"
@@ -0,0 +1,95 @@
+/****************************************************************************
+ * Copyright (C) 2016 by Theo Kluter                                        *
+ *                                                                          *
+ * This file is part of TSM_EmbHardw (MSE) sobel exercise                   *
+ *                                                                          *
+ *   lab1 ex is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as published  *
+ *   by the Free Software Foundation, either version 3 of the License, or   *
+ *   (at your option) any later version.                                    *
+ *                                                                          *
+ *   SMS is distributed in the hope that it will be useful, to students     *
+ *   following the course BTF1230 at Bern University but WITHOUT ANY        *
+ *   WARRANTY. See the GNU Lesser General Public License for more details.  *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with MSE-SE. If not, see <http://www.gnu.org/licenses/>. *
+ ****************************************************************************/
+/**
+ * @file main.c
+ * @date Oct 19, 2026
+ * @brief Introduction to Embedded Hardwar System Engineering
+ *
+ * Compute core (CPU_1) of base_system_dual: takes the jobs queued by the
+ * sobel application on core 0, runs the filter chain and queues them back,
+ * see dual_core.h. It owns the performance counter; SW7 prints the report
+ * on its JTAG UART (nios2-terminal --instance 1).
+ *
+ * @copyright GNU Lesser General Public License
+ * @see http://www.msengineering.ch/
+ * @bug currently no bugs
+ * @todo no open tasks
+ */
+
+#include <stdio.h>
+#include <system.h>
+#include <sys/alt_cache.h>
+#include "dual_core.h"
+#include "filter_chain.h"
+#include "altera_avalon_mutex.h"
+#include "altera_avalon_performance_counter.h"
+
+#define PERF_REPORT_FRAMES 64
+
+int main(void)
+{
+  dual_shared_t *shared = DUAL_SHARED;
+  dual_job_t *job;
+  alt_mutex_dev *mutex;
+  unsigned char current_mode;
+  unsigned char mode;
+  unsigned char last_mode = 0xFF;
+  unsigned int frames = 0;
+  /* core 0 owns the mutex until the shared memory is set up */
+  mutex = altera_avalon_mutex_open(MUTEX_NAME);
+  altera_avalon_mutex_lock(mutex,1);
+  altera_avalon_mutex_unlock(mutex);
+  printf("Hello from Nios II core 1!\n");
+  init_filter_chain(shared->width,shared->height);
+  PERF_RESET(PERFORMANCE_COUNTER_0_BASE);
+  PERF_START_MEASURING(PERFORMANCE_COUNTER_0_BASE);
+  do {
+	  job = (dual_job_t *)frame_queue_get(&shared->to_compute);
+	  if (job == NULL)
+		  continue;
+	  current_mode = job->current_mode;
+	  mode = current_mode&FILTER_MODE_MASK;
+	  if (mode != last_mode) {
+		  PERF_RESET(PERFORMANCE_COUNTER_0_BASE);
+		  PERF_START_MEASURING(PERFORMANCE_COUNTER_0_BASE);
+		  last_mode = mode;
+		  frames = 0;
+	  }
+	  PERF_BEGIN(PERFORMANCE_COUNTER_0_BASE,PERF_FRAME_SECTION);
+	  /* the camera wrote the source behind the cache of this core */
+	  alt_dcache_flush(job->source,shared->frame_bytes);
+	  filter_chain(current_mode,job->source,job->destination,
+			       &job->result);
+	  /* the LCD and the VGA read the destination from the sdram */
+	  alt_dcache_flush(job->destination,shared->frame_bytes);
+	  PERF_END(PERFORMANCE_COUNTER_0_BASE,PERF_FRAME_SECTION);
+	  /* cannot be full, there are less jobs than slots; core 0 may reuse
+	   * the job as soon as it is queued */
+	  frame_queue_put(&shared->to_display,job);
+	  if (++frames == PERF_REPORT_FRAMES) {
+		  if ((current_mode&DIPSW_SW7_MASK)!=0) {
+			  PERF_STOP_MEASURING(PERFORMANCE_COUNTER_0_BASE);
+			  filter_chain_report(mode,frames);
+		  }
+		  PERF_RESET(PERFORMANCE_COUNTER_0_BASE);
+		  PERF_START_MEASURING(PERFORMANCE_COUNTER_0_BASE);
+		  frames = 0;
+	  }
+  } while (1);
+  return 0;
+}
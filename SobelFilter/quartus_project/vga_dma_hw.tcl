@@ -105,7 +105,9 @@ set_interface_property slave SVD_ADDRESS_GROUP ""
 add_interface_port slave slave_address address Input 1
 add_interface_port slave slave_cs chipselect Input 1
 add_interface_port slave slave_we write Input 1
+add_interface_port slave slave_rd read Input 1
 add_interface_port slave slave_write_data writedata Input 32
+add_interface_port slave slave_read_data readdata Output 32
 set_interface_assignment slave embeddedsw.configuration.isFlash 0
 set_interface_assignment slave embeddedsw.configuration.isMemoryDevice 0
 set_interface_assignment slave embeddedsw.configuration.isNonVolatileStorage 0
@@ -175,6 +177,24 @@ add_interface_port master master_read_data readdata Input 32
 add_interface_port master master_waitrequest waitrequest Input 1
 
 
+# 
+# connection point irq
+# 
+add_interface irq interrupt end
+set_interface_property irq associatedAddressablePoint slave
+set_interface_property irq associatedClock clock
+set_interface_property irq associatedReset reset
+set_interface_property irq bridgedReceiverOffset ""
+set_interface_property irq bridgesToReceiver ""
+set_interface_property irq ENABLED true
+set_interface_property irq EXPORT_OF ""
+set_interface_property irq PORT_NAME_MAP ""
+set_interface_property irq CMSIS_SVD_VARIABLES ""
+set_interface_property irq SVD_ADDRESS_GROUP ""
+
+add_interface_port irq flip_done_irq irq Output 1
+
+
 # 
 # connection point vga
 # 
@@ -0,0 +1,181 @@
+#!/bin/sh
+#
+# Builds and runs one of the testbenches of ../vhdl with GHDL
+#
+#   ./run_tb.sh <testbench> [ghdl run options]
+#   ./run_tb.sh all
+#
+# e.g. ./run_tb.sh vga_dma_flip_tb --wave=vga.ghw
+#      ./run_tb.sh lcd_dma_throughput_tb -gMAX_WAIT=8
+#
+# "all" runs every testbench with its defaults and prints PASS or FAIL for
+# each, the log of a testbench is kept in work/<testbench>.log
+#
+
+MODULES=../../vhdl_modules
+VHDL_2=../../../2_vhdl
+TB_DIR=../vhdl
+GHDL_FLAGS="--std=93c --ieee=synopsys -fexplicit --workdir=work"
+TESTBENCHES="bus_monitor_tb
+             cam_dma_throughput_tb
+             dma_lcd_ctrl_tb
+             lcd_binary_tb
+             lcd_dma_throughput_tb
+             lcd_rotation_tb
+             send_receive_if_timing_tb
+             simple_pio_irq_tb
+             simple_pio_read_burst_tb
+             vga_dma_flip_tb
+             vga_dma_throughput_tb"
+
+TB=$1
+if [ -z "$TB" ]; then
+   echo "usage: $0 <testbench> [ghdl run options]"
+   exit 1
+fi
+shift
+
+if [ "$TB" = "all" ]; then
+   mkdir -p work
+   FAILED=0
+   for T in $TESTBENCHES; do
+      if "$0" $T > work/$T.log 2>&1; then
+         echo "PASS $T"
+      else
+         echo "FAIL $T (work/$T.log)"
+         FAILED=1
+      fi
+   done
+   exit $FAILED
+fi
+
+case $TB in
+   vga_dma_flip_tb)
+      SOURCES="$MODULES/camera_controller/synchroflop_entity.vhdl
+               $MODULES/camera_controller/synchroflop_behavior.vhdl
+               $MODULES/vga_controller/delay_line_entity.vhdl
+               $MODULES/vga_controller/delay_line_behavior.vhdl
+               $MODULES/vga_controller/vga_entity.vhdl
+               $MODULES/vga_controller/vga_behavior.vhdl
+               $MODULES/vga_controller/vga_dma_cntrl_entity.vhdl
+               $MODULES/vga_controller/vga_dma_cntrl_behavior.vhdl
+               $MODULES/vga_controller/vga_dma_entity.vhdl
+               $MODULES/vga_controller/vga_dma_behavior.vhdl
+               $TB_DIR/vga_dma_flip_tb.vhdl"
+      ;;
+   bus_monitor_tb)
+      SOURCES="$MODULES/bus_monitor/bus_monitor_channel_entity.vhdl
+               $MODULES/bus_monitor/bus_monitor_channel_behavior.vhdl
+               $MODULES/bus_monitor/bus_monitor_entity.vhdl
+               $MODULES/bus_monitor/bus_monitor_behavior.vhdl
+               $TB_DIR/bus_monitor_tb.vhdl"
+      ;;
+   lcd_dma_throughput_tb)
+      SOURCES="$TB_DIR/avalon_bfm_pkg/avalon_bfm_pkg.vhdl
+               $TB_DIR/avalon_bfm_pkg/avalon_bfm_slave.vhdl
+               $MODULES/lcd_controller/send_receive_if_entity.vhdl
+               $MODULES/lcd_controller/send_receive_if_behavior.vhdl
+               $MODULES/lcd_controller/dma_controller_entity.vhdl
+               $MODULES/lcd_controller/dma_controller_behavior.vhdl
+               $MODULES/lcd_controller/pixel_formatter_entity.vhdl
+               $MODULES/lcd_controller/pixel_formatter_behavior.vhdl
+               $MODULES/lcd_controller/lcd_dma_entity.vhdl
+               $MODULES/lcd_controller/lcd_dma_behavior.vhdl
+               $TB_DIR/lcd_dma_throughput_tb.vhdl"
+      ;;
+   cam_dma_throughput_tb)
+      SOURCES="$TB_DIR/avalon_bfm_pkg/avalon_bfm_pkg.vhdl
+               $TB_DIR/avalon_bfm_pkg/avalon_bfm_slave.vhdl
+               $MODULES/camera_controller/synchroflop_entity.vhdl
+               $MODULES/camera_controller/synchroflop_behavior.vhdl
+               $MODULES/camera_controller/frame_interpreter_entity.vhdl
+               $MODULES/camera_controller/frame_interpreter_behavior.vhdl
+               $MODULES/camera_controller/pixel_interface_entity.vhdl
+               $MODULES/camera_controller/pixel_interface_behavior.vhdl
+               $MODULES/camera_controller/cam_dma_ctrl_entity.vhdl
+               $MODULES/camera_controller/cam_dma_ctrl_behaviour.vhdl
+               $MODULES/camera_controller/cam_dma_entity.vhdl
+               $MODULES/camera_controller/cam_dma_behaviour.vhdl
+               $TB_DIR/cam_dma_throughput_tb.vhdl"
+      ;;
+   vga_dma_throughput_tb)
+      SOURCES="$TB_DIR/avalon_bfm_pkg/avalon_bfm_pkg.vhdl
+               $TB_DIR/avalon_bfm_pkg/avalon_bfm_slave.vhdl
+               $MODULES/camera_controller/synchroflop_entity.vhdl
+               $MODULES/camera_controller/synchroflop_behavior.vhdl
+               $MODULES/vga_controller/delay_line_entity.vhdl
+               $MODULES/vga_controller/delay_line_behavior.vhdl
+               $MODULES/vga_controller/vga_entity.vhdl
+               $MODULES/vga_controller/vga_behavior.vhdl
+               $MODULES/vga_controller/vga_dma_cntrl_entity.vhdl
+               $MODULES/vga_controller/vga_dma_cntrl_behavior.vhdl
+               $MODULES/vga_controller/vga_dma_entity.vhdl
+               $MODULES/vga_controller/vga_dma_behavior.vhdl
+               $TB_DIR/vga_dma_throughput_tb.vhdl"
+      ;;
+   dma_lcd_ctrl_tb)
+      SOURCES="$TB_DIR/avalon_bfm_pkg/avalon_bfm_pkg.vhdl
+               $TB_DIR/avalon_bfm_pkg/avalon_bfm_slave.vhdl
+               $VHDL_2/DMA_LCD_ctrl.vhd
+               $MODULES/lcd_controller/send_receive_if_entity.vhdl
+               $MODULES/lcd_controller/send_receive_if_behavior.vhdl
+               $MODULES/lcd_controller/dma_controller_entity.vhdl
+               $MODULES/lcd_controller/dma_controller_behavior.vhdl
+               $MODULES/lcd_controller/pixel_formatter_entity.vhdl
+               $MODULES/lcd_controller/pixel_formatter_behavior.vhdl
+               $MODULES/lcd_controller/lcd_dma_entity.vhdl
+               $MODULES/lcd_controller/lcd_dma_behavior.vhdl
+               $TB_DIR/dma_lcd_ctrl_tb.vhdl"
+      ;;
+   lcd_rotation_tb)
+      SOURCES="$TB_DIR/avalon_bfm_pkg/avalon_bfm_pkg.vhdl
+               $TB_DIR/avalon_bfm_pkg/avalon_bfm_slave.vhdl
+               $MODULES/lcd_controller/send_receive_if_entity.vhdl
+               $MODULES/lcd_controller/send_receive_if_behavior.vhdl
+               $MODULES/lcd_controller/dma_controller_entity.vhdl
+               $MODULES/lcd_controller/dma_controller_behavior.vhdl
+               $MODULES/lcd_controller/pixel_formatter_entity.vhdl
+               $MODULES/lcd_controller/pixel_formatter_behavior.vhdl
+               $MODULES/lcd_controller/lcd_dma_entity.vhdl
+               $MODULES/lcd_controller/lcd_dma_behavior.vhdl
+               $TB_DIR/lcd_rotation_tb.vhdl"
+      ;;
+   lcd_binary_tb)
+      SOURCES="$TB_DIR/avalon_bfm_pkg/avalon_bfm_pkg.vhdl
+               $TB_DIR/avalon_bfm_pkg/avalon_bfm_slave.vhdl
+               $MODULES/lcd_controller/send_receive_if_entity.vhdl
+               $MODULES/lcd_controller/send_receive_if_behavior.vhdl
+               $MODULES/lcd_controller/dma_controller_entity.vhdl
+               $MODULES/lcd_controller/dma_controller_behavior.vhdl
+               $MODULES/lcd_controller/pixel_formatter_entity.vhdl
+               $MODULES/lcd_controller/pixel_formatter_behavior.vhdl
+               $MODULES/lcd_controller/lcd_dma_entity.vhdl
+               $MODULES/lcd_controller/lcd_dma_behavior.vhdl
+               $TB_DIR/lcd_binary_tb.vhdl"
+      ;;
+   simple_pio_irq_tb)
+      SOURCES="$TB_DIR/avalon_bfm_pkg/avalon_bfm_pkg.vhdl
+               $VHDL_2/simplePIO-arch1Wait.vhd
+               $TB_DIR/simple_pio_irq_tb.vhdl"
+      ;;
+   simple_pio_read_burst_tb)
+      SOURCES="$TB_DIR/avalon_bfm_pkg/avalon_bfm_pkg.vhdl
+               $VHDL_2/simplePIO-arch1Wait.vhd
+               $VHDL_2/simplePIO-archPipelined.vhd
+               $TB_DIR/simple_pio_read_burst_tb.vhdl"
+      ;;
+   send_receive_if_timing_tb)
+      SOURCES="$MODULES/lcd_controller/send_receive_if_entity.vhdl
+               $MODULES/lcd_controller/send_receive_if_behavior.vhdl
+               $TB_DIR/send_receive_if_timing_tb.vhdl"
+      ;;
+   *)
+      echo "unknown testbench $TB"
+      exit 1
+      ;;
+esac
+
+mkdir -p work
+ghdl -a $GHDL_FLAGS $SOURCES || exit 1
+ghdl -e $GHDL_FLAGS $TB || exit 1
+ghdl -r $GHDL_FLAGS $TB --assert-level=error "$@"
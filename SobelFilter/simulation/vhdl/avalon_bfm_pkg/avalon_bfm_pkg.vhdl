@@ -0,0 +1,275 @@
+--------------------------------------------------------------------------------
+--- Avalon-MM bus functional models                                          ---
+---                                                                          ---
+--- Master side: procedures for single reads and writes on the control       ---
+--- slaves of the modules (with wait request and read wait time), and burst  ---
+--- reads and writes for masters in front of a memory.                       ---
+--- Slave side: the component avalon_bfm_slave (avalon_bfm_slave.vhdl), a    ---
+--- burst capable memory model with random wait states, a configurable read  ---
+--- latency and bus statistics.                                              ---
+--- avalon_bfm_report prints the cycles per pixel and the throughput of a    ---
+--- DMA transfer from these statistics.                                      ---
+--------------------------------------------------------------------------------
+LIBRARY ieee;
+USE ieee.std_logic_1164.all;
+USE ieee.numeric_std.all;
+USE ieee.math_real.all;
+USE std.textio.all;
+
+PACKAGE avalon_bfm_pkg IS
+
+   COMPONENT avalon_bfm_slave IS
+      GENERIC( BURST_WIDTH          : INTEGER := 10;
+               MIN_WAIT             : INTEGER := 0;
+               MAX_WAIT             : INTEGER := 0;
+               READ_LATENCY         : INTEGER := 1;
+               MAX_PENDING          : INTEGER := 4;
+               SEED                 : INTEGER := 1);
+      PORT ( Clock                  : IN  std_logic;
+             Reset                  : IN  std_logic;
+             Clear                  : IN  std_logic;
+             slave_address          : IN  std_logic_vector( 31 DOWNTO 0 );
+             slave_read             : IN  std_logic;
+             slave_write            : IN  std_logic;
+             slave_write_data       : IN  std_logic_vector( 31 DOWNTO 0 );
+             slave_burst_count      : IN  std_logic_vector( BURST_WIDTH-1 DOWNTO 0 );
+             slave_read_data        : OUT std_logic_vector( 31 DOWNTO 0 );
+             slave_read_data_valid  : OUT std_logic;
+             slave_wait_request     : OUT std_logic;
+             Commands               : OUT INTEGER;
+             Beats                  : OUT INTEGER;
+             WaitCycles             : OUT INTEGER;
+             BusyCycles             : OUT INTEGER;
+             MaxLatency             : OUT INTEGER);
+   END COMPONENT;
+
+   -- Draws a uniformly distributed integer in min_value..max_value
+   PROCEDURE avalon_bfm_random( VARIABLE seed1     : INOUT POSITIVE;
+                                VARIABLE seed2     : INOUT POSITIVE;
+                                CONSTANT min_value : IN    INTEGER;
+                                CONSTANT max_value : IN    INTEGER;
+                                VARIABLE value     : OUT   INTEGER );
+
+   -- Single write, the write is held until the wait request is released
+   PROCEDURE avalon_bfm_write( SIGNAL   Clock        : IN  std_logic;
+                               SIGNAL   address      : OUT std_logic_vector;
+                               SIGNAL   cs           : OUT std_logic;
+                               SIGNAL   we           : OUT std_logic;
+                               SIGNAL   write_data   : OUT std_logic_vector;
+                               SIGNAL   wait_request : IN  std_logic;
+                               CONSTANT reg_address  : IN  INTEGER;
+                               CONSTANT data         : IN  std_logic_vector );
+
+   -- Single read, read_wait is the readWaitTime of the slave (1 for slaves
+   -- with a registered read data)
+   PROCEDURE avalon_bfm_read( SIGNAL   Clock        : IN  std_logic;
+                              SIGNAL   address      : OUT std_logic_vector;
+                              SIGNAL   cs           : OUT std_logic;
+                              SIGNAL   rd           : OUT std_logic;
+                              SIGNAL   read_data    : IN  std_logic_vector;
+                              SIGNAL   wait_request : IN  std_logic;
+                              CONSTANT reg_address  : IN  INTEGER;
+                              CONSTANT read_wait    : IN  INTEGER;
+                              VARIABLE data         : OUT std_logic_vector );
+
+   -- Write burst of length beats, beat n carries start_address+4n, which is
+   -- the pattern avalon_bfm_slave returns on reads
+   PROCEDURE avalon_bfm_burst_write( SIGNAL   Clock         : IN  std_logic;
+                                     SIGNAL   address       : OUT std_logic_vector;
+                                     SIGNAL   write         : OUT std_logic;
+                                     SIGNAL   write_data    : OUT std_logic_vector;
+                                     SIGNAL   burst_count   : OUT std_logic_vector;
+                                     SIGNAL   wait_request  : IN  std_logic;
+                                     CONSTANT start_address : IN  INTEGER;
+                                     CONSTANT length        : IN  INTEGER );
+
+   -- Read burst of length beats, each beat is checked against the address
+   -- pattern, mismatches are added to errors
+   PROCEDURE avalon_bfm_burst_read( SIGNAL   Clock           : IN    std_logic;
+                                    SIGNAL   address         : OUT   std_logic_vector;
+                                    SIGNAL   read            : OUT   std_logic;
+                                    SIGNAL   burst_count     : OUT   std_logic_vector;
+                                    SIGNAL   read_data       : IN    std_logic_vector;
+                                    SIGNAL   read_data_valid : IN    std_logic;
+                                    SIGNAL   wait_request    : IN    std_logic;
+                                    CONSTANT start_address   : IN    INTEGER;
+                                    CONSTANT length          : IN    INTEGER;
+                                    VARIABLE errors          : INOUT INTEGER );
+
+   -- Formats a non negative value with two decimals
+   FUNCTION avalon_bfm_fixed( value : REAL ) RETURN STRING;
+
+   -- Prints the cycles per pixel and the throughput (1 MB = 10^6 bytes) of a
+   -- transfer of pixels pixels and bytes bytes that took cycles clock cycles,
+   -- of which the slave was busy for bus_cycles
+   PROCEDURE avalon_bfm_report( CONSTANT name         : IN STRING;
+                                CONSTANT pixels       : IN INTEGER;
+                                CONSTANT bytes        : IN INTEGER;
+                                CONSTANT cycles       : IN INTEGER;
+                                CONSTANT bus_cycles   : IN INTEGER;
+                                CONSTANT clock_period : IN TIME );
+
+END avalon_bfm_pkg;
+
+PACKAGE BODY avalon_bfm_pkg IS
+
+   PROCEDURE avalon_bfm_random( VARIABLE seed1     : INOUT POSITIVE;
+                                VARIABLE seed2     : INOUT POSITIVE;
+                                CONSTANT min_value : IN    INTEGER;
+                                CONSTANT max_value : IN    INTEGER;
+                                VARIABLE value     : OUT   INTEGER ) IS
+      VARIABLE v_random : REAL;
+   BEGIN
+      uniform(seed1,seed2,v_random);
+      value := min_value +
+               INTEGER(TRUNC(v_random*REAL(max_value-min_value+1)));
+   END avalon_bfm_random;
+
+   PROCEDURE avalon_bfm_write( SIGNAL   Clock        : IN  std_logic;
+                               SIGNAL   address      : OUT std_logic_vector;
+                               SIGNAL   cs           : OUT std_logic;
+                               SIGNAL   we           : OUT std_logic;
+                               SIGNAL   write_data   : OUT std_logic_vector;
+                               SIGNAL   wait_request : IN  std_logic;
+                               CONSTANT reg_address  : IN  INTEGER;
+                               CONSTANT data         : IN  std_logic_vector ) IS
+   BEGIN
+      WAIT UNTIL rising_edge(Clock);
+      address    <= std_logic_vector(to_unsigned(reg_address,address'length));
+      write_data <= data;
+      cs         <= '1';
+      we         <= '1';
+      WAIT UNTIL rising_edge(Clock);
+      WHILE wait_request = '1' LOOP
+         WAIT UNTIL rising_edge(Clock);
+      END LOOP;
+      cs         <= '0';
+      we         <= '0';
+   END avalon_bfm_write;
+
+   PROCEDURE avalon_bfm_read( SIGNAL   Clock        : IN  std_logic;
+                              SIGNAL   address      : OUT std_logic_vector;
+                              SIGNAL   cs           : OUT std_logic;
+                              SIGNAL   rd           : OUT std_logic;
+                              SIGNAL   read_data    : IN  std_logic_vector;
+                              SIGNAL   wait_request : IN  std_logic;
+                              CONSTANT reg_address  : IN  INTEGER;
+                              CONSTANT read_wait    : IN  INTEGER;
+                              VARIABLE data         : OUT std_logic_vector ) IS
+   BEGIN
+      WAIT UNTIL rising_edge(Clock);
+      address <= std_logic_vector(to_unsigned(reg_address,address'length));
+      cs      <= '1';
+      rd      <= '1';
+      WAIT UNTIL rising_edge(Clock);
+      WHILE wait_request = '1' LOOP
+         WAIT UNTIL rising_edge(Clock);
+      END LOOP;
+      FOR n IN 1 TO read_wait LOOP
+         WAIT UNTIL rising_edge(Clock);
+      END LOOP;
+      data    := read_data;
+      cs      <= '0';
+      rd      <= '0';
+   END avalon_bfm_read;
+
+   PROCEDURE avalon_bfm_burst_write( SIGNAL   Clock         : IN  std_logic;
+                                     SIGNAL   address       : OUT std_logic_vector;
+                                     SIGNAL   write         : OUT std_logic;
+                                     SIGNAL   write_data    : OUT std_logic_vector;
+                                     SIGNAL   burst_count   : OUT std_logic_vector;
+                                     SIGNAL   wait_request  : IN  std_logic;
+                                     CONSTANT start_address : IN  INTEGER;
+                                     CONSTANT length        : IN  INTEGER ) IS
+   BEGIN
+      WAIT UNTIL rising_edge(Clock);
+      address     <= std_logic_vector(to_unsigned(start_address,address'length));
+      burst_count <= std_logic_vector(to_unsigned(length,burst_count'length));
+      write       <= '1';
+      FOR beat IN 0 TO length-1 LOOP
+         write_data <= std_logic_vector(to_unsigned(start_address+4*beat,
+                                                    write_data'length));
+         WAIT UNTIL rising_edge(Clock);
+         WHILE wait_request = '1' LOOP
+            WAIT UNTIL rising_edge(Clock);
+         END LOOP;
+      END LOOP;
+      write       <= '0';
+   END avalon_bfm_burst_write;
+
+   PROCEDURE avalon_bfm_burst_read( SIGNAL   Clock           : IN    std_logic;
+                                    SIGNAL   address         : OUT   std_logic_vector;
+                                    SIGNAL   read            : OUT   std_logic;
+                                    SIGNAL   burst_count     : OUT   std_logic_vector;
+                                    SIGNAL   read_data       : IN    std_logic_vector;
+                                    SIGNAL   read_data_valid : IN    std_logic;
+                                    SIGNAL   wait_request    : IN    std_logic;
+                                    CONSTANT start_address   : IN    INTEGER;
+                                    CONSTANT length          : IN    INTEGER;
+                                    VARIABLE errors          : INOUT INTEGER ) IS
+      VARIABLE v_beat : INTEGER := 0;
+   BEGIN
+      WAIT UNTIL rising_edge(Clock);
+      address     <= std_logic_vector(to_unsigned(start_address,address'length));
+      burst_count <= std_logic_vector(to_unsigned(length,burst_count'length));
+      read        <= '1';
+      WAIT UNTIL rising_edge(Clock);
+      WHILE wait_request = '1' LOOP
+         WAIT UNTIL rising_edge(Clock);
+      END LOOP;
+      read        <= '0';
+      WHILE v_beat < length LOOP
+         WAIT UNTIL rising_edge(Clock);
+         IF (read_data_valid = '1') THEN
+            IF (unsigned(read_data) /= to_unsigned(start_address+4*v_beat,
+                                                   read_data'length)) THEN
+               errors := errors + 1;
+            END IF;
+            v_beat := v_beat + 1;
+         END IF;
+      END LOOP;
+   END avalon_bfm_burst_read;
+
+   FUNCTION avalon_bfm_fixed( value : REAL ) RETURN STRING IS
+      VARIABLE v_hundredths : INTEGER := INTEGER(value*100.0);
+   BEGIN
+      IF (v_hundredths MOD 100 < 10) THEN
+         RETURN INTEGER'image(v_hundredths/100)&".0"&
+                INTEGER'image(v_hundredths MOD 100);
+      END IF;
+      RETURN INTEGER'image(v_hundredths/100)&"."&
+             INTEGER'image(v_hundredths MOD 100);
+   END avalon_bfm_fixed;
+
+   PROCEDURE avalon_bfm_report( CONSTANT name         : IN STRING;
+                                CONSTANT pixels       : IN INTEGER;
+                                CONSTANT bytes        : IN INTEGER;
+                                CONSTANT cycles       : IN INTEGER;
+                                CONSTANT bus_cycles   : IN INTEGER;
+                                CONSTANT clock_period : IN TIME ) IS
+      VARIABLE v_line : LINE;
+      VARIABLE v_ns   : REAL := REAL(clock_period/1 ps)/1000.0;
+   BEGIN
+      write(v_line,name&": "&INTEGER'image(pixels)&" pixels, "&
+                   INTEGER'image(bytes)&" bytes in "&
+                   INTEGER'image(cycles)&" cycles");
+      writeline(output,v_line);
+      write(v_line,"   cycles per pixel         : "&
+                   avalon_bfm_fixed(REAL(cycles)/REAL(pixels)));
+      writeline(output,v_line);
+      write(v_line,"   sustained throughput     : "&
+                   avalon_bfm_fixed(REAL(bytes)*1000.0/
+                                    (REAL(cycles)*v_ns))&" MB/s");
+      writeline(output,v_line);
+      write(v_line,"   bus cycles per pixel     : "&
+                   avalon_bfm_fixed(REAL(bus_cycles)/REAL(pixels)));
+      writeline(output,v_line);
+      IF (bus_cycles > 0) THEN
+         write(v_line,"   throughput while on bus  : "&
+                      avalon_bfm_fixed(REAL(bytes)*1000.0/
+                                       (REAL(bus_cycles)*v_ns))&" MB/s");
+         writeline(output,v_line);
+      END IF;
+   END avalon_bfm_report;
+
+END avalon_bfm_pkg;
@@ -0,0 +1,197 @@
+--------------------------------------------------------------------------------
+--- Avalon-MM slave bus functional model                                     ---
+---                                                                          ---
+--- Pipelined burst slave in place of the sdram controller. Each command (a  ---
+--- read burst or the first beat of a write burst) is held off by a random   ---
+--- number of wait states in MIN_WAIT..MAX_WAIT, the further beats of a      ---
+--- write burst are accepted without wait states. Read data is returned      ---
+--- READ_LATENCY (>= 1) cycles after the command is accepted, without gaps;  ---
+--- each beat carries its own byte address. Up to MAX_PENDING read bursts    ---
+--- can be outstanding.                                                      ---
+---                                                                          ---
+--- Statistics (cleared by Clear):                                           ---
+---   Commands   : accepted read bursts and write bursts                     ---
+---   Beats      : words written and read                                    ---
+---   WaitCycles : cycles a command was held by the wait request             ---
+---   BusyCycles : cycles a command was presented or read data outstanding   ---
+---   MaxLatency : longest time from a command presented to its last beat    ---
+--------------------------------------------------------------------------------
+LIBRARY ieee;
+USE ieee.std_logic_1164.all;
+USE ieee.numeric_std.all;
+USE work.avalon_bfm_pkg.all;
+
+ENTITY avalon_bfm_slave IS
+   GENERIC( BURST_WIDTH          : INTEGER := 10;
+            MIN_WAIT             : INTEGER := 0;
+            MAX_WAIT             : INTEGER := 0;
+            READ_LATENCY         : INTEGER := 1;
+            MAX_PENDING          : INTEGER := 4;
+            SEED                 : INTEGER := 1);
+   PORT ( Clock                  : IN  std_logic;
+          Reset                  : IN  std_logic;
+          Clear                  : IN  std_logic;
+          slave_address          : IN  std_logic_vector( 31 DOWNTO 0 );
+          slave_read             : IN  std_logic;
+          slave_write            : IN  std_logic;
+          slave_write_data       : IN  std_logic_vector( 31 DOWNTO 0 );
+          slave_burst_count      : IN  std_logic_vector( BURST_WIDTH-1 DOWNTO 0 );
+          slave_read_data        : OUT std_logic_vector( 31 DOWNTO 0 );
+          slave_read_data_valid  : OUT std_logic;
+          slave_wait_request     : OUT std_logic;
+          Commands               : OUT INTEGER;
+          Beats                  : OUT INTEGER;
+          WaitCycles             : OUT INTEGER;
+          BusyCycles             : OUT INTEGER;
+          MaxLatency             : OUT INTEGER);
+END avalon_bfm_slave;
+
+ARCHITECTURE MSE OF avalon_bfm_slave IS
+
+   TYPE ADDRESS_ARRAY IS ARRAY( 0 TO MAX_PENDING-1 ) OF unsigned( 31 DOWNTO 0 );
+   TYPE INT_ARRAY IS ARRAY( 0 TO MAX_PENDING-1 ) OF INTEGER;
+
+   SIGNAL s_wait_reg            : INTEGER := 0;
+   SIGNAL s_write_remaining_reg : INTEGER := 0;
+   SIGNAL s_pending_reg         : INTEGER := 0;
+   SIGNAL s_command             : std_logic;
+   SIGNAL s_wait_request        : std_logic;
+
+BEGIN
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the wait request is defined                              ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   s_command          <= slave_read OR slave_write;
+   s_wait_request     <= '1' WHEN s_command = '1' AND
+                                  s_write_remaining_reg = 0 AND
+                                  (s_wait_reg /= 0 OR
+                                   (slave_read = '1' AND
+                                    s_pending_reg = MAX_PENDING)) ELSE '0';
+   slave_wait_request <= s_wait_request;
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the memory model is defined                              ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   model : PROCESS( Clock )
+      VARIABLE v_seed1       : POSITIVE := SEED;
+      VARIABLE v_seed2       : POSITIVE := 7919;
+      VARIABLE v_wait        : INTEGER;
+      VARIABLE v_cycle       : INTEGER := 0;
+      VARIABLE v_in_command  : BOOLEAN := FALSE;
+      VARIABLE v_start       : INTEGER := 0;
+      VARIABLE v_address     : ADDRESS_ARRAY;
+      VARIABLE v_remaining   : INT_ARRAY;
+      VARIABLE v_ready       : INT_ARRAY;
+      VARIABLE v_started     : INT_ARRAY;
+      VARIABLE v_count       : INTEGER := 0;
+      VARIABLE v_commands    : INTEGER := 0;
+      VARIABLE v_beats       : INTEGER := 0;
+      VARIABLE v_wait_cycles : INTEGER := 0;
+      VARIABLE v_busy_cycles : INTEGER := 0;
+      VARIABLE v_max_latency : INTEGER := 0;
+
+      PROCEDURE latency( started : IN INTEGER ) IS
+      BEGIN
+         IF (v_cycle-started+1 > v_max_latency) THEN
+            v_max_latency := v_cycle-started+1;
+         END IF;
+      END latency;
+   BEGIN
+      IF (rising_edge(Clock)) THEN
+         IF (Reset = '1') THEN
+            avalon_bfm_random(v_seed1,v_seed2,MIN_WAIT,MAX_WAIT,v_wait);
+            s_wait_reg            <= v_wait;
+            s_write_remaining_reg <= 0;
+            v_in_command          := FALSE;
+            v_count               := 0;
+            slave_read_data_valid <= '0';
+                          ELSE
+            v_cycle := v_cycle + 1;
+            IF (Clear = '1') THEN
+               v_commands    := 0;
+               v_beats       := 0;
+               v_wait_cycles := 0;
+               v_busy_cycles := 0;
+               v_max_latency := 0;
+            END IF;
+            IF (s_command = '1' OR v_count > 0) THEN
+               v_busy_cycles := v_busy_cycles + 1;
+            END IF;
+            IF (s_command = '1' AND s_wait_request = '1') THEN
+               v_wait_cycles := v_wait_cycles + 1;
+            END IF;
+            -- wait states of the command
+            IF (s_command = '1' AND s_write_remaining_reg = 0) THEN
+               IF NOT v_in_command THEN
+                  v_in_command := TRUE;
+                  v_start      := v_cycle;
+               END IF;
+               IF (s_wait_reg /= 0) THEN
+                  s_wait_reg <= s_wait_reg - 1;
+               END IF;
+            END IF;
+            -- accepted commands and write beats
+            IF (slave_write = '1' AND s_wait_request = '0') THEN
+               v_beats := v_beats + 1;
+               IF (s_write_remaining_reg = 0) THEN
+                  v_commands := v_commands + 1;
+                  avalon_bfm_random(v_seed1,v_seed2,MIN_WAIT,MAX_WAIT,v_wait);
+                  s_wait_reg <= v_wait;
+                  s_write_remaining_reg <= to_integer(unsigned(slave_burst_count))-1;
+                  IF (to_integer(unsigned(slave_burst_count)) <= 1) THEN
+                     latency(v_start);
+                     v_in_command := FALSE;
+                  END IF;
+                                                 ELSE
+                  s_write_remaining_reg <= s_write_remaining_reg - 1;
+                  IF (s_write_remaining_reg = 1) THEN
+                     latency(v_start);
+                     v_in_command := FALSE;
+                  END IF;
+               END IF;
+            ELSIF (slave_read = '1' AND s_wait_request = '0') THEN
+               v_commands := v_commands + 1;
+               avalon_bfm_random(v_seed1,v_seed2,MIN_WAIT,MAX_WAIT,v_wait);
+               s_wait_reg <= v_wait;
+               v_address(v_count)   := unsigned(slave_address);
+               v_remaining(v_count) := to_integer(unsigned(slave_burst_count));
+               v_ready(v_count)     := v_cycle + READ_LATENCY - 1;
+               v_started(v_count)   := v_start;
+               v_count              := v_count + 1;
+               v_in_command         := FALSE;
+            END IF;
+            -- read data of the oldest burst
+            IF (v_count > 0 AND v_ready(0) <= v_cycle) THEN
+               slave_read_data       <= std_logic_vector(v_address(0));
+               slave_read_data_valid <= '1';
+               v_address(0)          := v_address(0) + 4;
+               v_remaining(0)        := v_remaining(0) - 1;
+               v_beats               := v_beats + 1;
+               IF (v_remaining(0) <= 0) THEN
+                  latency(v_started(0));
+                  FOR n IN 1 TO MAX_PENDING-1 LOOP
+                     v_address(n-1)   := v_address(n);
+                     v_remaining(n-1) := v_remaining(n);
+                     v_ready(n-1)     := v_ready(n);
+                     v_started(n-1)   := v_started(n);
+                  END LOOP;
+                  v_count := v_count - 1;
+               END IF;
+                                                      ELSE
+               slave_read_data_valid <= '0';
+            END IF;
+         END IF;
+         s_pending_reg <= v_count;
+         Commands      <= v_commands;
+         Beats         <= v_beats;
+         WaitCycles    <= v_wait_cycles;
+         BusyCycles    <= v_busy_cycles;
+         MaxLatency    <= v_max_latency;
+      END IF;
+   END PROCESS model;
+
+END MSE;
@@ -0,0 +1,534 @@
+--------------------------------------------------------------------------------
+--- Testbench for the bus_monitor                                            ---
+---                                                                          ---
+--- Three synthetic masters (write bursts, read bursts and single reads)     ---
+--- run through the monitor into memory models with two wait states for each ---
+--- command. The counters of each channel are checked against the traffic,  ---
+--- as well as the pass through of the read data and the window length.     ---
+--------------------------------------------------------------------------------
+LIBRARY ieee;
+USE ieee.std_logic_1164.all;
+USE ieee.numeric_std.all;
+
+ENTITY bus_monitor_tb IS
+END bus_monitor_tb;
+
+ARCHITECTURE MSE OF bus_monitor_tb IS
+
+   CONSTANT CLOCK_PERIOD   : TIME := 20 ns; -- 50 MHz
+   CONSTANT WAIT_STATES    : INTEGER := 2;
+   CONSTANT TIMEOUT        : INTEGER := 10000; -- clock cycles
+
+   CONSTANT WRITE_BURSTS   : INTEGER := 5;
+   CONSTANT WRITE_LENGTH   : INTEGER := 8;
+   CONSTANT READ_BURSTS    : INTEGER := 3;
+   CONSTANT READ_LENGTH    : INTEGER := 16;
+   CONSTANT SINGLE_READS   : INTEGER := 10;
+   CONSTANT WINDOW         : INTEGER := 100;
+
+   TYPE SL_ARRAY IS ARRAY( 0 TO 3 ) OF std_logic;
+   TYPE ADDRESS_ARRAY IS ARRAY( 0 TO 3 ) OF std_logic_vector( 23 DOWNTO 0 );
+   TYPE DATA_ARRAY IS ARRAY( 0 TO 3 ) OF std_logic_vector( 31 DOWNTO 0 );
+   TYPE BE_ARRAY IS ARRAY( 0 TO 3 ) OF std_logic_vector(  3 DOWNTO 0 );
+   TYPE BURST_ARRAY IS ARRAY( 0 TO 3 ) OF std_logic_vector(  9 DOWNTO 0 );
+
+   COMPONENT bus_monitor IS
+      PORT ( Clock                 : IN  std_logic;
+             Reset                 : IN  std_logic;
+             slave_address         : IN  std_logic_vector(  4 DOWNTO 0 );
+             slave_cs              : IN  std_logic;
+             slave_we              : IN  std_logic;
+             slave_rd              : IN  std_logic;
+             slave_write_data      : IN  std_logic_vector( 31 DOWNTO 0 );
+             slave_read_data       : OUT std_logic_vector( 31 DOWNTO 0 );
+             s0_address            : IN  std_logic_vector( 23 DOWNTO 0 );
+             s0_read               : IN  std_logic;
+             s0_write              : IN  std_logic;
+             s0_write_data         : IN  std_logic_vector( 31 DOWNTO 0 );
+             s0_byte_enable        : IN  std_logic_vector(  3 DOWNTO 0 );
+             s0_burst_count        : IN  std_logic_vector(  9 DOWNTO 0 );
+             s0_read_data          : OUT std_logic_vector( 31 DOWNTO 0 );
+             s0_read_data_valid    : OUT std_logic;
+             s0_wait_request       : OUT std_logic;
+             m0_address            : OUT std_logic_vector( 23 DOWNTO 0 );
+             m0_read               : OUT std_logic;
+             m0_write              : OUT std_logic;
+             m0_write_data         : OUT std_logic_vector( 31 DOWNTO 0 );
+             m0_byte_enable        : OUT std_logic_vector(  3 DOWNTO 0 );
+             m0_burst_count        : OUT std_logic_vector(  9 DOWNTO 0 );
+             m0_read_data          : IN  std_logic_vector( 31 DOWNTO 0 );
+             m0_read_data_valid    : IN  std_logic;
+             m0_wait_request       : IN  std_logic;
+             s1_address            : IN  std_logic_vector( 23 DOWNTO 0 );
+             s1_read               : IN  std_logic;
+             s1_write              : IN  std_logic;
+             s1_write_data         : IN  std_logic_vector( 31 DOWNTO 0 );
+             s1_byte_enable        : IN  std_logic_vector(  3 DOWNTO 0 );
+             s1_burst_count        : IN  std_logic_vector(  9 DOWNTO 0 );
+             s1_read_data          : OUT std_logic_vector( 31 DOWNTO 0 );
+             s1_read_data_valid    : OUT std_logic;
+             s1_wait_request       : OUT std_logic;
+             m1_address            : OUT std_logic_vector( 23 DOWNTO 0 );
+             m1_read               : OUT std_logic;
+             m1_write              : OUT std_logic;
+             m1_write_data         : OUT std_logic_vector( 31 DOWNTO 0 );
+             m1_byte_enable        : OUT std_logic_vector(  3 DOWNTO 0 );
+             m1_burst_count        : OUT std_logic_vector(  9 DOWNTO 0 );
+             m1_read_data          : IN  std_logic_vector( 31 DOWNTO 0 );
+             m1_read_data_valid    : IN  std_logic;
+             m1_wait_request       : IN  std_logic;
+             s2_address            : IN  std_logic_vector( 23 DOWNTO 0 );
+             s2_read               : IN  std_logic;
+             s2_write              : IN  std_logic;
+             s2_write_data         : IN  std_logic_vector( 31 DOWNTO 0 );
+             s2_byte_enable        : IN  std_logic_vector(  3 DOWNTO 0 );
+             s2_burst_count        : IN  std_logic_vector(  9 DOWNTO 0 );
+             s2_read_data          : OUT std_logic_vector( 31 DOWNTO 0 );
+             s2_read_data_valid    : OUT std_logic;
+             s2_wait_request       : OUT std_logic;
+             m2_address            : OUT std_logic_vector( 23 DOWNTO 0 );
+             m2_read               : OUT std_logic;
+             m2_write              : OUT std_logic;
+             m2_write_data         : OUT std_logic_vector( 31 DOWNTO 0 );
+             m2_byte_enable        : OUT std_logic_vector(  3 DOWNTO 0 );
+             m2_burst_count        : OUT std_logic_vector(  9 DOWNTO 0 );
+             m2_read_data          : IN  std_logic_vector( 31 DOWNTO 0 );
+             m2_read_data_valid    : IN  std_logic;
+             m2_wait_request       : IN  std_logic;
+             s3_address            : IN  std_logic_vector( 23 DOWNTO 0 );
+             s3_read               : IN  std_logic;
+             s3_write              : IN  std_logic;
+             s3_write_data         : IN  std_logic_vector( 31 DOWNTO 0 );
+             s3_byte_enable        : IN  std_logic_vector(  3 DOWNTO 0 );
+             s3_burst_count        : IN  std_logic_vector(  9 DOWNTO 0 );
+             s3_read_data          : OUT std_logic_vector( 31 DOWNTO 0 );
+             s3_read_data_valid    : OUT std_logic;
+             s3_wait_request       : OUT std_logic;
+             m3_address            : OUT std_logic_vector( 23 DOWNTO 0 );
+             m3_read               : OUT std_logic;
+             m3_write              : OUT std_logic;
+             m3_write_data         : OUT std_logic_vector( 31 DOWNTO 0 );
+             m3_byte_enable        : OUT std_logic_vector(  3 DOWNTO 0 );
+             m3_burst_count        : OUT std_logic_vector(  9 DOWNTO 0 );
+             m3_read_data          : IN  std_logic_vector( 31 DOWNTO 0 );
+             m3_read_data_valid    : IN  std_logic;
+             m3_wait_request       : IN  std_logic);
+   END COMPONENT;
+
+   SIGNAL s_sim_end          : BOOLEAN := FALSE;
+   SIGNAL s_clock            : std_logic := '0';
+   SIGNAL s_reset            : std_logic := '1';
+   SIGNAL s_phase            : INTEGER := 0;
+   SIGNAL s_done             : SL_ARRAY := (OTHERS => '0');
+   SIGNAL s_slave_address    : std_logic_vector(  4 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_slave_cs         : std_logic := '0';
+   SIGNAL s_slave_we         : std_logic := '0';
+   SIGNAL s_slave_rd         : std_logic := '0';
+   SIGNAL s_slave_write_data : std_logic_vector( 31 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_slave_read_data  : std_logic_vector( 31 DOWNTO 0 );
+
+   -- master side of the monitor (driven by the traffic generators)
+   SIGNAL s_s_address        : ADDRESS_ARRAY := (OTHERS => (OTHERS => '0'));
+   SIGNAL s_s_read           : SL_ARRAY := (OTHERS => '0');
+   SIGNAL s_s_write          : SL_ARRAY := (OTHERS => '0');
+   SIGNAL s_s_write_data     : DATA_ARRAY := (OTHERS => (OTHERS => '0'));
+   SIGNAL s_s_burst_count    : BURST_ARRAY := (OTHERS => (OTHERS => '0'));
+   SIGNAL s_s_read_data      : DATA_ARRAY;
+   SIGNAL s_s_read_data_valid: SL_ARRAY;
+   SIGNAL s_s_wait_request   : SL_ARRAY;
+
+   -- memory side of the monitor (driven by the memory models)
+   SIGNAL s_m_address        : ADDRESS_ARRAY;
+   SIGNAL s_m_read           : SL_ARRAY;
+   SIGNAL s_m_write          : SL_ARRAY;
+   SIGNAL s_m_write_data     : DATA_ARRAY;
+   SIGNAL s_m_byte_enable    : BE_ARRAY;
+   SIGNAL s_m_burst_count    : BURST_ARRAY;
+   SIGNAL s_m_read_data      : DATA_ARRAY := (OTHERS => (OTHERS => '0'));
+   SIGNAL s_m_read_data_valid: SL_ARRAY := (OTHERS => '0');
+   SIGNAL s_m_wait_request   : SL_ARRAY;
+
+BEGIN
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the clock and the memory models are defined              ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   make_clock : PROCESS
+   BEGIN
+      WHILE NOT s_sim_end LOOP
+         s_clock <= '0';
+         WAIT FOR CLOCK_PERIOD/2;
+         s_clock <= '1';
+         WAIT FOR CLOCK_PERIOD/2;
+      END LOOP;
+      WAIT;
+   END PROCESS make_clock;
+
+   -- Each command waits WAIT_STATES cycles, the following beats of a write
+   -- burst are accepted without wait. The read data is the byte address.
+   memories : FOR n IN 0 TO 3 GENERATE
+      SIGNAL s_wait_count : INTEGER := 0;
+      SIGNAL s_beats_left : INTEGER := 0;
+      SIGNAL s_reads_left : INTEGER := 0;
+      SIGNAL s_address    : unsigned( 31 DOWNTO 0 ) := (OTHERS => '0');
+   BEGIN
+      s_m_wait_request(n) <= '1' WHEN (s_m_read(n) = '1' OR
+                                       s_m_write(n) = '1') AND
+                                      s_beats_left = 0 AND
+                                      s_wait_count < WAIT_STATES ELSE '0';
+
+      memory : PROCESS( s_clock )
+         VARIABLE v_reads   : INTEGER;
+         VARIABLE v_address : unsigned( 31 DOWNTO 0 );
+      BEGIN
+         IF (rising_edge(s_clock)) THEN
+            v_reads   := s_reads_left;
+            v_address := s_address;
+            IF (s_m_wait_request(n) = '1') THEN
+               s_wait_count <= s_wait_count + 1;
+            END IF;
+            IF (s_m_read(n) = '1' AND s_m_wait_request(n) = '0') THEN
+               s_wait_count <= 0;
+               v_reads      := v_reads + to_integer(unsigned(s_m_burst_count(n)));
+               v_address    := X"00"&unsigned(s_m_address(n));
+            END IF;
+            IF (s_m_write(n) = '1' AND s_m_wait_request(n) = '0') THEN
+               s_wait_count <= 0;
+               IF (s_beats_left = 0) THEN
+                  s_beats_left <= to_integer(unsigned(s_m_burst_count(n)))-1;
+                                     ELSE
+                  s_beats_left <= s_beats_left - 1;
+               END IF;
+            END IF;
+            IF (v_reads > 0) THEN
+               s_m_read_data_valid(n) <= '1';
+               s_m_read_data(n)       <= std_logic_vector(v_address);
+               v_address              := v_address + 4;
+               v_reads                := v_reads - 1;
+                             ELSE
+               s_m_read_data_valid(n) <= '0';
+            END IF;
+            s_reads_left <= v_reads;
+            s_address    <= v_address;
+         END IF;
+      END PROCESS memory;
+   END GENERATE memories;
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the device under test is instantiated                    ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   dut : bus_monitor
+      PORT MAP ( Clock              => s_clock,
+                 Reset              => s_reset,
+                 slave_address      => s_slave_address,
+                 slave_cs           => s_slave_cs,
+                 slave_we           => s_slave_we,
+                 slave_rd           => s_slave_rd,
+                 slave_write_data   => s_slave_write_data,
+                 slave_read_data    => s_slave_read_data,
+                 s0_address         => s_s_address(0),
+                 s0_read            => s_s_read(0),
+                 s0_write           => s_s_write(0),
+                 s0_write_data      => s_s_write_data(0),
+                 s0_byte_enable     => "1111",
+                 s0_burst_count     => s_s_burst_count(0),
+                 s0_read_data       => s_s_read_data(0),
+                 s0_read_data_valid => s_s_read_data_valid(0),
+                 s0_wait_request    => s_s_wait_request(0),
+                 m0_address         => s_m_address(0),
+                 m0_read            => s_m_read(0),
+                 m0_write           => s_m_write(0),
+                 m0_write_data      => s_m_write_data(0),
+                 m0_byte_enable     => s_m_byte_enable(0),
+                 m0_burst_count     => s_m_burst_count(0),
+                 m0_read_data       => s_m_read_data(0),
+                 m0_read_data_valid => s_m_read_data_valid(0),
+                 m0_wait_request    => s_m_wait_request(0),
+                 s1_address         => s_s_address(1),
+                 s1_read            => s_s_read(1),
+                 s1_write           => s_s_write(1),
+                 s1_write_data      => s_s_write_data(1),
+                 s1_byte_enable     => "1111",
+                 s1_burst_count     => s_s_burst_count(1),
+                 s1_read_data       => s_s_read_data(1),
+                 s1_read_data_valid => s_s_read_data_valid(1),
+                 s1_wait_request    => s_s_wait_request(1),
+                 m1_address         => s_m_address(1),
+                 m1_read            => s_m_read(1),
+                 m1_write           => s_m_write(1),
+                 m1_write_data      => s_m_write_data(1),
+                 m1_byte_enable     => s_m_byte_enable(1),
+                 m1_burst_count     => s_m_burst_count(1),
+                 m1_read_data       => s_m_read_data(1),
+                 m1_read_data_valid => s_m_read_data_valid(1),
+                 m1_wait_request    => s_m_wait_request(1),
+                 s2_address         => s_s_address(2),
+                 s2_read            => s_s_read(2),
+                 s2_write           => s_s_write(2),
+                 s2_write_data      => s_s_write_data(2),
+                 s2_byte_enable     => "1111",
+                 s2_burst_count     => s_s_burst_count(2),
+                 s2_read_data       => s_s_read_data(2),
+                 s2_read_data_valid => s_s_read_data_valid(2),
+                 s2_wait_request    => s_s_wait_request(2),
+                 m2_address         => s_m_address(2),
+                 m2_read            => s_m_read(2),
+                 m2_write           => s_m_write(2),
+                 m2_write_data      => s_m_write_data(2),
+                 m2_byte_enable     => s_m_byte_enable(2),
+                 m2_burst_count     => s_m_burst_count(2),
+                 m2_read_data       => s_m_read_data(2),
+                 m2_read_data_valid => s_m_read_data_valid(2),
+                 m2_wait_request    => s_m_wait_request(2),
+                 s3_address         => s_s_address(3),
+                 s3_read            => s_s_read(3),
+                 s3_write           => s_s_write(3),
+                 s3_write_data      => s_s_write_data(3),
+                 s3_byte_enable     => "1111",
+                 s3_burst_count     => s_s_burst_count(3),
+                 s3_read_data       => s_s_read_data(3),
+                 s3_read_data_valid => s_s_read_data_valid(3),
+                 s3_wait_request    => s_s_wait_request(3),
+                 m3_address         => s_m_address(3),
+                 m3_read            => s_m_read(3),
+                 m3_write           => s_m_write(3),
+                 m3_write_data      => s_m_write_data(3),
+                 m3_byte_enable     => s_m_byte_enable(3),
+                 m3_burst_count     => s_m_burst_count(3),
+                 m3_read_data       => s_m_read_data(3),
+                 m3_read_data_valid => s_m_read_data_valid(3),
+                 m3_wait_request    => s_m_wait_request(3));
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the traffic generators are defined                       ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   -- Channel 0: write bursts, in phase 1 and again in phase 3 (after the
+   -- window of phase 2 has ended)
+   write_master : PROCESS
+      VARIABLE v_beats : INTEGER;
+   BEGIN
+      FOR phase IN 1 TO 3 LOOP
+         IF (s_phase /= phase) THEN WAIT UNTIL s_phase = phase;
+         END IF;
+         IF (phase /= 2) THEN
+            FOR burst IN 0 TO WRITE_BURSTS-1 LOOP
+               WAIT UNTIL rising_edge(s_clock);
+               s_s_address(0)     <= std_logic_vector(to_unsigned(burst*256,24));
+               s_s_burst_count(0) <= std_logic_vector(to_unsigned(WRITE_LENGTH,10));
+               s_s_write(0)       <= '1';
+               v_beats            := 0;
+               WHILE v_beats < WRITE_LENGTH LOOP
+                  WAIT UNTIL rising_edge(s_clock);
+                  IF (s_s_wait_request(0) = '0') THEN
+                     v_beats           := v_beats + 1;
+                     s_s_write_data(0) <= std_logic_vector(to_unsigned(v_beats,32));
+                  END IF;
+               END LOOP;
+               s_s_write(0)       <= '0';
+            END LOOP;
+         END IF;
+         s_done(0) <= '1';
+         WAIT UNTIL s_phase /= phase;
+         s_done(0) <= '0';
+      END LOOP;
+      WAIT;
+   END PROCESS write_master;
+
+   -- Channel 1: read bursts and channel 2: single reads, both in phase 1 and 2
+   read_masters : FOR n IN 1 TO 2 GENERATE
+      read_master : PROCESS
+         VARIABLE v_beats    : INTEGER;
+         VARIABLE v_bursts   : INTEGER;
+         VARIABLE v_length   : INTEGER;
+         VARIABLE v_address  : unsigned( 31 DOWNTO 0 );
+      BEGIN
+         IF (n = 1) THEN v_bursts := READ_BURSTS;
+                         v_length := READ_LENGTH;
+                    ELSE v_bursts := SINGLE_READS;
+                         v_length := 1;
+         END IF;
+         FOR phase IN 1 TO 3 LOOP
+            IF (s_phase /= phase) THEN WAIT UNTIL s_phase = phase;
+            END IF;
+            IF (phase /= 3) THEN
+               FOR burst IN 0 TO v_bursts-1 LOOP
+                  v_address := to_unsigned(n*65536+burst*1024,32);
+                  WAIT UNTIL rising_edge(s_clock);
+                  s_s_address(n)     <= std_logic_vector(v_address(23 DOWNTO 0));
+                  s_s_burst_count(n) <= std_logic_vector(to_unsigned(v_length,10));
+                  s_s_read(n)        <= '1';
+                  WAIT UNTIL rising_edge(s_clock);
+                  WHILE s_s_wait_request(n) = '1' LOOP
+                     WAIT UNTIL rising_edge(s_clock);
+                  END LOOP;
+                  s_s_read(n)        <= '0';
+                  v_beats            := 0;
+                  WHILE v_beats < v_length LOOP
+                     WAIT UNTIL rising_edge(s_clock);
+                     IF (s_s_read_data_valid(n) = '1') THEN
+                        ASSERT unsigned(s_s_read_data(n)) = v_address
+                           REPORT "Read data not passed through" SEVERITY error;
+                        v_address := v_address + 4;
+                        v_beats   := v_beats + 1;
+                     END IF;
+                  END LOOP;
+               END LOOP;
+            END IF;
+            s_done(n) <= '1';
+            WAIT UNTIL s_phase /= phase;
+            s_done(n) <= '0';
+         END LOOP;
+         WAIT;
+      END PROCESS read_master;
+   END GENERATE read_masters;
+
+   s_done(3) <= '1';
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the stimuli and checks are defined                       ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   stimuli : PROCESS
+      VARIABLE v_errors : INTEGER := 0;
+      VARIABLE v_data   : std_logic_vector( 31 DOWNTO 0 );
+      VARIABLE v_cycles : INTEGER;
+
+      PROCEDURE slave_write( address : IN INTEGER;
+                             data    : IN std_logic_vector( 31 DOWNTO 0 ) ) IS
+      BEGIN
+         WAIT UNTIL rising_edge(s_clock);
+         s_slave_address    <= std_logic_vector(to_unsigned(address,5));
+         s_slave_write_data <= data;
+         s_slave_cs         <= '1';
+         s_slave_we         <= '1';
+         WAIT UNTIL rising_edge(s_clock);
+         s_slave_cs         <= '0';
+         s_slave_we         <= '0';
+      END slave_write;
+
+      -- one wait state, the read data is registered
+      PROCEDURE slave_read( address : IN  INTEGER;
+                            data    : OUT std_logic_vector( 31 DOWNTO 0 ) ) IS
+      BEGIN
+         WAIT UNTIL rising_edge(s_clock);
+         s_slave_address <= std_logic_vector(to_unsigned(address,5));
+         s_slave_cs      <= '1';
+         s_slave_rd      <= '1';
+         WAIT UNTIL rising_edge(s_clock);
+         WAIT UNTIL rising_edge(s_clock);
+         data            := s_slave_read_data;
+         s_slave_cs      <= '0';
+         s_slave_rd      <= '0';
+      END slave_read;
+
+      PROCEDURE check( condition : IN BOOLEAN;
+                       message   : IN STRING ) IS
+      BEGIN
+         IF NOT condition THEN
+            REPORT message SEVERITY error;
+            v_errors := v_errors + 1;
+         END IF;
+      END check;
+
+      PROCEDURE check_channel( channel     : IN INTEGER;
+                               transfers   : IN INTEGER;
+                               bytes       : IN INTEGER;
+                               wait_cycles : IN INTEGER;
+                               max_burst   : IN INTEGER ) IS
+         VARIABLE v_value : std_logic_vector( 31 DOWNTO 0 );
+      BEGIN
+         slave_read(4+4*channel,v_value);
+         check(to_integer(unsigned(v_value)) = transfers,
+               "Channel " & INTEGER'image(channel) & ": wrong transfer count " &
+               INTEGER'image(to_integer(unsigned(v_value))));
+         slave_read(5+4*channel,v_value);
+         check(to_integer(unsigned(v_value)) = bytes,
+               "Channel " & INTEGER'image(channel) & ": wrong byte count " &
+               INTEGER'image(to_integer(unsigned(v_value))));
+         slave_read(6+4*channel,v_value);
+         check(to_integer(unsigned(v_value)) = wait_cycles,
+               "Channel " & INTEGER'image(channel) & ": wrong wait cycles " &
+               INTEGER'image(to_integer(unsigned(v_value))));
+         slave_read(7+4*channel,v_value);
+         check(to_integer(unsigned(v_value)) = max_burst,
+               "Channel " & INTEGER'image(channel) & ": wrong max burst " &
+               INTEGER'image(to_integer(unsigned(v_value))));
+      END check_channel;
+
+      -- The generators clear their done flag one cycle after a phase change
+      PROCEDURE wait_done IS
+         VARIABLE v_count : INTEGER := 0;
+      BEGIN
+         WAIT UNTIL rising_edge(s_clock);
+         WHILE s_done /= "1111" AND v_count < TIMEOUT LOOP
+            WAIT UNTIL rising_edge(s_clock);
+            v_count := v_count + 1;
+         END LOOP;
+         check(v_count < TIMEOUT,"Timeout waiting for the traffic generators");
+      END wait_done;
+
+   BEGIN
+      s_reset <= '1';
+      WAIT FOR 10*CLOCK_PERIOD;
+      s_reset <= '0';
+
+      REPORT "Test 1: counters of an open window" SEVERITY note;
+      slave_read(3,v_data);
+      check(to_integer(unsigned(v_data)) = 4,"Wrong number of channels");
+      slave_write(1,X"00000000");
+      slave_write(0,X"00000001");
+      slave_read(0,v_data);
+      check(v_data(0) = '1',"Window not running after start");
+      s_phase <= 1;
+      wait_done;
+      slave_write(0,X"00000002");
+      slave_read(0,v_data);
+      check(v_data(0) = '0',"Window still running after stop");
+      check_channel(0,WRITE_BURSTS,WRITE_BURSTS*WRITE_LENGTH*4,
+                    WRITE_BURSTS*WAIT_STATES,WRITE_LENGTH);
+      check_channel(1,READ_BURSTS,READ_BURSTS*READ_LENGTH*4,
+                    READ_BURSTS*WAIT_STATES,READ_LENGTH);
+      check_channel(2,SINGLE_READS,SINGLE_READS*4,
+                    SINGLE_READS*WAIT_STATES,1);
+      check_channel(3,0,0,0,0);
+
+      REPORT "Test 2: window of fixed length" SEVERITY note;
+      slave_write(1,std_logic_vector(to_unsigned(WINDOW,32)));
+      slave_write(0,X"00000001");
+      s_phase  <= 2;
+      v_cycles := 0;
+      v_data   := X"00000001";
+      WHILE v_data(0) = '1' AND v_cycles < TIMEOUT LOOP
+         slave_read(0,v_data);
+         v_cycles := v_cycles + 3;
+      END LOOP;
+      check(v_cycles < TIMEOUT,"Window does not end");
+      slave_read(2,v_data);
+      check(to_integer(unsigned(v_data)) = WINDOW,
+            "Elapsed cycles differ from the window length");
+      check_channel(0,0,0,0,0);
+
+      REPORT "Test 3: no counting after the window" SEVERITY note;
+      wait_done;
+      s_phase <= 3;
+      wait_done;
+      check_channel(0,0,0,0,0);
+      slave_read(2,v_data);
+      check(to_integer(unsigned(v_data)) = WINDOW,
+            "Elapsed cycles changed after the window");
+
+      ASSERT v_errors = 0
+         REPORT "bus_monitor_tb: " & INTEGER'image(v_errors) & " error(s)"
+         SEVERITY failure;
+      REPORT "bus_monitor_tb: all tests passed" SEVERITY note;
+      s_sim_end <= TRUE;
+      WAIT;
+   END PROCESS stimuli;
+
+END MSE;
@@ -0,0 +1,274 @@
+--------------------------------------------------------------------------------
+--- Throughput testbench for the cam_dma                                     ---
+---                                                                          ---
+--- A camera model sends frames of LINES lines of LINE_PIXELS RGB565 pixels  ---
+--- (two bytes each) to the cam_dma, which writes one frame in single image  ---
+--- mode into the avalon_bfm_slave memory model. From the start of the frame ---
+--- up to the IRQ the cycles per pixel and the throughput are reported; the  ---
+--- frame time is given by the camera, the bus figures show the share the    ---
+--- DMA takes from the sdram. The memory timing is set by the generics, e.g. ---
+---    ./run_tb.sh cam_dma_throughput_tb -gMAX_WAIT=8                        ---
+--------------------------------------------------------------------------------
+LIBRARY ieee;
+USE ieee.std_logic_1164.all;
+USE ieee.numeric_std.all;
+USE work.avalon_bfm_pkg.all;
+
+ENTITY cam_dma_throughput_tb IS
+   GENERIC( MIN_WAIT     : INTEGER := 0;
+            MAX_WAIT     : INTEGER := 2;
+            READ_LATENCY : INTEGER := 3;
+            SEED         : INTEGER := 1;
+            LINE_PIXELS  : INTEGER := 320;
+            LINES        : INTEGER := 16);
+END cam_dma_throughput_tb;
+
+ARCHITECTURE MSE OF cam_dma_throughput_tb IS
+
+   CONSTANT CLOCK_PERIOD       : TIME := 20 ns; -- 50 MHz
+   CONSTANT PIXEL_CLOCK_PERIOD : TIME := 40 ns; -- 25 MHz
+   CONSTANT LINE_BLANK         : INTEGER := 144; -- pixel clocks
+   CONSTANT FRAME_BLANK        : INTEGER := 3; -- lines
+   CONSTANT PIXELS             : INTEGER := LINE_PIXELS*LINES;
+   CONSTANT BUFFER_POINTER     : INTEGER := 16#00200000#;
+   CONSTANT TIMEOUT            : INTEGER := 4*(LINES+2*FRAME_BLANK)*
+                                            (2*LINE_PIXELS+LINE_BLANK); -- clock cycles
+
+   CONSTANT CONTROL_REG        : INTEGER := 3;
+   CONSTANT BUFFER_1_REG       : INTEGER := 4;
+   CONSTANT CAMERA_ON          : INTEGER := 0;
+   CONSTANT SINGLE_WITH_IRQ    : INTEGER := 16#48#;
+
+   COMPONENT cam_dma IS
+      PORT ( Clock                 : IN  std_logic;
+             Reset                 : IN  std_logic;
+             IRQ                   : OUT std_logic;
+             slave_address         : IN  std_logic_vector( 2 DOWNTO 0 );
+             slave_cs              : IN  std_logic;
+             slave_we              : IN  std_logic;
+             slave_write_data      : IN  std_logic_vector(31 DOWNTO 0 );
+             slave_read_data       : OUT std_logic_vector(31 DOWNTO 0 );
+             master_address        : OUT std_logic_vector(31 DOWNTO 0 );
+             master_we             : OUT std_logic;
+             master_write_data     : OUT std_logic_vector(31 DOWNTO 0 );
+             master_burst_count    : OUT std_logic_vector( 9 DOWNTO 0 );
+             master_wait_req       : IN  std_logic;
+             PixelClk              : IN  std_logic;
+             HSync                 : IN  std_logic;
+             VSync                 : IN  std_logic;
+             DataIn                : IN  std_logic_vector( 9 DOWNTO 0 );
+             ResetBar              : OUT std_logic;
+             PowerDown             : OUT std_logic);
+   END COMPONENT;
+
+   SIGNAL s_sim_end              : BOOLEAN := FALSE;
+   SIGNAL s_clock                : std_logic := '0';
+   SIGNAL s_pixel_clock          : std_logic := '0';
+   SIGNAL s_reset                : std_logic := '1';
+   SIGNAL s_clear                : std_logic := '0';
+   SIGNAL s_camera_on            : BOOLEAN := FALSE;
+   SIGNAL s_no_wait              : std_logic := '0';
+   SIGNAL s_slave_address        : std_logic_vector(  2 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_slave_cs             : std_logic := '0';
+   SIGNAL s_slave_we             : std_logic := '0';
+   SIGNAL s_slave_write_data     : std_logic_vector( 31 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_slave_read_data      : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_master_address       : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_master_we            : std_logic;
+   SIGNAL s_master_write_data    : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_master_burst_count   : std_logic_vector(  9 DOWNTO 0 );
+   SIGNAL s_master_wait_request  : std_logic;
+   SIGNAL s_irq                  : std_logic;
+   SIGNAL s_hsync                : std_logic := '0';
+   SIGNAL s_vsync                : std_logic := '0';
+   SIGNAL s_cam_data             : std_logic_vector(  9 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_commands             : INTEGER;
+   SIGNAL s_beats                : INTEGER;
+   SIGNAL s_wait_cycles          : INTEGER;
+   SIGNAL s_busy_cycles          : INTEGER;
+   SIGNAL s_max_latency          : INTEGER;
+
+BEGIN
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the clocks, the memory model and the camera are defined  ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   make_clock : PROCESS
+   BEGIN
+      WHILE NOT s_sim_end LOOP
+         s_clock <= '0';
+         WAIT FOR CLOCK_PERIOD/2;
+         s_clock <= '1';
+         WAIT FOR CLOCK_PERIOD/2;
+      END LOOP;
+      WAIT;
+   END PROCESS make_clock;
+
+   make_pixel_clock : PROCESS
+   BEGIN
+      WHILE NOT s_sim_end LOOP
+         s_pixel_clock <= '0';
+         WAIT FOR PIXEL_CLOCK_PERIOD/2;
+         s_pixel_clock <= '1';
+         WAIT FOR PIXEL_CLOCK_PERIOD/2;
+      END LOOP;
+      WAIT;
+   END PROCESS make_pixel_clock;
+
+   memory : avalon_bfm_slave
+      GENERIC MAP ( BURST_WIDTH  => 10,
+                    MIN_WAIT     => MIN_WAIT,
+                    MAX_WAIT     => MAX_WAIT,
+                    READ_LATENCY => READ_LATENCY,
+                    SEED         => SEED)
+      PORT MAP ( Clock                 => s_clock,
+                 Reset                 => s_reset,
+                 Clear                 => s_clear,
+                 slave_address         => s_master_address,
+                 slave_read            => '0',
+                 slave_write           => s_master_we,
+                 slave_write_data      => s_master_write_data,
+                 slave_burst_count     => s_master_burst_count,
+                 slave_read_data       => OPEN,
+                 slave_read_data_valid => OPEN,
+                 slave_wait_request    => s_master_wait_request,
+                 Commands              => s_commands,
+                 Beats                 => s_beats,
+                 WaitCycles            => s_wait_cycles,
+                 BusyCycles            => s_busy_cycles,
+                 MaxLatency            => s_max_latency);
+
+   -- Frames start with a vertical sync pulse (the falling edge marks the end
+   -- of the previous frame); during a line the horizontal sync is high and a
+   -- byte is sent each pixel clock
+   camera : PROCESS
+      VARIABLE v_byte : INTEGER;
+   BEGIN
+      WAIT UNTIL s_camera_on;
+      WHILE NOT s_sim_end LOOP
+         WAIT UNTIL falling_edge(s_pixel_clock);
+         s_vsync <= '1';
+         FOR n IN 1 TO FRAME_BLANK*(2*LINE_PIXELS+LINE_BLANK) LOOP
+            WAIT UNTIL falling_edge(s_pixel_clock);
+         END LOOP;
+         s_vsync <= '0';
+         FOR line IN 0 TO LINES-1 LOOP
+            FOR n IN 1 TO LINE_BLANK LOOP
+               WAIT UNTIL falling_edge(s_pixel_clock);
+            END LOOP;
+            s_hsync <= '1';
+            FOR n IN 0 TO 2*LINE_PIXELS-1 LOOP
+               v_byte     := (line+n) MOD 256;
+               s_cam_data <= std_logic_vector(to_unsigned(v_byte,8))&"00";
+               WAIT UNTIL falling_edge(s_pixel_clock);
+            END LOOP;
+            s_hsync <= '0';
+         END LOOP;
+         FOR n IN 1 TO FRAME_BLANK*(2*LINE_PIXELS+LINE_BLANK) LOOP
+            WAIT UNTIL falling_edge(s_pixel_clock);
+         END LOOP;
+      END LOOP;
+      WAIT;
+   END PROCESS camera;
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the device under test is instantiated                    ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   dut : cam_dma
+      PORT MAP ( Clock              => s_clock,
+                 Reset              => s_reset,
+                 IRQ                => s_irq,
+                 slave_address      => s_slave_address,
+                 slave_cs           => s_slave_cs,
+                 slave_we           => s_slave_we,
+                 slave_write_data   => s_slave_write_data,
+                 slave_read_data    => s_slave_read_data,
+                 master_address     => s_master_address,
+                 master_we          => s_master_we,
+                 master_write_data  => s_master_write_data,
+                 master_burst_count => s_master_burst_count,
+                 master_wait_req    => s_master_wait_request,
+                 PixelClk           => s_pixel_clock,
+                 HSync              => s_hsync,
+                 VSync              => s_vsync,
+                 DataIn             => s_cam_data,
+                 ResetBar           => OPEN,
+                 PowerDown          => OPEN);
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the stimuli and the measurement are defined              ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   stimuli : PROCESS
+      VARIABLE v_errors : INTEGER := 0;
+      VARIABLE v_cycles : INTEGER;
+      VARIABLE v_start  : TIME;
+
+      -- the cam_dma has no wait request
+      PROCEDURE write_reg( address : IN INTEGER;
+                           data    : IN INTEGER ) IS
+      BEGIN
+         avalon_bfm_write(s_clock,s_slave_address,s_slave_cs,s_slave_we,
+                          s_slave_write_data,s_no_wait,address,
+                          std_logic_vector(to_unsigned(data,32)));
+      END write_reg;
+
+      PROCEDURE check( condition : IN BOOLEAN;
+                       message   : IN STRING ) IS
+      BEGIN
+         IF NOT condition THEN
+            REPORT message SEVERITY error;
+            v_errors := v_errors + 1;
+         END IF;
+      END check;
+
+   BEGIN
+      s_reset <= '1';
+      WAIT FOR 10*CLOCK_PERIOD;
+      s_reset <= '0';
+
+      write_reg(CONTROL_REG,CAMERA_ON);
+      write_reg(BUFFER_1_REG,BUFFER_POINTER);
+      write_reg(CONTROL_REG,SINGLE_WITH_IRQ);
+      s_camera_on <= TRUE;
+
+      -- the frame written is the one that starts at the first vertical sync
+      WAIT UNTIL falling_edge(s_vsync);
+      WAIT UNTIL rising_edge(s_clock);
+      s_clear <= '1';
+      WAIT UNTIL rising_edge(s_clock);
+      s_clear <= '0';
+      v_start  := NOW;
+      v_cycles := 0;
+      WHILE s_irq /= '1' AND v_cycles < TIMEOUT LOOP
+         WAIT UNTIL rising_edge(s_clock);
+         v_cycles := v_cycles + 1;
+      END LOOP;
+      check(s_irq = '1',"Timeout waiting for the frame IRQ");
+      v_cycles := (NOW-v_start)/CLOCK_PERIOD;
+
+      check(s_beats*4 = PIXELS*2,
+            "Words written " & INTEGER'image(s_beats) & ", expected " &
+            INTEGER'image(PIXELS/2));
+      check(s_commands = LINES,
+            "Bursts written " & INTEGER'image(s_commands) & ", expected " &
+            INTEGER'image(LINES));
+      avalon_bfm_report("cam_dma",PIXELS,PIXELS*2,v_cycles,s_busy_cycles,
+                        CLOCK_PERIOD);
+      REPORT "cam_dma: " & INTEGER'image(s_wait_cycles) &
+             " wait cycles, max latency " & INTEGER'image(s_max_latency) &
+             " cycles" SEVERITY note;
+
+      ASSERT v_errors = 0
+         REPORT "cam_dma_throughput_tb: " & INTEGER'image(v_errors) & " error(s)"
+         SEVERITY failure;
+      REPORT "cam_dma_throughput_tb: done" SEVERITY note;
+      s_sim_end <= TRUE;
+      WAIT;
+   END PROCESS stimuli;
+
+END MSE;
@@ -0,0 +1,494 @@
+--------------------------------------------------------------------------------
+--- Testbench for the 8-bit DMA_LCD_ctrl of 2_vhdl                           ---
+---                                                                          ---
+--- Transfers an RGB565 picture of LINES lines of the LCD width with the     ---
+--- DMA_LCD_ctrl and with the 16-bit lcd_dma, each from its own              ---
+--- avalon_bfm_slave memory model, and reports the pixels per second of      ---
+--- both. For the DMA_LCD_ctrl the bytes on the LCD bus are checked against  ---
+--- the memory pattern and the write cycle against the ILI9341 timing        ---
+--- (twrl >= 15 ns, twrh >= 15 ns, twc >= 66 ns), e.g.                       ---
+---    ./run_tb.sh dma_lcd_ctrl_tb -gMAX_WAIT=8 -gREAD_LATENCY=6             ---
+--- Note: the display reset of the lcd_dma is shortened to RECOVER_CYCLES,  ---
+--- the testbench polls its busy flag before the second transfer.            ---
+--------------------------------------------------------------------------------
+LIBRARY ieee;
+USE ieee.std_logic_1164.all;
+USE ieee.numeric_std.all;
+USE work.avalon_bfm_pkg.all;
+
+ENTITY dma_lcd_ctrl_tb IS
+   GENERIC( MIN_WAIT     : INTEGER := 0;
+            MAX_WAIT     : INTEGER := 2;
+            READ_LATENCY : INTEGER := 3;
+            SEED         : INTEGER := 1;
+            LINES        : INTEGER := 16);
+END dma_lcd_ctrl_tb;
+
+ARCHITECTURE MSE OF dma_lcd_ctrl_tb IS
+
+   CONSTANT CLOCK_PERIOD     : TIME := 20 ns; -- 50 MHz
+   CONSTANT LCD_WIDTH        : INTEGER := 240;
+   CONSTANT PIXELS           : INTEGER := LCD_WIDTH*LINES;
+   CONSTANT PICTURE_POINTER  : INTEGER := 16#00100000#;
+   CONSTANT TIMEOUT          : INTEGER := 100*PIXELS; -- clock cycles
+   CONSTANT RECOVER_CYCLES   : INTEGER := 12000; -- 12000000 on the board
+   CONSTANT RESET_TIMEOUT    : INTEGER := RECOVER_CYCLES+100000; -- clock cycles
+   CONSTANT MEMORY_WRITE     : INTEGER := 16#2C#;
+
+   -- DMA_LCD_ctrl registers
+   CONSTANT CMD_REG          : INTEGER := 0;
+   CONSTANT POINTER_REG      : INTEGER := 2;
+   CONSTANT SIZE_REG         : INTEGER := 3;
+   CONSTANT CONTROL_REG      : INTEGER := 4;
+   CONSTANT START            : INTEGER := 1;
+   CONSTANT IRQ_ACK          : INTEGER := 4;
+
+   -- lcd_dma registers
+   CONSTANT REF_CONTROL_REG    : INTEGER := 2;
+   CONSTANT REF_POINTER_REG    : INTEGER := 3;
+   CONSTANT REF_SIZE_REG       : INTEGER := 4;
+   CONSTANT REF_LCD_LINE_REG   : INTEGER := 5;
+   CONSTANT REF_IMAGE_LINE_REG : INTEGER := 6;
+   CONSTANT REF_LCD_BUSY       : INTEGER := 1;
+   CONSTANT REF_START_WITH_IRQ : std_logic_vector( 31 DOWNTO 0 ) := X"00000120";
+
+   COMPONENT DMA_LCD_ctrl IS
+      GENERIC ( BURST_LENGTH           : INTEGER := 16;
+                FIFO_DEPTH             : INTEGER := 64;
+                WR_LOW_CYCLES          : INTEGER := 2;
+                WR_HIGH_CYCLES         : INTEGER := 2);
+      PORT ( clk                       : IN  std_logic;
+             reset                     : IN  std_logic;
+             master_address            : OUT std_logic_vector(31 DOWNTO 0 );
+             master_read               : OUT std_logic;
+             master_burstcount         : OUT std_logic_vector( 7 DOWNTO 0 );
+             master_readdata           : IN  std_logic_vector(31 DOWNTO 0 );
+             master_readdatavalid      : IN  std_logic;
+             master_waitrequest        : IN  std_logic;
+             end_of_transaction_irq    : OUT std_logic;
+             avalon_address            : IN  std_logic_vector( 2 DOWNTO 0 );
+             avalon_cs                 : IN  std_logic;
+             avalon_wr                 : IN  std_logic;
+             avalon_write_data         : IN  std_logic_vector(31 DOWNTO 0 );
+             avalon_rd                 : IN  std_logic;
+             avalon_read_data          : OUT std_logic_vector(31 DOWNTO 0 );
+             avalon_waitrequest        : OUT std_logic;
+             LCD_data                  : OUT std_logic_vector( 7 DOWNTO 0 );
+             LCD_CS_n                  : OUT std_logic;
+             LCD_WR_n                  : OUT std_logic;
+             LCD_D_C_n                 : OUT std_logic);
+   END COMPONENT;
+
+   COMPONENT lcd_dma IS
+      GENERIC( RECOVER_CYCLES            : INTEGER);
+      PORT ( Clock                       : IN  std_logic;
+             Reset                       : IN  std_logic;
+             slave_address               : IN  std_logic_vector( 2 DOWNTO 0 );
+             slave_cs                    : IN  std_logic;
+             slave_we                    : IN  std_logic;
+             slave_rd                    : IN  std_logic;
+             slave_write_data            : IN  std_logic_vector(31 DOWNTO 0 );
+             slave_read_data             : OUT std_logic_vector(31 DOWNTO 0 );
+             slave_wait_request          : OUT std_logic;
+             master_address              : OUT std_logic_vector(31 DOWNTO 0 );
+             master_read                 : OUT std_logic;
+             master_burst_count          : OUT std_logic_vector( 7 DOWNTO 0 );
+             master_read_data            : IN  std_logic_vector(31 DOWNTO 0 );
+             master_read_data_valid      : IN  std_logic;
+             master_wait_request         : IN  std_logic;
+             end_of_transaction_irq      : OUT std_logic;
+             ChipSelectBar               : OUT std_logic;
+             DataCommandBar              : OUT std_logic;
+             WriteBar                    : OUT std_logic;
+             ReadBar                     : OUT std_logic;
+             ResetBar                    : OUT std_logic;
+             IM0                         : OUT std_logic;
+             DataBus                     : INOUT std_logic_vector( 15 DOWNTO 0 ));
+   END COMPONENT;
+
+   SIGNAL s_sim_end              : BOOLEAN := FALSE;
+   SIGNAL s_clock                : std_logic := '0';
+   SIGNAL s_reset                : std_logic := '1';
+   SIGNAL s_clear                : std_logic := '0';
+
+   -- DMA_LCD_ctrl
+   SIGNAL s_slave_address        : std_logic_vector(  2 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_slave_cs             : std_logic := '0';
+   SIGNAL s_slave_we             : std_logic := '0';
+   SIGNAL s_slave_rd             : std_logic := '0';
+   SIGNAL s_slave_write_data     : std_logic_vector( 31 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_slave_read_data      : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_slave_wait_request   : std_logic;
+   SIGNAL s_master_address       : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_master_read          : std_logic;
+   SIGNAL s_master_burst_count   : std_logic_vector(  7 DOWNTO 0 );
+   SIGNAL s_master_read_data     : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_master_read_data_valid : std_logic;
+   SIGNAL s_master_wait_request  : std_logic;
+   SIGNAL s_irq                  : std_logic;
+   SIGNAL s_lcd_data             : std_logic_vector(  7 DOWNTO 0 );
+   SIGNAL s_lcd_cs_n             : std_logic;
+   SIGNAL s_lcd_wr_n             : std_logic;
+   SIGNAL s_lcd_d_c_n            : std_logic;
+   SIGNAL s_commands             : INTEGER;
+   SIGNAL s_beats                : INTEGER;
+   SIGNAL s_wait_cycles          : INTEGER;
+   SIGNAL s_busy_cycles          : INTEGER;
+   SIGNAL s_max_latency          : INTEGER;
+
+   -- LCD bus monitor of the DMA_LCD_ctrl
+   SIGNAL s_lcd_commands         : INTEGER := 0;
+   SIGNAL s_last_command         : std_logic_vector(  7 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_lcd_bytes            : INTEGER := 0;
+   SIGNAL s_byte_errors          : INTEGER := 0;
+   SIGNAL s_min_low              : TIME := 1 ms;
+   SIGNAL s_min_high             : TIME := 1 ms;
+   SIGNAL s_min_cycle            : TIME := 1 ms;
+
+   -- lcd_dma
+   SIGNAL s_ref_slave_address    : std_logic_vector(  2 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_ref_slave_cs         : std_logic := '0';
+   SIGNAL s_ref_slave_we         : std_logic := '0';
+   SIGNAL s_ref_slave_rd         : std_logic := '0';
+   SIGNAL s_ref_slave_write_data : std_logic_vector( 31 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_ref_slave_read_data  : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_ref_slave_wait_request : std_logic;
+   SIGNAL s_ref_master_address   : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_ref_master_read      : std_logic;
+   SIGNAL s_ref_master_burst_count : std_logic_vector(  7 DOWNTO 0 );
+   SIGNAL s_ref_master_read_data : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_ref_master_read_data_valid : std_logic;
+   SIGNAL s_ref_master_wait_request : std_logic;
+   SIGNAL s_ref_irq              : std_logic;
+   SIGNAL s_ref_write_bar        : std_logic;
+   SIGNAL s_ref_data_command_bar : std_logic;
+   SIGNAL s_ref_lcd_data         : std_logic_vector( 15 DOWNTO 0 );
+   SIGNAL s_ref_lcd_writes       : INTEGER := 0;
+   SIGNAL s_ref_commands         : INTEGER;
+   SIGNAL s_ref_beats            : INTEGER;
+   SIGNAL s_ref_wait_cycles      : INTEGER;
+   SIGNAL s_ref_busy_cycles      : INTEGER;
+   SIGNAL s_ref_max_latency      : INTEGER;
+
+BEGIN
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the clock, the memory models and the LCDs are defined    ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   make_clock : PROCESS
+   BEGIN
+      WHILE NOT s_sim_end LOOP
+         s_clock <= '0';
+         WAIT FOR CLOCK_PERIOD/2;
+         s_clock <= '1';
+         WAIT FOR CLOCK_PERIOD/2;
+      END LOOP;
+      WAIT;
+   END PROCESS make_clock;
+
+   memory : avalon_bfm_slave
+      GENERIC MAP ( BURST_WIDTH  => 8,
+                    MIN_WAIT     => MIN_WAIT,
+                    MAX_WAIT     => MAX_WAIT,
+                    READ_LATENCY => READ_LATENCY,
+                    SEED         => SEED)
+      PORT MAP ( Clock                 => s_clock,
+                 Reset                 => s_reset,
+                 Clear                 => s_clear,
+                 slave_address         => s_master_address,
+                 slave_read            => s_master_read,
+                 slave_write           => '0',
+                 slave_write_data      => (OTHERS => '0'),
+                 slave_burst_count     => s_master_burst_count,
+                 slave_read_data       => s_master_read_data,
+                 slave_read_data_valid => s_master_read_data_valid,
+                 slave_wait_request    => s_master_wait_request,
+                 Commands              => s_commands,
+                 Beats                 => s_beats,
+                 WaitCycles            => s_wait_cycles,
+                 BusyCycles            => s_busy_cycles,
+                 MaxLatency            => s_max_latency);
+
+   ref_memory : avalon_bfm_slave
+      GENERIC MAP ( BURST_WIDTH  => 8,
+                    MIN_WAIT     => MIN_WAIT,
+                    MAX_WAIT     => MAX_WAIT,
+                    READ_LATENCY => READ_LATENCY,
+                    SEED         => SEED)
+      PORT MAP ( Clock                 => s_clock,
+                 Reset                 => s_reset,
+                 Clear                 => s_clear,
+                 slave_address         => s_ref_master_address,
+                 slave_read            => s_ref_master_read,
+                 slave_write           => '0',
+                 slave_write_data      => (OTHERS => '0'),
+                 slave_burst_count     => s_ref_master_burst_count,
+                 slave_read_data       => s_ref_master_read_data,
+                 slave_read_data_valid => s_ref_master_read_data_valid,
+                 slave_wait_request    => s_ref_master_wait_request,
+                 Commands              => s_ref_commands,
+                 Beats                 => s_ref_beats,
+                 WaitCycles            => s_ref_wait_cycles,
+                 BusyCycles            => s_ref_busy_cycles,
+                 MaxLatency            => s_ref_max_latency);
+
+   -- The ILI9341 takes the byte with the rising edge of WR. The memory model
+   -- returns the byte address of each word, byte n of the picture is thus
+   -- byte n mod 4 (in the order 15..8, 7..0, 31..24, 23..16) of the word at
+   -- PICTURE_POINTER+4*(n/4).
+   lcd_monitor : PROCESS( s_lcd_wr_n )
+      VARIABLE v_falling : TIME := 0 ns;
+      VARIABLE v_rising  : TIME := 0 ns;
+      VARIABLE v_word    : std_logic_vector( 31 DOWNTO 0 );
+      VARIABLE v_byte    : std_logic_vector(  7 DOWNTO 0 );
+   BEGIN
+      IF (falling_edge(s_lcd_wr_n)) THEN
+         IF (v_falling /= 0 ns AND NOW-v_falling < s_min_cycle) THEN
+            s_min_cycle <= NOW-v_falling;
+         END IF;
+         IF (v_rising /= 0 ns AND NOW-v_rising < s_min_high) THEN
+            s_min_high <= NOW-v_rising;
+         END IF;
+         v_falling := NOW;
+      END IF;
+      IF (rising_edge(s_lcd_wr_n) AND s_lcd_cs_n = '0') THEN
+         IF (NOW-v_falling < s_min_low) THEN
+            s_min_low <= NOW-v_falling;
+         END IF;
+         v_rising := NOW;
+         IF (s_lcd_d_c_n = '0') THEN
+            s_lcd_commands <= s_lcd_commands + 1;
+            s_last_command <= s_lcd_data;
+                                ELSE
+            v_word := std_logic_vector(to_unsigned(PICTURE_POINTER+
+                                                   4*(s_lcd_bytes/4),32));
+            CASE s_lcd_bytes MOD 4 IS
+               WHEN 0      => v_byte := v_word( 15 DOWNTO  8 );
+               WHEN 1      => v_byte := v_word(  7 DOWNTO  0 );
+               WHEN 2      => v_byte := v_word( 31 DOWNTO 24 );
+               WHEN OTHERS => v_byte := v_word( 23 DOWNTO 16 );
+            END CASE;
+            IF (s_lcd_data /= v_byte) THEN
+               s_byte_errors <= s_byte_errors + 1;
+            END IF;
+            s_lcd_bytes <= s_lcd_bytes + 1;
+         END IF;
+      END IF;
+   END PROCESS lcd_monitor;
+
+   count_ref_lcd_writes : PROCESS( s_ref_write_bar )
+   BEGIN
+      IF (rising_edge(s_ref_write_bar) AND s_ref_data_command_bar = '1') THEN
+         s_ref_lcd_writes <= s_ref_lcd_writes + 1;
+      END IF;
+   END PROCESS count_ref_lcd_writes;
+
+   s_ref_lcd_data <= (OTHERS => 'H');
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the devices under test are instantiated                  ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   dut : DMA_LCD_ctrl
+      PORT MAP ( clk                    => s_clock,
+                 reset                  => s_reset,
+                 master_address         => s_master_address,
+                 master_read            => s_master_read,
+                 master_burstcount      => s_master_burst_count,
+                 master_readdata        => s_master_read_data,
+                 master_readdatavalid   => s_master_read_data_valid,
+                 master_waitrequest     => s_master_wait_request,
+                 end_of_transaction_irq => s_irq,
+                 avalon_address         => s_slave_address,
+                 avalon_cs              => s_slave_cs,
+                 avalon_wr              => s_slave_we,
+                 avalon_write_data      => s_slave_write_data,
+                 avalon_rd              => s_slave_rd,
+                 avalon_read_data       => s_slave_read_data,
+                 avalon_waitrequest     => s_slave_wait_request,
+                 LCD_data               => s_lcd_data,
+                 LCD_CS_n               => s_lcd_cs_n,
+                 LCD_WR_n               => s_lcd_wr_n,
+                 LCD_D_C_n              => s_lcd_d_c_n);
+
+   ref : lcd_dma
+      GENERIC MAP ( RECOVER_CYCLES => RECOVER_CYCLES)
+      PORT MAP ( Clock                  => s_clock,
+                 Reset                  => s_reset,
+                 slave_address          => s_ref_slave_address,
+                 slave_cs               => s_ref_slave_cs,
+                 slave_we               => s_ref_slave_we,
+                 slave_rd               => s_ref_slave_rd,
+                 slave_write_data       => s_ref_slave_write_data,
+                 slave_read_data        => s_ref_slave_read_data,
+                 slave_wait_request     => s_ref_slave_wait_request,
+                 master_address         => s_ref_master_address,
+                 master_read            => s_ref_master_read,
+                 master_burst_count     => s_ref_master_burst_count,
+                 master_read_data       => s_ref_master_read_data,
+                 master_read_data_valid => s_ref_master_read_data_valid,
+                 master_wait_request    => s_ref_master_wait_request,
+                 end_of_transaction_irq => s_ref_irq,
+                 ChipSelectBar          => OPEN,
+                 DataCommandBar         => s_ref_data_command_bar,
+                 WriteBar               => s_ref_write_bar,
+                 ReadBar                => OPEN,
+                 ResetBar               => OPEN,
+                 IM0                    => OPEN,
+                 DataBus                => s_ref_lcd_data);
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the stimuli and the measurement are defined              ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   stimuli : PROCESS
+      VARIABLE v_errors     : INTEGER := 0;
+      VARIABLE v_data       : std_logic_vector( 31 DOWNTO 0 );
+      VARIABLE v_cycles     : INTEGER;
+      VARIABLE v_ref_cycles : INTEGER;
+      VARIABLE v_start      : TIME;
+
+      PROCEDURE write_reg( address : IN INTEGER;
+                           data    : IN INTEGER ) IS
+      BEGIN
+         avalon_bfm_write(s_clock,s_slave_address,s_slave_cs,s_slave_we,
+                          s_slave_write_data,s_slave_wait_request,address,
+                          std_logic_vector(to_unsigned(data,32)));
+      END write_reg;
+
+      PROCEDURE write_ref_reg( address : IN INTEGER;
+                               data    : IN INTEGER ) IS
+      BEGIN
+         avalon_bfm_write(s_clock,s_ref_slave_address,s_ref_slave_cs,
+                          s_ref_slave_we,s_ref_slave_write_data,
+                          s_ref_slave_wait_request,address,
+                          std_logic_vector(to_unsigned(data,32)));
+      END write_ref_reg;
+
+      PROCEDURE check( condition : IN BOOLEAN;
+                       message   : IN STRING ) IS
+      BEGIN
+         IF NOT condition THEN
+            REPORT message SEVERITY error;
+            v_errors := v_errors + 1;
+         END IF;
+      END check;
+
+      PROCEDURE measure_start IS
+      BEGIN
+         WAIT UNTIL rising_edge(s_clock);
+         s_clear <= '1';
+         WAIT UNTIL rising_edge(s_clock);
+         s_clear <= '0';
+         v_start := NOW;
+      END measure_start;
+
+      PROCEDURE wait_irq( SIGNAL irq : IN std_logic ) IS
+         VARIABLE v_count : INTEGER := 0;
+      BEGIN
+         WHILE irq /= '1' AND v_count < TIMEOUT LOOP
+            WAIT UNTIL rising_edge(s_clock);
+            v_count := v_count + 1;
+         END LOOP;
+         check(irq = '1',"Timeout waiting for the end of transaction IRQ");
+      END wait_irq;
+
+   BEGIN
+      s_reset <= '1';
+      WAIT FOR 10*CLOCK_PERIOD;
+      s_reset <= '0';
+
+      -- DMA_LCD_ctrl, the memory write command is sent by the CPU
+      write_reg(CMD_REG,MEMORY_WRITE);
+      write_reg(POINTER_REG,PICTURE_POINTER);
+      write_reg(SIZE_REG,PIXELS*2);
+      measure_start;
+      write_reg(CONTROL_REG,START);
+      wait_irq(s_irq);
+      v_cycles := (NOW-v_start)/CLOCK_PERIOD;
+      WAIT FOR 10*CLOCK_PERIOD;
+
+      check(s_lcd_commands = 1 AND
+            s_last_command = std_logic_vector(to_unsigned(MEMORY_WRITE,8)),
+            "Memory write command not seen on the LCD bus");
+      check(s_beats*4 = PIXELS*2,
+            "Words read " & INTEGER'image(s_beats) & ", expected " &
+            INTEGER'image(PIXELS/2));
+      check(s_lcd_bytes = PIXELS*2,
+            "Bytes written to the LCD " & INTEGER'image(s_lcd_bytes) &
+            ", expected " & INTEGER'image(PIXELS*2));
+      check(s_byte_errors = 0,
+            INTEGER'image(s_byte_errors) & " wrong byte(s) on the LCD bus");
+      check(s_min_low >= 15 ns,
+            "WR low time " & TIME'image(s_min_low) & " < 15 ns");
+      check(s_min_high >= 15 ns,
+            "WR high time " & TIME'image(s_min_high) & " < 15 ns");
+      check(s_min_cycle >= 66 ns,
+            "WR cycle time " & TIME'image(s_min_cycle) & " < 66 ns");
+
+      avalon_bfm_read(s_clock,s_slave_address,s_slave_cs,s_slave_rd,
+                      s_slave_read_data,s_slave_wait_request,CONTROL_REG,
+                      1,v_data);
+      check(v_data(2 DOWNTO 0) = "100","Status after the transfer not IRQ only");
+      write_reg(CONTROL_REG,IRQ_ACK);
+      WAIT UNTIL rising_edge(s_clock);
+      check(s_irq = '0',"IRQ not acknowledged");
+
+      avalon_bfm_report("DMA_LCD_ctrl",PIXELS,PIXELS*2,v_cycles,s_busy_cycles,
+                        CLOCK_PERIOD);
+      REPORT "DMA_LCD_ctrl: " & INTEGER'image(s_commands) & " bursts, " &
+             INTEGER'image(s_wait_cycles) & " wait cycles, WR cycle " &
+             TIME'image(s_min_cycle) SEVERITY note;
+
+      -- lcd_dma, the display reset sequence runs after the core reset
+      v_ref_cycles := 0;
+      LOOP
+         avalon_bfm_read(s_clock,s_ref_slave_address,s_ref_slave_cs,
+                         s_ref_slave_rd,s_ref_slave_read_data,
+                         s_ref_slave_wait_request,REF_CONTROL_REG,0,v_data);
+         EXIT WHEN v_data(REF_LCD_BUSY) = '0' OR v_ref_cycles > RESET_TIMEOUT;
+         WAIT FOR 100*CLOCK_PERIOD;
+         v_ref_cycles := v_ref_cycles + 102;
+      END LOOP;
+      check(v_data(REF_LCD_BUSY) = '0',"Timeout waiting for the display reset");
+
+      write_ref_reg(REF_CONTROL_REG,0);
+      write_ref_reg(REF_LCD_LINE_REG,LCD_WIDTH);
+      write_ref_reg(REF_IMAGE_LINE_REG,LCD_WIDTH);
+      write_ref_reg(REF_POINTER_REG,PICTURE_POINTER);
+      write_ref_reg(REF_SIZE_REG,PIXELS);
+      measure_start;
+      avalon_bfm_write(s_clock,s_ref_slave_address,s_ref_slave_cs,
+                       s_ref_slave_we,s_ref_slave_write_data,
+                       s_ref_slave_wait_request,REF_CONTROL_REG,
+                       REF_START_WITH_IRQ);
+      wait_irq(s_ref_irq);
+      v_ref_cycles := (NOW-v_start)/CLOCK_PERIOD;
+
+      check(s_ref_lcd_writes = PIXELS,
+            "Pixels written by the lcd_dma " & INTEGER'image(s_ref_lcd_writes) &
+            ", expected " & INTEGER'image(PIXELS));
+      avalon_bfm_report("lcd_dma",PIXELS,PIXELS*2,v_ref_cycles,
+                        s_ref_busy_cycles,CLOCK_PERIOD);
+
+      REPORT "Pixels per second: DMA_LCD_ctrl " &
+             INTEGER'image(INTEGER(REAL(PIXELS)/
+                                   (REAL(v_cycles)*REAL(CLOCK_PERIOD/1 ns)*1.0e-9))) &
+             ", lcd_dma " &
+             INTEGER'image(INTEGER(REAL(PIXELS)/
+                                   (REAL(v_ref_cycles)*REAL(CLOCK_PERIOD/1 ns)*1.0e-9))) &
+             ", ratio " &
+             avalon_bfm_fixed(REAL(v_ref_cycles)/REAL(v_cycles)) SEVERITY note;
+
+      ASSERT v_errors = 0
+         REPORT "dma_lcd_ctrl_tb: " & INTEGER'image(v_errors) & " error(s)"
+         SEVERITY failure;
+      REPORT "dma_lcd_ctrl_tb: done" SEVERITY note;
+      s_sim_end <= TRUE;
+      WAIT;
+   END PROCESS stimuli;
+
+END MSE;
@@ -0,0 +1,313 @@
+--------------------------------------------------------------------------------
+--- Binary transfer testbench for the lcd_dma                                ---
+---                                                                          ---
+--- Sends packed one bit per pixel pictures of different widths from the     ---
+--- avalon_bfm_slave memory model to the LCD. The memory model returns the   ---
+--- byte address of each word as data, so the bits of a word are known and   ---
+--- each pixel written to the LCD must be FOREGROUND or BACKGROUND as given  ---
+--- by the bit of its word. The widths that are no multiple of 32 check the  ---
+--- skipping of the unused bits at the end of each line.                    ---
+--- Note: the display reset after a core reset is shortened to              ---
+--- RECOVER_CYCLES, the testbench polls the busy flag before it starts.      ---
+--------------------------------------------------------------------------------
+LIBRARY ieee;
+USE ieee.std_logic_1164.all;
+USE ieee.numeric_std.all;
+USE work.avalon_bfm_pkg.all;
+
+ENTITY lcd_binary_tb IS
+   GENERIC( MIN_WAIT     : INTEGER := 0;
+            MAX_WAIT     : INTEGER := 2;
+            READ_LATENCY : INTEGER := 3;
+            SEED         : INTEGER := 1);
+END lcd_binary_tb;
+
+ARCHITECTURE MSE OF lcd_binary_tb IS
+
+   CONSTANT CLOCK_PERIOD     : TIME := 20 ns; -- 50 MHz
+   CONSTANT IMAGE_HEIGHT     : INTEGER := 6;
+   CONSTANT MAX_WIDTH        : INTEGER := 240;
+   CONSTANT PICTURE_POINTER  : INTEGER := 16#00100000#;
+   CONSTANT TIMEOUT          : INTEGER := 200*MAX_WIDTH*IMAGE_HEIGHT; -- clock cycles
+   CONSTANT RECOVER_CYCLES   : INTEGER := 12000; -- 12000000 on the board
+   CONSTANT RESET_TIMEOUT    : INTEGER := RECOVER_CYCLES+100000; -- clock cycles
+   CONSTANT MAX_WRITES       : INTEGER := 8*MAX_WIDTH*IMAGE_HEIGHT;
+   CONSTANT FOREGROUND       : INTEGER := 16#07E0#;
+   CONSTANT BACKGROUND       : INTEGER := 16#001F#;
+
+   TYPE WIDTH_TYPE IS ARRAY( NATURAL RANGE <> ) OF INTEGER;
+   CONSTANT WIDTHS           : WIDTH_TYPE := (40,64,1,33,MAX_WIDTH);
+
+   CONSTANT CONTROL_REG      : INTEGER := 2;
+   CONSTANT POINTER_REG      : INTEGER := 3;
+   CONSTANT SIZE_REG         : INTEGER := 4;
+   CONSTANT LCD_LINE_REG     : INTEGER := 5;
+   CONSTANT IMAGE_LINE_REG   : INTEGER := 6;
+   CONSTANT LCD_BUSY         : INTEGER := 1;
+   CONSTANT IRQ_ENABLE       : INTEGER := 16#020#;
+   CONSTANT START_DMA        : INTEGER := 16#100#;
+   CONSTANT CLEAR_IRQ        : INTEGER := 16#200#;
+   CONSTANT BINARY           : INTEGER := 16#2000#;
+
+   TYPE LCD_DATA_TYPE IS ARRAY( 0 TO MAX_WRITES-1 ) OF
+                            std_logic_vector( 15 DOWNTO 0 );
+
+   COMPONENT lcd_dma IS
+      GENERIC( RECOVER_CYCLES            : INTEGER);
+      PORT ( Clock                       : IN  std_logic;
+             Reset                       : IN  std_logic;
+             slave_address               : IN  std_logic_vector( 2 DOWNTO 0 );
+             slave_cs                    : IN  std_logic;
+             slave_we                    : IN  std_logic;
+             slave_rd                    : IN  std_logic;
+             slave_write_data            : IN  std_logic_vector(31 DOWNTO 0 );
+             slave_read_data             : OUT std_logic_vector(31 DOWNTO 0 );
+             slave_wait_request          : OUT std_logic;
+             master_address              : OUT std_logic_vector(31 DOWNTO 0 );
+             master_read                 : OUT std_logic;
+             master_burst_count          : OUT std_logic_vector( 7 DOWNTO 0 );
+             master_read_data            : IN  std_logic_vector(31 DOWNTO 0 );
+             master_read_data_valid      : IN  std_logic;
+             master_wait_request         : IN  std_logic;
+             end_of_transaction_irq      : OUT std_logic;
+             ChipSelectBar               : OUT std_logic;
+             DataCommandBar              : OUT std_logic;
+             WriteBar                    : OUT std_logic;
+             ReadBar                     : OUT std_logic;
+             ResetBar                    : OUT std_logic;
+             IM0                         : OUT std_logic;
+             DataBus                     : INOUT std_logic_vector( 15 DOWNTO 0 ));
+   END COMPONENT;
+
+   SIGNAL s_sim_end              : BOOLEAN := FALSE;
+   SIGNAL s_clock                : std_logic := '0';
+   SIGNAL s_reset                : std_logic := '1';
+   SIGNAL s_clear                : std_logic := '0';
+   SIGNAL s_slave_address        : std_logic_vector(  2 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_slave_cs             : std_logic := '0';
+   SIGNAL s_slave_we             : std_logic := '0';
+   SIGNAL s_slave_rd             : std_logic := '0';
+   SIGNAL s_slave_write_data     : std_logic_vector( 31 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_slave_read_data      : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_slave_wait_request   : std_logic;
+   SIGNAL s_master_address       : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_master_read          : std_logic;
+   SIGNAL s_master_burst_count   : std_logic_vector(  7 DOWNTO 0 );
+   SIGNAL s_master_read_data     : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_master_read_data_valid : std_logic;
+   SIGNAL s_master_wait_request  : std_logic;
+   SIGNAL s_irq                  : std_logic;
+   SIGNAL s_write_bar            : std_logic;
+   SIGNAL s_data_command_bar     : std_logic;
+   SIGNAL s_lcd_data             : std_logic_vector( 15 DOWNTO 0 );
+   SIGNAL s_lcd_writes           : INTEGER := 0;
+   SIGNAL s_lcd_pixels           : LCD_DATA_TYPE;
+   SIGNAL s_commands             : INTEGER;
+   SIGNAL s_beats                : INTEGER;
+   SIGNAL s_wait_cycles          : INTEGER;
+   SIGNAL s_busy_cycles          : INTEGER;
+   SIGNAL s_max_latency          : INTEGER;
+
+   -- the LCD data of pixel x of line y, the memory model returns the
+   -- address of the word
+   FUNCTION pixel_data( width : INTEGER;
+                        x     : INTEGER;
+                        y     : INTEGER ) RETURN std_logic_vector IS
+      VARIABLE v_word : std_logic_vector( 31 DOWNTO 0 );
+   BEGIN
+      v_word := std_logic_vector(to_unsigned(PICTURE_POINTER+
+                                             (y*((width+31)/32)+x/32)*4,32));
+      IF v_word(x MOD 32) = '1' THEN
+         RETURN std_logic_vector(to_unsigned(FOREGROUND,16));
+      END IF;
+      RETURN std_logic_vector(to_unsigned(BACKGROUND,16));
+   END pixel_data;
+
+BEGIN
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the clock, the memory model and the LCD are defined      ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   make_clock : PROCESS
+   BEGIN
+      WHILE NOT s_sim_end LOOP
+         s_clock <= '0';
+         WAIT FOR CLOCK_PERIOD/2;
+         s_clock <= '1';
+         WAIT FOR CLOCK_PERIOD/2;
+      END LOOP;
+      WAIT;
+   END PROCESS make_clock;
+
+   memory : avalon_bfm_slave
+      GENERIC MAP ( BURST_WIDTH  => 8,
+                    MIN_WAIT     => MIN_WAIT,
+                    MAX_WAIT     => MAX_WAIT,
+                    READ_LATENCY => READ_LATENCY,
+                    SEED         => SEED)
+      PORT MAP ( Clock                 => s_clock,
+                 Reset                 => s_reset,
+                 Clear                 => s_clear,
+                 slave_address         => s_master_address,
+                 slave_read            => s_master_read,
+                 slave_write           => '0',
+                 slave_write_data      => (OTHERS => '0'),
+                 slave_burst_count     => s_master_burst_count,
+                 slave_read_data       => s_master_read_data,
+                 slave_read_data_valid => s_master_read_data_valid,
+                 slave_wait_request    => s_master_wait_request,
+                 Commands              => s_commands,
+                 Beats                 => s_beats,
+                 WaitCycles            => s_wait_cycles,
+                 BusyCycles            => s_busy_cycles,
+                 MaxLatency            => s_max_latency);
+
+   -- stores the pixels written to the display (the memory start command
+   -- is sent as command)
+   capture_lcd_writes : PROCESS( s_write_bar )
+   BEGIN
+      IF (rising_edge(s_write_bar) AND s_data_command_bar = '1') THEN
+         IF (s_lcd_writes < MAX_WRITES) THEN
+            s_lcd_pixels(s_lcd_writes) <= To_X01(s_lcd_data);
+         END IF;
+         s_lcd_writes <= s_lcd_writes + 1;
+      END IF;
+   END PROCESS capture_lcd_writes;
+
+   s_lcd_data <= (OTHERS => 'H');
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the device under test is instantiated                    ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   dut : lcd_dma
+      GENERIC MAP ( RECOVER_CYCLES => RECOVER_CYCLES)
+      PORT MAP ( Clock                  => s_clock,
+                 Reset                  => s_reset,
+                 slave_address          => s_slave_address,
+                 slave_cs               => s_slave_cs,
+                 slave_we               => s_slave_we,
+                 slave_rd               => s_slave_rd,
+                 slave_write_data       => s_slave_write_data,
+                 slave_read_data        => s_slave_read_data,
+                 slave_wait_request     => s_slave_wait_request,
+                 master_address         => s_master_address,
+                 master_read            => s_master_read,
+                 master_burst_count     => s_master_burst_count,
+                 master_read_data       => s_master_read_data,
+                 master_read_data_valid => s_master_read_data_valid,
+                 master_wait_request    => s_master_wait_request,
+                 end_of_transaction_irq => s_irq,
+                 ChipSelectBar          => OPEN,
+                 DataCommandBar         => s_data_command_bar,
+                 WriteBar               => s_write_bar,
+                 ReadBar                => OPEN,
+                 ResetBar               => OPEN,
+                 IM0                    => OPEN,
+                 DataBus                => s_lcd_data);
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the stimuli and the checks are defined                   ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   stimuli : PROCESS
+      VARIABLE v_errors   : INTEGER := 0;
+      VARIABLE v_data     : std_logic_vector( 31 DOWNTO 0 );
+      VARIABLE v_cycles   : INTEGER;
+      VARIABLE v_width    : INTEGER;
+      VARIABLE v_mode     : INTEGER;
+      VARIABLE v_first    : INTEGER;
+      VARIABLE v_expected : std_logic_vector( 15 DOWNTO 0 );
+      VARIABLE v_bad      : INTEGER;
+
+      PROCEDURE write_reg( address : IN INTEGER;
+                           data    : IN INTEGER ) IS
+      BEGIN
+         avalon_bfm_write(s_clock,s_slave_address,s_slave_cs,s_slave_we,
+                          s_slave_write_data,s_slave_wait_request,address,
+                          std_logic_vector(to_unsigned(data,32)));
+      END write_reg;
+
+      PROCEDURE check( condition : IN BOOLEAN;
+                       message   : IN STRING ) IS
+      BEGIN
+         IF NOT condition THEN
+            REPORT message SEVERITY error;
+            v_errors := v_errors + 1;
+         END IF;
+      END check;
+
+   BEGIN
+      s_reset <= '1';
+      WAIT FOR 10*CLOCK_PERIOD;
+      s_reset <= '0';
+
+      -- the display reset sequence runs after the core reset
+      v_cycles := 0;
+      LOOP
+         avalon_bfm_read(s_clock,s_slave_address,s_slave_cs,s_slave_rd,
+                         s_slave_read_data,s_slave_wait_request,CONTROL_REG,
+                         0,v_data);
+         EXIT WHEN v_data(LCD_BUSY) = '0' OR v_cycles > RESET_TIMEOUT;
+         WAIT FOR 100*CLOCK_PERIOD;
+         v_cycles := v_cycles + 102;
+      END LOOP;
+      check(v_data(LCD_BUSY) = '0',"Timeout waiting for the display reset");
+
+      write_reg(CONTROL_REG,0);
+      FOR n IN WIDTHS'RANGE LOOP
+         v_width := WIDTHS(n);
+         v_mode  := IRQ_ENABLE+BINARY;
+         write_reg(CONTROL_REG,v_mode);
+         write_reg(LCD_LINE_REG,v_width+BACKGROUND*65536);
+         write_reg(IMAGE_LINE_REG,v_width+FOREGROUND*65536);
+         write_reg(POINTER_REG,PICTURE_POINTER);
+         write_reg(SIZE_REG,v_width*IMAGE_HEIGHT);
+         v_first := s_lcd_writes;
+         write_reg(CONTROL_REG,v_mode+START_DMA);
+         v_cycles := 0;
+         WHILE s_irq /= '1' AND v_cycles < TIMEOUT LOOP
+            WAIT UNTIL rising_edge(s_clock);
+            v_cycles := v_cycles + 1;
+         END LOOP;
+         check(s_irq = '1',"Timeout waiting for the end of transaction IRQ");
+         write_reg(CONTROL_REG,v_mode+CLEAR_IRQ);
+
+         check(s_lcd_writes-v_first = v_width*IMAGE_HEIGHT,
+               "Width " & INTEGER'image(v_width) & ": " &
+               INTEGER'image(s_lcd_writes-v_first) &
+               " pixels written to the LCD, expected " &
+               INTEGER'image(v_width*IMAGE_HEIGHT));
+         v_bad := 0;
+         FOR p IN 0 TO v_width*IMAGE_HEIGHT-1 LOOP
+            v_expected := pixel_data(v_width,p MOD v_width,p / v_width);
+            IF (v_first+p < MAX_WRITES AND
+                s_lcd_pixels(v_first+p) /= v_expected) THEN
+               IF v_bad = 0 THEN
+                  REPORT "Width " & INTEGER'image(v_width) &
+                         ": pixel " & INTEGER'image(p) & " is " &
+                         INTEGER'image(to_integer(
+                                       unsigned(s_lcd_pixels(v_first+p)))) &
+                         ", expected " & INTEGER'image(to_integer(
+                                       unsigned(v_expected)))
+                     SEVERITY note;
+               END IF;
+               v_bad := v_bad + 1;
+            END IF;
+         END LOOP;
+         check(v_bad = 0,"Width " & INTEGER'image(v_width) & ": " &
+                         INTEGER'image(v_bad) & " wrong pixel(s)");
+      END LOOP;
+
+      ASSERT v_errors = 0
+         REPORT "lcd_binary_tb: " & INTEGER'image(v_errors) & " error(s)"
+         SEVERITY failure;
+      REPORT "lcd_binary_tb: done" SEVERITY note;
+      s_sim_end <= TRUE;
+      WAIT;
+   END PROCESS stimuli;
+
+END MSE;
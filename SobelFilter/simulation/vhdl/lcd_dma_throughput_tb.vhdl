@@ -0,0 +1,267 @@
+--------------------------------------------------------------------------------
+--- Throughput testbench for the lcd_dma                                     ---
+---                                                                          ---
+--- Transfers an RGB565 picture of LINES lines of the LCD width from the     ---
+--- avalon_bfm_slave memory model to the LCD and reports the cycles per      ---
+--- pixel and the throughput from the start of the DMA up to the end of      ---
+--- transaction IRQ. The memory timing is set by the generics, e.g.          ---
+---    ./run_tb.sh lcd_dma_throughput_tb -gMAX_WAIT=8 -gREAD_LATENCY=6       ---
+--- Note: the display reset after a core reset is shortened to              ---
+--- RECOVER_CYCLES, the testbench polls the busy flag before it starts.      ---
+--------------------------------------------------------------------------------
+LIBRARY ieee;
+USE ieee.std_logic_1164.all;
+USE ieee.numeric_std.all;
+USE work.avalon_bfm_pkg.all;
+
+ENTITY lcd_dma_throughput_tb IS
+   GENERIC( MIN_WAIT     : INTEGER := 0;
+            MAX_WAIT     : INTEGER := 2;
+            READ_LATENCY : INTEGER := 3;
+            SEED         : INTEGER := 1;
+            LINES        : INTEGER := 16);
+END lcd_dma_throughput_tb;
+
+ARCHITECTURE MSE OF lcd_dma_throughput_tb IS
+
+   CONSTANT CLOCK_PERIOD     : TIME := 20 ns; -- 50 MHz
+   CONSTANT LCD_WIDTH        : INTEGER := 240;
+   CONSTANT PIXELS           : INTEGER := LCD_WIDTH*LINES;
+   CONSTANT PICTURE_POINTER  : INTEGER := 16#00100000#;
+   CONSTANT TIMEOUT          : INTEGER := 100*PIXELS; -- clock cycles
+   CONSTANT RECOVER_CYCLES   : INTEGER := 12000; -- 12000000 on the board
+   CONSTANT RESET_TIMEOUT    : INTEGER := RECOVER_CYCLES+100000; -- clock cycles
+
+   CONSTANT CONTROL_REG      : INTEGER := 2;
+   CONSTANT POINTER_REG      : INTEGER := 3;
+   CONSTANT SIZE_REG         : INTEGER := 4;
+   CONSTANT LCD_LINE_REG     : INTEGER := 5;
+   CONSTANT IMAGE_LINE_REG   : INTEGER := 6;
+   CONSTANT LCD_BUSY         : INTEGER := 1;
+   CONSTANT START_WITH_IRQ   : std_logic_vector( 31 DOWNTO 0 ) := X"00000120";
+
+   COMPONENT lcd_dma IS
+      GENERIC( RECOVER_CYCLES            : INTEGER);
+      PORT ( Clock                       : IN  std_logic;
+             Reset                       : IN  std_logic;
+             slave_address               : IN  std_logic_vector( 2 DOWNTO 0 );
+             slave_cs                    : IN  std_logic;
+             slave_we                    : IN  std_logic;
+             slave_rd                    : IN  std_logic;
+             slave_write_data            : IN  std_logic_vector(31 DOWNTO 0 );
+             slave_read_data             : OUT std_logic_vector(31 DOWNTO 0 );
+             slave_wait_request          : OUT std_logic;
+             master_address              : OUT std_logic_vector(31 DOWNTO 0 );
+             master_read                 : OUT std_logic;
+             master_burst_count          : OUT std_logic_vector( 7 DOWNTO 0 );
+             master_read_data            : IN  std_logic_vector(31 DOWNTO 0 );
+             master_read_data_valid      : IN  std_logic;
+             master_wait_request         : IN  std_logic;
+             end_of_transaction_irq      : OUT std_logic;
+             ChipSelectBar               : OUT std_logic;
+             DataCommandBar              : OUT std_logic;
+             WriteBar                    : OUT std_logic;
+             ReadBar                     : OUT std_logic;
+             ResetBar                    : OUT std_logic;
+             IM0                         : OUT std_logic;
+             DataBus                     : INOUT std_logic_vector( 15 DOWNTO 0 ));
+   END COMPONENT;
+
+   SIGNAL s_sim_end              : BOOLEAN := FALSE;
+   SIGNAL s_clock                : std_logic := '0';
+   SIGNAL s_reset                : std_logic := '1';
+   SIGNAL s_clear                : std_logic := '0';
+   SIGNAL s_slave_address        : std_logic_vector(  2 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_slave_cs             : std_logic := '0';
+   SIGNAL s_slave_we             : std_logic := '0';
+   SIGNAL s_slave_rd             : std_logic := '0';
+   SIGNAL s_slave_write_data     : std_logic_vector( 31 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_slave_read_data      : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_slave_wait_request   : std_logic;
+   SIGNAL s_master_address       : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_master_read          : std_logic;
+   SIGNAL s_master_burst_count   : std_logic_vector(  7 DOWNTO 0 );
+   SIGNAL s_master_read_data     : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_master_read_data_valid : std_logic;
+   SIGNAL s_master_wait_request  : std_logic;
+   SIGNAL s_irq                  : std_logic;
+   SIGNAL s_write_bar            : std_logic;
+   SIGNAL s_data_command_bar     : std_logic;
+   SIGNAL s_lcd_data             : std_logic_vector( 15 DOWNTO 0 );
+   SIGNAL s_lcd_writes           : INTEGER := 0;
+   SIGNAL s_commands             : INTEGER;
+   SIGNAL s_beats                : INTEGER;
+   SIGNAL s_wait_cycles          : INTEGER;
+   SIGNAL s_busy_cycles          : INTEGER;
+   SIGNAL s_max_latency          : INTEGER;
+
+BEGIN
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the clock, the memory model and the LCD are defined      ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   make_clock : PROCESS
+   BEGIN
+      WHILE NOT s_sim_end LOOP
+         s_clock <= '0';
+         WAIT FOR CLOCK_PERIOD/2;
+         s_clock <= '1';
+         WAIT FOR CLOCK_PERIOD/2;
+      END LOOP;
+      WAIT;
+   END PROCESS make_clock;
+
+   memory : avalon_bfm_slave
+      GENERIC MAP ( BURST_WIDTH  => 8,
+                    MIN_WAIT     => MIN_WAIT,
+                    MAX_WAIT     => MAX_WAIT,
+                    READ_LATENCY => READ_LATENCY,
+                    SEED         => SEED)
+      PORT MAP ( Clock                 => s_clock,
+                 Reset                 => s_reset,
+                 Clear                 => s_clear,
+                 slave_address         => s_master_address,
+                 slave_read            => s_master_read,
+                 slave_write           => '0',
+                 slave_write_data      => (OTHERS => '0'),
+                 slave_burst_count     => s_master_burst_count,
+                 slave_read_data       => s_master_read_data,
+                 slave_read_data_valid => s_master_read_data_valid,
+                 slave_wait_request    => s_master_wait_request,
+                 Commands              => s_commands,
+                 Beats                 => s_beats,
+                 WaitCycles            => s_wait_cycles,
+                 BusyCycles            => s_busy_cycles,
+                 MaxLatency            => s_max_latency);
+
+   -- counts the pixels written to the display (the memory start command
+   -- is sent as command)
+   count_lcd_writes : PROCESS( s_write_bar )
+   BEGIN
+      IF (rising_edge(s_write_bar) AND s_data_command_bar = '1') THEN
+         s_lcd_writes <= s_lcd_writes + 1;
+      END IF;
+   END PROCESS count_lcd_writes;
+
+   s_lcd_data <= (OTHERS => 'H');
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the device under test is instantiated                    ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   dut : lcd_dma
+      GENERIC MAP ( RECOVER_CYCLES => RECOVER_CYCLES)
+      PORT MAP ( Clock                  => s_clock,
+                 Reset                  => s_reset,
+                 slave_address          => s_slave_address,
+                 slave_cs               => s_slave_cs,
+                 slave_we               => s_slave_we,
+                 slave_rd               => s_slave_rd,
+                 slave_write_data       => s_slave_write_data,
+                 slave_read_data        => s_slave_read_data,
+                 slave_wait_request     => s_slave_wait_request,
+                 master_address         => s_master_address,
+                 master_read            => s_master_read,
+                 master_burst_count     => s_master_burst_count,
+                 master_read_data       => s_master_read_data,
+                 master_read_data_valid => s_master_read_data_valid,
+                 master_wait_request    => s_master_wait_request,
+                 end_of_transaction_irq => s_irq,
+                 ChipSelectBar          => OPEN,
+                 DataCommandBar         => s_data_command_bar,
+                 WriteBar               => s_write_bar,
+                 ReadBar                => OPEN,
+                 ResetBar               => OPEN,
+                 IM0                    => OPEN,
+                 DataBus                => s_lcd_data);
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the stimuli and the measurement are defined              ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   stimuli : PROCESS
+      VARIABLE v_errors : INTEGER := 0;
+      VARIABLE v_data   : std_logic_vector( 31 DOWNTO 0 );
+      VARIABLE v_cycles : INTEGER;
+      VARIABLE v_start  : TIME;
+
+      PROCEDURE write_reg( address : IN INTEGER;
+                           data    : IN INTEGER ) IS
+      BEGIN
+         avalon_bfm_write(s_clock,s_slave_address,s_slave_cs,s_slave_we,
+                          s_slave_write_data,s_slave_wait_request,address,
+                          std_logic_vector(to_unsigned(data,32)));
+      END write_reg;
+
+      PROCEDURE check( condition : IN BOOLEAN;
+                       message   : IN STRING ) IS
+      BEGIN
+         IF NOT condition THEN
+            REPORT message SEVERITY error;
+            v_errors := v_errors + 1;
+         END IF;
+      END check;
+
+   BEGIN
+      s_reset <= '1';
+      WAIT FOR 10*CLOCK_PERIOD;
+      s_reset <= '0';
+
+      -- the display reset sequence runs after the core reset
+      v_cycles := 0;
+      LOOP
+         avalon_bfm_read(s_clock,s_slave_address,s_slave_cs,s_slave_rd,
+                         s_slave_read_data,s_slave_wait_request,CONTROL_REG,
+                         0,v_data);
+         EXIT WHEN v_data(LCD_BUSY) = '0' OR v_cycles > RESET_TIMEOUT;
+         WAIT FOR 100*CLOCK_PERIOD;
+         v_cycles := v_cycles + 102;
+      END LOOP;
+      check(v_data(LCD_BUSY) = '0',"Timeout waiting for the display reset");
+
+      write_reg(CONTROL_REG,0);
+      write_reg(LCD_LINE_REG,LCD_WIDTH);
+      write_reg(IMAGE_LINE_REG,LCD_WIDTH);
+      write_reg(POINTER_REG,PICTURE_POINTER);
+      write_reg(SIZE_REG,PIXELS);
+
+      WAIT UNTIL rising_edge(s_clock);
+      s_clear <= '1';
+      WAIT UNTIL rising_edge(s_clock);
+      s_clear <= '0';
+      v_start := NOW;
+      avalon_bfm_write(s_clock,s_slave_address,s_slave_cs,s_slave_we,
+                       s_slave_write_data,s_slave_wait_request,CONTROL_REG,
+                       START_WITH_IRQ);
+      v_cycles := 0;
+      WHILE s_irq /= '1' AND v_cycles < TIMEOUT LOOP
+         WAIT UNTIL rising_edge(s_clock);
+         v_cycles := v_cycles + 1;
+      END LOOP;
+      check(s_irq = '1',"Timeout waiting for the end of transaction IRQ");
+      v_cycles := (NOW-v_start)/CLOCK_PERIOD;
+
+      check(s_beats*4 = PIXELS*2,
+            "Words read " & INTEGER'image(s_beats) & ", expected " &
+            INTEGER'image(PIXELS/2));
+      check(s_lcd_writes = PIXELS,
+            "Pixels written to the LCD " & INTEGER'image(s_lcd_writes) &
+            ", expected " & INTEGER'image(PIXELS));
+      avalon_bfm_report("lcd_dma",PIXELS,PIXELS*2,v_cycles,s_busy_cycles,
+                        CLOCK_PERIOD);
+      REPORT "lcd_dma: " & INTEGER'image(s_commands) & " bursts, " &
+             INTEGER'image(s_wait_cycles) & " wait cycles, max latency " &
+             INTEGER'image(s_max_latency) & " cycles" SEVERITY note;
+
+      ASSERT v_errors = 0
+         REPORT "lcd_dma_throughput_tb: " & INTEGER'image(v_errors) & " error(s)"
+         SEVERITY failure;
+      REPORT "lcd_dma_throughput_tb: done" SEVERITY note;
+      s_sim_end <= TRUE;
+      WAIT;
+   END PROCESS stimuli;
+
+END MSE;
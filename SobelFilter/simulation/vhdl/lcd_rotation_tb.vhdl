@@ -0,0 +1,367 @@
+--------------------------------------------------------------------------------
+--- Rotation testbench for the lcd_dma                                       ---
+---                                                                          ---
+--- Sends an IMAGE_WIDTH x IMAGE_HEIGHT picture in all eight orientations,   ---
+--- in RGB565 and in grayscale, from the avalon_bfm_slave memory model to    ---
+--- the LCD. The memory model returns the byte address of each word as data, ---
+--- so each pixel written to the LCD tells where it was read from. The       ---
+--- pixels are compared with a picture rotated in software. The picture      ---
+--- pointer is the first pixel sent, as computed by transfer_LCD_with_dma.   ---
+--- Note: the display reset after a core reset is shortened to              ---
+--- RECOVER_CYCLES, the testbench polls the busy flag before it starts.      ---
+--------------------------------------------------------------------------------
+LIBRARY ieee;
+USE ieee.std_logic_1164.all;
+USE ieee.numeric_std.all;
+USE work.avalon_bfm_pkg.all;
+
+ENTITY lcd_rotation_tb IS
+   GENERIC( MIN_WAIT     : INTEGER := 0;
+            MAX_WAIT     : INTEGER := 2;
+            READ_LATENCY : INTEGER := 3;
+            SEED         : INTEGER := 1);
+END lcd_rotation_tb;
+
+ARCHITECTURE MSE OF lcd_rotation_tb IS
+
+   CONSTANT CLOCK_PERIOD     : TIME := 20 ns; -- 50 MHz
+   CONSTANT IMAGE_WIDTH      : INTEGER := 16;
+   CONSTANT IMAGE_HEIGHT     : INTEGER := 12;
+   CONSTANT PIXELS           : INTEGER := IMAGE_WIDTH*IMAGE_HEIGHT;
+   CONSTANT PICTURE_POINTER  : INTEGER := 16#00100000#;
+   CONSTANT TIMEOUT          : INTEGER := 200*PIXELS; -- clock cycles
+   CONSTANT RECOVER_CYCLES   : INTEGER := 12000; -- 12000000 on the board
+   CONSTANT RESET_TIMEOUT    : INTEGER := RECOVER_CYCLES+100000; -- clock cycles
+   CONSTANT MAX_WRITES       : INTEGER := 16*PIXELS;
+
+   CONSTANT CONTROL_REG      : INTEGER := 2;
+   CONSTANT POINTER_REG      : INTEGER := 3;
+   CONSTANT SIZE_REG         : INTEGER := 4;
+   CONSTANT LCD_LINE_REG     : INTEGER := 5;
+   CONSTANT IMAGE_LINE_REG   : INTEGER := 6;
+   CONSTANT LCD_BUSY         : INTEGER := 1;
+   CONSTANT GRAYSCALE        : INTEGER := 16#010#;
+   CONSTANT IRQ_ENABLE       : INTEGER := 16#020#;
+   CONSTANT START_DMA        : INTEGER := 16#100#;
+   CONSTANT CLEAR_IRQ        : INTEGER := 16#200#;
+   CONSTANT ORIENTATION_LSB  : INTEGER := 16#400#;
+
+   TYPE LCD_DATA_TYPE IS ARRAY( 0 TO MAX_WRITES-1 ) OF
+                            std_logic_vector( 15 DOWNTO 0 );
+
+   COMPONENT lcd_dma IS
+      GENERIC( RECOVER_CYCLES            : INTEGER);
+      PORT ( Clock                       : IN  std_logic;
+             Reset                       : IN  std_logic;
+             slave_address               : IN  std_logic_vector( 2 DOWNTO 0 );
+             slave_cs                    : IN  std_logic;
+             slave_we                    : IN  std_logic;
+             slave_rd                    : IN  std_logic;
+             slave_write_data            : IN  std_logic_vector(31 DOWNTO 0 );
+             slave_read_data             : OUT std_logic_vector(31 DOWNTO 0 );
+             slave_wait_request          : OUT std_logic;
+             master_address              : OUT std_logic_vector(31 DOWNTO 0 );
+             master_read                 : OUT std_logic;
+             master_burst_count          : OUT std_logic_vector( 7 DOWNTO 0 );
+             master_read_data            : IN  std_logic_vector(31 DOWNTO 0 );
+             master_read_data_valid      : IN  std_logic;
+             master_wait_request         : IN  std_logic;
+             end_of_transaction_irq      : OUT std_logic;
+             ChipSelectBar               : OUT std_logic;
+             DataCommandBar              : OUT std_logic;
+             WriteBar                    : OUT std_logic;
+             ReadBar                     : OUT std_logic;
+             ResetBar                    : OUT std_logic;
+             IM0                         : OUT std_logic;
+             DataBus                     : INOUT std_logic_vector( 15 DOWNTO 0 ));
+   END COMPONENT;
+
+   SIGNAL s_sim_end              : BOOLEAN := FALSE;
+   SIGNAL s_clock                : std_logic := '0';
+   SIGNAL s_reset                : std_logic := '1';
+   SIGNAL s_clear                : std_logic := '0';
+   SIGNAL s_slave_address        : std_logic_vector(  2 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_slave_cs             : std_logic := '0';
+   SIGNAL s_slave_we             : std_logic := '0';
+   SIGNAL s_slave_rd             : std_logic := '0';
+   SIGNAL s_slave_write_data     : std_logic_vector( 31 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_slave_read_data      : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_slave_wait_request   : std_logic;
+   SIGNAL s_master_address       : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_master_read          : std_logic;
+   SIGNAL s_master_burst_count   : std_logic_vector(  7 DOWNTO 0 );
+   SIGNAL s_master_read_data     : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_master_read_data_valid : std_logic;
+   SIGNAL s_master_wait_request  : std_logic;
+   SIGNAL s_irq                  : std_logic;
+   SIGNAL s_write_bar            : std_logic;
+   SIGNAL s_data_command_bar     : std_logic;
+   SIGNAL s_lcd_data             : std_logic_vector( 15 DOWNTO 0 );
+   SIGNAL s_lcd_writes           : INTEGER := 0;
+   SIGNAL s_lcd_pixels           : LCD_DATA_TYPE;
+   SIGNAL s_commands             : INTEGER;
+   SIGNAL s_beats                : INTEGER;
+   SIGNAL s_wait_cycles          : INTEGER;
+   SIGNAL s_busy_cycles          : INTEGER;
+   SIGNAL s_max_latency          : INTEGER;
+
+   -- the byte address of the pixel sent as pixel x of LCD line y
+   FUNCTION pixel_address( orientation : INTEGER;
+                           gray        : BOOLEAN;
+                           x           : INTEGER;
+                           y           : INTEGER ) RETURN INTEGER IS
+      VARIABLE v_ix    : INTEGER;
+      VARIABLE v_iy    : INTEGER;
+      VARIABLE v_bytes : INTEGER := 2;
+   BEGIN
+      IF gray THEN
+         v_bytes := 1;
+      END IF;
+      IF (orientation MOD 2) = 1 THEN
+         -- transposed, each LCD line is an image column
+         v_iy := x;
+         v_ix := y;
+         IF ((orientation/2) MOD 2) = 1 THEN
+            v_iy := IMAGE_HEIGHT-1-x;
+         END IF;
+         IF orientation >= 4 THEN
+            v_ix := IMAGE_WIDTH-1-y;
+         END IF;
+      ELSE
+         v_ix := x;
+         v_iy := y;
+         IF ((orientation/2) MOD 2) = 1 THEN
+            v_ix := IMAGE_WIDTH-1-x;
+         END IF;
+         IF orientation >= 4 THEN
+            v_iy := IMAGE_HEIGHT-1-y;
+         END IF;
+      END IF;
+      RETURN PICTURE_POINTER+(v_iy*IMAGE_WIDTH+v_ix)*v_bytes;
+   END pixel_address;
+
+   -- the LCD data of a pixel, the memory model returns the word address
+   FUNCTION pixel_data( address : INTEGER;
+                        gray    : BOOLEAN ) RETURN std_logic_vector IS
+      VARIABLE v_word  : std_logic_vector( 31 DOWNTO 0 );
+      VARIABLE v_short : std_logic_vector( 15 DOWNTO 0 );
+      VARIABLE v_byte  : std_logic_vector(  7 DOWNTO 0 );
+   BEGIN
+      v_word := std_logic_vector(to_unsigned(address-(address MOD 4),32));
+      IF ((address/2) MOD 2) = 1 THEN
+         v_short := v_word(31 DOWNTO 16);
+      ELSE
+         v_short := v_word(15 DOWNTO  0);
+      END IF;
+      IF NOT gray THEN
+         RETURN v_short;
+      END IF;
+      IF (address MOD 2) = 1 THEN
+         v_byte := v_short(15 DOWNTO 8);
+      ELSE
+         v_byte := v_short( 7 DOWNTO 0);
+      END IF;
+      RETURN v_byte(7 DOWNTO 3)&v_byte(7 DOWNTO 2)&v_byte(7 DOWNTO 3);
+   END pixel_data;
+
+BEGIN
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the clock, the memory model and the LCD are defined      ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   make_clock : PROCESS
+   BEGIN
+      WHILE NOT s_sim_end LOOP
+         s_clock <= '0';
+         WAIT FOR CLOCK_PERIOD/2;
+         s_clock <= '1';
+         WAIT FOR CLOCK_PERIOD/2;
+      END LOOP;
+      WAIT;
+   END PROCESS make_clock;
+
+   memory : avalon_bfm_slave
+      GENERIC MAP ( BURST_WIDTH  => 8,
+                    MIN_WAIT     => MIN_WAIT,
+                    MAX_WAIT     => MAX_WAIT,
+                    READ_LATENCY => READ_LATENCY,
+                    SEED         => SEED)
+      PORT MAP ( Clock                 => s_clock,
+                 Reset                 => s_reset,
+                 Clear                 => s_clear,
+                 slave_address         => s_master_address,
+                 slave_read            => s_master_read,
+                 slave_write           => '0',
+                 slave_write_data      => (OTHERS => '0'),
+                 slave_burst_count     => s_master_burst_count,
+                 slave_read_data       => s_master_read_data,
+                 slave_read_data_valid => s_master_read_data_valid,
+                 slave_wait_request    => s_master_wait_request,
+                 Commands              => s_commands,
+                 Beats                 => s_beats,
+                 WaitCycles            => s_wait_cycles,
+                 BusyCycles            => s_busy_cycles,
+                 MaxLatency            => s_max_latency);
+
+   -- stores the pixels written to the display (the memory start command
+   -- is sent as command)
+   capture_lcd_writes : PROCESS( s_write_bar )
+   BEGIN
+      IF (rising_edge(s_write_bar) AND s_data_command_bar = '1') THEN
+         IF (s_lcd_writes < MAX_WRITES) THEN
+            s_lcd_pixels(s_lcd_writes) <= To_X01(s_lcd_data);
+         END IF;
+         s_lcd_writes <= s_lcd_writes + 1;
+      END IF;
+   END PROCESS capture_lcd_writes;
+
+   s_lcd_data <= (OTHERS => 'H');
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the device under test is instantiated                    ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   dut : lcd_dma
+      GENERIC MAP ( RECOVER_CYCLES => RECOVER_CYCLES)
+      PORT MAP ( Clock                  => s_clock,
+                 Reset                  => s_reset,
+                 slave_address          => s_slave_address,
+                 slave_cs               => s_slave_cs,
+                 slave_we               => s_slave_we,
+                 slave_rd               => s_slave_rd,
+                 slave_write_data       => s_slave_write_data,
+                 slave_read_data        => s_slave_read_data,
+                 slave_wait_request     => s_slave_wait_request,
+                 master_address         => s_master_address,
+                 master_read            => s_master_read,
+                 master_burst_count     => s_master_burst_count,
+                 master_read_data       => s_master_read_data,
+                 master_read_data_valid => s_master_read_data_valid,
+                 master_wait_request    => s_master_wait_request,
+                 end_of_transaction_irq => s_irq,
+                 ChipSelectBar          => OPEN,
+                 DataCommandBar         => s_data_command_bar,
+                 WriteBar               => s_write_bar,
+                 ReadBar                => OPEN,
+                 ResetBar               => OPEN,
+                 IM0                    => OPEN,
+                 DataBus                => s_lcd_data);
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the stimuli and the checks are defined                   ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   stimuli : PROCESS
+      VARIABLE v_errors   : INTEGER := 0;
+      VARIABLE v_data     : std_logic_vector( 31 DOWNTO 0 );
+      VARIABLE v_cycles   : INTEGER;
+      VARIABLE v_gray     : BOOLEAN;
+      VARIABLE v_mode     : INTEGER;
+      VARIABLE v_line     : INTEGER;
+      VARIABLE v_first    : INTEGER;
+      VARIABLE v_expected : std_logic_vector( 15 DOWNTO 0 );
+      VARIABLE v_bad      : INTEGER;
+
+      PROCEDURE write_reg( address : IN INTEGER;
+                           data    : IN INTEGER ) IS
+      BEGIN
+         avalon_bfm_write(s_clock,s_slave_address,s_slave_cs,s_slave_we,
+                          s_slave_write_data,s_slave_wait_request,address,
+                          std_logic_vector(to_unsigned(data,32)));
+      END write_reg;
+
+      PROCEDURE check( condition : IN BOOLEAN;
+                       message   : IN STRING ) IS
+      BEGIN
+         IF NOT condition THEN
+            REPORT message SEVERITY error;
+            v_errors := v_errors + 1;
+         END IF;
+      END check;
+
+   BEGIN
+      s_reset <= '1';
+      WAIT FOR 10*CLOCK_PERIOD;
+      s_reset <= '0';
+
+      -- the display reset sequence runs after the core reset
+      v_cycles := 0;
+      LOOP
+         avalon_bfm_read(s_clock,s_slave_address,s_slave_cs,s_slave_rd,
+                         s_slave_read_data,s_slave_wait_request,CONTROL_REG,
+                         0,v_data);
+         EXIT WHEN v_data(LCD_BUSY) = '0' OR v_cycles > RESET_TIMEOUT;
+         WAIT FOR 100*CLOCK_PERIOD;
+         v_cycles := v_cycles + 102;
+      END LOOP;
+      check(v_data(LCD_BUSY) = '0',"Timeout waiting for the display reset");
+
+      write_reg(CONTROL_REG,0);
+      write_reg(IMAGE_LINE_REG,IMAGE_WIDTH);
+      write_reg(SIZE_REG,PIXELS);
+
+      FOR gray IN 0 TO 1 LOOP
+         v_gray := gray = 1;
+         FOR orientation IN 0 TO 7 LOOP
+            IF (orientation MOD 2) = 1 THEN
+               v_line := IMAGE_HEIGHT;
+            ELSE
+               v_line := IMAGE_WIDTH;
+            END IF;
+            v_mode := IRQ_ENABLE+orientation*ORIENTATION_LSB;
+            IF v_gray THEN
+               v_mode := v_mode+GRAYSCALE;
+            END IF;
+            write_reg(CONTROL_REG,v_mode);
+            write_reg(LCD_LINE_REG,v_line);
+            write_reg(POINTER_REG,pixel_address(orientation,v_gray,0,0));
+            v_first := s_lcd_writes;
+            write_reg(CONTROL_REG,v_mode+START_DMA);
+            v_cycles := 0;
+            WHILE s_irq /= '1' AND v_cycles < TIMEOUT LOOP
+               WAIT UNTIL rising_edge(s_clock);
+               v_cycles := v_cycles + 1;
+            END LOOP;
+            check(s_irq = '1',"Timeout waiting for the end of transaction IRQ");
+            write_reg(CONTROL_REG,v_mode+CLEAR_IRQ);
+
+            check(s_lcd_writes-v_first = PIXELS,
+                  "Orientation " & INTEGER'image(orientation) & ": " &
+                  INTEGER'image(s_lcd_writes-v_first) &
+                  " pixels written to the LCD, expected " &
+                  INTEGER'image(PIXELS));
+            v_bad := 0;
+            FOR n IN 0 TO PIXELS-1 LOOP
+               v_expected := pixel_data(pixel_address(orientation,v_gray,
+                                                      n MOD v_line,
+                                                      n / v_line),v_gray);
+               IF (v_first+n < MAX_WRITES AND
+                   s_lcd_pixels(v_first+n) /= v_expected) THEN
+                  IF v_bad = 0 THEN
+                     check(FALSE,"Orientation " & INTEGER'image(orientation) &
+                                 " grayscale " & BOOLEAN'image(v_gray) &
+                                 ": pixel " & INTEGER'image(n) &
+                                 " is " & INTEGER'image(to_integer(
+                                          unsigned(s_lcd_pixels(v_first+n)))) &
+                                 ", expected " & INTEGER'image(to_integer(
+                                          unsigned(v_expected))));
+                  END IF;
+                  v_bad := v_bad + 1;
+               END IF;
+            END LOOP;
+            check(v_bad = 0,INTEGER'image(v_bad) & " wrong pixel(s)");
+         END LOOP;
+      END LOOP;
+
+      ASSERT v_errors = 0
+         REPORT "lcd_rotation_tb: " & INTEGER'image(v_errors) & " error(s)"
+         SEVERITY failure;
+      REPORT "lcd_rotation_tb: done" SEVERITY note;
+      s_sim_end <= TRUE;
+      WAIT;
+   END PROCESS stimuli;
+
+END MSE;
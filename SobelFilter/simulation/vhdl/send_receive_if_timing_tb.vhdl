@@ -0,0 +1,326 @@
+--------------------------------------------------------------------------------
+--- Write timing testbench for the SendReceiveInterface                      ---
+---                                                                          ---
+--- Sends WORDS words with each setting of the WriteTiming port (the first   ---
+--- setting selects the generics) and checks the LCD bus against the         ---
+--- ILI9341 8080-I write timing:                                             ---
+---    twc >= 66 ns, twrl >= 15 ns, twrh >= 15 ns,                           ---
+---    tdst >= 10 ns, tdht >= 10 ns (data and D/C)                           ---
+--- and the cycles of each phase against the setting. The next word is       ---
+--- started one cycle after busy is released, like the pixel_formatter does. ---
+--- The defaults are set by the generics, e.g.                               ---
+---    ./run_tb.sh send_receive_if_timing_tb -gWRITE_LOW_CYCLES=1            ---
+--------------------------------------------------------------------------------
+LIBRARY ieee;
+USE ieee.std_logic_1164.all;
+USE ieee.numeric_std.all;
+
+ENTITY send_receive_if_timing_tb IS
+   GENERIC( WRITE_SETUP_CYCLES : INTEGER := 1;
+            WRITE_LOW_CYCLES   : INTEGER := 2;
+            WRITE_HOLD_CYCLES  : INTEGER := 0;
+            WORDS              : INTEGER := 16);
+END send_receive_if_timing_tb;
+
+ARCHITECTURE MSE OF send_receive_if_timing_tb IS
+
+   CONSTANT CLOCK_PERIOD     : TIME := 20 ns; -- 50 MHz
+   CONSTANT TIMEOUT          : INTEGER := 1000; -- clock cycles
+   CONSTANT TWC_MIN          : TIME := 66 ns;
+   CONSTANT TWRL_MIN         : TIME := 15 ns;
+   CONSTANT TWRH_MIN         : TIME := 15 ns;
+   CONSTANT TDST_MIN         : TIME := 10 ns;
+   CONSTANT TDHT_MIN         : TIME := 10 ns;
+   CONSTANT FIRST_WORD       : INTEGER := 16#A5C3#;
+   CONSTANT WORD_STEP        : INTEGER := 16#0101#;
+
+   -- setup, low and hold cycles, 0/0/0 selects the generics
+   TYPE SETTING_TYPE IS ARRAY( 0 TO 2 ) OF INTEGER;
+   TYPE SETTINGS_TYPE IS ARRAY( NATURAL RANGE <> ) OF SETTING_TYPE;
+   CONSTANT SETTINGS : SETTINGS_TYPE := ( (0,0,0),
+                                          (1,1,0),
+                                          (1,1,1),
+                                          (1,2,1),
+                                          (2,3,2),
+                                          (4,4,4));
+
+   COMPONENT SendReceiveInterface IS
+      GENERIC( WRITE_SETUP_CYCLES   : INTEGER;
+               WRITE_LOW_CYCLES     : INTEGER;
+               WRITE_HOLD_CYCLES    : INTEGER;
+               RESET_CYCLES         : INTEGER;
+               RECOVER_CYCLES       : INTEGER);
+      PORT ( Clock                 : IN  std_logic;
+             Reset                 : IN  std_logic;
+             ResetDisplay          : IN  std_logic;
+             StartSendReceive      : IN  std_logic;
+             CommandBarData        : IN  std_logic;
+             EightBitSixteenBitBar : IN  std_logic;
+             WriteReadBar          : IN  std_logic;
+             DataToSend            : IN  std_logic_vector( 15 DOWNTO 0 );
+             WriteTiming           : IN  std_logic_vector( 11 DOWNTO 0 );
+             DataReceived          : OUT std_logic_vector( 15 DOWNTO 0 );
+             busy                  : OUT std_logic;
+             ChipSelectBar         : OUT std_logic;
+             DataCommandBar        : OUT std_logic;
+             WriteBar              : OUT std_logic;
+             ReadBar               : OUT std_logic;
+             ResetBar              : OUT std_logic;
+             IM0                   : OUT std_logic;
+             DataBus               : INOUT std_logic_vector( 15 DOWNTO 0 ));
+   END COMPONENT;
+
+   SIGNAL s_sim_end              : BOOLEAN := FALSE;
+   SIGNAL s_clock                : std_logic := '0';
+   SIGNAL s_reset                : std_logic := '1';
+   SIGNAL s_start                : std_logic := '0';
+   SIGNAL s_command_bar_data     : std_logic := '0';
+   SIGNAL s_data_to_send         : std_logic_vector( 15 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_write_timing         : std_logic_vector( 11 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_busy                 : std_logic;
+   SIGNAL s_chip_select_bar      : std_logic;
+   SIGNAL s_data_command_bar     : std_logic;
+   SIGNAL s_write_bar            : std_logic;
+   SIGNAL s_data_bus             : std_logic_vector( 15 DOWNTO 0 );
+
+   -- LCD bus monitor, cleared by a toggle of s_clear_stats
+   SIGNAL s_clear_stats          : BOOLEAN := FALSE;
+   SIGNAL s_writes               : INTEGER := 0;
+   SIGNAL s_data_errors          : INTEGER := 0;
+   SIGNAL s_min_low              : TIME := 1 ms;
+   SIGNAL s_max_low              : TIME := 0 ns;
+   SIGNAL s_min_high             : TIME := 1 ms;
+   SIGNAL s_min_cycle            : TIME := 1 ms;
+   SIGNAL s_max_cycle            : TIME := 0 ns;
+   SIGNAL s_min_setup            : TIME := 1 ms;
+   SIGNAL s_min_hold             : TIME := 1 ms;
+
+BEGIN
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the clock and the LCD bus monitor are defined            ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   make_clock : PROCESS
+   BEGIN
+      WHILE NOT s_sim_end LOOP
+         s_clock <= '0';
+         WAIT FOR CLOCK_PERIOD/2;
+         s_clock <= '1';
+         WAIT FOR CLOCK_PERIOD/2;
+      END LOOP;
+      WAIT;
+   END PROCESS make_clock;
+
+   -- the ILI9341 takes data and D/C with the rising edge of WriteBar, the
+   -- words of a setting are FIRST_WORD+n*WORD_STEP
+   lcd_monitor : PROCESS( s_write_bar , s_data_bus , s_data_command_bar ,
+                          s_clear_stats )
+      VARIABLE v_falling : TIME := 0 ns;
+      VARIABLE v_rising  : TIME := 0 ns;
+      VARIABLE v_changed : TIME := 0 ns;
+      VARIABLE v_held    : BOOLEAN := TRUE;
+   BEGIN
+      IF (s_clear_stats'event) THEN
+         s_writes      <= 0;
+         s_data_errors <= 0;
+         s_min_low     <= 1 ms;
+         s_max_low     <= 0 ns;
+         s_min_high    <= 1 ms;
+         s_min_cycle   <= 1 ms;
+         s_max_cycle   <= 0 ns;
+         s_min_setup   <= 1 ms;
+         s_min_hold    <= 1 ms;
+         v_falling     := 0 ns;
+         v_rising      := 0 ns;
+         v_held        := TRUE;
+      END IF;
+      IF (s_data_bus'event OR s_data_command_bar'event) THEN
+         v_changed := NOW;
+         IF NOT v_held THEN
+            IF (NOW-v_rising < s_min_hold) THEN
+               s_min_hold <= NOW-v_rising;
+            END IF;
+            v_held := TRUE;
+         END IF;
+      END IF;
+      IF (falling_edge(s_write_bar) AND s_chip_select_bar = '0') THEN
+         IF (v_falling /= 0 ns) THEN
+            IF (NOW-v_falling < s_min_cycle) THEN
+               s_min_cycle <= NOW-v_falling;
+            END IF;
+            IF (NOW-v_falling > s_max_cycle) THEN
+               s_max_cycle <= NOW-v_falling;
+            END IF;
+         END IF;
+         IF (v_rising /= 0 ns AND NOW-v_rising < s_min_high) THEN
+            s_min_high <= NOW-v_rising;
+         END IF;
+         v_falling := NOW;
+      END IF;
+      IF (rising_edge(s_write_bar) AND s_chip_select_bar = '0') THEN
+         IF (NOW-v_falling < s_min_low) THEN
+            s_min_low <= NOW-v_falling;
+         END IF;
+         IF (NOW-v_falling > s_max_low) THEN
+            s_max_low <= NOW-v_falling;
+         END IF;
+         IF (NOW-v_changed < s_min_setup) THEN
+            s_min_setup <= NOW-v_changed;
+         END IF;
+         IF (s_data_bus /= std_logic_vector(to_unsigned(FIRST_WORD+
+                                                        s_writes*WORD_STEP,16)) OR
+             s_data_command_bar /= '1') THEN
+            s_data_errors <= s_data_errors + 1;
+         END IF;
+         s_writes <= s_writes + 1;
+         v_rising := NOW;
+         v_held   := FALSE;
+      END IF;
+   END PROCESS lcd_monitor;
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the device under test is instantiated                    ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   dut : SendReceiveInterface
+      GENERIC MAP ( WRITE_SETUP_CYCLES => WRITE_SETUP_CYCLES,
+                    WRITE_LOW_CYCLES   => WRITE_LOW_CYCLES,
+                    WRITE_HOLD_CYCLES  => WRITE_HOLD_CYCLES,
+                    RESET_CYCLES       => 10,
+                    RECOVER_CYCLES     => 20)
+      PORT MAP ( Clock                 => s_clock,
+                 Reset                 => s_reset,
+                 ResetDisplay          => '0',
+                 StartSendReceive      => s_start,
+                 CommandBarData        => s_command_bar_data,
+                 EightBitSixteenBitBar => '0',
+                 WriteReadBar          => '1',
+                 DataToSend            => s_data_to_send,
+                 WriteTiming           => s_write_timing,
+                 DataReceived          => OPEN,
+                 busy                  => s_busy,
+                 ChipSelectBar         => s_chip_select_bar,
+                 DataCommandBar        => s_data_command_bar,
+                 WriteBar              => s_write_bar,
+                 ReadBar               => OPEN,
+                 ResetBar              => OPEN,
+                 IM0                   => OPEN,
+                 DataBus               => s_data_bus);
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the stimuli and the checks are defined                   ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   stimuli : PROCESS
+      VARIABLE v_errors : INTEGER := 0;
+      VARIABLE v_setup  : INTEGER;
+      VARIABLE v_low    : INTEGER;
+      VARIABLE v_hold   : INTEGER;
+      VARIABLE v_cycle  : TIME;
+
+      PROCEDURE check( condition : IN BOOLEAN;
+                       message   : IN STRING ) IS
+      BEGIN
+         IF NOT condition THEN
+            REPORT message SEVERITY error;
+            v_errors := v_errors + 1;
+         END IF;
+      END check;
+
+      -- waits until busy is released, the start follows one cycle later
+      PROCEDURE wait_not_busy IS
+         VARIABLE v_count : INTEGER := 0;
+      BEGIN
+         WAIT UNTIL rising_edge(s_clock);
+         WHILE s_busy /= '0' AND v_count < TIMEOUT LOOP
+            WAIT UNTIL rising_edge(s_clock);
+            v_count := v_count + 1;
+         END LOOP;
+         check(v_count < TIMEOUT,"Timeout waiting for the interface");
+      END wait_not_busy;
+
+      PROCEDURE send( data : IN INTEGER ) IS
+      BEGIN
+         wait_not_busy;
+         s_data_to_send     <= std_logic_vector(to_unsigned(data,16));
+         s_command_bar_data <= '1';
+         s_start            <= '1';
+         WAIT UNTIL rising_edge(s_clock);
+         s_start            <= '0';
+      END send;
+
+   BEGIN
+      s_reset <= '1';
+      WAIT FOR 10*CLOCK_PERIOD;
+      s_reset <= '0';
+
+      FOR n IN SETTINGS'range LOOP
+         v_setup := SETTINGS(n)(0);
+         v_low   := SETTINGS(n)(1);
+         v_hold  := SETTINGS(n)(2);
+         s_write_timing <= std_logic_vector(to_unsigned(v_hold,4))&
+                           std_logic_vector(to_unsigned(v_low,4))&
+                           std_logic_vector(to_unsigned(v_setup,4));
+         IF (v_setup = 0) THEN
+            v_setup := WRITE_SETUP_CYCLES;
+            v_low   := WRITE_LOW_CYCLES;
+            v_hold  := WRITE_HOLD_CYCLES;
+         END IF;
+         wait_not_busy;
+         s_clear_stats <= NOT s_clear_stats;
+         FOR w IN 0 TO WORDS-1 LOOP
+            send(FIRST_WORD+w*WORD_STEP);
+         END LOOP;
+         wait_not_busy;
+         WAIT FOR 4*CLOCK_PERIOD;
+
+         -- the cycle of a word: setup+low+hold plus the cycle to take the
+         -- next start (the first word is not measured)
+         v_cycle := (v_setup+v_low+v_hold+2)*CLOCK_PERIOD;
+         REPORT "setup " & INTEGER'image(v_setup) & ", low " &
+                INTEGER'image(v_low) & ", hold " & INTEGER'image(v_hold) &
+                ": write cycle " & TIME'image(s_min_cycle) & ", " &
+                INTEGER'image(1 sec/s_min_cycle) & " words/s" SEVERITY note;
+         check(s_writes = WORDS,
+               "Words written " & INTEGER'image(s_writes) & ", expected " &
+               INTEGER'image(WORDS));
+         check(s_data_errors = 0,
+               INTEGER'image(s_data_errors) & " wrong word(s) on the LCD bus");
+         check(s_min_low = v_low*CLOCK_PERIOD AND s_max_low = s_min_low,
+               "WriteBar low " & TIME'image(s_min_low) & " .. " &
+               TIME'image(s_max_low) & ", expected " &
+               TIME'image(v_low*CLOCK_PERIOD));
+         check(s_min_cycle = v_cycle AND s_max_cycle = v_cycle,
+               "Write cycle " & TIME'image(s_min_cycle) & " .. " &
+               TIME'image(s_max_cycle) & ", expected " & TIME'image(v_cycle));
+         check(s_min_setup = (v_setup+v_low+1)*CLOCK_PERIOD,
+               "Data setup " & TIME'image(s_min_setup) & ", expected " &
+               TIME'image((v_setup+v_low+1)*CLOCK_PERIOD));
+         check(s_min_hold >= (v_hold+1)*CLOCK_PERIOD,
+               "Data hold " & TIME'image(s_min_hold) & ", expected " &
+               TIME'image((v_hold+1)*CLOCK_PERIOD));
+         -- the ILI9341 limits
+         check(s_min_cycle >= TWC_MIN,
+               "twc " & TIME'image(s_min_cycle) & " < " & TIME'image(TWC_MIN));
+         check(s_min_low >= TWRL_MIN,
+               "twrl " & TIME'image(s_min_low) & " < " & TIME'image(TWRL_MIN));
+         check(s_min_high >= TWRH_MIN,
+               "twrh " & TIME'image(s_min_high) & " < " & TIME'image(TWRH_MIN));
+         check(s_min_setup >= TDST_MIN,
+               "tdst " & TIME'image(s_min_setup) & " < " & TIME'image(TDST_MIN));
+         check(s_min_hold >= TDHT_MIN,
+               "tdht " & TIME'image(s_min_hold) & " < " & TIME'image(TDHT_MIN));
+      END LOOP;
+
+      ASSERT v_errors = 0
+         REPORT "send_receive_if_timing_tb: " & INTEGER'image(v_errors) & " error(s)"
+         SEVERITY failure;
+      REPORT "send_receive_if_timing_tb: done" SEVERITY note;
+      s_sim_end <= TRUE;
+      WAIT;
+   END PROCESS stimuli;
+
+END MSE;
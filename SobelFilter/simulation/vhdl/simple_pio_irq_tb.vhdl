@@ -0,0 +1,236 @@
+--------------------------------------------------------------------------------
+--- Testbench for the edge capture interrupt of the SimplePIO of 2_vhdl      ---
+---                                                                          ---
+--- Toggles the input pins and checks that:                                  ---
+---  - rising and falling edges of input pins set their capture bit          ---
+---  - output pins (direction bit set) never capture                         ---
+---  - the IRQ follows the capture bits masked by the IRQ enable register    ---
+---  - writing ones to the capture register clears only these bits           ---
+---  - the IRQ is raised at most IRQ_LATENCY cycles after the pin changed    ---
+--------------------------------------------------------------------------------
+LIBRARY ieee;
+USE ieee.std_logic_1164.all;
+USE ieee.numeric_std.all;
+USE work.avalon_bfm_pkg.all;
+
+ENTITY simple_pio_irq_tb IS
+END simple_pio_irq_tb;
+
+ARCHITECTURE MSE OF simple_pio_irq_tb IS
+
+   CONSTANT CLOCK_PERIOD     : TIME := 20 ns; -- 50 MHz
+   CONSTANT IRQ_LATENCY      : INTEGER := 4;  -- 2 synchronizer + edge + capture
+   CONSTANT TIMEOUT          : INTEGER := 100; -- clock cycles
+
+   -- SimplePIO registers
+   CONSTANT DIR_REG          : INTEGER := 0;
+   CONSTANT PIN_REG          : INTEGER := 1;
+   CONSTANT PORT_REG         : INTEGER := 2;
+   CONSTANT IRQ_ENABLE_REG   : INTEGER := 5;
+   CONSTANT EDGE_REG         : INTEGER := 6;
+   CONSTANT READ_WAIT        : INTEGER := 1;
+
+   COMPONENT SimplePIO IS
+      PORT ( Clk_CI                    : IN    std_logic;
+             Reset_RLI                 : IN    std_logic;
+             Address_DI                : IN    std_logic_vector( 2 DOWNTO 0 );
+             ChipSelect_SI             : IN    std_logic;
+             Read_SI                   : IN    std_logic;
+             Write_SI                  : IN    std_logic;
+             ReadData_DO               : OUT   std_logic_vector( 7 DOWNTO 0 );
+             WriteData_DI              : IN    std_logic_vector( 7 DOWNTO 0 );
+             Irq_SO                    : OUT   std_logic;
+             ParPort_DIO               : INOUT std_logic_vector( 7 DOWNTO 0 ));
+   END COMPONENT;
+
+   SIGNAL s_sim_end              : BOOLEAN := FALSE;
+   SIGNAL s_clock                : std_logic := '0';
+   SIGNAL s_reset_n              : std_logic := '0';
+   SIGNAL s_no_wait              : std_logic := '0';
+   SIGNAL s_address              : std_logic_vector( 2 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_cs                   : std_logic := '0';
+   SIGNAL s_rd                   : std_logic := '0';
+   SIGNAL s_we                   : std_logic := '0';
+   SIGNAL s_read_data            : std_logic_vector( 7 DOWNTO 0 );
+   SIGNAL s_write_data           : std_logic_vector( 7 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_irq                  : std_logic;
+   SIGNAL s_port                 : std_logic_vector( 7 DOWNTO 0 );
+   SIGNAL s_pins                 : std_logic_vector( 7 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_drive                : std_logic_vector( 7 DOWNTO 0 ) := (OTHERS => '1');
+
+BEGIN
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the clock and the pins are defined                       ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   make_clock : PROCESS
+   BEGIN
+      WHILE NOT s_sim_end LOOP
+         s_clock <= '0';
+         WAIT FOR CLOCK_PERIOD/2;
+         s_clock <= '1';
+         WAIT FOR CLOCK_PERIOD/2;
+      END LOOP;
+      WAIT;
+   END PROCESS make_clock;
+
+   -- the testbench drives the pins that are not driven by the SimplePIO
+   make_pins : PROCESS( s_pins , s_drive )
+   BEGIN
+      FOR n IN 0 TO 7 LOOP
+         IF s_drive(n) = '1' THEN
+            s_port(n) <= s_pins(n);
+         ELSE
+            s_port(n) <= 'Z';
+         END IF;
+      END LOOP;
+   END PROCESS make_pins;
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the device under test is instantiated                    ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   dut : SimplePIO
+      PORT MAP ( Clk_CI        => s_clock,
+                 Reset_RLI     => s_reset_n,
+                 Address_DI    => s_address,
+                 ChipSelect_SI => s_cs,
+                 Read_SI       => s_rd,
+                 Write_SI      => s_we,
+                 ReadData_DO   => s_read_data,
+                 WriteData_DI  => s_write_data,
+                 Irq_SO        => s_irq,
+                 ParPort_DIO   => s_port);
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the stimuli are defined                                  ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   stimuli : PROCESS
+      VARIABLE v_errors : INTEGER := 0;
+      VARIABLE v_data   : std_logic_vector( 7 DOWNTO 0 );
+      VARIABLE v_cycles : INTEGER;
+
+      PROCEDURE check( condition : IN BOOLEAN;
+                       message   : IN STRING ) IS
+      BEGIN
+         IF NOT condition THEN
+            REPORT message SEVERITY error;
+            v_errors := v_errors + 1;
+         END IF;
+      END check;
+
+      PROCEDURE write_reg( reg_address : IN INTEGER;
+                           data        : IN std_logic_vector ) IS
+      BEGIN
+         avalon_bfm_write(s_clock,s_address,s_cs,s_we,s_write_data,s_no_wait,
+                          reg_address,data);
+      END write_reg;
+
+      PROCEDURE check_reg( reg_address : IN INTEGER;
+                           expected    : IN std_logic_vector( 7 DOWNTO 0 );
+                           message     : IN STRING ) IS
+      BEGIN
+         avalon_bfm_read(s_clock,s_address,s_cs,s_rd,s_read_data,s_no_wait,
+                         reg_address,READ_WAIT,v_data);
+         check(v_data = expected,
+               message & ": read " & INTEGER'image(to_integer(unsigned(v_data))) &
+               ", expected " & INTEGER'image(to_integer(unsigned(expected))));
+      END check_reg;
+
+      -- changes the pins and counts the cycles until the IRQ is raised
+      PROCEDURE toggle_and_wait( pins : IN std_logic_vector( 7 DOWNTO 0 ) ) IS
+      BEGIN
+         WAIT UNTIL rising_edge(s_clock);
+         s_pins   <= pins;
+         v_cycles := 0;
+         WHILE s_irq /= '1' AND v_cycles < TIMEOUT LOOP
+            WAIT UNTIL rising_edge(s_clock);
+            v_cycles := v_cycles + 1;
+         END LOOP;
+         check(v_cycles <= IRQ_LATENCY,
+               "IRQ raised after " & INTEGER'image(v_cycles) &
+               " cycles, expected at most " & INTEGER'image(IRQ_LATENCY));
+      END toggle_and_wait;
+
+      PROCEDURE idle( cycles : IN INTEGER ) IS
+      BEGIN
+         FOR n IN 1 TO cycles LOOP
+            WAIT UNTIL rising_edge(s_clock);
+         END LOOP;
+      END idle;
+
+   BEGIN
+      s_reset_n <= '0';
+      WAIT FOR 10*CLOCK_PERIOD;
+      s_reset_n <= '1';
+      idle(IRQ_LATENCY);
+
+      -- after reset all pins are inputs, nothing is captured
+      check_reg(IRQ_ENABLE_REG,X"00","IRQ enable after reset");
+      check_reg(EDGE_REG,X"00","Edge capture after reset");
+      check(s_irq = '0',"IRQ active after reset");
+
+      -- edges are captured with the IRQ disabled, but do not raise it
+      s_pins <= X"01";
+      idle(IRQ_LATENCY);
+      check(s_irq = '0',"IRQ raised while disabled");
+      check_reg(EDGE_REG,X"01","Rising edge of pin 0");
+      check_reg(PIN_REG,X"01","Pin register");
+      write_reg(EDGE_REG,X"FF");
+      check_reg(EDGE_REG,X"00","Edge capture after clear");
+
+      -- enabling an already captured edge raises the IRQ at once
+      s_pins <= X"00";
+      idle(IRQ_LATENCY);
+      check_reg(EDGE_REG,X"01","Falling edge of pin 0");
+      write_reg(IRQ_ENABLE_REG,X"03");
+      check_reg(IRQ_ENABLE_REG,X"03","IRQ enable");
+      check(s_irq = '1',"IRQ not raised for a captured enabled edge");
+      write_reg(EDGE_REG,X"01");
+      idle(1);
+      check(s_irq = '0',"IRQ still active after clear");
+
+      -- latency of an enabled edge
+      toggle_and_wait(X"02");
+      check_reg(EDGE_REG,X"02","Rising edge of pin 1");
+
+      -- an edge of a disabled pin is captured, the clear keeps the others
+      s_pins <= X"06";
+      idle(IRQ_LATENCY);
+      check_reg(EDGE_REG,X"06","Edges of pin 1 and pin 2");
+      write_reg(EDGE_REG,X"02");
+      idle(1);
+      check(s_irq = '0',"IRQ active for a disabled pin");
+      check_reg(EDGE_REG,X"04","Edge of pin 2 cleared with pin 1");
+      write_reg(EDGE_REG,X"04");
+
+      -- the pins of the output nibble are written by the SimplePIO
+      s_drive <= X"0F";
+      write_reg(DIR_REG,X"F0");
+      write_reg(PORT_REG,X"A0");
+      idle(IRQ_LATENCY);
+      write_reg(IRQ_ENABLE_REG,X"FF");
+      check(s_irq = '0',"IRQ raised by an output pin");
+      check_reg(EDGE_REG,X"00","Output pins captured");
+      check_reg(PIN_REG,X"A6","Pins with output nibble");
+
+      -- an input pin still raises the IRQ in the same time
+      toggle_and_wait(X"0E");
+      check_reg(EDGE_REG,X"08","Rising edge of pin 3");
+      write_reg(EDGE_REG,X"FF");
+      idle(1);
+      check(s_irq = '0',"IRQ still active after clear all");
+
+      ASSERT v_errors = 0
+         REPORT "simple_pio_irq_tb: " & INTEGER'image(v_errors) & " error(s)"
+         SEVERITY failure;
+      REPORT "simple_pio_irq_tb: done" SEVERITY note;
+      s_sim_end <= TRUE;
+      WAIT;
+   END PROCESS stimuli;
+
+END MSE;
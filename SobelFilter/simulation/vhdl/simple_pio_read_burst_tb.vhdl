@@ -0,0 +1,269 @@
+--------------------------------------------------------------------------------
+--- Read throughput testbench for the SimplePIO variants of 2_vhdl           ---
+---                                                                          ---
+--- Both variants are set up with the same register values and then read    ---
+--- READS times, cycling through the readable registers:                    ---
+---  - SimplePIO (oneWait): each read is held for its wait state, as the     ---
+---    fabric does for readWaitTime 1                                        ---
+---  - SimplePIOPipelined: a read is issued in every cycle, the data is      ---
+---    taken with readdatavalid                                              ---
+--- The data of every read is checked, the cycles per read and the read     ---
+--- throughput of both are reported, e.g.                                    ---
+---    ./run_tb.sh simple_pio_read_burst_tb -gREADS=256                      ---
+--------------------------------------------------------------------------------
+LIBRARY ieee;
+USE ieee.std_logic_1164.all;
+USE ieee.numeric_std.all;
+USE work.avalon_bfm_pkg.all;
+
+ENTITY simple_pio_read_burst_tb IS
+   GENERIC( READS : INTEGER := 64 );
+END simple_pio_read_burst_tb;
+
+ARCHITECTURE MSE OF simple_pio_read_burst_tb IS
+
+   CONSTANT CLOCK_PERIOD     : TIME := 20 ns; -- 50 MHz
+   CONSTANT TIMEOUT          : INTEGER := 10; -- clock cycles after the last read
+
+   -- SimplePIO registers and the values set up by the testbench
+   CONSTANT DIR_REG          : INTEGER := 0;
+   CONSTANT PORT_REG         : INTEGER := 2;
+   CONSTANT IRQ_ENABLE_REG   : INTEGER := 5;
+   CONSTANT EDGE_REG         : INTEGER := 6;
+   CONSTANT DIRECTION        : std_logic_vector( 7 DOWNTO 0 ) := X"0F";
+   CONSTANT PORT_VALUE       : std_logic_vector( 7 DOWNTO 0 ) := X"05";
+   CONSTANT IRQ_ENABLE       : std_logic_vector( 7 DOWNTO 0 ) := X"A0";
+   CONSTANT PIN_VALUE        : std_logic_vector( 7 DOWNTO 0 ) := X"30";
+
+   TYPE reg_list_t IS ARRAY( NATURAL RANGE <> ) OF INTEGER;
+   TYPE data_list_t IS ARRAY( NATURAL RANGE <> ) OF std_logic_vector( 7 DOWNTO 0 );
+   CONSTANT REG_LIST         : reg_list_t( 0 TO 4 ) := ( 0 , 1 , 2 , 5 , 6 );
+   CONSTANT DATA_LIST        : data_list_t( 0 TO 4 ) :=
+      ( DIRECTION , PIN_VALUE OR PORT_VALUE , PORT_VALUE , IRQ_ENABLE , X"00" );
+
+   COMPONENT SimplePIO IS
+      PORT ( Clk_CI                    : IN    std_logic;
+             Reset_RLI                 : IN    std_logic;
+             Address_DI                : IN    std_logic_vector( 2 DOWNTO 0 );
+             ChipSelect_SI             : IN    std_logic;
+             Read_SI                   : IN    std_logic;
+             Write_SI                  : IN    std_logic;
+             ReadData_DO               : OUT   std_logic_vector( 7 DOWNTO 0 );
+             WriteData_DI              : IN    std_logic_vector( 7 DOWNTO 0 );
+             Irq_SO                    : OUT   std_logic;
+             ParPort_DIO               : INOUT std_logic_vector( 7 DOWNTO 0 ));
+   END COMPONENT;
+
+   COMPONENT SimplePIOPipelined IS
+      PORT ( Clk_CI                    : IN    std_logic;
+             Reset_RLI                 : IN    std_logic;
+             Address_DI                : IN    std_logic_vector( 2 DOWNTO 0 );
+             ChipSelect_SI             : IN    std_logic;
+             Read_SI                   : IN    std_logic;
+             Write_SI                  : IN    std_logic;
+             ReadData_DO               : OUT   std_logic_vector( 7 DOWNTO 0 );
+             ReadDataValid_SO          : OUT   std_logic;
+             WriteData_DI              : IN    std_logic_vector( 7 DOWNTO 0 );
+             Irq_SO                    : OUT   std_logic;
+             ParPort_DIO               : INOUT std_logic_vector( 7 DOWNTO 0 ));
+   END COMPONENT;
+
+   SIGNAL s_sim_end              : BOOLEAN := FALSE;
+   SIGNAL s_clock                : std_logic := '0';
+   SIGNAL s_reset_n              : std_logic := '0';
+   SIGNAL s_no_wait              : std_logic := '0';
+   SIGNAL s_address              : std_logic_vector( 2 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_write_data           : std_logic_vector( 7 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_we                   : std_logic := '0';
+   SIGNAL s_cs                   : std_logic := '0';
+   SIGNAL s_wait_cs              : std_logic := '0';
+   SIGNAL s_wait_rd              : std_logic := '0';
+   SIGNAL s_pipe_cs              : std_logic := '0';
+   SIGNAL s_pipe_rd              : std_logic := '0';
+   SIGNAL s_wait_read_data       : std_logic_vector( 7 DOWNTO 0 );
+   SIGNAL s_pipe_read_data       : std_logic_vector( 7 DOWNTO 0 );
+   SIGNAL s_pipe_valid           : std_logic;
+   SIGNAL s_wait_port            : std_logic_vector( 7 DOWNTO 0 );
+   SIGNAL s_pipe_port            : std_logic_vector( 7 DOWNTO 0 );
+   SIGNAL s_pins                 : std_logic_vector( 7 DOWNTO 0 );
+
+BEGIN
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the clock and the pins are defined                       ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   make_clock : PROCESS
+   BEGIN
+      WHILE NOT s_sim_end LOOP
+         s_clock <= '0';
+         WAIT FOR CLOCK_PERIOD/2;
+         s_clock <= '1';
+         WAIT FOR CLOCK_PERIOD/2;
+      END LOOP;
+      WAIT;
+   END PROCESS make_clock;
+
+   -- the upper nibble are inputs driven by the testbench
+   s_pins      <= PIN_VALUE(7 DOWNTO 4)&"ZZZZ";
+   s_wait_port <= s_pins;
+   s_pipe_port <= s_pins;
+
+   -- the setup writes go to both, the reads are separate
+   s_wait_cs <= s_cs OR s_wait_rd;
+   s_pipe_cs <= s_cs OR s_pipe_rd;
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the devices under test are instantiated                  ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   dut_wait : SimplePIO
+      PORT MAP ( Clk_CI        => s_clock,
+                 Reset_RLI     => s_reset_n,
+                 Address_DI    => s_address,
+                 ChipSelect_SI => s_wait_cs,
+                 Read_SI       => s_wait_rd,
+                 Write_SI      => s_we,
+                 ReadData_DO   => s_wait_read_data,
+                 WriteData_DI  => s_write_data,
+                 Irq_SO        => OPEN,
+                 ParPort_DIO   => s_wait_port);
+
+   dut_pipe : SimplePIOPipelined
+      PORT MAP ( Clk_CI           => s_clock,
+                 Reset_RLI        => s_reset_n,
+                 Address_DI       => s_address,
+                 ChipSelect_SI    => s_pipe_cs,
+                 Read_SI          => s_pipe_rd,
+                 Write_SI         => s_we,
+                 ReadData_DO      => s_pipe_read_data,
+                 ReadDataValid_SO => s_pipe_valid,
+                 WriteData_DI     => s_write_data,
+                 Irq_SO           => OPEN,
+                 ParPort_DIO      => s_pipe_port);
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the stimuli and the measurement are defined              ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   stimuli : PROCESS
+      VARIABLE v_errors      : INTEGER := 0;
+      VARIABLE v_index       : INTEGER;
+      VARIABLE v_valid       : INTEGER;
+      VARIABLE v_count       : INTEGER;
+      VARIABLE v_wait_cycles : INTEGER;
+      VARIABLE v_pipe_cycles : INTEGER;
+
+      PROCEDURE check( condition : IN BOOLEAN;
+                       message   : IN STRING ) IS
+      BEGIN
+         IF NOT condition THEN
+            REPORT message SEVERITY error;
+            v_errors := v_errors + 1;
+         END IF;
+      END check;
+
+      PROCEDURE check_data( name  : IN STRING;
+                            index : IN INTEGER;
+                            data  : IN std_logic_vector( 7 DOWNTO 0 ) ) IS
+         VARIABLE v_expected : std_logic_vector( 7 DOWNTO 0 );
+      BEGIN
+         v_expected := DATA_LIST(index MOD REG_LIST'length);
+         check(data = v_expected,
+               name & " read " & INTEGER'image(index) & " of register " &
+               INTEGER'image(REG_LIST(index MOD REG_LIST'length)) & " is " &
+               INTEGER'image(to_integer(unsigned(data))) & ", expected " &
+               INTEGER'image(to_integer(unsigned(v_expected))));
+      END check_data;
+
+      PROCEDURE write_reg( reg_address : IN INTEGER;
+                           data        : IN std_logic_vector ) IS
+      BEGIN
+         avalon_bfm_write(s_clock,s_address,s_cs,s_we,s_write_data,s_no_wait,
+                          reg_address,data);
+      END write_reg;
+
+   BEGIN
+      s_reset_n <= '0';
+      WAIT FOR 10*CLOCK_PERIOD;
+      s_reset_n <= '1';
+
+      write_reg(DIR_REG,DIRECTION);
+      write_reg(PORT_REG,PORT_VALUE);
+      write_reg(IRQ_ENABLE_REG,IRQ_ENABLE);
+      -- the inputs left reset with their value, clear the captured edges
+      FOR n IN 1 TO 4 LOOP
+         WAIT UNTIL rising_edge(s_clock);
+      END LOOP;
+      write_reg(EDGE_REG,X"FF");
+
+      -- oneWait: the read is held for two cycles, the data is taken at the
+      -- end of the second one
+      WAIT UNTIL rising_edge(s_clock);
+      v_wait_cycles := 0;
+      FOR n IN 0 TO READS-1 LOOP
+         s_address <= std_logic_vector(to_unsigned(
+                         REG_LIST(n MOD REG_LIST'length),s_address'length));
+         s_wait_rd <= '1';
+         WAIT UNTIL rising_edge(s_clock);
+         WAIT UNTIL rising_edge(s_clock);
+         v_wait_cycles := v_wait_cycles + 2;
+         check_data("oneWait",n,s_wait_read_data);
+      END LOOP;
+      s_wait_rd <= '0';
+
+      -- pipelined: a read is issued in every cycle, the data is taken in
+      -- every cycle with readdatavalid
+      WAIT UNTIL rising_edge(s_clock);
+      v_pipe_cycles := 0;
+      v_index       := 0;
+      v_valid       := 0;
+      v_count       := 0;
+      WHILE v_valid < READS AND v_count < TIMEOUT LOOP
+         IF v_index < READS THEN
+            s_address <= std_logic_vector(to_unsigned(
+                            REG_LIST(v_index MOD REG_LIST'length),s_address'length));
+            s_pipe_rd <= '1';
+            v_index   := v_index + 1;
+         ELSE
+            s_pipe_rd <= '0';
+            v_count   := v_count + 1;
+         END IF;
+         WAIT UNTIL rising_edge(s_clock);
+         v_pipe_cycles := v_pipe_cycles + 1;
+         IF s_pipe_valid = '1' THEN
+            check_data("pipelined",v_valid,s_pipe_read_data);
+            v_valid := v_valid + 1;
+         END IF;
+      END LOOP;
+      s_pipe_rd <= '0';
+      check(v_valid = READS,
+            "pipelined: " & INTEGER'image(v_valid) & " of " &
+            INTEGER'image(READS) & " reads returned data");
+      check(v_pipe_cycles <= READS+1,
+            "pipelined: " & INTEGER'image(READS) & " reads took " &
+            INTEGER'image(v_pipe_cycles) & " cycles, expected " &
+            INTEGER'image(READS+1));
+
+      avalon_bfm_report("SimplePIO oneWait",READS,READS,v_wait_cycles,
+                        v_wait_cycles,CLOCK_PERIOD);
+      avalon_bfm_report("SimplePIO pipelined",READS,READS,v_pipe_cycles,
+                        v_pipe_cycles,CLOCK_PERIOD);
+      REPORT "simple_pio_read_burst_tb: " & INTEGER'image(READS) &
+             " reads, oneWait " & INTEGER'image(v_wait_cycles) &
+             " cycles, pipelined " & INTEGER'image(v_pipe_cycles) &
+             " cycles, speedup " &
+             avalon_bfm_fixed(REAL(v_wait_cycles)/REAL(v_pipe_cycles))
+         SEVERITY note;
+
+      ASSERT v_errors = 0
+         REPORT "simple_pio_read_burst_tb: " & INTEGER'image(v_errors) & " error(s)"
+         SEVERITY failure;
+      REPORT "simple_pio_read_burst_tb: done" SEVERITY note;
+      s_sim_end <= TRUE;
+      WAIT;
+   END PROCESS stimuli;
+
+END MSE;
@@ -0,0 +1,306 @@
+--------------------------------------------------------------------------------
+--- Testbench for the page flip of the vga_dma                               ---
+---                                                                          ---
+--- Checks that a memory pointer written while a frame is scanned out is     ---
+--- only used from the start of the next frame on, that the flip done IRQ    ---
+--- is raised at this frame boundary, and that the last pointer written      ---
+--- before the frame boundary wins.                                          ---
+--------------------------------------------------------------------------------
+LIBRARY ieee;
+USE ieee.std_logic_1164.all;
+USE ieee.numeric_std.all;
+
+ENTITY vga_dma_flip_tb IS
+END vga_dma_flip_tb;
+
+ARCHITECTURE MSE OF vga_dma_flip_tb IS
+
+   CONSTANT CLOCK_PERIOD       : TIME := 20 ns; -- 50 MHz
+   CONSTANT PIXEL_CLOCK_PERIOD : TIME := 15 ns; -- ~65 MHz, 1024x768@60
+   CONSTANT FRAME_TIMEOUT      : INTEGER := 2000000; -- clock cycles
+   CONSTANT FRAME_SPAN         : unsigned( 31 DOWNTO 0 ) := X"00200000";
+
+   CONSTANT POINTER_1          : unsigned( 31 DOWNTO 0 ) := X"00100000";
+   CONSTANT POINTER_2          : unsigned( 31 DOWNTO 0 ) := X"00400000";
+   CONSTANT POINTER_3          : unsigned( 31 DOWNTO 0 ) := X"00700000";
+   CONSTANT POINTER_4          : unsigned( 31 DOWNTO 0 ) := X"00A00000";
+
+   CONSTANT IRQ_ENABLE         : std_logic_vector( 31 DOWNTO 0 ) := X"00000020";
+   CONSTANT IRQ_CLEAR          : std_logic_vector( 31 DOWNTO 0 ) := X"00000040";
+
+   COMPONENT vga_dma IS
+      PORT ( Clock                       : IN  std_logic;
+             PixelClock                  : IN  std_logic;
+             Reset                       : IN  std_logic;
+             slave_address               : IN  std_logic;
+             slave_cs                    : IN  std_logic;
+             slave_we                    : IN  std_logic;
+             slave_rd                    : IN  std_logic;
+             slave_write_data            : IN  std_logic_vector(31 DOWNTO 0 );
+             slave_read_data             : OUT std_logic_vector(31 DOWNTO 0 );
+             master_address              : OUT std_logic_vector( 31 DOWNTO 0 );
+             master_read                 : OUT std_logic;
+             master_burstcount           : OUT std_logic_vector(  9 DOWNTO 0 );
+             master_waitrequest          : IN  std_logic;
+             master_data_valid           : IN  std_logic;
+             master_read_data            : IN  std_logic_vector( 31 DOWNTO 0 );
+             flip_done_irq               : OUT std_logic;
+             red                         : OUT std_logic_vector( 9 DOWNTO 0 );
+             green                       : OUT std_logic_vector( 9 DOWNTO 0 );
+             blue                        : OUT std_logic_vector( 9 DOWNTO 0 );
+             hsync                       : OUT std_logic;
+             vsync                       : OUT std_logic);
+   END COMPONENT;
+
+   SIGNAL s_sim_end          : BOOLEAN := FALSE;
+   SIGNAL s_clock            : std_logic := '0';
+   SIGNAL s_pixel_clock      : std_logic := '0';
+   SIGNAL s_reset            : std_logic := '1';
+   SIGNAL s_slave_address    : std_logic := '0';
+   SIGNAL s_slave_cs         : std_logic := '0';
+   SIGNAL s_slave_we         : std_logic := '0';
+   SIGNAL s_slave_rd         : std_logic := '0';
+   SIGNAL s_slave_write_data : std_logic_vector( 31 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_slave_read_data  : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_master_address   : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_master_read      : std_logic;
+   SIGNAL s_master_burstcount: std_logic_vector(  9 DOWNTO 0 );
+   SIGNAL s_master_data_valid: std_logic := '0';
+   SIGNAL s_master_read_data : std_logic_vector( 31 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_irq              : std_logic;
+   SIGNAL s_hsync            : std_logic;
+   SIGNAL s_vsync            : std_logic;
+
+BEGIN
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the clocks and the memory model are defined             ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   make_clock : PROCESS
+   BEGIN
+      WHILE NOT s_sim_end LOOP
+         s_clock <= '0';
+         WAIT FOR CLOCK_PERIOD/2;
+         s_clock <= '1';
+         WAIT FOR CLOCK_PERIOD/2;
+      END LOOP;
+      WAIT;
+   END PROCESS make_clock;
+
+   make_pixel_clock : PROCESS
+   BEGIN
+      WHILE NOT s_sim_end LOOP
+         s_pixel_clock <= '0';
+         WAIT FOR PIXEL_CLOCK_PERIOD/2;
+         s_pixel_clock <= '1';
+         WAIT FOR PIXEL_CLOCK_PERIOD/2;
+      END LOOP;
+      WAIT;
+   END PROCESS make_pixel_clock;
+
+   -- zero wait state memory, the read data is the byte address
+   memory : PROCESS( s_clock )
+      VARIABLE v_words   : INTEGER := 0;
+      VARIABLE v_address : unsigned( 31 DOWNTO 0 ) := (OTHERS => '0');
+   BEGIN
+      IF (rising_edge(s_clock)) THEN
+         IF (s_master_read = '1') THEN
+            v_words   := to_integer(unsigned(s_master_burstcount));
+            v_address := unsigned(s_master_address);
+         END IF;
+         IF (v_words > 0) THEN
+            s_master_data_valid <= '1';
+            s_master_read_data  <= std_logic_vector(v_address);
+            v_address           := v_address + 4;
+            v_words             := v_words - 1;
+                          ELSE
+            s_master_data_valid <= '0';
+         END IF;
+      END IF;
+   END PROCESS memory;
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the device under test is instantiated                    ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   dut : vga_dma
+      PORT MAP ( Clock              => s_clock,
+                 PixelClock         => s_pixel_clock,
+                 Reset              => s_reset,
+                 slave_address      => s_slave_address,
+                 slave_cs           => s_slave_cs,
+                 slave_we           => s_slave_we,
+                 slave_rd           => s_slave_rd,
+                 slave_write_data   => s_slave_write_data,
+                 slave_read_data    => s_slave_read_data,
+                 master_address     => s_master_address,
+                 master_read        => s_master_read,
+                 master_burstcount  => s_master_burstcount,
+                 master_waitrequest => '0',
+                 master_data_valid  => s_master_data_valid,
+                 master_read_data   => s_master_read_data,
+                 flip_done_irq      => s_irq,
+                 red                => OPEN,
+                 green              => OPEN,
+                 blue               => OPEN,
+                 hsync              => s_hsync,
+                 vsync              => s_vsync);
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the stimuli and checks are defined                       ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   stimuli : PROCESS
+      VARIABLE v_errors : INTEGER := 0;
+      VARIABLE v_data   : std_logic_vector( 31 DOWNTO 0 );
+
+      PROCEDURE slave_write( address : IN std_logic;
+                             data    : IN std_logic_vector( 31 DOWNTO 0 ) ) IS
+      BEGIN
+         WAIT UNTIL rising_edge(s_clock);
+         s_slave_address    <= address;
+         s_slave_write_data <= data;
+         s_slave_cs         <= '1';
+         s_slave_we         <= '1';
+         WAIT UNTIL rising_edge(s_clock);
+         s_slave_cs         <= '0';
+         s_slave_we         <= '0';
+      END slave_write;
+
+      -- one wait state, the read data is registered
+      PROCEDURE slave_read( address : IN  std_logic;
+                            data    : OUT std_logic_vector( 31 DOWNTO 0 ) ) IS
+      BEGIN
+         WAIT UNTIL rising_edge(s_clock);
+         s_slave_address <= address;
+         s_slave_cs      <= '1';
+         s_slave_rd      <= '1';
+         WAIT UNTIL rising_edge(s_clock);
+         WAIT UNTIL rising_edge(s_clock);
+         data            := s_slave_read_data;
+         s_slave_cs      <= '0';
+         s_slave_rd      <= '0';
+      END slave_read;
+
+      PROCEDURE check( condition : IN BOOLEAN;
+                       message   : IN STRING ) IS
+      BEGIN
+         IF NOT condition THEN
+            REPORT message SEVERITY error;
+            v_errors := v_errors + 1;
+         END IF;
+      END check;
+
+      -- Waits for the given number of line bursts of the current frame
+      PROCEDURE wait_bursts( count : IN INTEGER ) IS
+         VARIABLE v_count : INTEGER := 0;
+      BEGIN
+         WHILE v_count < count LOOP
+            WAIT UNTIL rising_edge(s_clock);
+            IF (s_master_read = '1') THEN v_count := v_count + 1;
+            END IF;
+         END LOOP;
+      END wait_bursts;
+
+      -- Waits for the flip done IRQ (or the flip pending bit to drop if the
+      -- IRQ is disabled). All bursts until then must read from the old
+      -- buffer, a vertical sync must be seen before the flip, and the first
+      -- burst afterwards must start at the new buffer.
+      PROCEDURE wait_flip( old_pointer : IN unsigned( 31 DOWNTO 0 );
+                           new_pointer : IN unsigned( 31 DOWNTO 0 );
+                           use_irq     : IN BOOLEAN ) IS
+         VARIABLE v_cycles     : INTEGER := 0;
+         VARIABLE v_vsync_seen : BOOLEAN := FALSE;
+         VARIABLE v_done       : BOOLEAN := FALSE;
+         VARIABLE v_address    : unsigned( 31 DOWNTO 0 );
+      BEGIN
+         WHILE NOT v_done AND v_cycles < FRAME_TIMEOUT LOOP
+            WAIT UNTIL rising_edge(s_clock);
+            v_cycles := v_cycles + 1;
+            IF (s_vsync = '1') THEN v_vsync_seen := TRUE;
+            END IF;
+            IF (s_master_read = '1') THEN
+               v_address := unsigned(s_master_address);
+               check(v_address >= old_pointer AND
+                     v_address < old_pointer + FRAME_SPAN,
+                     "New pointer used before the frame boundary");
+            END IF;
+            IF (use_irq) THEN v_done := s_irq = '1';
+                         ELSE v_done := s_vsync = '1';
+            END IF;
+         END LOOP;
+         check(v_cycles < FRAME_TIMEOUT,"Timeout waiting for the flip");
+         IF (use_irq) THEN
+            check(v_vsync_seen,"Flip done IRQ outside the vertical blanking");
+         END IF;
+         WHILE s_master_read /= '1' AND v_cycles < FRAME_TIMEOUT LOOP
+            WAIT UNTIL rising_edge(s_clock);
+            v_cycles := v_cycles + 1;
+         END LOOP;
+         check(unsigned(s_master_address) = new_pointer,
+               "First burst of the frame does not start at the new pointer");
+      END wait_flip;
+
+   BEGIN
+      s_reset <= '1';
+      WAIT FOR 10*CLOCK_PERIOD;
+      s_reset <= '0';
+
+      REPORT "Test 1: first pointer starts the core and flips" SEVERITY note;
+      slave_write('1',IRQ_ENABLE);
+      slave_write('0',std_logic_vector(POINTER_1));
+      slave_read('1',v_data);
+      check(v_data(7) = '1',"Flip pending bit not set after pointer write");
+      check(s_irq = '0',"IRQ raised before the frame boundary");
+      wait_flip(POINTER_1,POINTER_1,TRUE);
+      slave_read('0',v_data);
+      check(unsigned(v_data) = POINTER_1,"Displayed pointer is not pointer 1");
+      slave_read('1',v_data);
+      check(v_data(7 DOWNTO 5) = "011","Status not IRQ pending after flip");
+      slave_write('1',IRQ_ENABLE OR IRQ_CLEAR);
+      WAIT UNTIL rising_edge(s_clock);
+      check(s_irq = '0',"IRQ not cleared");
+
+      REPORT "Test 2: pointer written mid frame is latched at vblank" SEVERITY note;
+      wait_bursts(100);
+      slave_write('0',std_logic_vector(POINTER_2));
+      slave_read('0',v_data);
+      check(unsigned(v_data) = POINTER_1,"Displayed pointer changed mid frame");
+      wait_flip(POINTER_1,POINTER_2,TRUE);
+      slave_read('0',v_data);
+      check(unsigned(v_data) = POINTER_2,"Displayed pointer is not pointer 2");
+      slave_write('1',IRQ_ENABLE OR IRQ_CLEAR);
+
+      REPORT "Test 3: last pointer before vblank wins, one IRQ" SEVERITY note;
+      wait_bursts(200);
+      slave_write('0',std_logic_vector(POINTER_3));
+      wait_bursts(200);
+      check(s_irq = '0',"IRQ raised mid frame");
+      slave_write('0',std_logic_vector(POINTER_4));
+      wait_flip(POINTER_2,POINTER_4,TRUE);
+      slave_write('1',IRQ_ENABLE OR IRQ_CLEAR);
+      wait_bursts(300);
+      check(s_irq = '0',"Second IRQ without a new pointer");
+      slave_read('0',v_data);
+      check(unsigned(v_data) = POINTER_4,"Displayed pointer is not pointer 4");
+
+      REPORT "Test 4: flip without IRQ enabled" SEVERITY note;
+      slave_write('1',IRQ_CLEAR);
+      slave_write('0',std_logic_vector(POINTER_1));
+      wait_flip(POINTER_4,POINTER_1,FALSE);
+      slave_read('1',v_data);
+      check(v_data(7 DOWNTO 5) = "000","IRQ or flip pending with IRQ disabled");
+      check(s_irq = '0',"IRQ raised while disabled");
+
+      ASSERT v_errors = 0
+         REPORT "vga_dma_flip_tb: " & INTEGER'image(v_errors) & " error(s)"
+         SEVERITY failure;
+      REPORT "vga_dma_flip_tb: all tests passed" SEVERITY note;
+      s_sim_end <= TRUE;
+      WAIT;
+   END PROCESS stimuli;
+
+END MSE;
@@ -0,0 +1,240 @@
+--------------------------------------------------------------------------------
+--- Throughput testbench for the vga_dma                                     ---
+---                                                                          ---
+--- The vga_dma scans out a 1024x768 RGB565 frame from the avalon_bfm_slave  ---
+--- memory model. Between two vertical syncs the cycles per pixel and the    ---
+--- throughput are reported. The line buffer is reloaded once each line, a   ---
+--- burst that takes longer than a line is reported as underrun. The memory  ---
+--- timing is set by the generics, e.g.                                      ---
+---    ./run_tb.sh vga_dma_throughput_tb -gMAX_WAIT=8 -gREAD_LATENCY=6       ---
+--------------------------------------------------------------------------------
+LIBRARY ieee;
+USE ieee.std_logic_1164.all;
+USE ieee.numeric_std.all;
+USE work.avalon_bfm_pkg.all;
+
+ENTITY vga_dma_throughput_tb IS
+   GENERIC( MIN_WAIT     : INTEGER := 0;
+            MAX_WAIT     : INTEGER := 2;
+            READ_LATENCY : INTEGER := 3;
+            SEED         : INTEGER := 1);
+END vga_dma_throughput_tb;
+
+ARCHITECTURE MSE OF vga_dma_throughput_tb IS
+
+   CONSTANT CLOCK_PERIOD       : TIME := 20 ns; -- 50 MHz
+   CONSTANT PIXEL_CLOCK_PERIOD : TIME := 15 ns; -- ~65 MHz, 1024x768@60
+   CONSTANT PIXELS             : INTEGER := 1024*768;
+   CONSTANT LINE_TIME          : TIME := 1344*PIXEL_CLOCK_PERIOD;
+   CONSTANT FRAME_TIMEOUT      : INTEGER := 2000000; -- clock cycles
+   CONSTANT FRAME_POINTER      : std_logic_vector( 31 DOWNTO 0 ) := X"00100000";
+
+   CONSTANT POINTER_REG        : INTEGER := 0;
+   CONSTANT CONTROL_REG        : INTEGER := 1;
+
+   COMPONENT vga_dma IS
+      PORT ( Clock                       : IN  std_logic;
+             PixelClock                  : IN  std_logic;
+             Reset                       : IN  std_logic;
+             slave_address               : IN  std_logic;
+             slave_cs                    : IN  std_logic;
+             slave_we                    : IN  std_logic;
+             slave_rd                    : IN  std_logic;
+             slave_write_data            : IN  std_logic_vector(31 DOWNTO 0 );
+             slave_read_data             : OUT std_logic_vector(31 DOWNTO 0 );
+             master_address              : OUT std_logic_vector( 31 DOWNTO 0 );
+             master_read                 : OUT std_logic;
+             master_burstcount           : OUT std_logic_vector(  9 DOWNTO 0 );
+             master_waitrequest          : IN  std_logic;
+             master_data_valid           : IN  std_logic;
+             master_read_data            : IN  std_logic_vector( 31 DOWNTO 0 );
+             flip_done_irq               : OUT std_logic;
+             red                         : OUT std_logic_vector( 9 DOWNTO 0 );
+             green                       : OUT std_logic_vector( 9 DOWNTO 0 );
+             blue                        : OUT std_logic_vector( 9 DOWNTO 0 );
+             hsync                       : OUT std_logic;
+             vsync                       : OUT std_logic);
+   END COMPONENT;
+
+   SIGNAL s_sim_end              : BOOLEAN := FALSE;
+   SIGNAL s_clock                : std_logic := '0';
+   SIGNAL s_pixel_clock          : std_logic := '0';
+   SIGNAL s_reset                : std_logic := '1';
+   SIGNAL s_clear                : std_logic := '0';
+   SIGNAL s_no_wait              : std_logic := '0';
+   SIGNAL s_slave_address        : std_logic_vector(  0 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_slave_cs             : std_logic := '0';
+   SIGNAL s_slave_we             : std_logic := '0';
+   SIGNAL s_slave_rd             : std_logic := '0';
+   SIGNAL s_slave_write_data     : std_logic_vector( 31 DOWNTO 0 ) := (OTHERS => '0');
+   SIGNAL s_slave_read_data      : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_master_address       : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_master_read          : std_logic;
+   SIGNAL s_master_burstcount    : std_logic_vector(  9 DOWNTO 0 );
+   SIGNAL s_master_waitrequest   : std_logic;
+   SIGNAL s_master_data_valid    : std_logic;
+   SIGNAL s_master_read_data     : std_logic_vector( 31 DOWNTO 0 );
+   SIGNAL s_vsync                : std_logic;
+   SIGNAL s_commands             : INTEGER;
+   SIGNAL s_beats                : INTEGER;
+   SIGNAL s_wait_cycles          : INTEGER;
+   SIGNAL s_busy_cycles          : INTEGER;
+   SIGNAL s_max_latency          : INTEGER;
+
+BEGIN
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the clocks and the memory model are defined              ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   make_clock : PROCESS
+   BEGIN
+      WHILE NOT s_sim_end LOOP
+         s_clock <= '0';
+         WAIT FOR CLOCK_PERIOD/2;
+         s_clock <= '1';
+         WAIT FOR CLOCK_PERIOD/2;
+      END LOOP;
+      WAIT;
+   END PROCESS make_clock;
+
+   make_pixel_clock : PROCESS
+   BEGIN
+      WHILE NOT s_sim_end LOOP
+         s_pixel_clock <= '0';
+         WAIT FOR PIXEL_CLOCK_PERIOD/2;
+         s_pixel_clock <= '1';
+         WAIT FOR PIXEL_CLOCK_PERIOD/2;
+      END LOOP;
+      WAIT;
+   END PROCESS make_pixel_clock;
+
+   memory : avalon_bfm_slave
+      GENERIC MAP ( BURST_WIDTH  => 10,
+                    MIN_WAIT     => MIN_WAIT,
+                    MAX_WAIT     => MAX_WAIT,
+                    READ_LATENCY => READ_LATENCY,
+                    SEED         => SEED)
+      PORT MAP ( Clock                 => s_clock,
+                 Reset                 => s_reset,
+                 Clear                 => s_clear,
+                 slave_address         => s_master_address,
+                 slave_read            => s_master_read,
+                 slave_write           => '0',
+                 slave_write_data      => (OTHERS => '0'),
+                 slave_burst_count     => s_master_burstcount,
+                 slave_read_data       => s_master_read_data,
+                 slave_read_data_valid => s_master_data_valid,
+                 slave_wait_request    => s_master_waitrequest,
+                 Commands              => s_commands,
+                 Beats                 => s_beats,
+                 WaitCycles            => s_wait_cycles,
+                 BusyCycles            => s_busy_cycles,
+                 MaxLatency            => s_max_latency);
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the device under test is instantiated                    ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   dut : vga_dma
+      PORT MAP ( Clock              => s_clock,
+                 PixelClock         => s_pixel_clock,
+                 Reset              => s_reset,
+                 slave_address      => s_slave_address(0),
+                 slave_cs           => s_slave_cs,
+                 slave_we           => s_slave_we,
+                 slave_rd           => s_slave_rd,
+                 slave_write_data   => s_slave_write_data,
+                 slave_read_data    => s_slave_read_data,
+                 master_address     => s_master_address,
+                 master_read        => s_master_read,
+                 master_burstcount  => s_master_burstcount,
+                 master_waitrequest => s_master_waitrequest,
+                 master_data_valid  => s_master_data_valid,
+                 master_read_data   => s_master_read_data,
+                 flip_done_irq      => OPEN,
+                 red                => OPEN,
+                 green              => OPEN,
+                 blue               => OPEN,
+                 hsync              => OPEN,
+                 vsync              => s_vsync);
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the stimuli and the measurement are defined              ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   stimuli : PROCESS
+      VARIABLE v_errors      : INTEGER := 0;
+      VARIABLE v_cycles      : INTEGER;
+      VARIABLE v_line_cycles : INTEGER := LINE_TIME/CLOCK_PERIOD;
+      VARIABLE v_start       : TIME;
+
+      PROCEDURE check( condition : IN BOOLEAN;
+                       message   : IN STRING ) IS
+      BEGIN
+         IF NOT condition THEN
+            REPORT message SEVERITY error;
+            v_errors := v_errors + 1;
+         END IF;
+      END check;
+
+      PROCEDURE wait_vsync IS
+         VARIABLE v_count : INTEGER := 0;
+      BEGIN
+         WHILE s_vsync /= '0' AND v_count < FRAME_TIMEOUT LOOP
+            WAIT UNTIL rising_edge(s_clock);
+            v_count := v_count + 1;
+         END LOOP;
+         WHILE s_vsync /= '1' AND v_count < FRAME_TIMEOUT LOOP
+            WAIT UNTIL rising_edge(s_clock);
+            v_count := v_count + 1;
+         END LOOP;
+         check(v_count < FRAME_TIMEOUT,"Timeout waiting for the vertical sync");
+      END wait_vsync;
+
+   BEGIN
+      s_reset <= '1';
+      WAIT FOR 10*CLOCK_PERIOD;
+      s_reset <= '0';
+
+      -- writing the pointer starts the core
+      avalon_bfm_write(s_clock,s_slave_address,s_slave_cs,s_slave_we,
+                       s_slave_write_data,s_no_wait,CONTROL_REG,X"00000000");
+      avalon_bfm_write(s_clock,s_slave_address,s_slave_cs,s_slave_we,
+                       s_slave_write_data,s_no_wait,POINTER_REG,FRAME_POINTER);
+
+      -- the first frame may start with the old pointer, measure the second
+      wait_vsync;
+      wait_vsync;
+      s_clear  <= '1';
+      WAIT UNTIL rising_edge(s_clock);
+      s_clear  <= '0';
+      v_start  := NOW;
+      wait_vsync;
+      v_cycles := (NOW-v_start)/CLOCK_PERIOD;
+
+      check(s_beats*4 >= PIXELS*2,
+            "Words read " & INTEGER'image(s_beats) & ", expected at least " &
+            INTEGER'image(PIXELS/2));
+      check(s_max_latency < v_line_cycles,
+            "Line buffer underrun, a burst took " &
+            INTEGER'image(s_max_latency) & " of " &
+            INTEGER'image(v_line_cycles) & " cycles of a line");
+      avalon_bfm_report("vga_dma",PIXELS,PIXELS*2,v_cycles,s_busy_cycles,
+                        CLOCK_PERIOD);
+      REPORT "vga_dma: " & INTEGER'image(s_commands) & " bursts, " &
+             INTEGER'image(s_wait_cycles) & " wait cycles, max latency " &
+             INTEGER'image(s_max_latency) & " of " &
+             INTEGER'image(v_line_cycles) & " cycles each line" SEVERITY note;
+
+      ASSERT v_errors = 0
+         REPORT "vga_dma_throughput_tb: " & INTEGER'image(v_errors) & " error(s)"
+         SEVERITY failure;
+      REPORT "vga_dma_throughput_tb: done" SEVERITY note;
+      s_sim_end <= TRUE;
+      WAIT;
+   END PROCESS stimuli;
+
+END MSE;
@@ -0,0 +1,262 @@
+ARCHITECTURE MSE OF bus_monitor IS
+
+   CONSTANT NR_OF_CHANNELS : INTEGER := 4;
+
+   TYPE COUNTER_TYPE IS ARRAY( NR_OF_CHANNELS-1 DOWNTO 0 ) OF
+                        std_logic_vector( 31 DOWNTO 0 );
+   TYPE BURST_TYPE IS ARRAY( NR_OF_CHANNELS-1 DOWNTO 0 ) OF
+                      std_logic_vector(  9 DOWNTO 0 );
+
+   COMPONENT bus_monitor_channel IS
+      PORT ( Clock                  : IN  std_logic;
+             Reset                  : IN  std_logic;
+             Enable                 : IN  std_logic;
+             Clear                  : IN  std_logic;
+             slave_address          : IN  std_logic_vector( 23 DOWNTO 0 );
+             slave_read             : IN  std_logic;
+             slave_write            : IN  std_logic;
+             slave_write_data       : IN  std_logic_vector( 31 DOWNTO 0 );
+             slave_byte_enable      : IN  std_logic_vector(  3 DOWNTO 0 );
+             slave_burst_count      : IN  std_logic_vector(  9 DOWNTO 0 );
+             slave_read_data        : OUT std_logic_vector( 31 DOWNTO 0 );
+             slave_read_data_valid  : OUT std_logic;
+             slave_wait_request     : OUT std_logic;
+             master_address         : OUT std_logic_vector( 23 DOWNTO 0 );
+             master_read            : OUT std_logic;
+             master_write           : OUT std_logic;
+             master_write_data      : OUT std_logic_vector( 31 DOWNTO 0 );
+             master_byte_enable     : OUT std_logic_vector(  3 DOWNTO 0 );
+             master_burst_count     : OUT std_logic_vector(  9 DOWNTO 0 );
+             master_read_data       : IN  std_logic_vector( 31 DOWNTO 0 );
+             master_read_data_valid : IN  std_logic;
+             master_wait_request    : IN  std_logic;
+             Transfers              : OUT std_logic_vector( 31 DOWNTO 0 );
+             Bytes                  : OUT std_logic_vector( 31 DOWNTO 0 );
+             WaitCycles             : OUT std_logic_vector( 31 DOWNTO 0 );
+             MaxBurst               : OUT std_logic_vector(  9 DOWNTO 0 ));
+   END COMPONENT;
+
+   SIGNAL s_we_control         : std_logic;
+   SIGNAL s_we_window          : std_logic;
+   SIGNAL s_start              : std_logic;
+   SIGNAL s_stop               : std_logic;
+   SIGNAL s_running_reg        : std_logic;
+   SIGNAL s_window_reg         : unsigned( 31 DOWNTO 0 );
+   SIGNAL s_elapsed_reg        : unsigned( 31 DOWNTO 0 );
+   SIGNAL s_window_end         : std_logic;
+   SIGNAL s_transfers          : COUNTER_TYPE;
+   SIGNAL s_bytes              : COUNTER_TYPE;
+   SIGNAL s_wait_cycles        : COUNTER_TYPE;
+   SIGNAL s_max_burst          : BURST_TYPE;
+
+BEGIN
+     -------- register model -----------
+     -- 0 Write     : bit 0 -> start a new window, all counters are cleared
+     --               bit 1 -> stop the current window
+     --   Read      : bit 0 -> window running
+     -- 1 Write/Read: Window length in clock cycles, 0 counts until stopped
+     -- 2 Read      : Clock cycles elapsed in the current window
+     -- 3 Read      : Number of channels
+     -- 4+4*n Read  : Channel n accepted commands (a burst counts once)
+     -- 5+4*n Read  : Channel n bytes transferred (4 for each data beat)
+     -- 6+4*n Read  : Channel n cycles a command was stalled by waitrequest
+     -- 7+4*n Read  : Channel n longest burst in words
+     -- Channel 0 : cam_dma, 1 : lcd_dma, 2 : vga_dma, 3 : cpu
+   
+   s_we_control <= '1' WHEN slave_address = "00000" AND
+                            slave_cs = '1' AND
+                            slave_we = '1' ELSE '0';
+   s_we_window  <= '1' WHEN slave_address = "00001" AND
+                            slave_cs = '1' AND
+                            slave_we = '1' ELSE '0';
+   s_start      <= s_we_control AND slave_write_data(0);
+   s_stop       <= s_we_control AND slave_write_data(1);
+
+   make_read_data : PROCESS( Clock )
+      VARIABLE v_channel : INTEGER RANGE 0 TO 6;
+      VARIABLE v_counter : std_logic_vector( 1 DOWNTO 0 );
+   BEGIN
+      IF (rising_edge(Clock)) THEN
+         CASE slave_address IS
+            WHEN "00000" => slave_read_data <= X"0000000"&"000"&s_running_reg;
+            WHEN "00001" => slave_read_data <= std_logic_vector(s_window_reg);
+            WHEN "00010" => slave_read_data <= std_logic_vector(s_elapsed_reg);
+            WHEN "00011" => slave_read_data <=
+                               std_logic_vector(to_unsigned(NR_OF_CHANNELS,32));
+            WHEN OTHERS  =>
+               v_channel := to_integer(unsigned(slave_address(4 DOWNTO 2)))-1;
+               v_counter := slave_address(1 DOWNTO 0);
+               IF (v_channel < NR_OF_CHANNELS) THEN
+                  CASE v_counter IS
+                     WHEN "00"   => slave_read_data <= s_transfers(v_channel);
+                     WHEN "01"   => slave_read_data <= s_bytes(v_channel);
+                     WHEN "10"   => slave_read_data <= s_wait_cycles(v_channel);
+                     WHEN OTHERS => slave_read_data <= X"00000"&"00"&
+                                                       s_max_burst(v_channel);
+                  END CASE;
+                                               ELSE
+                  slave_read_data <= (OTHERS => '0');
+               END IF;
+         END CASE;
+      END IF;
+   END PROCESS make_read_data;
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the measurement window is defined                        ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   s_window_end <= '1' WHEN s_window_reg /= 0 AND
+                            s_elapsed_reg = s_window_reg-1 ELSE '0';
+
+   make_window_reg : PROCESS( Clock )
+   BEGIN
+      IF (rising_edge(Clock)) THEN
+         IF (Reset = '1') THEN s_window_reg <= (OTHERS => '0');
+         ELSIF (s_we_window = '1') THEN
+            s_window_reg <= unsigned(slave_write_data);
+         END IF;
+      END IF;
+   END PROCESS make_window_reg;
+   
+   make_running_reg : PROCESS( Clock )
+   BEGIN
+      IF (rising_edge(Clock)) THEN
+         IF (Reset = '1') THEN s_running_reg <= '0';
+         ELSIF (s_start = '1') THEN s_running_reg <= '1';
+         ELSIF (s_stop = '1' OR
+                (s_running_reg = '1' AND
+                 s_window_end = '1')) THEN s_running_reg <= '0';
+         END IF;
+      END IF;
+   END PROCESS make_running_reg;
+   
+   make_elapsed_reg : PROCESS( Clock )
+   BEGIN
+      IF (rising_edge(Clock)) THEN
+         IF (Reset = '1' OR s_start = '1') THEN
+            s_elapsed_reg <= (OTHERS => '0');
+         ELSIF (s_running_reg = '1') THEN
+            s_elapsed_reg <= s_elapsed_reg + 1;
+         END IF;
+      END IF;
+   END PROCESS make_elapsed_reg;
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the channels are instantiated                            ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   channel0 : bus_monitor_channel
+      PORT MAP ( Clock                  => Clock,
+                 Reset                  => Reset,
+                 Enable                 => s_running_reg,
+                 Clear                  => s_start,
+                 slave_address          => s0_address,
+                 slave_read             => s0_read,
+                 slave_write            => s0_write,
+                 slave_write_data       => s0_write_data,
+                 slave_byte_enable      => s0_byte_enable,
+                 slave_burst_count      => s0_burst_count,
+                 slave_read_data        => s0_read_data,
+                 slave_read_data_valid  => s0_read_data_valid,
+                 slave_wait_request     => s0_wait_request,
+                 master_address         => m0_address,
+                 master_read            => m0_read,
+                 master_write           => m0_write,
+                 master_write_data      => m0_write_data,
+                 master_byte_enable     => m0_byte_enable,
+                 master_burst_count     => m0_burst_count,
+                 master_read_data       => m0_read_data,
+                 master_read_data_valid => m0_read_data_valid,
+                 master_wait_request    => m0_wait_request,
+                 Transfers              => s_transfers(0),
+                 Bytes                  => s_bytes(0),
+                 WaitCycles             => s_wait_cycles(0),
+                 MaxBurst               => s_max_burst(0));
+   
+   channel1 : bus_monitor_channel
+      PORT MAP ( Clock                  => Clock,
+                 Reset                  => Reset,
+                 Enable                 => s_running_reg,
+                 Clear                  => s_start,
+                 slave_address          => s1_address,
+                 slave_read             => s1_read,
+                 slave_write            => s1_write,
+                 slave_write_data       => s1_write_data,
+                 slave_byte_enable      => s1_byte_enable,
+                 slave_burst_count      => s1_burst_count,
+                 slave_read_data        => s1_read_data,
+                 slave_read_data_valid  => s1_read_data_valid,
+                 slave_wait_request     => s1_wait_request,
+                 master_address         => m1_address,
+                 master_read            => m1_read,
+                 master_write           => m1_write,
+                 master_write_data      => m1_write_data,
+                 master_byte_enable     => m1_byte_enable,
+                 master_burst_count     => m1_burst_count,
+                 master_read_data       => m1_read_data,
+                 master_read_data_valid => m1_read_data_valid,
+                 master_wait_request    => m1_wait_request,
+                 Transfers              => s_transfers(1),
+                 Bytes                  => s_bytes(1),
+                 WaitCycles             => s_wait_cycles(1),
+                 MaxBurst               => s_max_burst(1));
+   
+   channel2 : bus_monitor_channel
+      PORT MAP ( Clock                  => Clock,
+                 Reset                  => Reset,
+                 Enable                 => s_running_reg,
+                 Clear                  => s_start,
+                 slave_address          => s2_address,
+                 slave_read             => s2_read,
+                 slave_write            => s2_write,
+                 slave_write_data       => s2_write_data,
+                 slave_byte_enable      => s2_byte_enable,
+                 slave_burst_count      => s2_burst_count,
+                 slave_read_data        => s2_read_data,
+                 slave_read_data_valid  => s2_read_data_valid,
+                 slave_wait_request     => s2_wait_request,
+                 master_address         => m2_address,
+                 master_read            => m2_read,
+                 master_write           => m2_write,
+                 master_write_data      => m2_write_data,
+                 master_byte_enable     => m2_byte_enable,
+                 master_burst_count     => m2_burst_count,
+                 master_read_data       => m2_read_data,
+                 master_read_data_valid => m2_read_data_valid,
+                 master_wait_request    => m2_wait_request,
+                 Transfers              => s_transfers(2),
+                 Bytes                  => s_bytes(2),
+                 WaitCycles             => s_wait_cycles(2),
+                 MaxBurst               => s_max_burst(2));
+   
+   channel3 : bus_monitor_channel
+      PORT MAP ( Clock                  => Clock,
+                 Reset                  => Reset,
+                 Enable                 => s_running_reg,
+                 Clear                  => s_start,
+                 slave_address          => s3_address,
+                 slave_read             => s3_read,
+                 slave_write            => s3_write,
+                 slave_write_data       => s3_write_data,
+                 slave_byte_enable      => s3_byte_enable,
+                 slave_burst_count      => s3_burst_count,
+                 slave_read_data        => s3_read_data,
+                 slave_read_data_valid  => s3_read_data_valid,
+                 slave_wait_request     => s3_wait_request,
+                 master_address         => m3_address,
+                 master_read            => m3_read,
+                 master_write           => m3_write,
+                 master_write_data      => m3_write_data,
+                 master_byte_enable     => m3_byte_enable,
+                 master_burst_count     => m3_burst_count,
+                 master_read_data       => m3_read_data,
+                 master_read_data_valid => m3_read_data_valid,
+                 master_wait_request    => m3_wait_request,
+                 Transfers              => s_transfers(3),
+                 Bytes                  => s_bytes(3),
+                 WaitCycles             => s_wait_cycles(3),
+                 MaxBurst               => s_max_burst(3));
+
+END MSE;
@@ -0,0 +1,93 @@
+ARCHITECTURE MSE OF bus_monitor_channel IS
+
+   SIGNAL s_command_accepted     : std_logic;
+   SIGNAL s_write_beat           : std_logic;
+   SIGNAL s_beat                 : std_logic;
+   SIGNAL s_waiting              : std_logic;
+   SIGNAL s_write_remaining_reg  : unsigned(  9 DOWNTO 0 );
+   SIGNAL s_transfers_reg        : unsigned( 31 DOWNTO 0 );
+   SIGNAL s_bytes_reg            : unsigned( 31 DOWNTO 0 );
+   SIGNAL s_wait_cycles_reg      : unsigned( 31 DOWNTO 0 );
+   SIGNAL s_max_burst_reg        : unsigned(  9 DOWNTO 0 );
+
+BEGIN
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the bus is passed through, no register is inserted       ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   master_address        <= slave_address;
+   master_read           <= slave_read;
+   master_write          <= slave_write;
+   master_write_data     <= slave_write_data;
+   master_byte_enable    <= slave_byte_enable;
+   master_burst_count    <= slave_burst_count;
+   slave_read_data       <= master_read_data;
+   slave_read_data_valid <= master_read_data_valid;
+   slave_wait_request    <= master_wait_request;
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the transfers are observed                               ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   -- A write burst is accepted with its first beat, the following beats of
+   -- the burst are no new commands.
+   s_write_beat       <= slave_write AND NOT(master_wait_request);
+   s_command_accepted <= '1' WHEN (slave_read = '1' AND
+                                   master_wait_request = '0') OR
+                                  (s_write_beat = '1' AND
+                                   s_write_remaining_reg = 0) ELSE '0';
+   s_beat             <= s_write_beat OR master_read_data_valid;
+   s_waiting          <= (slave_read OR slave_write) AND master_wait_request;
+   
+   make_write_remaining_reg : PROCESS( Clock )
+   BEGIN
+      IF (rising_edge(Clock)) THEN
+         IF (Reset = '1') THEN s_write_remaining_reg <= (OTHERS => '0');
+         ELSIF (s_write_beat = '1') THEN
+            IF (s_write_remaining_reg = 0) THEN
+               s_write_remaining_reg <= unsigned(slave_burst_count) - 1;
+                                           ELSE
+               s_write_remaining_reg <= s_write_remaining_reg - 1;
+            END IF;
+         END IF;
+      END IF;
+   END PROCESS make_write_remaining_reg;
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the counters are defined                                 ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   Transfers  <= std_logic_vector(s_transfers_reg);
+   Bytes      <= std_logic_vector(s_bytes_reg);
+   WaitCycles <= std_logic_vector(s_wait_cycles_reg);
+   MaxBurst   <= std_logic_vector(s_max_burst_reg);
+   
+   make_counters : PROCESS( Clock )
+   BEGIN
+      IF (rising_edge(Clock)) THEN
+         IF (Reset = '1' OR Clear = '1') THEN
+            s_transfers_reg   <= (OTHERS => '0');
+            s_bytes_reg       <= (OTHERS => '0');
+            s_wait_cycles_reg <= (OTHERS => '0');
+            s_max_burst_reg   <= (OTHERS => '0');
+         ELSIF (Enable = '1') THEN
+            IF (s_command_accepted = '1') THEN
+               s_transfers_reg <= s_transfers_reg + 1;
+               IF (unsigned(slave_burst_count) > s_max_burst_reg) THEN
+                  s_max_burst_reg <= unsigned(slave_burst_count);
+               END IF;
+            END IF;
+            IF (s_beat = '1') THEN
+               s_bytes_reg <= s_bytes_reg + 4;
+            END IF;
+            IF (s_waiting = '1') THEN
+               s_wait_cycles_reg <= s_wait_cycles_reg + 1;
+            END IF;
+         END IF;
+      END IF;
+   END PROCESS make_counters;
+
+END MSE;
@@ -0,0 +1,40 @@
+LIBRARY ieee;
+USE ieee.std_logic_1164.all;
+USE ieee.numeric_std.all;
+
+ENTITY bus_monitor_channel IS
+   PORT ( Clock                  : IN  std_logic;
+          Reset                  : IN  std_logic;
+          
+          -- Counting control
+          Enable                 : IN  std_logic;
+          Clear                  : IN  std_logic;
+          
+          -- Here the avalon slave interface of the master is defined
+          slave_address          : IN  std_logic_vector( 23 DOWNTO 0 );
+          slave_read             : IN  std_logic;
+          slave_write            : IN  std_logic;
+          slave_write_data       : IN  std_logic_vector( 31 DOWNTO 0 );
+          slave_byte_enable      : IN  std_logic_vector(  3 DOWNTO 0 );
+          slave_burst_count      : IN  std_logic_vector(  9 DOWNTO 0 );
+          slave_read_data        : OUT std_logic_vector( 31 DOWNTO 0 );
+          slave_read_data_valid  : OUT std_logic;
+          slave_wait_request     : OUT std_logic;
+          
+          -- Here the avalon master interface to the memory is defined
+          master_address         : OUT std_logic_vector( 23 DOWNTO 0 );
+          master_read            : OUT std_logic;
+          master_write           : OUT std_logic;
+          master_write_data      : OUT std_logic_vector( 31 DOWNTO 0 );
+          master_byte_enable     : OUT std_logic_vector(  3 DOWNTO 0 );
+          master_burst_count     : OUT std_logic_vector(  9 DOWNTO 0 );
+          master_read_data       : IN  std_logic_vector( 31 DOWNTO 0 );
+          master_read_data_valid : IN  std_logic;
+          master_wait_request    : IN  std_logic;
+          
+          -- Counters
+          Transfers              : OUT std_logic_vector( 31 DOWNTO 0 );
+          Bytes                  : OUT std_logic_vector( 31 DOWNTO 0 );
+          WaitCycles             : OUT std_logic_vector( 31 DOWNTO 0 );
+          MaxBurst               : OUT std_logic_vector(  9 DOWNTO 0 ));
+END bus_monitor_channel;
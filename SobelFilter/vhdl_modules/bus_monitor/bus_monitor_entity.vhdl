@@ -0,0 +1,96 @@
+LIBRARY ieee;
+USE ieee.std_logic_1164.all;
+USE ieee.numeric_std.all;
+
+ENTITY bus_monitor IS
+   PORT ( Clock                 : IN  std_logic;
+          Reset                 : IN  std_logic;
+          
+          -- Here the avalon slave interface is defined
+          slave_address         : IN  std_logic_vector(  4 DOWNTO 0 );
+          slave_cs              : IN  std_logic;
+          slave_we              : IN  std_logic;
+          slave_rd              : IN  std_logic;
+          slave_write_data      : IN  std_logic_vector( 31 DOWNTO 0 );
+          slave_read_data       : OUT std_logic_vector( 31 DOWNTO 0 );
+          
+          -- Channel 0 (cam_dma): slave port for the master, master port to the memory
+          s0_address            : IN  std_logic_vector( 23 DOWNTO 0 );
+          s0_read               : IN  std_logic;
+          s0_write              : IN  std_logic;
+          s0_write_data         : IN  std_logic_vector( 31 DOWNTO 0 );
+          s0_byte_enable        : IN  std_logic_vector(  3 DOWNTO 0 );
+          s0_burst_count        : IN  std_logic_vector(  9 DOWNTO 0 );
+          s0_read_data          : OUT std_logic_vector( 31 DOWNTO 0 );
+          s0_read_data_valid    : OUT std_logic;
+          s0_wait_request       : OUT std_logic;
+          m0_address            : OUT std_logic_vector( 23 DOWNTO 0 );
+          m0_read               : OUT std_logic;
+          m0_write              : OUT std_logic;
+          m0_write_data         : OUT std_logic_vector( 31 DOWNTO 0 );
+          m0_byte_enable        : OUT std_logic_vector(  3 DOWNTO 0 );
+          m0_burst_count        : OUT std_logic_vector(  9 DOWNTO 0 );
+          m0_read_data          : IN  std_logic_vector( 31 DOWNTO 0 );
+          m0_read_data_valid    : IN  std_logic;
+          m0_wait_request       : IN  std_logic;
+          
+          -- Channel 1 (lcd_dma): slave port for the master, master port to the memory
+          s1_address            : IN  std_logic_vector( 23 DOWNTO 0 );
+          s1_read               : IN  std_logic;
+          s1_write              : IN  std_logic;
+          s1_write_data         : IN  std_logic_vector( 31 DOWNTO 0 );
+          s1_byte_enable        : IN  std_logic_vector(  3 DOWNTO 0 );
+          s1_burst_count        : IN  std_logic_vector(  9 DOWNTO 0 );
+          s1_read_data          : OUT std_logic_vector( 31 DOWNTO 0 );
+          s1_read_data_valid    : OUT std_logic;
+          s1_wait_request       : OUT std_logic;
+          m1_address            : OUT std_logic_vector( 23 DOWNTO 0 );
+          m1_read               : OUT std_logic;
+          m1_write              : OUT std_logic;
+          m1_write_data         : OUT std_logic_vector( 31 DOWNTO 0 );
+          m1_byte_enable        : OUT std_logic_vector(  3 DOWNTO 0 );
+          m1_burst_count        : OUT std_logic_vector(  9 DOWNTO 0 );
+          m1_read_data          : IN  std_logic_vector( 31 DOWNTO 0 );
+          m1_read_data_valid    : IN  std_logic;
+          m1_wait_request       : IN  std_logic;
+          
+          -- Channel 2 (vga_dma): slave port for the master, master port to the memory
+          s2_address            : IN  std_logic_vector( 23 DOWNTO 0 );
+          s2_read               : IN  std_logic;
+          s2_write              : IN  std_logic;
+          s2_write_data         : IN  std_logic_vector( 31 DOWNTO 0 );
+          s2_byte_enable        : IN  std_logic_vector(  3 DOWNTO 0 );
+          s2_burst_count        : IN  std_logic_vector(  9 DOWNTO 0 );
+          s2_read_data          : OUT std_logic_vector( 31 DOWNTO 0 );
+          s2_read_data_valid    : OUT std_logic;
+          s2_wait_request       : OUT std_logic;
+          m2_address            : OUT std_logic_vector( 23 DOWNTO 0 );
+          m2_read               : OUT std_logic;
+          m2_write              : OUT std_logic;
+          m2_write_data         : OUT std_logic_vector( 31 DOWNTO 0 );
+          m2_byte_enable        : OUT std_logic_vector(  3 DOWNTO 0 );
+          m2_burst_count        : OUT std_logic_vector(  9 DOWNTO 0 );
+          m2_read_data          : IN  std_logic_vector( 31 DOWNTO 0 );
+          m2_read_data_valid    : IN  std_logic;
+          m2_wait_request       : IN  std_logic;
+          
+          -- Channel 3 (cpu): slave port for the master, master port to the memory
+          s3_address            : IN  std_logic_vector( 23 DOWNTO 0 );
+          s3_read               : IN  std_logic;
+          s3_write              : IN  std_logic;
+          s3_write_data         : IN  std_logic_vector( 31 DOWNTO 0 );
+          s3_byte_enable        : IN  std_logic_vector(  3 DOWNTO 0 );
+          s3_burst_count        : IN  std_logic_vector(  9 DOWNTO 0 );
+          s3_read_data          : OUT std_logic_vector( 31 DOWNTO 0 );
+          s3_read_data_valid    : OUT std_logic;
+          s3_wait_request       : OUT std_logic;
+          m3_address            : OUT std_logic_vector( 23 DOWNTO 0 );
+          m3_read               : OUT std_logic;
+          m3_write              : OUT std_logic;
+          m3_write_data         : OUT std_logic_vector( 31 DOWNTO 0 );
+          m3_byte_enable        : OUT std_logic_vector(  3 DOWNTO 0 );
+          m3_burst_count        : OUT std_logic_vector(  9 DOWNTO 0 );
+          m3_read_data          : IN  std_logic_vector( 31 DOWNTO 0 );
+          m3_read_data_valid    : IN  std_logic;
+          m3_wait_request       : IN  std_logic);
+END bus_monitor;
@@ -11,6 +11,12 @@ ARCHITECTURE MSE OF dma_controller_lcd IS
    SIGNAL s_empty_next       : std_logic;
    SIGNAL s_we_fifo          : std_logic;
    SIGNAL s_to_receive_reg   : unsigned( 8 DOWNTO 0 );
+   SIGNAL s_address_reg      : unsigned(31 DOWNTO 0 );
+   SIGNAL s_stride_reg       : unsigned(31 DOWNTO 0 );
+   SIGNAL s_strided_reg      : std_logic;
+   SIGNAL s_requests_reg     : unsigned( 7 DOWNTO 0 );
+   SIGNAL s_accept           : std_logic;
+   SIGNAL s_last_request     : std_logic;
    
 BEGIN
 
@@ -20,18 +26,45 @@ BEGIN
 ---                                                                          ---
 --------------------------------------------------------------------------------
 
+   s_accept       <= s_read_reg AND NOT(master_wait_request);
+   s_last_request <= '1' WHEN s_strided_reg = '0' OR
+                              s_requests_reg = X"00" ELSE '0';
+   master_address <= std_logic_vector(s_address_reg(31 DOWNTO 2))&"00";
+
    make_master_address : PROCESS( Clock )
    BEGIN
       IF (rising_edge(Clock)) THEN
-         IF (Reset = '1') THEN master_address <= (OTHERS => '0');
-         ELSIF (Start = '1') THEN master_address <= StartAddress&"00";
+         IF (Reset = '1') THEN s_address_reg <= (OTHERS => '0');
+         ELSIF (Start = '1') THEN s_address_reg <= unsigned(StartAddress);
+         ELSIF (s_accept = '1' AND s_strided_reg = '1') THEN
+            s_address_reg <= s_address_reg + s_stride_reg;
          END IF;
       END IF;
    END PROCESS make_master_address;
+
+   make_stride_reg : PROCESS( Clock )
+   BEGIN
+      IF (rising_edge(Clock)) THEN
+         IF (Reset = '1') THEN
+            s_stride_reg   <= (OTHERS => '0');
+            s_strided_reg  <= '0';
+            s_requests_reg <= (OTHERS => '0');
+         ELSIF (Start = '1') THEN
+            s_stride_reg   <= unsigned(Stride);
+            IF (unsigned(Stride) = 0) THEN s_strided_reg <= '0';
+                                      ELSE s_strided_reg <= '1';
+            END IF;
+            s_requests_reg <= unsigned(BurstSize)-1;
+         ELSIF (s_accept = '1' AND s_last_request = '0') THEN
+            s_requests_reg <= s_requests_reg-1;
+         END IF;
+      END IF;
+   END PROCESS make_stride_reg;
    
    master_read <= s_read_reg;
    s_read_next <= '1' WHEN Start = '1' ELSE
-                  '0' WHEN master_wait_request = '0' ELSE
+                  '0' WHEN master_wait_request = '0' AND
+                           s_last_request = '1' ELSE
                   s_read_reg;
    
    make_read_reg : PROCESS( Clock )
@@ -44,8 +77,11 @@ BEGIN
    END PROCESS make_read_reg;
    
    master_burst_count <= s_burst_count_reg;
-   s_burst_count_next <= BurstSize WHEN Start = '1' ELSE
-                         X"00" WHEN master_wait_request = '0' ELSE
+   s_burst_count_next <= BurstSize WHEN Start = '1' AND
+                                        unsigned(Stride) = 0 ELSE
+                         X"01" WHEN Start = '1' ELSE
+                         X"00" WHEN master_wait_request = '0' AND
+                                    s_last_request = '1' ELSE
                          s_burst_count_reg;
 
    make_burst_count_reg : PROCESS( Clock )
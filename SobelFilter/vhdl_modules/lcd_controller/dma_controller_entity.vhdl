@@ -2,12 +2,18 @@ LIBRARY ieee;
 USE ieee.std_logic_1164.all;
 USE ieee.numeric_std.all;
 
+-- A Start with Stride = 0 reads one burst of BurstSize words from
+-- StartAddress. With a Stride (in bytes, two's complement) BurstSize single
+-- word reads are issued at StartAddress+n*Stride, used for the rotated
+-- modes of the pixel_formatter; the fifo receives the word containing each
+-- byte address.
 ENTITY dma_controller_lcd IS
    PORT ( -- Here the internal interface is defined
           Clock                       : IN  std_logic;
           Reset                       : IN  std_logic;
           Start                       : IN  std_logic;
-          StartAddress                : IN  std_logic_vector(31 DOWNTO 2);
+          StartAddress                : IN  std_logic_vector(31 DOWNTO 0);
+          Stride                      : IN  std_logic_vector(31 DOWNTO 0);
           BurstSize                   : IN  std_logic_vector( 7 DOWNTO 0);
           busy                        : OUT std_logic;
           empty                       : OUT std_logic;
@@ -12,6 +12,7 @@ ARCHITECTURE MSE OF lcd_avalon_slave IS
              EightBitSixteenBitBar : IN  std_logic;
              WriteReadBar          : IN  std_logic;
              DataToSend            : IN  std_logic_vector( 15 DOWNTO 0 );
+             WriteTiming           : IN  std_logic_vector( 11 DOWNTO 0 );
              DataReceived          : OUT std_logic_vector( 15 DOWNTO 0 );
              busy                  : OUT std_logic;
              -- Here the external LCD-panel signals are defined
@@ -149,6 +150,7 @@ BEGIN
                  EightBitSixteenBitBar => s_control_reg(0),
                  WriteReadBar          => s_WriteReadBar,
                  DataToSend            => slave_write_data(15 DOWNTO 0 ),
+                 WriteTiming           => (OTHERS => '0'),
                  DataReceived          => s_LCD_data_out,
                  busy                  => s_busy,
                  -- Here the external LCD-panel signals are defined
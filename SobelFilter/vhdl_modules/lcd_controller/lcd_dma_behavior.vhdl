@@ -3,6 +3,11 @@ ARCHITECTURE MSE OF lcd_dma IS
    TYPE LCD_READ_TYPE IS (IDLE,WAITBUSY,INITREAD,WAITREAD,RELEASE);
 
    COMPONENT SendReceiveInterface IS
+      GENERIC( WRITE_SETUP_CYCLES   : INTEGER;
+               WRITE_LOW_CYCLES     : INTEGER;
+               WRITE_HOLD_CYCLES    : INTEGER;
+               RESET_CYCLES         : INTEGER;
+               RECOVER_CYCLES       : INTEGER);
       PORT ( -- Here the internal interface is defined
              Clock            : IN  std_logic;
              Reset                 : IN  std_logic;
@@ -12,6 +17,7 @@ ARCHITECTURE MSE OF lcd_dma IS
              EightBitSixteenBitBar : IN  std_logic;
              WriteReadBar          : IN  std_logic;
              DataToSend            : IN  std_logic_vector( 15 DOWNTO 0 );
+             WriteTiming           : IN  std_logic_vector( 11 DOWNTO 0 );
              DataReceived          : OUT std_logic_vector( 15 DOWNTO 0 );
              busy                  : OUT std_logic;
              -- Here the external LCD-panel signals are defined
@@ -29,7 +35,8 @@ ARCHITECTURE MSE OF lcd_dma IS
              Clock                  : IN  std_logic;
              Reset                       : IN  std_logic;
              Start                       : IN  std_logic;
-             StartAddress                : IN  std_logic_vector(31 DOWNTO 2);
+             StartAddress                : IN  std_logic_vector(31 DOWNTO 0);
+             Stride                      : IN  std_logic_vector(31 DOWNTO 0);
              BurstSize                   : IN  std_logic_vector( 7 DOWNTO 0);
              busy                        : OUT std_logic;
              empty                       : OUT std_logic;
@@ -53,14 +60,20 @@ ARCHITECTURE MSE OF lcd_dma IS
              GenerateIRQ                 : OUT std_logic;
              -- Here the register interface is defined
              ImageSize                   : IN  std_logic_vector(19 DOWNTO 0);
-             ImagePointer                : IN  std_logic_vector(31 DOWNTO 2);
+             ImagePointer                : IN  std_logic_vector(31 DOWNTO 0);
              ImageXSize                  : IN  std_logic_vector(11 DOWNTO 0);
              EightSixteenBar             : IN  std_logic;
              RGB888RGB565Bar             : IN  std_logic;
              GrayscaleColorBar           : IN  std_logic;
+             Orientation                 : IN  std_logic_vector( 2 DOWNTO 0);
+             Binary                      : IN  std_logic;
+             PixelsEachLine              : IN  std_logic_vector( 8 DOWNTO 0);
+             ForegroundColor             : IN  std_logic_vector(15 DOWNTO 0);
+             BackgroundColor             : IN  std_logic_vector(15 DOWNTO 0);
              -- Here the DMA-interface signals are defined
              StartDMA                    : OUT std_logic;
-             DMAAddress                  : OUT std_logic_vector(31 DOWNTO 2);
+             DMAAddress                  : OUT std_logic_vector(31 DOWNTO 0);
+             DMAStride                   : OUT std_logic_vector(31 DOWNTO 0);
              DMABusy                     : IN  std_logic;
              DMAFifoEmpty                : IN  std_logic;
              DMAFifoPop                  : OUT std_logic;
@@ -79,17 +92,22 @@ ARCHITECTURE MSE OF lcd_dma IS
    SIGNAL s_busy                : std_logic;
    SIGNAL s_control_reg         : std_logic_vector( 5 DOWNTO 0 );
    SIGNAL s_control_next        : std_logic_vector( 5 DOWNTO 0 );
+   SIGNAL s_orientation_reg     : std_logic_vector( 2 DOWNTO 0 );
+   SIGNAL s_orientation_next    : std_logic_vector( 2 DOWNTO 0 );
+   SIGNAL s_binary_reg          : std_logic;
+   SIGNAL s_binary_next         : std_logic;
    SIGNAL s_LCD_data_out        : std_logic_vector(15 DOWNTO 0 );
    SIGNAL s_LCD_data_in         : std_logic_vector(15 DOWNTO 0 );
    SIGNAL s_current_state       : LCD_READ_TYPE;
    SIGNAL s_next_state          : LCD_READ_TYPE;
    SIGNAL s_reset_display       : std_logic;
-   SIGNAL s_picture_pointer_reg : std_logic_vector( 31 DOWNTO 2 );
+   SIGNAL s_picture_pointer_reg : std_logic_vector( 31 DOWNTO 0 );
    SIGNAL s_we_picture_pointer  : std_logic;
    SIGNAL s_picture_size_reg    : std_logic_vector( 31 DOWNTO 0 );
    SIGNAL s_we_picture_size     : std_logic;
    SIGNAL s_DMA_Start           : std_logic;
-   SIGNAL s_DMA_StartAddress    : std_logic_vector(31 DOWNTO 2);
+   SIGNAL s_DMA_StartAddress    : std_logic_vector(31 DOWNTO 0);
+   SIGNAL s_DMA_Stride          : std_logic_vector(31 DOWNTO 0);
    SIGNAL s_DMA_busy            : std_logic;
    SIGNAL s_DMAe_busy           : std_logic;
    SIGNAL s_DMA_empty           : std_logic;
@@ -108,7 +126,11 @@ ARCHITECTURE MSE OF lcd_dma IS
    SIGNAL s_we_pixel_ell        : std_logic;
    SIGNAL s_burst_size          : std_logic_vector( 7 DOWNTO 0 );
    SIGNAL s_ImageXSize_reg      : std_logic_vector(11 DOWNTO 0 );
+   SIGNAL s_background_reg      : std_logic_vector(15 DOWNTO 0 );
+   SIGNAL s_foreground_reg      : std_logic_vector(15 DOWNTO 0 );
    SIGNAL s_we_ImageXSize       : std_logic;
+   SIGNAL s_write_timing_reg    : std_logic_vector(11 DOWNTO 0 );
+   SIGNAL s_we_write_timing     : std_logic;
 
 BEGIN
 --------------------------------------------------------------------------------
@@ -118,17 +140,22 @@ BEGIN
 --------------------------------------------------------------------------------
    make_read_data : PROCESS( slave_address , s_control_reg , s_busy ,
                              s_picture_pointer_reg , s_picture_size_reg ,
-                             s_pixel_each_line_lcd )
+                             s_pixel_each_line_lcd , s_write_timing_reg ,
+                             s_orientation_reg , s_binary_reg ,
+                             s_background_reg , s_foreground_reg )
    BEGIN
       CASE (slave_address) IS
-         WHEN "010"  => slave_read_data <= X"000000"&"0"&s_irq_reg&
+         WHEN "010"  => slave_read_data <= X"0000"&"00"&s_binary_reg&s_orientation_reg&
+                           "000"&s_irq_reg&
                            s_control_reg(5 DOWNTO 3)&s_DMA_busy&s_busy&s_control_reg(0);
          WHEN "000" |
               "001"  => slave_read_data <= s_LCD_data_out&s_LCD_data_out;
-         WHEN "011"  => slave_read_data <= s_picture_pointer_reg&"00";
+         WHEN "011"  => slave_read_data <= s_picture_pointer_reg;
          WHEN "100"  => slave_read_data <= s_picture_size_reg;
-         WHEN "101"  => slave_read_data <= X"00000"&"000"&s_pixel_each_line_lcd;
-         WHEN "110"  => slave_read_data <= X"00000"&s_ImageXSize_reg;
+         WHEN "101"  => slave_read_data <= s_background_reg&"0000000"&
+                                           s_pixel_each_line_lcd;
+         WHEN "110"  => slave_read_data <= s_foreground_reg&X"0"&s_ImageXSize_reg;
+         WHEN "111"  => slave_read_data <= X"00000"&s_write_timing_reg;
          WHEN OTHERS => slave_read_data <= (OTHERS => '0');
       END CASE;
    END PROCESS make_read_data;
@@ -218,18 +245,33 @@ BEGIN
                                                          slave_cs = '1' AND
                                                          slave_address = "010" ELSE 
                      s_control_reg;
+   s_orientation_next <= slave_write_data(12 DOWNTO 10) WHEN slave_we = '1' AND
+                                                             slave_cs = '1' AND
+                                                             slave_address = "010" ELSE
+                         s_orientation_reg;
+   s_binary_next      <= slave_write_data(13) WHEN slave_we = '1' AND
+                                                   slave_cs = '1' AND
+                                                   slave_address = "010" ELSE
+                         s_binary_reg;
    s_we_pixel_ell  <= '1' WHEN slave_we = '1' AND
                                slave_cs = '1' AND
                                slave_address = "101" ELSE '0';
    s_we_ImageXSize <= '1' WHEN slave_we = '1' AND
                                slave_cs = '1' AND
                                slave_address = "110" ELSE '0';
+   s_we_write_timing <= '1' WHEN slave_we = '1' AND
+                                 slave_cs = '1' AND
+                                 slave_address = "111" ELSE '0';
    
    make_control_reg : PROCESS( Clock )
    BEGIN
       IF (rising_edge(Clock)) THEN
-         IF (Reset = '1') THEN s_control_reg <= (OTHERS => '0');
-                          ELSE s_control_reg <= s_control_next;
+         IF (Reset = '1') THEN s_control_reg     <= (OTHERS => '0');
+                               s_orientation_reg <= (OTHERS => '0');
+                               s_binary_reg      <= '0';
+                          ELSE s_control_reg     <= s_control_next;
+                               s_orientation_reg <= s_orientation_next;
+                               s_binary_reg      <= s_binary_next;
          END IF;
       END IF;
    END PROCESS make_control_reg;
@@ -239,7 +281,7 @@ BEGIN
       IF (rising_edge(Clock)) THEN
          IF (Reset = '1') THEN s_picture_pointer_reg <= (OTHERS => '0');
          ELSIF (s_we_picture_pointer = '1') THEN
-            s_picture_pointer_reg <= slave_write_data( 31 DOWNTO 2 );
+            s_picture_pointer_reg <= slave_write_data;
          END IF;
       END IF;
    END PROCESS make_pointer_reg;
@@ -258,8 +300,10 @@ BEGIN
    BEGIN
       IF (rising_edge(Clock)) THEN
          IF (Reset = '1') THEN s_pixel_each_line_lcd <= (OTHERS => '0');
+                               s_background_reg      <= (OTHERS => '0');
          ELSIF (s_we_pixel_ell = '1') THEN
             s_pixel_each_line_lcd <= slave_write_data( 8 DOWNTO 0);
+            s_background_reg      <= slave_write_data(31 DOWNTO 16);
          END IF;
       END IF;
    END PROCESS make_pixel_each_line_lcd;
@@ -268,18 +312,40 @@ BEGIN
    BEGIN
       IF (rising_edge(Clock)) THEN
          IF (Reset = '1') THEN s_ImageXSize_reg <= (OTHERS => '0');
+                               s_foreground_reg <= (OTHERS => '0');
          ELSIF (s_we_ImageXSize = '1') THEN 
             s_ImageXSize_reg <= slave_write_data(11 DOWNTO 0);
+            s_foreground_reg <= slave_write_data(31 DOWNTO 16);
          END IF;
       END IF;
    END PROCESS make_ImageXSize_reg;
 
+   make_write_timing_reg : PROCESS( Clock )
+   BEGIN
+      IF (rising_edge(Clock)) THEN
+         IF (Reset = '1') THEN s_write_timing_reg <= (OTHERS => '0');
+         ELSIF (s_we_write_timing = '1') THEN
+            s_write_timing_reg <= slave_write_data(11 DOWNTO 0);
+         END IF;
+      END IF;
+   END PROCESS make_write_timing_reg;
+
 --------------------------------------------------------------------------------
 ---                                                                          ---
 --- In this section all control signals are defined                          ---
 ---                                                                          ---
 --------------------------------------------------------------------------------
-   s_burst_size       <= s_pixel_each_line_lcd( 8 DOWNTO 1 ) 
+   -- the binary mode reads 32 pixels each word, the rotated modes read each
+   -- pixel by a single word read
+   s_burst_size       <= "000"&std_logic_vector(
+                            unsigned("0"&s_pixel_each_line_lcd( 8 DOWNTO 5 ))+1)
+                            WHEN s_binary_reg = '1' AND
+                                 s_pixel_each_line_lcd( 4 DOWNTO 0 ) /= "00000" ELSE
+                         "0000"&s_pixel_each_line_lcd( 8 DOWNTO 5 )
+                            WHEN s_binary_reg = '1' ELSE
+                         s_pixel_each_line_lcd( 7 DOWNTO 0 )
+                            WHEN s_orientation_reg /= "000" ELSE
+                         s_pixel_each_line_lcd( 8 DOWNTO 1 ) 
                             WHEN s_control_reg(4) = '0' ELSE
                          "0"&s_pixel_each_line_lcd( 8 DOWNTO 2 );
    s_WriteReadBar     <= slave_we WHEN s_pixel_start = '0' ELSE
@@ -321,6 +387,11 @@ BEGIN
 --------------------------------------------------------------------------------
 
    interface : SendReceiveInterface
+      GENERIC MAP ( WRITE_SETUP_CYCLES => WRITE_SETUP_CYCLES,
+                    WRITE_LOW_CYCLES   => WRITE_LOW_CYCLES,
+                    WRITE_HOLD_CYCLES  => WRITE_HOLD_CYCLES,
+                    RESET_CYCLES       => RESET_CYCLES,
+                    RECOVER_CYCLES     => RECOVER_CYCLES)
       PORT MAP ( Clock                 => Clock,
                  Reset                 => Reset,
                  ResetDisplay          => s_reset_display,
@@ -329,6 +400,7 @@ BEGIN
                  EightBitSixteenBitBar => s_control_reg(0),
                  WriteReadBar          => s_WriteReadBar,
                  DataToSend            => s_LCD_data_in,
+                 WriteTiming           => s_write_timing_reg,
                  DataReceived          => s_LCD_data_out,
                  busy                  => s_busy,
                  -- Here the external LCD-panel signals are defined
@@ -344,6 +416,7 @@ BEGIN
                  Reset                       => Reset,
                  Start                       => s_DMA_Start,
                  StartAddress                => s_DMA_StartAddress,
+                 Stride                      => s_DMA_Stride,
                  BurstSize                   => s_burst_size,
                  busy                        => s_DMAe_busy,
                  empty                       => s_DMA_empty,
@@ -370,9 +443,15 @@ BEGIN
                  EightSixteenBar             => s_control_reg(0),
                  RGB888RGB565Bar             => s_control_reg(3),
                  GrayscaleColorBar           => s_control_reg(4),
+                 Orientation                 => s_orientation_reg,
+                 Binary                      => s_binary_reg,
+                 PixelsEachLine              => s_pixel_each_line_lcd,
+                 ForegroundColor             => s_foreground_reg,
+                 BackgroundColor             => s_background_reg,
                  -- Here the DMA-interface signals are defined
                  StartDMA                    => s_DMA_Start,
                  DMAAddress                  => s_DMA_StartAddress,
+                 DMAStride                   => s_DMA_Stride,
                  DMABusy                     => s_DMAe_busy,
                  DMAFifoEmpty                => s_DMA_empty,
                  DMAFifoPop                  => s_DMA_pop,
@@ -2,6 +2,11 @@ LIBRARY ieee;
 USE ieee.std_logic_1164.all;
 
 ENTITY lcd_dma IS
+   GENERIC( WRITE_SETUP_CYCLES          : INTEGER := 1;
+            WRITE_LOW_CYCLES            : INTEGER := 2;
+            WRITE_HOLD_CYCLES           : INTEGER := 0;
+            RESET_CYCLES                : INTEGER := 1200;
+            RECOVER_CYCLES              : INTEGER := 12000000);
    PORT ( -- Here the internal interface is defined
           Clock                       : IN  std_logic;
           Reset                       : IN  std_logic;
@@ -56,8 +61,22 @@ END lcd_dma;
      --             bit 6  => IRQ status (read only)
      --             bit 8  => Start DMA transfer (write only)
      --             bit 9  => clear irq (write only)
+     --             bit 10 => transpose, LCD lines are image columns
+     --             bit 11 => reverse the pixels of each LCD line
+     --             bit 12 => reverse the LCD lines
+     --                       (90 degrees: 10+11, 180: 11+12, 270: 10+12)
+     --             bit 13 => 0 -> transfer selected by bits 4,3,0
+     --                       1 -> binary transfer, 1 bit each pixel packed
+     --                            32 pixels each word from bit 0, each
+     --                            image line starts with a new word
      --             others => 0
-     -- 011  Picture start address (pointer to image)
+     -- 011  Picture start address (pointer to the first pixel sent)
      -- 100  Picture size in pixels
-     -- 101  Nr. of Pixels each line of LCD
-     -- 110  Nr. of Pixels each line of Image
+     -- 101  bit  8..0  => Nr. of Pixels each line of LCD
+     --      bit 31..16 => RGB565 color of the '0' pixels (binary transfer)
+     -- 110  bit 11..0  => Nr. of Pixels each line of Image
+     --      bit 31..16 => RGB565 color of the '1' pixels (binary transfer)
+     -- 111  r/w  : LCD write timing in clock cycles, 0 selects the default
+     --             bit  3..0 => setup (data valid, WriteBar high)
+     --             bit  7..4 => WriteBar low
+     --             bit 11..8 => hold (WriteBar high)
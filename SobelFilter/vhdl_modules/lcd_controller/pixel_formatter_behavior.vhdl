@@ -5,11 +5,25 @@ ARCHITECTURE MSE OF pixel_formatter IS
                              SENDSHORT2,WAITSHORT2,POP,CHECKBUSY,
                              STARTDMATRANS,WAITDMABUSY,GENIRQ,
                              SENDGRAY1,WAITGRAY1,SENDGRAY2,WAITGRAY2,
-                             SENDGRAY3,WAITGRAY3,SENDGRAY4,WAITGRAY4);
+                             SENDGRAY3,WAITGRAY3,SENDGRAY4,WAITGRAY4,
+                             SENDPIXEL,WAITPIXEL,SENDBIT,WAITBIT);
    SIGNAL s_current_state , s_next_state : CONTROLSTATETYPE;
-   SIGNAL s_current_address_reg          : unsigned(31 DOWNTO 2);
-   SIGNAL s_current_address_next         : unsigned(31 DOWNTO 2);
+   SIGNAL s_current_address_reg          : unsigned(31 DOWNTO 0);
+   SIGNAL s_current_address_next         : unsigned(31 DOWNTO 0);
    SIGNAL s_address_increment            : unsigned(31 DOWNTO 2);
+   SIGNAL s_bytes_each_pixel             : unsigned(31 DOWNTO 0);
+   SIGNAL s_bytes_each_line              : unsigned(31 DOWNTO 0);
+   SIGNAL s_pixel_step                   : unsigned(31 DOWNTO 0);
+   SIGNAL s_line_step                    : unsigned(31 DOWNTO 0);
+   SIGNAL s_pixel_address_reg            : unsigned(31 DOWNTO 0);
+   SIGNAL s_pixel_address_next           : unsigned(31 DOWNTO 0);
+   SIGNAL s_pixel_short                  : std_logic_vector(15 DOWNTO 0);
+   SIGNAL s_pixel_byte                   : std_logic_vector( 7 DOWNTO 0);
+   SIGNAL s_orientation                  : std_logic_vector( 2 DOWNTO 0);
+   SIGNAL s_bit_reg                      : unsigned( 4 DOWNTO 0);
+   SIGNAL s_bit_next                     : unsigned( 4 DOWNTO 0);
+   SIGNAL s_line_left_reg                : unsigned( 8 DOWNTO 0);
+   SIGNAL s_line_left_next               : unsigned( 8 DOWNTO 0);
    SIGNAL s_pixel_counter_reg            : unsigned(20 DOWNTO 0);
    SIGNAL s_pixel_counter_next           : unsigned(20 DOWNTO 0);
 
@@ -34,7 +48,9 @@ BEGIN
                                    s_current_state = SENDGRAY1 OR
                                    s_current_state = SENDGRAY2 OR
                                    s_current_state = SENDGRAY3 OR
-                                   s_current_state = SENDGRAY4 ELSE
+                                   s_current_state = SENDGRAY4 OR
+                                   s_current_state = SENDPIXEL OR
+                                   s_current_state = SENDBIT ELSE
                            s_pixel_counter_reg;
    
    make_pixel_counter : PROCESS( Clock )
@@ -46,6 +62,28 @@ BEGIN
       END IF;
    END PROCESS make_pixel_counter;
 
+   -- the binary mode sends the bits of a word from bit 0 up, each LCD line
+   -- ends after PixelsEachLine bits, the rest of its last word is skipped
+   s_bit_next       <= (OTHERS => '0') WHEN s_current_state = POP ELSE
+                       s_bit_reg+1 WHEN s_current_state = SENDBIT ELSE
+                       s_bit_reg;
+   s_line_left_next <= unsigned(PixelsEachLine)
+                          WHEN s_current_state = SENDCOMMAND OR
+                               s_current_state = STARTDMATRANS ELSE
+                       s_line_left_reg-1 WHEN s_current_state = SENDBIT ELSE
+                       s_line_left_reg;
+
+   make_bit_counters : PROCESS( Clock )
+   BEGIN
+      IF (rising_edge(Clock)) THEN
+         IF (Reset = '1') THEN s_bit_reg       <= (OTHERS => '0');
+                               s_line_left_reg <= (OTHERS => '0');
+                          ELSE s_bit_reg       <= s_bit_next;
+                               s_line_left_reg <= s_line_left_next;
+         END IF;
+      END IF;
+   END PROCESS make_bit_counters;
+
 --------------------------------------------------------------------------------
 ---                                                                          ---
 --- In this section the LCD-control signals are defined                      ---
@@ -57,12 +95,22 @@ BEGIN
                                    s_current_state = SENDGRAY1 OR
                                    s_current_state = SENDGRAY2 OR
                                    s_current_state = SENDGRAY3 OR
-                                   s_current_state = SENDGRAY4 ELSE '0';
+                                   s_current_state = SENDGRAY4 OR
+                                   s_current_state = SENDPIXEL OR
+                                   s_current_state = SENDBIT ELSE '0';
    LCDCommandBarData   <= '0' WHEN s_current_state = SENDCOMMAND OR
                                    s_current_state = IDLE ELSE '1';
    LCDWriteReadBar     <= '0' WHEN s_current_state = IDLE ELSE '1';
    
-   make_lcd_data : PROCESS( s_current_state , DMAFifoDataIn )
+   -- the pixel of a rotated mode is selected by its byte address
+   s_pixel_short <= DMAFifoDataIn(31 DOWNTO 16) WHEN s_pixel_address_reg(1) = '1' ELSE
+                    DMAFifoDataIn(15 DOWNTO  0);
+   s_pixel_byte  <= s_pixel_short(15 DOWNTO 8) WHEN s_pixel_address_reg(0) = '1' ELSE
+                    s_pixel_short( 7 DOWNTO 0);
+
+   make_lcd_data : PROCESS( s_current_state , DMAFifoDataIn , s_pixel_short ,
+                            s_pixel_byte , GrayscaleColorBar , s_bit_reg ,
+                            ForegroundColor , BackgroundColor )
    BEGIN
       CASE (s_current_state) IS
          WHEN SENDCOMMAND        => LCDDataToSend <= X"002C";
@@ -80,6 +128,18 @@ BEGIN
          WHEN SENDGRAY4          => LCDDataToSend <= DMAFifoDataIn(31 DOWNTO 27)&
                                                      DMAFifoDataIn(31 DOWNTO 26)&
                                                      DMAFifoDataIn(31 DOWNTO 27);
+         WHEN SENDPIXEL          => IF (GrayscaleColorBar = '1') THEN
+                                       LCDDataToSend <= s_pixel_byte(7 DOWNTO 3)&
+                                                        s_pixel_byte(7 DOWNTO 2)&
+                                                        s_pixel_byte(7 DOWNTO 3);
+                                                                     ELSE
+                                       LCDDataToSend <= s_pixel_short;
+                                    END IF;
+         WHEN SENDBIT            => IF (DMAFifoDataIn(to_integer(s_bit_reg)) = '1') THEN
+                                       LCDDataToSend <= ForegroundColor;
+                                                                                    ELSE
+                                       LCDDataToSend <= BackgroundColor;
+                                    END IF;
          WHEN OTHERS             => LCDDataToSend <= X"0000";
       END CASE;
    END PROCESS make_lcd_data;
@@ -93,15 +153,57 @@ BEGIN
                            s_current_state = STARTDMATRANS ELSE '0';
    DMAFifoPop  <= '1' WHEN s_current_state = POP ELSE '0';
    DMAAddress  <= std_logic_vector(s_current_address_reg);
-   s_address_increment <= unsigned(X"0000"&"000"&ImageXSize(11 DOWNTO 1))
+   DMAStride   <= std_logic_vector(s_pixel_step) WHEN s_orientation /= "000" ELSE
+                  (OTHERS => '0');
+   s_orientation <= Orientation WHEN Binary = '0' ELSE "000";
+   s_address_increment <= unsigned(X"00000"&"000"&ImageXSize(11 DOWNTO 5))+1
+                             WHEN Binary = '1' AND
+                                  ImageXSize(4 DOWNTO 0) /= "00000" ELSE
+                          unsigned(X"00000"&"000"&ImageXSize(11 DOWNTO 5))
+                             WHEN Binary = '1' ELSE
+                          unsigned(X"0000"&"000"&ImageXSize(11 DOWNTO 1))
                              WHEN GrayscaleColorBar = '0' ELSE
                           unsigned(X"00000"&ImageXSize(11 DOWNTO 2)); 
+
+   -- the steps in bytes along an LCD line and from line to line
+   s_bytes_each_pixel  <= to_unsigned(2,32) WHEN GrayscaleColorBar = '0' ELSE
+                          to_unsigned(1,32);
+   s_bytes_each_line   <= unsigned(X"0000"&"000"&ImageXSize&"0")
+                             WHEN GrayscaleColorBar = '0' ELSE
+                          unsigned(X"00000"&ImageXSize);
+   s_pixel_step <= 0-s_bytes_each_line  WHEN s_orientation(1 DOWNTO 0) = "11" ELSE
+                   s_bytes_each_line    WHEN s_orientation(1 DOWNTO 0) = "01" ELSE
+                   0-s_bytes_each_pixel WHEN s_orientation(1 DOWNTO 0) = "10" ELSE
+                   s_bytes_each_pixel;
+   s_line_step  <= s_address_increment&"00" WHEN s_orientation = "000" ELSE
+                   0-s_bytes_each_pixel WHEN s_orientation(2) = '1' AND
+                                             s_orientation(0) = '1' ELSE
+                   s_bytes_each_pixel   WHEN s_orientation(0) = '1' ELSE
+                   0-s_bytes_each_line  WHEN s_orientation(2) = '1' ELSE
+                   s_bytes_each_line;
    
    s_current_address_next <= unsigned(ImagePointer) WHEN StartTransfer = '1' ELSE
-                             s_current_address_reg+s_address_increment
+                             s_current_address_reg+s_line_step
                                 WHEN s_current_state = SENDCOMMAND OR
                                      s_current_state = STARTDMATRANS ELSE
                              s_current_address_reg;
+
+   -- follows the single reads of the dma in the rotated modes
+   s_pixel_address_next <= s_current_address_reg
+                              WHEN s_current_state = SENDCOMMAND OR
+                                   s_current_state = STARTDMATRANS ELSE
+                           s_pixel_address_reg+s_pixel_step
+                              WHEN s_current_state = SENDPIXEL ELSE
+                           s_pixel_address_reg;
+
+   make_pixel_address : PROCESS( Clock )
+   BEGIN
+      IF (rising_edge(Clock)) THEN
+         IF (Reset = '1') THEN s_pixel_address_reg <= (OTHERS => '0');
+                          ELSE s_pixel_address_reg <= s_pixel_address_next;
+         END IF;
+      END IF;
+   END PROCESS make_pixel_address;
    
    make_current_address : PROCESS( Clock )
    BEGIN
@@ -120,7 +222,9 @@ BEGIN
 
    make_next_state : PROCESS( s_current_state , StartTransfer , LCDBusy ,
                               DMAFifoEmpty, GrayscaleColorBar, RGB888RGB565Bar,
-                              EightSixteenBar, DMABusy)
+                              EightSixteenBar, DMABusy, s_orientation,
+                              s_pixel_counter_reg, Binary, s_bit_reg,
+                              s_line_left_reg)
       VARIABLE v_config : std_logic_vector( 2 DOWNTO 0 );
    BEGIN
       v_config := GrayscaleColorBar&RGB888RGB565Bar&EightSixteenBar;
@@ -143,11 +247,21 @@ BEGIN
                               END IF;
          WHEN WAITEMPTY    => IF (DMAFifoEmpty = '1') THEN
                                  s_next_state <= WAITEMPTY;
+                              ELSIF (Binary = '1') THEN
+                                 s_next_state <= SENDBIT;
                                                       ELSE
                                  CASE (v_config) IS
-                                    WHEN "000"  => s_next_state <= SENDSHORT1;
+                                    WHEN "000"  => IF (s_orientation = "000") THEN
+                                                      s_next_state <= SENDSHORT1;
+                                                                            ELSE
+                                                      s_next_state <= SENDPIXEL;
+                                                   END IF;
                                     WHEN "100" |
-                                         "110"  => s_next_state <= SENDGRAY1;
+                                         "110"  => IF (s_orientation = "000") THEN
+                                                      s_next_state <= SENDGRAY1;
+                                                                            ELSE
+                                                      s_next_state <= SENDPIXEL;
+                                                   END IF;
                                     WHEN OTHERS => s_next_state <= IDLE;
                                  END CASE;
                               END IF;
@@ -199,6 +313,25 @@ BEGIN
                                                                     ELSE
                                  s_next_state <= POP;
                               END IF;
+         WHEN SENDPIXEL    => s_next_state <= WAITPIXEL;
+         WHEN WAITPIXEL    => IF (LCDBusy = '1') THEN 
+                                 s_next_state <= WAITPIXEL;
+                              ELSIF (s_pixel_counter_reg(20) = '1') THEN
+                                 s_next_state <= WAITDMABUSY;
+                                                                    ELSE
+                                 s_next_state <= POP;
+                              END IF;
+         WHEN SENDBIT      => s_next_state <= WAITBIT;
+         WHEN WAITBIT      => IF (LCDBusy = '1') THEN 
+                                 s_next_state <= WAITBIT;
+                              ELSIF (s_pixel_counter_reg(20) = '1') THEN
+                                 s_next_state <= WAITDMABUSY;
+                              ELSIF (s_bit_reg = 0 OR
+                                     s_line_left_reg = 0) THEN
+                                 s_next_state <= POP;
+                                                                    ELSE
+                                 s_next_state <= SENDBIT;
+                              END IF;
          WHEN POP          => s_next_state <= CHECKBUSY;
          WHEN CHECKBUSY    => IF (DMAFifoEmpty = '1' AND
                                   DMABusy = '0') THEN
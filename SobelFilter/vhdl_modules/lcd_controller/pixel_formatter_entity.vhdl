@@ -2,6 +2,20 @@ LIBRARY ieee;
 USE ieee.std_logic_1164.all;
 USE ieee.numeric_std.all;
 
+-- Orientation selects the order the image is sent in (like MV/MX/MY of the
+-- ILI9341 memory access control):
+--   bit 0 => transpose, each LCD line is an image column
+--   bit 1 => each LCD line is sent in reverse order
+--   bit 2 => the LCD lines are sent in reverse order
+-- e.g. "011" rotates by 90, "110" by 180 and "101" by 270 degrees
+-- (clockwise). ImagePointer is the address of the first pixel sent, the
+-- corner of the image for the reversed directions. In all orientations but
+-- "000" each pixel is read by a single word read, at most 255 pixels each
+-- LCD line.
+-- Binary selects the packed one bit per pixel format: 32 pixels each word,
+-- the first pixel in bit 0, each image line starts with a new word. The
+-- pixels are sent as ForegroundColor ('1') or BackgroundColor ('0'), the
+-- orientation is ignored.
 ENTITY pixel_formatter IS
    PORT ( -- Here the internal interface is defined
           Clock                       : IN  std_logic;
@@ -12,15 +26,21 @@ ENTITY pixel_formatter IS
           
           -- Here the register interface is defined
           ImageSize                   : IN  std_logic_vector(19 DOWNTO 0);
-          ImagePointer                : IN  std_logic_vector(31 DOWNTO 2);
+          ImagePointer                : IN  std_logic_vector(31 DOWNTO 0);
           ImageXSize                  : IN  std_logic_vector(11 DOWNTO 0);
           EightSixteenBar             : IN  std_logic;
           RGB888RGB565Bar             : IN  std_logic;
           GrayscaleColorBar           : IN  std_logic;
+          Orientation                 : IN  std_logic_vector( 2 DOWNTO 0);
+          Binary                      : IN  std_logic;
+          PixelsEachLine              : IN  std_logic_vector( 8 DOWNTO 0);
+          ForegroundColor             : IN  std_logic_vector(15 DOWNTO 0);
+          BackgroundColor             : IN  std_logic_vector(15 DOWNTO 0);
           
           -- Here the DMA-interface signals are defined
           StartDMA                    : OUT std_logic;
-          DMAAddress                  : OUT std_logic_vector(31 DOWNTO 2);
+          DMAAddress                  : OUT std_logic_vector(31 DOWNTO 0);
+          DMAStride                   : OUT std_logic_vector(31 DOWNTO 0);
           DMABusy                     : IN  std_logic;
           DMAFifoEmpty                : IN  std_logic;
           DMAFifoPop                  : OUT std_logic;
@@ -1,6 +1,6 @@
 ARCHITECTURE MSE OF SendReceiveInterface IS
 
-   TYPE CONTROLSTATETYPE IS (IDLE,CLOCKDATAOUT,WRITELOW1,WRITELOW2,
+   TYPE CONTROLSTATETYPE IS (IDLE,CLOCKDATAOUT,WRITELOW,WRITEHOLD,
                              INITREAD,WAITREADLOW,READCLOCK,READHI1,READHI2,
                              READHI3,READHI4);
    TYPE RESETSTATETYPE IS (NOOP,ACTIVATERESET,WAITRESET,
@@ -11,6 +11,12 @@ ARCHITECTURE MSE OF SendReceiveInterface IS
    SIGNAL s_data_out_reg, s_data_out_next : std_logic_vector( 15 DOWNTO 0 );
    SIGNAL s_read_del_reg, s_read_del_next : unsigned( 4 DOWNTO 0 );
    SIGNAL s_read_del_zero                 : std_logic;
+   SIGNAL s_setup_cycles                  : unsigned(  3 DOWNTO 0 );
+   SIGNAL s_low_cycles                    : unsigned(  3 DOWNTO 0 );
+   SIGNAL s_hold_cycles                   : unsigned(  3 DOWNTO 0 );
+   SIGNAL s_write_del_reg                 : unsigned(  3 DOWNTO 0 );
+   SIGNAL s_write_del_next                : unsigned(  3 DOWNTO 0 );
+   SIGNAL s_write_del_zero                : std_logic;
    SIGNAL s_received_data_next            : std_logic_vector( 15 DOWNTO 0 );
    SIGNAL s_tri_bus_reg,s_tri_bus_next    : std_logic;
    SIGNAL s_current_reset,s_next_reset    : RESETSTATETYPE;
@@ -53,10 +59,9 @@ BEGIN
    make_write_bar : PROCESS( Clock )
    BEGIN
       IF (rising_edge(Clock)) THEN
-         IF (s_current_state = WRITELOW1 OR
-             s_current_state = WRITELOW2) THEN
+         IF (s_current_state = WRITELOW) THEN
             WriteBar <= '0';
-                                          ELSE
+                                         ELSE
             WriteBar <= '1';
          END IF;
       END IF;
@@ -134,9 +139,9 @@ BEGIN
 --- In this section The reset state machine is defined                       ---
 ---                                                                          ---
 --------------------------------------------------------------------------------
-   s_reset_counter_next <= to_unsigned(1199,24) 
+   s_reset_counter_next <= to_unsigned(RESET_CYCLES-1,24)
                               WHEN s_current_reset = ACTIVATERESET ELSE
-                           to_unsigned(11999999,24)
+                           to_unsigned(RECOVER_CYCLES-1,24)
                               WHEN s_current_reset = ACTIVATERECOVER ELSE
                            s_reset_counter_reg-1
                               WHEN s_reset_counter_zero = '0' ELSE
@@ -152,7 +157,7 @@ BEGIN
    END PROCESS make_reset_counter;
    
    make_reset_state_next : PROCESS( s_current_reset , s_reset_counter_zero ,
-                                    ResetDisplay )
+                                    ResetDisplay , s_current_state )
    BEGIN
       CASE( s_current_reset ) IS
          WHEN NOOP                  => IF (ResetDisplay = '1') THEN
@@ -198,7 +203,9 @@ BEGIN
                     s_current_reset = NOOP ELSE '1';
 
    update_logic : PROCESS( s_current_state, StartSendReceive,
-                           WriteReadBar , s_read_del_zero )
+                           WriteReadBar , s_read_del_zero ,
+                           s_write_del_zero , s_hold_cycles ,
+                           s_current_reset )
    BEGIN
       CASE (s_current_state) IS
          WHEN IDLE         => IF (StartSendReceive = '1' AND
@@ -211,8 +218,23 @@ BEGIN
                                                           ELSE
                                  s_next_state <= IDLE;
                               END IF;
-         WHEN CLOCKDATAOUT => s_next_state <= WRITELOW1;
-         WHEN WRITELOW1    => s_next_state <= WRITELOW2;
+         WHEN CLOCKDATAOUT => IF (s_write_del_zero = '1') THEN
+                                 s_next_state <= WRITELOW;
+                                                          ELSE
+                                 s_next_state <= CLOCKDATAOUT;
+                              END IF;
+         WHEN WRITELOW     => IF (s_write_del_zero = '0') THEN
+                                 s_next_state <= WRITELOW;
+                              ELSIF (s_hold_cycles = 0) THEN
+                                 s_next_state <= IDLE;
+                                                        ELSE
+                                 s_next_state <= WRITEHOLD;
+                              END IF;
+         WHEN WRITEHOLD    => IF (s_write_del_zero = '1') THEN
+                                 s_next_state <= IDLE;
+                                                          ELSE
+                                 s_next_state <= WRITEHOLD;
+                              END IF;
          WHEN INITREAD     => s_next_state <= WAITREADLOW;
          WHEN WAITREADLOW  => IF (s_read_del_zero = '1') THEN
                                  s_next_state <= READHI1;
@@ -235,6 +257,34 @@ BEGIN
       END IF;
    END PROCESS state_mem;
    
+   s_setup_cycles <= to_unsigned(WRITE_SETUP_CYCLES,4)
+                        WHEN WriteTiming( 3 DOWNTO 0 ) = X"0" ELSE
+                     unsigned(WriteTiming( 3 DOWNTO 0 ));
+   s_low_cycles   <= to_unsigned(WRITE_LOW_CYCLES,4)
+                        WHEN WriteTiming( 7 DOWNTO 4 ) = X"0" ELSE
+                     unsigned(WriteTiming( 7 DOWNTO 4 ));
+   s_hold_cycles  <= to_unsigned(WRITE_HOLD_CYCLES,4)
+                        WHEN WriteTiming(11 DOWNTO 8 ) = X"0" ELSE
+                     unsigned(WriteTiming(11 DOWNTO 8 ));
+
+   s_write_del_zero <= '1' WHEN s_write_del_reg = to_unsigned(0,4) ELSE '0';
+   s_write_del_next <= s_setup_cycles-1 WHEN s_current_state = IDLE ELSE
+                       s_low_cycles-1 WHEN s_current_state = CLOCKDATAOUT AND
+                                           s_write_del_zero = '1' ELSE
+                       s_hold_cycles-1 WHEN s_current_state = WRITELOW AND
+                                            s_write_del_zero = '1' ELSE
+                       s_write_del_reg-1 WHEN s_write_del_zero = '0' ELSE
+                       s_write_del_reg;
+
+   make_write_del_reg : PROCESS( Clock )
+   BEGIN
+      IF (rising_edge(Clock)) THEN
+         IF (Reset = '1') THEN s_write_del_reg <= (OTHERS => '0');
+                          ELSE s_write_del_reg <= s_write_del_next;
+         END IF;
+      END IF;
+   END PROCESS make_write_del_reg;
+
    s_read_del_zero <= '1' WHEN s_read_del_reg = to_unsigned(0,5) ELSE '0';
    s_read_del_next <= to_unsigned(17,5) WHEN s_current_state = INITREAD ELSE
                       s_read_del_reg-1 WHEN s_read_del_zero = '0' ELSE
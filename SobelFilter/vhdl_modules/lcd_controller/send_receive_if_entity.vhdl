@@ -2,7 +2,26 @@ LIBRARY ieee;
 USE ieee.std_logic_1164.all;
 USE ieee.numeric_std.all;
 
+-- The write cycle consists of three phases, each a number of Clock cycles:
+--   SETUP : data and D/C are driven, WriteBar high (>= 1)
+--   LOW   : WriteBar low (>= 1)
+--   HOLD  : WriteBar high, data still driven, busy (>= 0)
+-- WriteBar is low for LOW cycles and the data is valid SETUP+LOW+1 cycles
+-- before its rising edge. After the rising edge the data is held for HOLD
+-- cycles plus the cycles until the next StartSendReceive is taken, one or
+-- more when the user waits for busy in a registered state machine. A write
+-- is busy for SETUP+LOW+HOLD cycles. The generics are the defaults (the
+-- timing of the former fixed sequence), a field of WriteTiming (3..0 SETUP,
+-- 7..4 LOW, 11..8 HOLD) that is not zero overrides them at run time.
+-- RESET_CYCLES and RECOVER_CYCLES are the length of the display reset
+-- pulse and the time after it (24 bit), they can be shortened for
+-- simulation.
 ENTITY SendReceiveInterface IS
+   GENERIC( WRITE_SETUP_CYCLES   : INTEGER := 1;
+            WRITE_LOW_CYCLES     : INTEGER := 2;
+            WRITE_HOLD_CYCLES    : INTEGER := 0;
+            RESET_CYCLES         : INTEGER := 1200;
+            RECOVER_CYCLES       : INTEGER := 12000000);
    PORT ( -- Here the internal interface is defined
           Clock                 : IN  std_logic;
           Reset                 : IN  std_logic;
@@ -12,6 +31,7 @@ ENTITY SendReceiveInterface IS
           EightBitSixteenBitBar : IN  std_logic;
           WriteReadBar          : IN  std_logic;
           DataToSend            : IN  std_logic_vector( 15 DOWNTO 0 );
+          WriteTiming           : IN  std_logic_vector( 11 DOWNTO 0 );
           DataReceived          : OUT std_logic_vector( 15 DOWNTO 0 );
           busy                  : OUT std_logic;
           
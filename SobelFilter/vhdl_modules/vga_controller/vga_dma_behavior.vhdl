@@ -11,6 +11,7 @@ ARCHITECTURE MSE OF vga_dma IS
              PixelIndex         : IN  std_logic_vector(  9 DOWNTO 0 );
              NrOfPixelsEachLine : IN  std_logic_vector( 10 DOWNTO 0 );
              RGB565Data         : OUT std_logic_vector( 15 DOWNTO 0 );
+             FrameStart         : OUT std_logic;
              -- Here the Avalon Master Interface is defined
              master_address     : OUT std_logic_vector( 31 DOWNTO 0 );
              master_read        : OUT std_logic;
@@ -64,6 +65,12 @@ ARCHITECTURE MSE OF vga_dma IS
    SIGNAL s_FlipX_reg          : std_logic;
    SIGNAL s_QuarterScreen_reg  : std_logic;
    SIGNAL s_grayscale_reg      : std_logic;
+   SIGNAL s_frame_start        : std_logic;
+   SIGNAL s_front_pointer_reg  : std_logic_vector( 31 DOWNTO 2 );
+   SIGNAL s_flip_pending_reg   : std_logic;
+   SIGNAL s_irq_enable_reg     : std_logic;
+   SIGNAL s_irq_reg            : std_logic;
+   SIGNAL s_flip_done          : std_logic;
 
 BEGIN
    s_we_mem_pointer <= '1' WHEN slave_address = '0' AND
@@ -73,6 +80,20 @@ BEGIN
                                 slave_cs = '1' AND
                                 slave_we = '1' ELSE '0';
 
+   make_read_data : PROCESS( Clock )
+   BEGIN
+      IF (rising_edge(Clock)) THEN
+         IF (slave_address = '0') THEN
+            slave_read_data <= s_front_pointer_reg&"00";
+                                  ELSE
+            slave_read_data <= X"000000"&s_flip_pending_reg&s_irq_reg&
+                               s_irq_enable_reg&s_grayscale_reg&
+                               s_QuarterScreen_reg&s_FlipX_reg&
+                               s_test_screen_reg&s_swap_rb_reg;
+         END IF;
+      END IF;
+   END PROCESS make_read_data;
+
    make_reset_reg : PROCESS( Clock )
    BEGIN
       IF (rising_edge(Clock)) THEN
@@ -100,15 +121,62 @@ BEGIN
                                s_FlipX_reg         <= '0';
                                s_QuarterScreen_reg <= '0';
                                s_grayscale_reg     <= '0';
+                               s_irq_enable_reg    <= '0';
          ELSIF (s_we_swap_rb = '1') THEN
             s_swap_rb_reg       <= slave_write_data(0);
             s_test_screen_reg   <= slave_write_data(1);
             s_FlipX_reg         <= slave_write_data(2);
             s_QuarterScreen_reg <= slave_write_data(3);
             s_grayscale_reg     <= slave_write_data(4);
+            s_irq_enable_reg    <= slave_write_data(5);
          END IF;
       END IF;
    END PROCESS make_swap_rb_reg;
+
+--------------------------------------------------------------------------------
+---                                                                          ---
+--- In this section the page flip is handled                                 ---
+---                                                                          ---
+--------------------------------------------------------------------------------
+   -- A pointer written in the same cycle as the frame start is not latched
+   -- (the pointer register is only updated one cycle later), hence it stays
+   -- pending until the next frame.
+   s_flip_done <= s_frame_start AND s_flip_pending_reg AND
+                  NOT(s_we_mem_pointer);
+
+   make_flip_pending_reg : PROCESS( Clock )
+   BEGIN
+      IF (rising_edge(Clock)) THEN
+         IF (Reset = '1') THEN s_flip_pending_reg <= '0';
+         ELSIF (s_we_mem_pointer = '1') THEN s_flip_pending_reg <= '1';
+         ELSIF (s_flip_done = '1') THEN s_flip_pending_reg <= '0';
+         END IF;
+      END IF;
+   END PROCESS make_flip_pending_reg;
+   
+   make_front_pointer_reg : PROCESS( Clock )
+   BEGIN
+      IF (rising_edge(Clock)) THEN
+         IF (Reset = '1') THEN s_front_pointer_reg <= (OTHERS => '0');
+         ELSIF (s_frame_start = '1') THEN
+            s_front_pointer_reg <= s_memory_pointer_reg;
+         END IF;
+      END IF;
+   END PROCESS make_front_pointer_reg;
+
+   flip_done_irq <= s_irq_reg;
+
+   make_irq_reg : PROCESS( Clock )
+   BEGIN
+      IF (rising_edge(Clock)) THEN
+         IF (Reset = '1') THEN s_irq_reg <= '0';
+         ELSIF (s_flip_done = '1' AND
+                s_irq_enable_reg = '1') THEN s_irq_reg <= '1';
+         ELSIF (s_we_swap_rb = '1' AND
+                slave_write_data(6) = '1') THEN s_irq_reg <= '0';
+         END IF;
+      END IF;
+   END PROCESS make_irq_reg;
    
    dma : vga_dma_cntrl
       PORT MAP ( clock              => Clock,
@@ -121,6 +189,7 @@ BEGIN
                  PixelIndex         => s_PixelIndex,
                  NrOfPixelsEachLine => s_NrOfPixelsEachLine,
                  RGB565Data         => s_rgb565,
+                 FrameStart         => s_frame_start,
                  -- Here the Avalon Master Interface is defined
                  master_address     => master_address    ,
                  master_read        => master_read       ,
@@ -34,6 +34,9 @@ BEGIN
 --- In this section the output signals are defined                           ---
 ---                                                                          ---
 --------------------------------------------------------------------------------
+   -- MemoryPointer is sampled into s_bus_address_reg on this tick
+   FrameStart <= s_next_frame_clk;
+   
    make_del_reg : PROCESS( PixelClock )
    BEGIN
       IF (rising_edge(PixelClock)) THEN
@@ -14,6 +14,7 @@ ENTITY vga_dma_cntrl IS
           PixelIndex         : IN  std_logic_vector(  9 DOWNTO 0 );
           NrOfPixelsEachLine : IN  std_logic_vector( 10 DOWNTO 0 );
           RGB565Data         : OUT std_logic_vector( 15 DOWNTO 0 );
+          FrameStart         : OUT std_logic;
           
           -- Here the Avalon Master Interface is defined
           master_address     : OUT std_logic_vector( 31 DOWNTO 0 );
@@ -10,7 +10,9 @@ ENTITY vga_dma IS
           slave_address               : IN  std_logic;
           slave_cs                    : IN  std_logic;
           slave_we                    : IN  std_logic;
+          slave_rd                    : IN  std_logic;
           slave_write_data            : IN  std_logic_vector(31 DOWNTO 0 );
+          slave_read_data             : OUT std_logic_vector(31 DOWNTO 0 );
 
           -- Here the Avalon Master Interface is defined
           master_address              : OUT std_logic_vector( 31 DOWNTO 0 );
@@ -20,6 +22,9 @@ ENTITY vga_dma IS
           master_data_valid           : IN  std_logic;
           master_read_data            : IN  std_logic_vector( 31 DOWNTO 0 );
           
+          -- irq signal
+          flip_done_irq               : OUT std_logic;
+          
           -- Here the vga interface is defined
           red                         : OUT std_logic_vector( 9 DOWNTO 0 );
           green                       : OUT std_logic_vector( 9 DOWNTO 0 );
@@ -29,11 +34,18 @@ ENTITY vga_dma IS
 END vga_dma;
           
      -------- register model -----------
-     -- 0 Write Only: Memory pointer (if written the core starts
-     --                               automatically) 
-     -- 1 Write Only: bit 0 -> Swap RB bit
-     --               bit 2 -> TestScreen(1) Normal (0)
-     --               bit 3 -> FlipX(1) Normal (0)
-     --               bit 4 -> QuarterScreen(1) Normal (0)
-     --               bit 5 -> Grayscale(1) Normal(0)
-
+     -- 0 Write     : Memory pointer (if written the core starts
+     --                               automatically). The pointer is
+     --                               latched by the DMA at the start of
+     --                               the next frame (vertical blanking)
+     --   Read      : Memory pointer of the frame currently scanned out
+     -- 1 Write/Read: bit 0 -> Swap RB bit
+     --               bit 1 -> TestScreen(1) Normal (0)
+     --               bit 2 -> FlipX(1) Normal (0)
+     --               bit 3 -> QuarterScreen(1) Normal (0)
+     --               bit 4 -> Grayscale(1) Normal(0)
+     --               bit 5 -> Flip done IRQ enabled(1) disabled(0)
+     --               bit 6 -> Write: clear flip done IRQ
+     --                        Read : flip done IRQ status
+     --               bit 7 -> Flip pending (read only), a new pointer is
+     --                        written but not yet latched